@@ -625,6 +625,7 @@ void ai_announce_ship_dying(object *dying_objp);
 
 //Moved declaration here for player ship -WMC
 void ai_process_subobjects(int objnum);
+void ai_turret_think_all();
 
 //SUSHI: Setting ai_info stuff from both ai class and ai profile
 void init_aip_from_class_and_profile(ai_info *aip, ai_class *aicp, ai_profile_t *profile);
@@ -55,6 +55,7 @@
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/waypoint.h"
 #include "parse/parselo.h"
@@ -2376,7 +2377,7 @@ int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float ra
 {
 	object	*danger_weapon_objp;
 	ai_info	*aip;
-	ship_obj	*so;
+	static thread_local SCP_vector<int> candidates;
 
 	// initialize eno struct
 	eval_nearest_objnum eno;
@@ -2391,12 +2392,21 @@ int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float ra
 	eno.nearest_objnum = -1;
 	eno.check_danger_weapon_objnum = 0;
 
-	// go through the list of all ships and evaluate as potential targets
-	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-		if (Objects[so->objnum].flags[Object::Object_Flags::Should_be_dead])
+	// go through the nearby ships and evaluate as potential targets
+	// evaluate_object_as_nearest_objnum() halves the distance to fighters and bombers and measures the distance to big
+	// ships from their bounding box, so nothing beyond twice the range (plus the reach of the ship) can be picked
+	object_grid::filter filter;
+	filter.type_mask = object_grid::type_bit(OBJ_SHIP);
+	filter.team_mask = enemy_team_mask;
+	filter.excluded_flags = OGF_DYING | OGF_NOT_A_TARGET_CLASS;
+
+	candidates.clear();
+	obj_grid_find(Objects[objnum].pos, 2.0f * range, filter, candidates);
+	for (int trial_objnum : candidates) {
+		if (Objects[trial_objnum].flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
-		eno.trial_objp = &Objects[so->objnum];
+		eno.trial_objp = &Objects[trial_objnum];
 		evaluate_object_as_nearest_objnum(&eno);
 	}
 
@@ -2445,15 +2455,22 @@ int find_nearby_threat(int objnum, int enemy_team_mask, float range, int *count)
 	int		nearest_objnum;
 	float		nearest_dist;
 	object	*objp;
-	ship_obj	*so;
+	static thread_local SCP_vector<int> candidates;
 
 	nearest_objnum = -1;
 	nearest_dist = range;
 
 	*count = 0;
 
-	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-		objp = &Objects[so->objnum];
+	object_grid::filter filter;
+	filter.type_mask = object_grid::type_bit(OBJ_SHIP);
+	filter.team_mask = enemy_team_mask;
+	filter.excluded_flags = OGF_DYING | OGF_NOT_A_TARGET_CLASS;
+
+	candidates.clear();
+	obj_grid_find(Objects[objnum].pos, range, filter, candidates);
+	for (int candidate : candidates) {
+		objp = &Objects[candidate];
 		if (objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
@@ -4524,11 +4541,17 @@ void update_min_max(float val, float *min, float *max)
 int get_enemy_team_range(object *my_objp, float range, int enemy_team_mask, vec3d *min_vec, vec3d *max_vec)
 {
 	object	*objp;
-	ship_obj	*so;
 	int		count = 0;
+	static thread_local SCP_vector<int> candidates;
+
+	object_grid::filter filter;
+	filter.type_mask = object_grid::type_bit(OBJ_SHIP);
+	filter.team_mask = enemy_team_mask;
 
-    for (so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
-        objp = &Objects[so->objnum];
+	candidates.clear();
+	obj_grid_find(my_objp->pos, range, filter, candidates);
+    for (int candidate : candidates) {
+        objp = &Objects[candidate];
 		if (objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
@@ -10621,15 +10644,22 @@ static object *ai_find_nearby_mine_threat(object *from_objp, object *against_obj
 // Returns 1 if a threat was found and targeted, otherwise 0.
 int ai_guard_find_nearby_bomb(object *guarding_objp, object *guarded_objp)
 {
-	missile_obj	*mo;
 	object		*bomb_objp, *closest_bomb_objp=NULL;
 	float			dist, dist_to_guarding_obj,closest_dist_to_guarding_obj=999999.0f;
 	weapon		*wp;
 	weapon_info	*wip;
+	static thread_local SCP_vector<int> candidates;
 
-	for ( mo = GET_NEXT(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
-		bomb_objp = &Objects[mo->objnum];
+	float threshold = ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 3);
+
+	object_grid::filter filter;
+	filter.type_mask = object_grid::type_bit(OBJ_WEAPON);
+	filter.required_flags = OGF_FIGHTER_INTERCEPTABLE;
+
+	candidates.clear();
+	obj_grid_find(guarded_objp->pos, threshold, filter, candidates);
+	for (int candidate : candidates) {
+		bomb_objp = &Objects[candidate];
 		if (bomb_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
@@ -10650,7 +10680,7 @@ int ai_guard_find_nearby_bomb(object *guarding_objp, object *guarded_objp)
 
 		dist = vm_vec_dist_quick(&bomb_objp->pos, &guarded_objp->pos);
 
-		if (dist < ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 3)) {
+		if (dist < threshold) {
 			dist_to_guarding_obj = vm_vec_dist_quick(&bomb_objp->pos, &guarding_objp->pos);
 			if ( dist_to_guarding_obj < closest_dist_to_guarding_obj ) {
 				closest_dist_to_guarding_obj = dist_to_guarding_obj;
@@ -10681,13 +10711,22 @@ void ai_guard_find_nearby_ship(object *guarding_objp, object *guarded_objp)
 {
 	ship *guarding_shipp = &Ships[guarding_objp->instance];
 	ai_info	*guarding_aip = &Ai_info[guarding_shipp->ai_index];
-	ship_obj *so;
 	object *enemy_objp;
 	float dist;
+	static thread_local SCP_vector<int> candidates;
 
-	for (so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so))
+	float attack_threshold = ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 3);
+	float attacker_threshold = ai_guard_threshold(guarded_objp, 3000.0f);
+
+	object_grid::filter filter;
+	filter.type_mask = object_grid::type_bit(OBJ_SHIP);
+	filter.team_mask = iff_get_attackee_mask(guarding_shipp->team);
+
+	candidates.clear();
+	obj_grid_find(guarded_objp->pos, std::max(attack_threshold, attacker_threshold), filter, candidates);
+	for (int candidate : candidates)
 	{
-		enemy_objp = &Objects[so->objnum];
+		enemy_objp = &Objects[candidate];
 		if (enemy_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 		if (enemy_objp->instance < 0)
@@ -10701,10 +10740,10 @@ void ai_guard_find_nearby_ship(object *guarding_objp, object *guarded_objp)
 			if (Ship_info[eshipp->ship_info_index].class_type >= 0 && (Ship_types[Ship_info[eshipp->ship_info_index].class_type].flags[Ship::Type_Info_Flags::AI_guards_attack]))
 			{
 				dist = vm_vec_dist_quick(&enemy_objp->pos, &guarded_objp->pos);
-				if (dist < ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 3))
+				if (dist < attack_threshold)
 				{
 					guard_object_was_hit(guarding_objp, enemy_objp);
-				} else if ((dist < ai_guard_threshold(guarded_objp, 3000.0f)) &&
+				} else if ((dist < attacker_threshold) &&
 						   (Ai_info[eshipp->ai_index].target_objnum == guarding_aip->guard_objnum))
 				{
 					guard_object_was_hit(guarding_objp, enemy_objp);
@@ -10723,16 +10762,24 @@ void ai_guard_find_nearby_asteroid(object *guarding_objp, object *guarded_objp)
 
 	object	*closest_asteroid_objp=NULL, *danger_asteroid_objp=NULL, *asteroid_objp;
 	float		dist_to_self, closest_danger_asteroid_dist=999999.0f, closest_asteroid_dist=999999.0f;
+	static thread_local SCP_vector<int> candidates;
+
+	float threshold = ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 2);
+
+	object_grid::filter filter;
+	filter.type_mask = object_grid::type_bit(OBJ_ASTEROID);
 
-	for (auto aop: list_range(&Asteroid_obj_list)) {
-		asteroid_objp = &Objects[aop->objnum];
+	candidates.clear();
+	obj_grid_find(guarded_objp->pos, threshold, filter, candidates);
+	for (int candidate : candidates) {
+		asteroid_objp = &Objects[candidate];
 		if (asteroid_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
 		if ( asteroid_objp->type == OBJ_ASTEROID ) {
 			// Attack asteroid if near guarded ship
 			dist = vm_vec_dist_quick(&asteroid_objp->pos, &guarded_objp->pos);
-			if (dist < ai_guard_threshold(guarded_objp, (MAX_GUARD_DIST + guarded_objp->radius) * 2)) {
+			if (dist < threshold) {
 				dist_to_self = vm_vec_dist_quick(&asteroid_objp->pos, &guarding_objp->pos);
 				if ( OBJ_INDEX(guarded_objp) == asteroid_collide_objnum(asteroid_objp) ) {
 					if( dist_to_self < closest_danger_asteroid_dist ) {
@@ -15,12 +15,15 @@
 #include "network/multi.h"
 #include "network/multimsgs.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "scripting/global_hooks.h"
 #include "scripting/scripting.h"
 #include "render/3d.h"
 #include "ship/ship.h"
 #include "ship/shipfx.h"
+#include "tracing/tracing.h"
 #include "utils/Random.h"
+#include "utils/threading.h"
 #include "weapon/beam.h"
 #include "weapon/flak.h"
 #include "weapon/muzzleflash.h"
@@ -46,6 +49,33 @@ DCF(lethality_range, "N for modifying range: 1 / (1+N) at 100")
 	dc_stuff_float(&Lethality_range_const);
 }
 
+// Turret targets are picked on the task pool at the start of the frame, see ai_turret_think_all()
+bool Ai_turret_think = true;
+DCF_BOOL2(ai_turret_think, Ai_turret_think, "Turns picking turret targets in parallel at the start of the frame on/off",
+		  "Usage: ai_turret_think [bool]\nTurns picking turret targets on the task pool before objects move on/off.  If nothing passed, then toggles it.\n");
+
+bool Ai_turret_think_verify = false;
+DCF_BOOL2(ai_turret_think_verify, Ai_turret_think_verify, "Turns checking parallel turret target picks against serial ones on/off",
+		  "Usage: ai_turret_think_verify [bool]\nPicks the turret targets of every frame a second time on the main thread and reports any difference.  If nothing passed, then toggles it.\n");
+
+static int Turret_think_generation = 0;
+
+namespace {
+// How many turrets of the ship were attacking an object when a target pick asked
+struct turret_attackers {
+	int objnum;
+	int count;
+};
+}
+
+// The attacker counts the picks of the last ai_turret_think_all() depend on, see ship_subsys::turret_thought_attackers
+static SCP_vector<turret_attackers> Turret_thought_attackers;
+
+// set while ai_turret_think_all() picks a target on this thread
+static thread_local bool Turret_thinking = false;
+static thread_local bool Turret_thought_needs_serial = false;
+static thread_local SCP_vector<turret_attackers> *Turret_thinking_attackers = nullptr;
+
 float Player_lethality_bump[NUM_SKILL_LEVELS] = {
 	// 0.0f, 5.0f, 10.0f, 25.0f, 40.0f
 	0.0f, 0.0f, 0.0f, 0.0f, 0.0f
@@ -491,6 +521,20 @@ int valid_turret_enemy(object *objp, object *turret_parent)
 	return 0;
 }
 
+/**
+ * num_turrets_attacking(), which also remembers the answer while ai_turret_think_all() picks a target.  The other
+ * turrets on the ship can change their targets before the pick is taken, so the pick is only good as long as the
+ * answers stay the same.
+ */
+static int turret_num_attacking(const object *turret_parent, int target_objnum)
+{
+	int count = num_turrets_attacking(turret_parent, target_objnum);
+	if (Turret_thinking)
+		Turret_thinking_attackers->push_back({target_objnum, count});
+
+	return count;
+}
+
 extern int Player_attacking_enabled;
 void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 {
@@ -591,6 +635,13 @@ void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 			// BYPASS ocassionally for stealth
 			int try_anyway = FALSE;
 			if ( is_object_stealth_ship(objp) ) {
+				// the roll has to come out of the random numbers in the same order as before, so leave this
+				// pick to the turret itself
+				if (Turret_thinking) {
+					Turret_thought_needs_serial = true;
+					return;
+				}
+
 				float turret_stealth_find_chance = 0.5f;
 				float speed_mod = -0.1f + vm_vec_mag_quick(&objp->phys_info.vel) / 70.0f;
 				if (frand() > (turret_stealth_find_chance + speed_mod)) {
@@ -645,7 +696,7 @@ void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 	if ((objp->type == OBJ_WEAPON) && check_weapon) {
 		//Maybe restrict the number of turrets attacking this bomb
 		if (ss->turret_max_bomb_ownage != -1) {	
-			int num_att_turrets = num_turrets_attacking(turret_parent_obj, OBJ_INDEX(objp));
+			int num_att_turrets = turret_num_attacking(turret_parent_obj, OBJ_INDEX(objp));
 			if (num_att_turrets > ss->system_info->turret_max_bomb_ownage) {
 				return;
 			}
@@ -687,7 +738,7 @@ void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 
 		// modify distance based on number of turrets from my ship attacking enemy (add 10% per turret)
 		// dist *= (num_enemies_attacking(OBJ_INDEX(objp))+2)/2;	//	prevents lots of ships from attacking same target
-		int num_att_turrets = num_turrets_attacking(turret_parent_obj, OBJ_INDEX(objp));
+		int num_att_turrets = turret_num_attacking(turret_parent_obj, OBJ_INDEX(objp));
 		dist_comp *= (1.0f + 0.1f*num_att_turrets);
 
 		// return if we're over the cap
@@ -757,6 +808,20 @@ void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 	} // end asteroid selection
 }
 
+// Whether objp is in the field of view of the turret, measured the way evaluate_obj_as_target() does
+static bool turret_target_in_fov(const object *objp, const eval_enemy_obj_struct *eeo)
+{
+	vec3d vec_to_target;
+	vm_vec_sub(&vec_to_target, &objp->pos, eeo->tpos);
+
+	float dist = vm_vec_mag_quick(&vec_to_target) - objp->radius;
+	if (dist < 0.0f) {
+		dist = 0.0f;
+	}
+
+	return object_in_turret_fov(objp, eeo->turret_subsys, eeo->tvec, eeo->tpos, dist + objp->radius);
+}
+
 /**
  * Given an object and an enemy team, return the index of the nearest enemy object.
  *
@@ -780,8 +845,10 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 	auto swp = &turret_subsys->weapons;
 
 	// list of stuff to go thru
-	ship_obj		*so;
 	missile_obj *mo;
+	static thread_local SCP_vector<int> candidates;
+	object_grid::filter ship_filter;
+	ship_filter.type_mask = object_grid::type_bit(OBJ_SHIP);
 
 	//wip=&Weapon_info[tp->turret_weapon_type];
 	//weapon_travel_dist = MIN(wip->lifetime * wip->max_speed, wip->weapon_range);
@@ -822,6 +889,9 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 	eeo.tvec = tvec;
 	eeo.turret_subsys = turret_subsys;
 
+	// see evaluate_obj_as_target(), a turret without a target only ignores its field of view if it isn't required
+	const bool fov_required = turret_subsys->flags[Ship::Subsystem_Flags::FOV_Required] || (current_enemy != -1);
+
 	// here goes the new targeting priority setting
 	int n_tgt_priorities;
 	int priority_weapon_idx = -1;
@@ -1006,11 +1076,22 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 
 				case 1:
 					//Return if a ship is found
-					// Ship_used_list
-					for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-						auto objp = &Objects[so->objnum];
+					// evaluate_obj_as_target() only takes ships of the enemy team within weapon_travel_dist of the
+					// turret, so the grid has to be asked about those only
+					candidates.clear();
+					ship_filter.team_mask = enemy_team_mask;
+					obj_grid_find(*tpos, eeo.weapon_travel_dist, ship_filter, candidates);
+					for (int objnum : candidates) {
+						auto objp = &Objects[objnum];
 						if (objp->flags[Object::Object_Flags::Should_be_dead])
 							continue;
+
+						// Unless the turret takes targets outside its field of view, ships outside of it can't become
+						// the target, so don't bother scoring them.  Stealth ships are still evaluated, because they
+						// may roll for being spotted.
+						if (fov_required && !is_object_stealth_ship(objp) && !turret_target_in_fov(objp, &eeo))
+							continue;
+
 						evaluate_obj_as_target(objp, &eeo);
 					}
 
@@ -1059,6 +1140,95 @@ int get_nearest_turret_objnum(int turret_parent_objnum, const ship_subsys *turre
 	return -1;
 }
 
+// What the weapons of a turret limit its targets to
+struct turret_target_flags {
+	bool big_only;
+	bool small_only;
+	bool tagged_only;
+	bool beam;
+	bool flak;
+	bool laser;
+	bool missile;
+
+	int bits() const
+	{
+		return (big_only ? 1 : 0) | (small_only ? 2 : 0) | (tagged_only ? 4 : 0) | (beam ? 8 : 0) | (flak ? 16 : 0) | (laser ? 32 : 0) | (missile ? 64 : 0);
+	}
+};
+
+static turret_target_flags turret_get_target_flags(const ship_subsys *turret_subsys)
+{
+	auto swp = &turret_subsys->weapons;
+
+	turret_target_flags flags;
+	flags.big_only = all_turret_weapons_have_flags(swp, Weapon::Info_Flags::Huge);
+	flags.small_only = all_turret_weapons_have_flags(swp, Weapon::Info_Flags::Small_only);
+	flags.tagged_only = all_turret_weapons_have_flags(swp, Weapon::Info_Flags::Tagged_only) || (swp->flags[Ship::Weapon_Flags::Tagged_Only]);
+
+	flags.beam = turret_weapon_has_flags(swp, Weapon::Info_Flags::Beam);
+	flags.flak = turret_weapon_has_flags(swp, Weapon::Info_Flags::Flak);
+	flags.laser = turret_weapon_has_subtype(swp, WP_LASER);
+	flags.missile = turret_weapon_has_subtype(swp, WP_MISSILE);
+
+	return flags;
+}
+
+static int turret_get_nearest_enemy(int objnum, const ship_subsys *turret_subsys, int enemy_team_mask, const vec3d *tpos, const vec3d *tvec, int current_enemy, const turret_target_flags &flags)
+{
+	return get_nearest_turret_objnum(objnum, turret_subsys, enemy_team_mask, tpos, tvec, current_enemy, flags.big_only, flags.small_only, flags.tagged_only, flags.beam, flags.flak, flags.laser, flags.missile);
+}
+
+// The checks of evaluate_obj_as_target() that SEXPs and scripts can flip at any time
+static bool turret_target_is_protected(const object *objp, const turret_target_flags &flags)
+{
+	if (objp->flags[Object::Object_Flags::Protected])
+		return true;
+
+	return (objp->flags[Object::Object_Flags::Beam_protected] && flags.beam)
+		|| (objp->flags[Object::Object_Flags::Flak_protected] && flags.flak)
+		|| (objp->flags[Object::Object_Flags::Laser_protected] && flags.laser)
+		|| (objp->flags[Object::Object_Flags::Missile_protected] && flags.missile);
+}
+
+/**
+ * Takes the target ai_turret_think_all() picked for the turret at the start of the frame
+ *
+ * @return false if there is no pick, or if the turret, its pick or the other turrets have changed in a way that could
+ * change the pick
+ */
+static bool turret_take_thought(const ship_subsys *turret_subsys, int objnum, int current_enemy, int enemy_team_mask, const turret_target_flags &flags, int *enemy_objnum)
+{
+	if (turret_subsys->turret_thought_generation != Turret_think_generation)
+		return false;
+
+	if (turret_subsys->turret_thought_current_enemy != current_enemy)
+		return false;
+
+	// a changed team or a changed weapon can rule out the pick or make others possible
+	if (turret_subsys->turret_thought_team_mask != enemy_team_mask || turret_subsys->turret_thought_target_flags != flags.bits())
+		return false;
+
+	int thought_objnum = turret_subsys->turret_thought_enemy_objnum;
+	if (thought_objnum >= 0) {
+		auto thought_objp = &Objects[thought_objnum];
+		if (thought_objp->signature != turret_subsys->turret_thought_enemy_sig || thought_objp->flags[Object::Object_Flags::Should_be_dead])
+			return false;
+
+		if (obj_team(thought_objp) != turret_subsys->turret_thought_enemy_team || turret_target_is_protected(thought_objp, flags))
+			return false;
+	}
+
+	// the other turrets on the ship only matter through how many of them attack the objects the pick looked at
+	for (int i = 0; i < turret_subsys->turret_thought_num_attackers; ++i) {
+		const auto &attackers = Turret_thought_attackers[turret_subsys->turret_thought_attackers + i];
+		if (num_turrets_attacking(&Objects[objnum], attackers.objnum) != attackers.count)
+			return false;
+	}
+
+	*enemy_objnum = thought_objnum;
+	return true;
+}
+
 int Use_parent_target = 0;
 DCF_BOOL(use_parent_target, Use_parent_target)
 
@@ -1078,14 +1248,7 @@ int find_turret_enemy(const ship_subsys *turret_subsys, int objnum, const vec3d
 
 	enemy_team_mask = iff_get_attackee_mask(obj_team(&Objects[objnum]));
 
-	bool big_only_flag = all_turret_weapons_have_flags(&turret_subsys->weapons, Weapon::Info_Flags::Huge);
-	bool small_only_flag = all_turret_weapons_have_flags(&turret_subsys->weapons, Weapon::Info_Flags::Small_only);
-    bool tagged_only_flag = all_turret_weapons_have_flags(&turret_subsys->weapons, Weapon::Info_Flags::Tagged_only) || (turret_subsys->weapons.flags[Ship::Weapon_Flags::Tagged_Only]);
-
-	bool beam_flag = turret_weapon_has_flags(&turret_subsys->weapons, Weapon::Info_Flags::Beam);
-	bool flak_flag = turret_weapon_has_flags(&turret_subsys->weapons, Weapon::Info_Flags::Flak);
-	bool laser_flag = turret_weapon_has_subtype(&turret_subsys->weapons, WP_LASER);
-	bool missile_flag = turret_weapon_has_subtype(&turret_subsys->weapons, WP_MISSILE);
+	auto flags = turret_get_target_flags(turret_subsys);
 
 	//	If a small ship and target_objnum != -1, use that as goal.
 	ai_info	*aip = &Ai_info[Ships[Objects[objnum].instance].ai_index];
@@ -1123,18 +1286,18 @@ int find_turret_enemy(const ship_subsys *turret_subsys, int objnum, const vec3d
 			// maybe use ship target_objnum if valid for turret
 			// check for beam weapon and beam protected, etc.
 			bool skip = false;
-			     if ( target_flags[Object::Object_Flags::Beam_protected] && beam_flag ) skip = true;
-			else if ( target_flags[Object::Object_Flags::Flak_protected] && flak_flag ) skip = true;
-			else if ( target_flags[Object::Object_Flags::Laser_protected] && laser_flag ) skip = true;
-            else if ( target_flags[Object::Object_Flags::Missile_protected] && missile_flag) skip = true;
+			     if ( target_flags[Object::Object_Flags::Beam_protected] && flags.beam ) skip = true;
+			else if ( target_flags[Object::Object_Flags::Flak_protected] && flags.flak ) skip = true;
+			else if ( target_flags[Object::Object_Flags::Laser_protected] && flags.laser ) skip = true;
+            else if ( target_flags[Object::Object_Flags::Missile_protected] && flags.missile) skip = true;
 
 			if (!skip) {
 				if ( Objects[aip->target_objnum].type == OBJ_SHIP ) {
 					ship_info* esip = &Ship_info[Ships[Objects[aip->target_objnum].instance].ship_info_index];
 					// check for huge weapon and huge ship
-					if ( !big_only_flag || (esip->class_type >= 0 && Ship_types[esip->class_type].flags[Ship::Type_Info_Flags::Targeted_by_huge_Ignored_by_small_only]) ) {
+					if ( !flags.big_only || (esip->class_type >= 0 && Ship_types[esip->class_type].flags[Ship::Type_Info_Flags::Targeted_by_huge_Ignored_by_small_only]) ) {
 						// check for tagged only and tagged ship
-						if ( tagged_only_flag && ship_is_tagged(&Objects[aip->target_objnum]) ) {
+						if ( flags.tagged_only && ship_is_tagged(&Objects[aip->target_objnum]) ) {
 							// select new target if aip->target_objnum is out of field of view
 							vec3d v2e;
 							bool in_fov;
@@ -1154,12 +1317,13 @@ int find_turret_enemy(const ship_subsys *turret_subsys, int objnum, const vec3d
 		}
 	}
 
-	enemy_objnum = get_nearest_turret_objnum(objnum, turret_subsys, enemy_team_mask, tpos, tvec, current_enemy, big_only_flag, small_only_flag, tagged_only_flag, beam_flag, flak_flag, laser_flag, missile_flag);
+	if (!turret_take_thought(turret_subsys, objnum, current_enemy, enemy_team_mask, flags, &enemy_objnum))
+		enemy_objnum = turret_get_nearest_enemy(objnum, turret_subsys, enemy_team_mask, tpos, tvec, current_enemy, flags);
 	if ( enemy_objnum >= 0 ) {
-		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Beam_protected]) && beam_flag) );
-		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Flak_protected]) && flak_flag) );
-		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Laser_protected]) && laser_flag) );
-		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Missile_protected]) && missile_flag) );
+		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Beam_protected]) && flags.beam) );
+		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Flak_protected]) && flags.flak) );
+		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Laser_protected]) && flags.laser) );
+		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Missile_protected]) && flags.missile) );
 		Assertion(!Objects[enemy_objnum].flags[Object::Object_Flags::Protected], "find_turret_enemy selected an object of type %d %s that is protected, please report to the SCP!", Objects[enemy_objnum].type, Objects[enemy_objnum].type == OBJ_SHIP ? Ships[Objects[enemy_objnum].instance].ship_name : "");
 
 		if ( Objects[enemy_objnum].flags[Object::Object_Flags::Protected] ) {
@@ -1555,6 +1719,147 @@ bool turret_should_pick_new_target(ship_subsys *turret)
 	return timestamp_elapsed(turret->turret_next_enemy_check_stamp);
 }
 
+namespace {
+struct turret_think_job {
+	int objnum;
+	ship_subsys *turret;
+};
+
+struct turret_thought {
+	int enemy_objnum;
+	int enemy_sig;
+	int enemy_team;
+	int current_enemy;
+	int team_mask;
+	int target_flags;
+	SCP_vector<turret_attackers> attackers;
+	bool needs_serial;
+};
+}
+
+/**
+ * Picks a target for the turret the way find_turret_enemy() would, without changing anything
+ */
+static void turret_think(const turret_think_job &job, turret_thought &thought)
+{
+	auto objp = &Objects[job.objnum];
+	auto ss = job.turret;
+	auto tp = ss->system_info;
+
+	// ai_turret_execute_behavior() forgets targets that have gone away before it looks for a new one
+	thought.current_enemy = ss->turret_enemy_objnum;
+	if (thought.current_enemy < 0 || thought.current_enemy >= MAX_OBJECTS || ss->turret_enemy_sig != Objects[thought.current_enemy].signature)
+		thought.current_enemy = -1;
+
+	vec3d global_gun_pos, global_gun_vec;
+	if (tp->flags[Model::Subsystem_Flags::Turret_distant_firepoint] || Always_use_distant_firepoints) {
+		ship_get_global_turret_gun_info(objp, ss, &global_gun_pos, false, &global_gun_vec, true, nullptr);
+	} else {
+		ship_get_global_turret_info(objp, tp, &global_gun_pos, &global_gun_vec);
+	}
+
+	Turret_thinking = true;
+	Turret_thought_needs_serial = false;
+	Turret_thinking_attackers = &thought.attackers;
+	thought.attackers.clear();
+
+	auto flags = turret_get_target_flags(ss);
+	thought.team_mask = iff_get_attackee_mask(obj_team(objp));
+	thought.target_flags = flags.bits();
+	thought.enemy_objnum = turret_get_nearest_enemy(job.objnum, ss, thought.team_mask, &global_gun_pos, &global_gun_vec, thought.current_enemy, flags);
+	thought.enemy_sig = thought.enemy_objnum >= 0 ? Objects[thought.enemy_objnum].signature : 0;
+	thought.enemy_team = thought.enemy_objnum >= 0 ? obj_team(&Objects[thought.enemy_objnum]) : -1;
+	thought.needs_serial = Turret_thought_needs_serial;
+
+	Turret_thinking = false;
+	Turret_thinking_attackers = nullptr;
+}
+
+/**
+ * Picks new targets for all turrets due to look for one this frame on the task pool, before any object has moved.
+ *
+ * Looking through the candidates is what turrets spend most of their time on, and nothing else changes while this runs,
+ * so the picks don't depend on how many threads there are.  find_turret_enemy() later takes the pick, unless the turret,
+ * its target or the targets of the other turrets on the ship have changed in a way that could change it, in which case
+ * it looks again itself.  Targets are thus picked from where things were at the start of the frame.
+ */
+void ai_turret_think_all()
+{
+	TRACE_SCOPE(tracing::AiTurretThink);
+
+	// picks from earlier frames are never used
+	Turret_think_generation++;
+
+	if (!Ai_turret_think || physics_paused || ai_paused || !Ai_firing_enabled || MULTIPLAYER_CLIENT)
+		return;
+
+	if (gameseq_get_state() == GS_STATE_LAB)
+		return;
+
+	static SCP_vector<turret_think_job> jobs;
+	static SCP_vector<turret_thought> thoughts;
+	jobs.clear();
+
+	for (auto so : list_range(&Ship_obj_list)) {
+		auto objp = &Objects[so->objnum];
+		if (objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		auto shipp = &Ships[objp->instance];
+		if (shipp->ai_index < 0)
+			continue;
+
+		for (auto ss : list_range(&shipp->subsys_list)) {
+			if (ss->system_info->type != SUBSYSTEM_TURRET || ss->current_hits <= 0.0f)
+				continue;
+
+			if (!turret_should_pick_new_target(ss) || ss->scripting_target_override || ss->flags[Ship::Subsystem_Flags::Forced_target])
+				continue;
+
+			if (ss->weapons.flags[Ship::Weapon_Flags::Turret_Lock])
+				continue;
+
+			jobs.push_back({so->objnum, ss});
+		}
+	}
+
+	thoughts.resize(jobs.size());
+	threading::parallel_for(0, jobs.size(), 4, [](size_t i) { turret_think(jobs[i], thoughts[i]); });
+
+	if (Ai_turret_think_verify) {
+		int mismatches = 0;
+		turret_thought serial;
+		for (size_t i = 0; i < jobs.size(); ++i) {
+			turret_think(jobs[i], serial);
+			if (serial.enemy_objnum != thoughts[i].enemy_objnum || serial.needs_serial != thoughts[i].needs_serial) {
+				mprintf(("Turret %s on %s picked object %d in parallel, but %d on its own\n", jobs[i].turret->system_info->subobj_name,
+					Ships[Objects[jobs[i].objnum].instance].ship_name, thoughts[i].enemy_objnum, serial.enemy_objnum));
+				mismatches++;
+			}
+		}
+		Assertion(mismatches == 0, "%d turrets picked different targets in parallel than on their own, see the log for details!", mismatches);
+	}
+
+	Turret_thought_attackers.clear();
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		const auto &thought = thoughts[i];
+		if (thought.needs_serial)
+			continue;
+
+		auto ss = jobs[i].turret;
+		ss->turret_thought_generation = Turret_think_generation;
+		ss->turret_thought_enemy_objnum = thought.enemy_objnum;
+		ss->turret_thought_enemy_sig = thought.enemy_sig;
+		ss->turret_thought_enemy_team = thought.enemy_team;
+		ss->turret_thought_current_enemy = thought.current_enemy;
+		ss->turret_thought_team_mask = thought.team_mask;
+		ss->turret_thought_target_flags = thought.target_flags;
+		ss->turret_thought_attackers = static_cast<int>(Turret_thought_attackers.size());
+		ss->turret_thought_num_attackers = static_cast<int>(thought.attackers.size());
+		Turret_thought_attackers.insert(Turret_thought_attackers.end(), thought.attackers.begin(), thought.attackers.end());
+	}
+}
+
 /**
  * Set the next fire timestamp for a turret, based on weapon type and ai class
  */
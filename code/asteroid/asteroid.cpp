@@ -31,6 +31,7 @@
 #include "network/multiutil.h"
 #include "object/objcollide.h"
 #include "object/object.h"
+#include "object/objectgrid.h"
 #include "parse/parselo.h"
 #include "particle/ParticleEffect.h"
 #include "scripting/global_hooks.h"
@@ -167,6 +168,7 @@ static int asteroid_obj_list_add(int objnum)
 	Asteroid_objs[index].objnum = objnum;
 	list_append(&Asteroid_obj_list, &Asteroid_objs[index]);
 	Asteroid_objs[index].flags |= ASTEROID_OBJ_USED;
+	obj_grid_add_late(objnum);
 
 	return index;
 }
@@ -34,8 +34,10 @@
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 #include "ktxutils/ktxutils.h"
+#include "utils/threading.h"
 
 #include <cctype>
+#include <chrono>
 #include <climits>
 #include <iomanip>
 #include <memory>
@@ -103,6 +105,70 @@ static int Bm_max_ram = 0;
 static int Bm_ignore_duplicates = 0;
 static int Bm_ignore_load_count = 0;
 
+/**
+ * Key of the loaded bitmap index: the lower case file name without extension (i.e. what strextcmp() compares), the
+ * directory type and whether the bitmap is part of an animation
+ */
+struct bm_name_key {
+	SCP_string name;
+	int dir_type;
+	bool animated;
+
+	bool operator==(const bm_name_key& other) const {
+		return dir_type == other.dir_type && animated == other.animated && name == other.name;
+	}
+};
+
+struct bm_name_key_hash {
+	size_t operator()(const bm_name_key& key) const {
+		size_t seed = std::hash<SCP_string>()(key.name);
+		boost::hash_combine(seed, key.dir_type);
+		boost::hash_combine(seed, key.animated);
+		return seed;
+	}
+};
+
+/**
+ * All loaded bitmaps by name, so that bm_load_sub_fast() doesn't have to look at every slot.  The handles of a key are
+ * kept in ascending order, which is the order in which the slots used to be searched.
+ */
+static SCP_unordered_map<bm_name_key, SCP_vector<int>, bm_name_key_hash> Bm_name_index;
+
+/**
+ * Pixel data of a bitmap that a worker thread decoded during bm_page_in_stop(), waiting to be picked up by the
+ * bm_lock_*() function of the bitmap on the main thread
+ */
+struct bm_staged_image {
+	ubyte* data = nullptr;
+	size_t size = 0;
+	int bpp = 0;
+	int error = 0;		// the DDS_ERROR_* a worker got reading a DDS file, data is nullptr then
+};
+
+static SCP_unordered_map<int, bm_staged_image> Bm_staged_images;
+
+/**
+ * A bitmap to be decoded by a worker thread.  Everything the worker needs is copied out of the bitmap entry, since
+ * the main thread keeps working on the entries while the workers run.
+ */
+struct bm_decode_job {
+	int handle = -1;
+	BM_TYPE type = BM_TYPE_NONE;		// the type of the image file, i.e. the frame type for EFFs
+	BM_TYPE comp_type = BM_TYPE_NONE;
+	char filename[MAX_FILENAME_LEN];
+	int dir_type = CF_TYPE_ANY;
+	int bpp = 0;
+	size_t size = 0;
+
+	bm_staged_image image;				// filled in by the worker, data stays nullptr if decoding failed
+};
+
+// How many bitmaps (and how many bytes of them) are handed to the decoding workers at once while paging
+static const size_t BM_PAGE_IN_BATCH_SIZE = 64;
+static const size_t BM_PAGE_IN_BATCH_BYTES = 64 * 1024 * 1024;
+
+static std::chrono::steady_clock::time_point Bm_page_in_start_time;
+
 // This needs to be declared somewhere and bm_internal.h has no own source file
 gr_bitmap_info::~gr_bitmap_info() = default;
 
@@ -251,6 +317,16 @@ static int bm_load_sub_slow(const char *real_filename, const int num_ext, const
  */
 static int bm_load_sub_fast(const char *real_filename, int *handle, int dir_type = CF_TYPE_ANY, bool animated_type = false);
 
+/**
+ * Adds a bitmap to the name index once its filename, type and dir_type have been set up
+ */
+static void bm_index_add(bitmap_entry* entry);
+
+/**
+ * Removes a bitmap from the name index, before its filename, type or dir_type are changed
+ */
+static void bm_index_remove(bitmap_entry* entry);
+
 /**
  * @brief Finds a start handle to a block of contiguous bitmap slots
  *
@@ -539,6 +615,7 @@ void bm_close() {
 			}
 		}
 		bm_blocks.clear();
+		Bm_name_index.clear();
 		bm_inited = false;
 	}
 }
@@ -592,6 +669,8 @@ int bm_create(int bpp, int w, int h, void *data, int flags) {
 
 	entry->load_count++;
 
+	bm_index_add(entry);
+
 	bm_update_memory_used(n, (int)entry->mem_taken);
 
 	gr_bm_create(bm_get_slot(n));
@@ -645,6 +724,8 @@ int bm_create_3d(int bpp, int w, int h, int d, void* data) {
 
 	entry->load_count++;
 
+	bm_index_add(entry);
+
 	bm_update_memory_used(n, (int)entry->mem_taken);
 
 	gr_bm_create(bm_get_slot(n));
@@ -1340,6 +1421,8 @@ int bm_load(const char *real_filename, int dir_type) {
 
 	entry->load_count++;
 
+	bm_index_add(entry);
+
 	if (img_cfp != nullptr)
 		cfclose(img_cfp);
 
@@ -1887,6 +1970,10 @@ int bm_load_animation(const char *real_filename, int *nframes, int *fps, int *ke
 	// Set array flag of first frame
 	first_entry->info.ani.is_array = is_array;
 
+	for (i = 0; i < anim_frames; i++) {
+		bm_index_add(bm_get_entry(n + i));
+	}
+
 	if (nframes != nullptr)
 		*nframes = anim_frames;
 
@@ -1935,31 +2022,63 @@ int bm_load_either(const char *filename, int *nframes, int *fps, int *keyframe,
 	return tidx;
 }
 
+static bm_name_key bm_make_name_key(const char* filename, int dir_type, bool animated) {
+	bm_name_key key;
+
+	auto ext = strrchr(filename, '.');
+	key.name.assign(filename, ext != nullptr ? static_cast<size_t>(ext - filename) : strlen(filename));
+	SCP_tolower(key.name);
+
+	key.dir_type = dir_type;
+	key.animated = animated;
+
+	return key;
+}
+
+void bm_index_add(bitmap_entry* entry) {
+	auto& handles = Bm_name_index[bm_make_name_key(entry->filename, entry->dir_type, bm_is_anim(entry))];
+
+	auto it = std::lower_bound(handles.begin(), handles.end(), entry->handle);
+	if (it == handles.end() || *it != entry->handle)
+		handles.insert(it, entry->handle);
+}
+
+void bm_index_remove(bitmap_entry* entry) {
+	auto bucket = Bm_name_index.find(bm_make_name_key(entry->filename, entry->dir_type, bm_is_anim(entry)));
+	if (bucket == Bm_name_index.end())
+		return;
+
+	auto& handles = bucket->second;
+	auto it = std::lower_bound(handles.begin(), handles.end(), entry->handle);
+	if (it != handles.end() && *it == entry->handle)
+		handles.erase(it);
+
+	if (handles.empty())
+		Bm_name_index.erase(bucket);
+}
+
 int bm_load_sub_fast(const char *real_filename, int *handle, int dir_type, bool animated_type) {
 	if (Bm_ignore_duplicates)
 		return 0;
 
-	for (auto& block : bm_blocks) {
-		for (auto& slot : block) {
-			auto& entry = slot.entry;
-			if (entry.type == BM_TYPE_NONE)
-				continue;
+	auto bucket = Bm_name_index.find(bm_make_name_key(real_filename, dir_type, animated_type));
+	if (bucket == Bm_name_index.end())
+		return 0;
 
-			if (entry.dir_type != dir_type)
-				continue;
+	for (auto candidate : bucket->second) {
+		auto& entry = *bm_get_entry(candidate);
 
-			bool animated = bm_is_anim(&entry);
+		// the index is only a shortcut, the slot itself has the final say
+		if (entry.type == BM_TYPE_NONE || entry.handle != candidate || entry.dir_type != dir_type)
+			continue;
 
-			if (animated_type && !animated)
-				continue;
-			else if (!animated_type && animated)
-				continue;
+		if (bm_is_anim(&entry) != animated_type)
+			continue;
 
-			if (!strextcmp(real_filename, entry.filename)) {
-				entry.load_count++;
-				*handle = entry.handle;
-				return 1;
-			}
+		if (!strextcmp(real_filename, entry.filename)) {
+			entry.load_count++;
+			*handle = entry.handle;
+			return 1;
 		}
 	}
 
@@ -2261,6 +2380,75 @@ void bm_lock_apng(int /*handle*/, bitmap_slot *bs, bitmap *bmp, int bpp, uint /*
 }
 
 
+/**
+ * Reads the pixel data of a DDS file into data, which has to be zeroed and big enough for the whole image
+ */
+static int bm_read_dds_pixels(const char* filename, int dir_type, BM_TYPE comp_type, ubyte* data, size_t size, ubyte* dds_bpp) {
+	int error = dds_read_bitmap(filename, data, dds_bpp, dir_type);
+
+#if BYTE_ORDER == BIG_ENDIAN
+	// same as with TGA, we need to byte swap 16 & 32-bit, uncompressed, DDS images
+	if ((comp_type == BM_TYPE_DDS) || (comp_type == BM_TYPE_CUBEMAP_DDS)) {
+		size_t i = 0;
+
+		if (*dds_bpp == 32) {
+			unsigned int *swap_tmp;
+
+			for (i = 0; i < size; i += 4) {
+				swap_tmp = (unsigned int *)(data + i);
+				*swap_tmp = INTEL_INT(*swap_tmp);
+			}
+		} else if (*dds_bpp == 16) {
+			unsigned short *swap_tmp;
+
+			for (i = 0; i < size; i += 2) {
+				swap_tmp = (unsigned short *)(data + i);
+				*swap_tmp = INTEL_SHORT(*swap_tmp);
+			}
+		}
+	}
+#else
+	SCP_UNUSED(comp_type);
+	SCP_UNUSED(size);
+#endif
+
+	return error;
+}
+
+/**
+ * Reports a failure to read the pixels of a DDS file.  dds_read_bitmap() can't do this itself since it also runs on
+ * the paging workers, so this is called on the main thread.
+ */
+static void bm_report_dds_error(const char* filename, int error) {
+	if (error == DDS_ERROR_INVALID_FORMAT) {
+		Error(LOCATION, "Invalid FourCC for DDS decompression in '%s'!", filename);
+	} else {
+		mprintf(("DDS ERROR: Couldn't read '%s' -- %s\n", filename, dds_error_string(error)));
+	}
+}
+
+/**
+ * Hands over the pixel data a worker decoded for this bitmap while paging, if there is any.  The data counts as if it
+ * had been allocated by bm_malloc().
+ */
+static bool bm_take_staged_image(int handle, bm_staged_image& image) {
+	auto it = Bm_staged_images.find(handle);
+	if (it == Bm_staged_images.end())
+		return false;
+
+	image = it->second;
+	Bm_staged_images.erase(it);
+
+#ifdef BMPMAN_NDEBUG
+	auto entry = bm_get_entry(handle);
+	Assert(entry->data_size == 0);
+	entry->data_size += image.size;
+	bm_texture_ram += image.size;
+#endif
+
+	return true;
+}
+
 void bm_lock_dds(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, uint /*flags*/) {
 	ubyte *data = NULL;
 	int error;
@@ -2275,41 +2463,31 @@ void bm_lock_dds(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, uint /*f
 	Assert(be->mem_taken > 0);
 	Assert(&be->bm == bmp);
 
-	data = (ubyte*)bm_malloc(handle, be->mem_taken);
+	bm_staged_image staged;
 
-	if (data == NULL)
-		return;
-
-	memset(data, 0, be->mem_taken);
-
-	// make sure we are using the correct filename in the case of an EFF.
-	// this will populate filename[] whether it's EFF or not
-	EFF_FILENAME_CHECK;
+	if (bm_take_staged_image(handle, staged)) {
+		// a worker failure was already reported when the worker was done
+		data = staged.data;
+		dds_bpp = (ubyte)staged.bpp;
+		error = staged.error;
+	} else {
+		data = (ubyte*)bm_malloc(handle, be->mem_taken);
 
-	error = dds_read_bitmap(filename, data, &dds_bpp, be->dir_type);
+		if (data == NULL)
+			return;
 
-#if BYTE_ORDER == BIG_ENDIAN
-	// same as with TGA, we need to byte swap 16 & 32-bit, uncompressed, DDS images
-	if ((be->comp_type == BM_TYPE_DDS) || (be->comp_type == BM_TYPE_CUBEMAP_DDS)) {
-		size_t i = 0;
+		memset(data, 0, be->mem_taken);
 
-		if (dds_bpp == 32) {
-			unsigned int *swap_tmp;
+		// make sure we are using the correct filename in the case of an EFF.
+		// this will populate filename[] whether it's EFF or not
+		EFF_FILENAME_CHECK;
 
-			for (i = 0; i < be->mem_taken; i += 4) {
-				swap_tmp = (unsigned int *)(data + i);
-				*swap_tmp = INTEL_INT(*swap_tmp);
-			}
-		} else if (dds_bpp == 16) {
-			unsigned short *swap_tmp;
+		error = bm_read_dds_pixels(filename, be->dir_type, be->comp_type, data, be->mem_taken, &dds_bpp);
 
-			for (i = 0; i < be->mem_taken; i += 2) {
-				swap_tmp = (unsigned short *)(data + i);
-				*swap_tmp = INTEL_SHORT(*swap_tmp);
-			}
+		if (error != DDS_ERROR_NONE) {
+			bm_report_dds_error(filename, error);
 		}
 	}
-#endif
 
 	bmp->bpp = dds_bpp;
 	bmp->data = (ptr_u)data;
@@ -2432,25 +2610,35 @@ void bm_lock_png(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, uint /*f
 	// allocate bitmap data
 	Assert(bmp->w * bmp->h > 0);
 
-	//if it's not 32-bit, we expand when we read it
-	bmp->bpp = 32;
-	d_size = bmp->bpp >> 3;
-	//we waste memory if it turns out to be 24-bit, but the way this whole thing works is dodgy anyway
-	data = (ubyte*)bm_malloc(handle, bmp->w * bmp->h * d_size);
-	if (data == NULL)
-		return;
-	memset(data, 0, bmp->w * bmp->h * d_size);
-	bmp->data = (ptr_u)data;
-	bmp->palette = NULL;
-
 	Assert(&be->bm == bmp);
 
-	// make sure we are using the correct filename in the case of an EFF.
-	// this will populate filename[] whether it's EFF or not
-	EFF_FILENAME_CHECK;
+	bm_staged_image staged;
+
+	if (bm_take_staged_image(handle, staged)) {
+		bmp->bpp = staged.bpp;
+		bmp->data = (ptr_u)staged.data;
+		bmp->palette = NULL;
+
+		png_error = PNG_ERROR_NONE;
+	} else {
+		//if it's not 32-bit, we expand when we read it
+		bmp->bpp = 32;
+		d_size = bmp->bpp >> 3;
+		//we waste memory if it turns out to be 24-bit, but the way this whole thing works is dodgy anyway
+		data = (ubyte*)bm_malloc(handle, bmp->w * bmp->h * d_size);
+		if (data == NULL)
+			return;
+		memset(data, 0, bmp->w * bmp->h * d_size);
+		bmp->data = (ptr_u)data;
+		bmp->palette = NULL;
 
-	//bmp->bpp gets set correctly in here after reading into memory
-	png_error = png_read_bitmap(filename, data, &bmp->bpp, d_size, be->dir_type);
+		// make sure we are using the correct filename in the case of an EFF.
+		// this will populate filename[] whether it's EFF or not
+		EFF_FILENAME_CHECK;
+
+		//bmp->bpp gets set correctly in here after reading into memory
+		png_error = png_read_bitmap(filename, data, &bmp->bpp, d_size, be->dir_type);
+	}
 
 	if (png_error != PNG_ERROR_NONE) {
 		bm_free_data(bs);
@@ -2486,12 +2674,19 @@ void bm_lock_tga(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, uint flags)
 	Assert(byte_size);
 	Assert(be->mem_taken > 0);
 
-	data = (ubyte*)bm_malloc(handle, static_cast<size_t>(bmp->w * bmp->h * byte_size));
+	bm_staged_image staged;
+	const bool was_staged = bm_take_staged_image(handle, staged);
 
-	if (data) {
-		memset(data, 0, be->mem_taken);
+	if (was_staged) {
+		data = staged.data;
 	} else {
-		return;
+		data = (ubyte*)bm_malloc(handle, static_cast<size_t>(bmp->w * bmp->h * byte_size));
+
+		if (data) {
+			memset(data, 0, be->mem_taken);
+		} else {
+			return;
+		}
 	}
 
 	bmp->bpp = bpp;
@@ -2503,13 +2698,15 @@ void bm_lock_tga(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, uint flags)
 	Assert(be->data_size > 0);
 #endif
 
-	int tga_error;
+	int tga_error = TARGA_ERROR_NONE;
 
-	// make sure we are using the correct filename in the case of an EFF.
-	// this will populate filename[] whether it's EFF or not
-	EFF_FILENAME_CHECK;
+	if (!was_staged) {
+		// make sure we are using the correct filename in the case of an EFF.
+		// this will populate filename[] whether it's EFF or not
+		EFF_FILENAME_CHECK;
 
-	tga_error = targa_read_bitmap(filename, data, nullptr, byte_size, be->dir_type);
+		tga_error = targa_read_bitmap(filename, data, nullptr, byte_size, be->dir_type);
+	}
 
 	if (tga_error != TARGA_ERROR_NONE) {
 		bm_free_data(bs);
@@ -2622,6 +2819,8 @@ int bm_make_render_target(int width, int height, int flags) {
 
 	entry->handle = n;
 
+	bm_index_add(entry);
+
 	if (entry->mem_taken) {
 		entry->bm.data = (ptr_u)bm_malloc(n, entry->mem_taken);
 	}
@@ -2662,6 +2861,7 @@ void bm_page_in_aabitmap(int handle, int nframes) {
 
 void bm_page_in_start() {
 	Bm_paging = 1;
+	Bm_page_in_start_time = std::chrono::steady_clock::now();
 
 	// Mark all as inited
 	for (auto& block : bm_blocks) {
@@ -2680,6 +2880,103 @@ void bm_page_in_start() {
 	gr_bm_page_in_start();
 }
 
+/**
+ * Sets up a worker job for a bitmap if it is of a type whose decoder can run on any thread
+ */
+static bool bm_make_decode_job(int handle, bm_decode_job& job) {
+	auto be = bm_get_entry(handle);
+
+	if (be->bm.data != 0)
+		return false;
+
+	const bool is_eff = (be->type == BM_TYPE_EFF);
+
+	job.handle = handle;
+	job.type = is_eff ? be->info.ani.eff.type : be->type;
+	job.comp_type = be->comp_type;
+	job.dir_type = be->dir_type;
+	job.bpp = be->bm.true_bpp;
+	strcpy_s(job.filename, is_eff ? be->info.ani.eff.filename : be->filename);
+
+	// the JPEG and PCX readers (and 8/16 bit targas) use global state, so those are left to the main thread
+	switch (job.type) {
+	case BM_TYPE_DDS:
+	case BM_TYPE_DXT1:
+	case BM_TYPE_DXT3:
+	case BM_TYPE_DXT5:
+	case BM_TYPE_BC7:
+	case BM_TYPE_CUBEMAP_DDS:
+	case BM_TYPE_CUBEMAP_DXT1:
+	case BM_TYPE_CUBEMAP_DXT3:
+	case BM_TYPE_CUBEMAP_DXT5:
+		job.size = be->mem_taken;
+		break;
+
+	case BM_TYPE_PNG:
+		if (be->info.ani.apng.is_apng)
+			return false;
+		job.size = static_cast<size_t>(be->bm.w * be->bm.h * 4);
+		break;
+
+	case BM_TYPE_TGA:
+		if ((job.bpp != 24) && (job.bpp != 32))
+			return false;
+		job.size = static_cast<size_t>(be->bm.w * be->bm.h * (job.bpp >> 3));
+		break;
+
+	default:
+		return false;
+	}
+
+	return job.size > 0;
+}
+
+/**
+ * Decodes a bitmap into a new staging buffer the same way the bm_lock_*() function of its type would.  Runs on a
+ * worker thread.
+ */
+static void bm_decode_job_run(bm_decode_job& job) {
+	auto data = (ubyte*)vm_malloc(job.size);
+
+	if (data == nullptr)
+		return;
+
+	memset(data, 0, job.size);
+
+	int bpp = 0;
+	bool ok = false;
+
+	switch (job.type) {
+	case BM_TYPE_PNG:
+		bpp = 32;
+		ok = png_read_bitmap(job.filename, data, &bpp, 4, job.dir_type) == PNG_ERROR_NONE;
+		break;
+
+	case BM_TYPE_TGA:
+		bpp = job.bpp;
+		ok = targa_read_bitmap(job.filename, data, nullptr, bpp >> 3, job.dir_type) == TARGA_ERROR_NONE;
+		break;
+
+	default: {
+		ubyte dds_bpp = 0;
+		job.image.error = bm_read_dds_pixels(job.filename, job.dir_type, job.comp_type, data, job.size, &dds_bpp);
+		ok = job.image.error == DDS_ERROR_NONE;
+		bpp = dds_bpp;
+		break;
+	}
+	}
+
+	if (!ok) {
+		// DDS errors are reported on the main thread once the batch is done, bm_lock_*() tries the others again
+		vm_free(data);
+		return;
+	}
+
+	job.image.data = data;
+	job.image.size = job.size;
+	job.image.bpp = bpp;
+}
+
 void bm_page_in_stop() {
 	TRACE_SCOPE(tracing::PageInStop);
 
@@ -2689,10 +2986,10 @@ void bm_page_in_stop() {
 
 	nprintf(("BmpInfo", "BMPMAN: Loading all used bitmaps.\n"));
 
-	// Load all the ones that are supposed to be loaded for this level.
-	int n = 0;
+	auto start_time = std::chrono::steady_clock::now();
 
-	int bm_preloading = 1;
+	// Find all the ones that are supposed to be loaded for this level.
+	SCP_vector<int> to_load;
 
 	for (auto& block : bm_blocks) {
 		for (auto& slot : block) {
@@ -2701,42 +2998,146 @@ void bm_page_in_stop() {
 			if ((entry.type != BM_TYPE_NONE) && (entry.type != BM_TYPE_RENDER_TARGET_DYNAMIC)
 				&& (entry.type != BM_TYPE_RENDER_TARGET_STATIC)) {
 				if (entry.preloaded) {
-					TRACE_SCOPE(tracing::PageInSingleBitmap);
-					if (bm_preloading) {
-						if (!gr_preload(entry.handle, (entry.preloaded == 2))) {
-							mprintf(("Out of VRAM.  Done preloading.\n"));
-							bm_preloading = 0;
-						}
-					} else {
-						bm_lock(entry.handle, (entry.used_flags == BMP_AABITMAP) ? 8 : 16, entry.used_flags);
-						if (entry.ref_count >= 1) {
-							bm_unlock(entry.handle);
-						}
-					}
+					to_load.push_back(entry.handle);
+				} else {
+					bm_unload_fast(entry.handle);
+				}
+			}
+		}
+	}
+
+	// The pixel data of one batch of bitmaps is decoded on the workers while the previous batch is uploaded here.
+	// Uploads happen in the same order as before, the workers just get there first.
+	const bool decode_async = (threading::get_num_workers() > 0) && !Is_standalone;
+
+	threading::task_group decoding[2];
+	SCP_vector<bm_decode_job> batches[2];
+	size_t batch_end[2] = { 0, 0 };
+	size_t decode_end = 0;
+	int num_decoded = 0;
 
-					n++;
+	auto start_batch = [&](int batch) {
+		auto& jobs = batches[batch];
+		jobs.clear();
 
-					multi_send_anti_timeout_ping();
+		size_t bytes = 0;
+		while ((decode_end < to_load.size()) && (jobs.size() < BM_PAGE_IN_BATCH_SIZE) && (bytes < BM_PAGE_IN_BATCH_BYTES)) {
+			bm_decode_job job;
+			if (bm_make_decode_job(to_load[decode_end], job)) {
+				bytes += job.size;
+				jobs.push_back(job);
+			}
+			++decode_end;
+		}
+		batch_end[batch] = decode_end;
+
+		for (auto& job : jobs) {
+			decoding[batch].run([&job]() { bm_decode_job_run(job); });
+		}
+	};
+
+	// Load all the ones that are supposed to be loaded for this level.
+	int n = 0;
+
+	int bm_preloading = 1;
 
-					if ((entry.info.ani.first_frame == 0) || (entry.info.ani.first_frame == entry.handle)) {
+	int current = 0;
+	size_t upload_begin = 0;
+
+	if (decode_async) {
+		start_batch(current);
+	}
+
+	while (upload_begin < to_load.size()) {
+		size_t upload_end = to_load.size();
+
+		if (decode_async) {
+			decoding[current].wait();
+
+			for (auto& job : batches[current]) {
+				if ((job.image.data == nullptr) && (job.image.error == DDS_ERROR_NONE)) {
+					continue;
+				}
+
+				// this one may have been loaded along with an earlier frame of its animation
+				if (bm_get_entry(job.handle)->bm.data != 0) {
+					vm_free(job.image.data);
+					continue;
+				}
+
+				// staging the failure keeps bm_lock_dds() from reading the file again
+				if (job.image.error != DDS_ERROR_NONE) {
+					bm_report_dds_error(job.filename, job.image.error);
+				} else {
+					++num_decoded;
+				}
+
+				Bm_staged_images[job.handle] = job.image;
+			}
+
+			upload_end = batch_end[current];
+
+			if (decode_end < to_load.size()) {
+				start_batch(current ^ 1);
+			}
+		}
+
+		for (size_t i = upload_begin; i < upload_end; ++i) {
+			auto& entry = *bm_get_entry(to_load[i]);
+
+			if (entry.type == BM_TYPE_NONE) {
+				continue;
+			}
+
+			TRACE_SCOPE(tracing::PageInSingleBitmap);
+			if (bm_preloading) {
+				if (!gr_preload(entry.handle, (entry.preloaded == 2))) {
+					mprintf(("Out of VRAM.  Done preloading.\n"));
+					bm_preloading = 0;
+				}
+			} else {
+				bm_lock(entry.handle, (entry.used_flags == BMP_AABITMAP) ? 8 : 16, entry.used_flags);
+				if (entry.ref_count >= 1) {
+					bm_unlock(entry.handle);
+				}
+			}
+
+			n++;
+
+			multi_send_anti_timeout_ping();
+
+			if ((entry.info.ani.first_frame == 0) || (entry.info.ani.first_frame == entry.handle)) {
 #ifndef NDEBUG
-						memset(busy_text, 0, sizeof(busy_text));
+				memset(busy_text, 0, sizeof(busy_text));
 
-						strcat_s(busy_text, "** BmpMan: ");
-						strcat_s(busy_text, entry.filename);
-						strcat_s(busy_text, " **");
+				strcat_s(busy_text, "** BmpMan: ");
+				strcat_s(busy_text, entry.filename);
+				strcat_s(busy_text, " **");
 
-						game_busy(busy_text);
+				game_busy(busy_text);
 #else
-						game_busy();
+				game_busy();
 #endif
-					}
-				} else {
-					bm_unload_fast(entry.handle);
-				}
 			}
 		}
+
+		upload_begin = upload_end;
+		current ^= 1;
+	}
+
+	// anything that was decoded but never asked for
+	for (auto& staged : Bm_staged_images) {
+		vm_free(staged.second.data);
 	}
+	Bm_staged_images.clear();
+
+	auto end_time = std::chrono::steady_clock::now();
+	auto page_in_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+	mprintf(("BMPMAN: Paged in %d bitmaps in %.1f ms (%.0f bitmaps/s), %d decoded on %d worker threads\n", n, page_in_ms,
+		(page_in_ms > 0.0) ? n / (page_in_ms / 1000.0) : 0.0, num_decoded, decode_async ? static_cast<int>(threading::get_num_workers()) : 0));
+	mprintf(("BMPMAN: Level load took %.1f ms since bm_page_in_start()\n",
+		std::chrono::duration<double, std::milli>(end_time - Bm_page_in_start_time).count()));
 
 	nprintf(("BmpInfo", "BMPMAN: Loaded %d bitmaps that are marked as used for this level.\n", n));
 
@@ -2970,6 +3371,8 @@ int bm_release(int handle, int clear_render_targets) {
 		for (i = 0; i < total; i++) {
 			auto entry = bm_get_entry(first + i);
 
+			bm_index_remove(entry);
+
 			memset(entry, 0, sizeof(bitmap_entry));
 
 			entry->type = BM_TYPE_NONE;
@@ -2995,6 +3398,7 @@ int bm_release(int handle, int clear_render_targets) {
 
 		bm_free_data(slot, true);		// clears flags, bbp, data, etc
 
+		bm_index_remove(entry);
 
 		memset(entry, 0, sizeof(bitmap_entry));
 
@@ -3058,7 +3462,10 @@ int bm_reload(int bitmap_handle, const char* filename) {
 		return -1;
 	}
 
+	bm_index_remove(entry);
 	strcpy_s(entry->filename, filename);
+	bm_index_add(entry);
+
 	return bitmap_handle;
 }
 
@@ -14,6 +14,7 @@
 #include <cstring>
 #include <cstdio>
 #include <cerrno>
+#include <ctime>
 #include <sys/stat.h>
 
 #ifdef _WIN32
@@ -28,13 +29,16 @@
 
 #include "cfile/cfile.h"
 #include "cfile/cfilearchive.h"
+#include "cfile/cfilecompression.h"
 #include "cfile/cfilesystem.h"
+#include "cmdline/cmdline.h"
 #include "osapi/osapi.h"
 #include "parse/encrypt.h"
 #include "cfilesystem.h"
 
 
 #include <limits>
+#include <mutex>
 
 char Cfile_root_dir[CFILE_ROOT_DIRECTORY_LEN] = "";
 char Cfile_user_dir[CFILE_ROOT_DIRECTORY_LEN] = "";
@@ -96,6 +100,9 @@ static SCP_vector<SCP_string> Cfile_stack;
 
 std::array<CFILE, MAX_CFILE_BLOCKS> Cfile_block_list;
 
+// Guards taking and giving back blocks of Cfile_block_list, since files may be opened on worker threads
+static std::mutex Cfile_block_mutex;
+
 static const char *Cfile_cdrom_dir = NULL;
 
 //
@@ -104,6 +111,7 @@ static const char *Cfile_cdrom_dir = NULL;
 static int cfget_cfile_block();
 static CFILE *cf_open_fill_cfblock(const char* source, int line, const char* original_filename, FILE * fp, int type);
 static CFILE *cf_open_packed_cfblock(const char* source, int line, const char* original_filename, FILE *fp, int type, size_t offset, size_t size);
+static CFILE *cf_open_mapped_cfblock(const char* source, int line, const char* original_filename, std::shared_ptr<cfile::file_mapping> mapping, int type, size_t offset, size_t size);
 static CFILE *cf_open_memory_fill_cfblock(const char* source, int line, const char* original_filename, const void* data, size_t size, int dir_type);
 
 static void cf_chksum_long_init();
@@ -467,6 +475,39 @@ int cf_delete(const char *filename, int path_type, uint32_t location_flags)
 	return (_unlink(longname.c_str()) != -1);
 }
 
+void cf_purge_old_cache_files(const char *prefix, const char *ext)
+{
+	const uint32_t location = CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT;
+
+	SCP_string filter("*.");
+	filter += ext;
+
+	SCP_vector<SCP_string> cache_files;
+	SCP_vector<file_list_info> file_info;
+	cf_get_file_list(cache_files, CF_TYPE_CACHE, filter.c_str(), CF_SORT_NONE, &file_info, location);
+
+	Assertion(cache_files.size() == file_info.size(),
+			  "cf_get_file_list returned different sizes for file names and file informations!");
+
+	const auto TIMEOUT = 2.0 * 30.0 * 24.0 * 60.0 * 60.0; // purge timeout in seconds which is ~2 months
+	const size_t prefix_len = strlen(prefix);
+
+	auto now = std::time(nullptr);
+	for (size_t i = 0; i < cache_files.size(); ++i) {
+		auto& name = cache_files[i];
+
+		if (name.compare(0, prefix_len, prefix) != 0) {
+			// Belongs to some other cache
+			continue;
+		}
+
+		if (std::difftime(now, file_info[i].write_time) > TIMEOUT) {
+			auto full_name = name + "." + ext;
+			cf_delete(full_name.c_str(), CF_TYPE_CACHE, location);
+		}
+	}
+}
+
 
 // Same as _access function to read a file's access bits
 int cf_access(const char *filename, int dir_type, int mode)
@@ -763,6 +804,24 @@ CFILE *_cfopen_special(const char* source, int line, const CFileLocation &res, c
 		return cf_open_memory_fill_cfblock(source, line, res.name_ext.c_str(), res.data_ptr, res.size, dir_type);
 	}
 	else {
+		if (res.offset && Cmdline_mmap_vps) {
+			// Read packed files straight out of the mapped pack file, unless they are compressed since decompression
+			// needs its own file handle
+			auto mapping = cf_get_pack_mapping(res.full_name);
+
+			if (mapping && (res.offset + res.size <= mapping->size())) {
+				int header = 0;
+
+				if (res.size > 16) {
+					memcpy(&header, mapping->data() + res.offset, sizeof(header));
+				}
+
+				if (comp_check_header(header) != COMP_HEADER_MATCH) {
+					return cf_open_mapped_cfblock(source, line, res.name_ext.c_str(), std::move(mapping), dir_type, res.offset, res.size);
+				}
+			}
+		}
+
 		// "file_path" should already be a fully qualified path, so just try to open it
 		FILE *fp = fopen(res.full_name.c_str(), "rb");
 
@@ -814,6 +873,8 @@ static int cfget_cfile_block()
 	int i;
 	CFILE* cfile;
 
+	std::unique_lock<std::mutex> lock(Cfile_block_mutex);
+
 	for ( i = 0; i < MAX_CFILE_BLOCKS; i++ ) {
 		cfile = &Cfile_block_list[i];
 		if (cfile->type == CFILE_BLOCK_UNUSED) {
@@ -825,6 +886,8 @@ static int cfget_cfile_block()
 		}
 	}
 
+	lock.unlock();
+
 	// If we've reached this point, a free Cfile_block could not be found
 	nprintf(("Warning","A free Cfile_block could not be found.\n"));
 
@@ -857,6 +920,9 @@ int cfclose( CFILE * cfile )
 		// VP  do nothing
 	}
 	cf_clear_compression_info(cfile);
+	cfile->mapping.reset();
+
+	std::scoped_lock lock {Cfile_block_mutex};
 	cfile->type = CFILE_BLOCK_UNUSED;
 	return result;
 }
@@ -973,6 +1039,23 @@ static CFILE *cf_open_memory_fill_cfblock(const char* source, int line, const ch
 	}
 }
 
+// cf_open_mapped_cfblock() will fill up a Cfile_block element in the Cfile_block_list[] array
+// for the case of a packed file being read out of its memory-mapped pack file
+//
+// returns:   success ==> ptr to CFILE structure.
+//            error   ==> NULL
+//
+static CFILE *cf_open_mapped_cfblock(const char* source, int line, const char* original_filename, std::shared_ptr<cfile::file_mapping> mapping, int type, size_t offset, size_t size)
+{
+	auto cfp = cf_open_memory_fill_cfblock(source, line, original_filename, mapping->data() + offset, size, type);
+
+	if (cfp != nullptr) {
+		cfp->mapping = std::move(mapping);
+	}
+
+	return cfp;
+}
+
 const char *cf_get_filename(const CFILE *cfile)
 {
 	return cfile->original_filename.c_str();
@@ -995,6 +1078,20 @@ const void *cf_returndata(CFILE *cfile)
 	return cfile->data;
 }
 
+CFileView cf_get_view(CFILE *cfile)
+{
+	Assert(cfile != nullptr);
+
+	CFileView view;
+
+	if (cfile->data != nullptr) {
+		view.data = reinterpret_cast<const ubyte*>(cfile->data);
+		view.size = cfile->size;
+	}
+
+	return view;
+}
+
 // cutoff point where cfread() will throw an error when it hits this limit
 // if 'len' is 0 then this check will be disabled
 void cf_set_max_read_len( CFILE * cfile, size_t len )
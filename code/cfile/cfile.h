@@ -200,6 +200,10 @@ void cf_set_max_read_len(CFILE *cfile, size_t len);
 // Deletes a file. Returns 0 on error, 1 if successful
 int cf_delete(const char *filename, int dir_type, uint32_t location_flags = CF_LOCATION_ALL);
 
+// Deletes the files in the cache directory whose names start with prefix, have the extension ext and that haven't been
+// written for about two months.  Those most likely belong to data that has changed since.
+void cf_purge_old_cache_files(const char *prefix, const char *ext);
+
 // Same as _access function to read a file's access bits
 int cf_access(const char *filename, int dir_type, int mode);
 
@@ -256,6 +260,17 @@ int cfeof(CFILE *cfile);
 // Return the data pointer associated with the CFILE structure (for memory mapped files)
 const void *cf_returndata(CFILE *cfile);
 
+// A read-only view of the whole contents of a file
+struct CFileView {
+	const ubyte* data = nullptr;
+	size_t size = 0;
+};
+
+// Returns a view of the file if its contents are in memory, i.e. for in-memory files and for packed files while VPs
+// are memory-mapped (-mmap_vps).  Returns an empty view (data == nullptr) for everything else, in which case the
+// file has to be read with cfread() as usual.  The view stays valid until the file is closed.
+CFileView cf_get_view(CFILE *cfile);
+
 // get the 2 byte checksum of the passed filename - return 0 if operation failed, 1 if succeeded
 int cf_chksum_short(const char *filename, ushort *chksum, int max_size = -1, int cf_type = CF_TYPE_ANY );
 
@@ -411,7 +426,6 @@ struct CFileLocationExt : public CFileLocation {
 //         size        - File size
 //         offset      - Offset into pack file.  0 if not a packfile.
 // Returns: If not found returns -1, else returns offset into ext_list.
-// (NOTE: This function is exponentially slow, so don't use it unless truely needed!!)
 CFileLocationExt cf_find_file_location_ext(const char* filename, const int ext_num, const char** ext_list, int pathtype);
 
 // Functions to change directories
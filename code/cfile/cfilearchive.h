@@ -15,6 +15,7 @@
 #endif
 
 #include "globalincs/pstypes.h"
+#include "cfile/cfilemapping.h"
 
 // The following Cfile_block data is private to cfile.cpp
 // DO NOT MOVE the Cfile_block* information to cfile.h / do not extern this data
@@ -38,6 +39,7 @@ struct CFILE {
 	int dir_type;        // directory location
 	FILE* fp;                // File pointer if opening an individual file
 	const void* data;            // Pointer for memory-mapped file access.  NULL if not mem-mapped.
+	std::shared_ptr<cfile::file_mapping> mapping;	// The pack file mapping data points into, if any
 	size_t lib_offset;
 	size_t raw_position;
 	size_t size;                // for packed files
@@ -0,0 +1,102 @@
+
+#include "cfile/cfilemapping.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cfile {
+
+#ifdef _WIN32
+
+std::shared_ptr<file_mapping> file_mapping::map(const char* path)
+{
+	std::shared_ptr<file_mapping> mapping(new file_mapping());
+
+	auto file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+	mapping->_file = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 ||
+		static_cast<ULONGLONG>(size.QuadPart) > static_cast<ULONGLONG>(SIZE_MAX)) {
+		return nullptr;
+	}
+
+	mapping->_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping->_mapping == nullptr) {
+		return nullptr;
+	}
+
+	mapping->_data = static_cast<const ubyte*>(MapViewOfFile(mapping->_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (mapping->_data == nullptr) {
+		return nullptr;
+	}
+	mapping->_size = static_cast<size_t>(size.QuadPart);
+
+	return mapping;
+}
+
+file_mapping::~file_mapping()
+{
+	if (_data != nullptr) {
+		UnmapViewOfFile(_data);
+	}
+	if (_mapping != nullptr) {
+		CloseHandle(_mapping);
+	}
+	if (_file != nullptr) {
+		CloseHandle(_file);
+	}
+}
+
+#else
+
+std::shared_ptr<file_mapping> file_mapping::map(const char* path)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return nullptr;
+	}
+
+	struct stat buf;
+	if (fstat(fd, &buf) != 0 || buf.st_size <= 0 ||
+		static_cast<unsigned long long>(buf.st_size) > static_cast<unsigned long long>(SIZE_MAX)) {
+		close(fd);
+		return nullptr;
+	}
+
+	const auto size = static_cast<size_t>(buf.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+	// the mapping keeps its own reference to the file
+	close(fd);
+
+	if (data == MAP_FAILED) {
+		return nullptr;
+	}
+
+	std::shared_ptr<file_mapping> mapping(new file_mapping());
+	mapping->_data = static_cast<const ubyte*>(data);
+	mapping->_size = size;
+
+	return mapping;
+}
+
+file_mapping::~file_mapping()
+{
+	if (_data != nullptr) {
+		munmap(const_cast<ubyte*>(_data), _size);
+	}
+}
+
+#endif
+
+}
@@ -0,0 +1,44 @@
+#ifndef _CFILEMAPPING_H
+#define _CFILEMAPPING_H
+
+#include "globalincs/pstypes.h"
+
+#include <memory>
+
+namespace cfile {
+
+/**
+ * @brief A read-only mapping of a whole file into memory
+ *
+ * Used for pack files so that the CFILEs of packed files can read straight out of the mapping instead of going
+ * through their own FILE handle.  Open CFILEs keep a reference to the mapping, so it stays valid until the last
+ * of them is closed even if the file list is rebuilt in the meantime.
+ */
+class file_mapping {
+  public:
+	~file_mapping();
+
+	file_mapping(const file_mapping&) = delete;
+	file_mapping& operator=(const file_mapping&) = delete;
+
+	// Maps the file at path. Returns nullptr if the file can't be opened or mapped.
+	static std::shared_ptr<file_mapping> map(const char* path);
+
+	const ubyte* data() const { return _data; }
+	size_t size() const { return _size; }
+
+  private:
+	file_mapping() = default;
+
+	const ubyte* _data = nullptr;
+	size_t _size = 0;
+
+#ifdef _WIN32
+	void* _file = nullptr;
+	void* _mapping = nullptr;
+#endif
+};
+
+}
+
+#endif // _CFILEMAPPING_H
@@ -15,6 +15,8 @@
 #include <cerrno>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <mutex>
 
 #ifdef _WIN32
 #include <io.h>
@@ -41,6 +43,7 @@
 #include "def_files/def_files.h"
 #include "osapi/osapi.h"
 #include "parse/parselo.h"
+#include "utils/threading.h"
 
 enum CfileRootType {
 	CF_ROOTTYPE_PATH = 0,
@@ -58,12 +61,16 @@ typedef struct cf_root {
 	int		roottype;						// CF_ROOTTYPE_PATH  = Path, CF_ROOTTYPE_PACK =Pack file, CF_ROOTTYPE_MEMORY=In memory
 	uint32_t location_flags;
 
+	// for pack files, the mapping of the whole file once something has been read from it while VPs are memory-mapped
+	std::shared_ptr<cfile::file_mapping> mapping;
+	bool mapping_failed;
+
 #ifdef SCP_UNIX
 	// map of existing case sensitive paths
 	SCP_unordered_map<int, SCP_string> pathTypeToRealPath;
 #endif
 
-	cf_root() : roottype(-1), location_flags(0) {}
+	cf_root() : roottype(-1), location_flags(0), mapping_failed(false) {}
 } cf_root;
 
 // convenient type for sorting (see cf_build_pack_list())
@@ -88,6 +95,9 @@ static SCP_vector<std::unique_ptr<cf_root_block>> Root_blocks;
 
 static int Num_path_roots = 0;
 
+// cfopen() may be called from worker threads, so pack files are mapped under a lock
+static std::mutex Pack_mapping_mutex;
+
 // Created by searching all roots in order.   This means Files is then sorted by precedence.
 typedef struct cf_file {
 	SCP_string	name_ext;	// Filename and extension
@@ -116,6 +126,12 @@ typedef struct cf_file_block {
 static uint Num_files = 0;
 static SCP_vector<std::unique_ptr<cf_file_block>> File_blocks;
 
+// Case-insensitive index of all files by name and extension, built by cf_build_file_list().  Every entry
+// lists the indices of the files with that name in ascending order, i.e. in order of root priority, so
+// the first one that passes the pathtype, location and sub path checks is the one a scan over all files
+// would have found.
+static SCP_unordered_map<SCP_string, SCP_vector<uint>, SCP_string_lcase_hash, SCP_string_lcase_equal_to> File_name_index;
+
 // Return a pointer to to file 'index'.
 cf_file *cf_get_file(int index)
 {
@@ -842,15 +858,17 @@ static void check_file_shadows(const int root_index __UNUSED, const int pathtype
 }
 
 
-void cf_search_root_path(int root_index)
-{
-	int i;
-	int num_files = 0;
-
-	cf_root* root = cf_get_root(root_index);
-
-	mprintf(("Searching root '%s' ... ", root->path.c_str()));
+// The files found in a single root.  Roots are searched concurrently, so every search fills its own table which is
+// only added to the file list once all searches are done.
+struct cf_root_scan {
+	SCP_vector<cf_file> files;
+	SCP_string log;				// messages about the root, written to the log in root order
+	double time_ms = 0.0;
+};
 
+// Checks that a path root can be used, before it's searched on a worker thread
+static void cf_check_root_path(const cf_root *root __UNUSED)
+{
 #ifndef WIN32
 	try {
 		auto current           = root->path.begin();
@@ -873,6 +891,13 @@ void cf_search_root_path(int root_index)
 		Error(LOCATION, "UTF-8 error while checking the root path \"%s\": %s", root->path.c_str(), e.what());
 	}
 #endif
+}
+
+static void cf_search_root_path(int root_index, cf_root_scan &scan)
+{
+	int i;
+
+	cf_root* root = cf_get_root(root_index);
 
 	SCP_string search_path;
 
@@ -910,9 +935,8 @@ void cf_search_root_path(int root_index)
 				continue;
 			}
 
-			check_file_shadows(root_index, i, file.name, file.sub_path, orig_name.c_str());
-
-			cf_file *cfile = cf_create_file();
+			scan.files.emplace_back();
+			cf_file *cfile = &scan.files.back();
 
 			cfile->name_ext = file.name;
 			cfile->root_index = root_index;
@@ -922,12 +946,8 @@ void cf_search_root_path(int root_index)
 			cfile->pack_offset = 0;
 			cfile->real_name = search_path + DIR_SEPARATOR_STR + file.sub_path + orig_name;
 			cfile->sub_path = file.sub_path;
-
-			++num_files;
 		}
 	}
-
-	mprintf(( "%i files\n", num_files ));
 }
 
 
@@ -945,18 +965,17 @@ typedef struct VP_FILE {
 	_fs_time_t write_time;
 } VP_FILE;
 
-static int cf_add_pack_files(const int root_index, SCP_vector<_file_list_t> &files)
+static void cf_add_pack_files(const int root_index, SCP_vector<_file_list_t> &files, cf_root_scan &scan)
 {
 	if (files.empty()) {
-		return 0;
+		return;
 	}
 
 	std::sort(files.begin(), files.end(), sort_file_list);
 
 	for (auto &file : files) {
-		check_file_shadows(root_index, file.pathtype, file.name, file.sub_path);
-
-		cf_file *pf = cf_create_file();
+		scan.files.emplace_back();
+		cf_file *pf = &scan.files.back();
 
 		pf->name_ext = file.name;
 		pf->root_index = root_index;
@@ -966,13 +985,10 @@ static int cf_add_pack_files(const int root_index, SCP_vector<_file_list_t> &fil
 		pf->pack_offset = file.offset;			// Mark as a packed file
 		pf->sub_path = file.sub_path;
 	}
-
-	return static_cast<int>(files.size());
 }
 
-void cf_search_root_pack(int root_index)
+static void cf_search_root_pack(int root_index, cf_root_scan &scan)
 {
-	int num_files = 0;
 	cf_root *root = cf_get_root(root_index);
 
 	Assert( root != NULL );
@@ -984,8 +1000,10 @@ void cf_search_root_pack(int root_index)
 		return;
 	}
 
-	if ( filelength(fileno(fp)) < (int)(sizeof(VP_FILE_HEADER) + (sizeof(int) * 3)) ) {
-		mprintf(( "Skipping VP file ('%s') of invalid size...\n", root->path.c_str() ));
+	const auto pack_length = filelength(fileno(fp));
+
+	if ( pack_length < (int)(sizeof(VP_FILE_HEADER) + (sizeof(int) * 3)) ) {
+		scan.log += "Skipping VP file ('" + root->path + "') of invalid size...\n";
 		fclose(fp);
 		return;
 	}
@@ -994,7 +1012,7 @@ void cf_search_root_pack(int root_index)
 
 	Assert( sizeof(VP_header) == 16 );
 	if (fread(&VP_header, sizeof(VP_header), 1, fp) != 1) {
-		mprintf(("Skipping VP file ('%s') because the header could not be read...\n", root->path.c_str()));
+		scan.log += "Skipping VP file ('" + root->path + "') because the header could not be read...\n";
 		fclose(fp);
 		return;
 	}
@@ -1003,11 +1021,19 @@ void cf_search_root_pack(int root_index)
 	VP_header.index_offset = INTEL_INT( VP_header.index_offset ); //-V570
 	VP_header.num_files = INTEL_INT( VP_header.num_files ); //-V570
 
-	mprintf(( "Searching root pack '%s' ... ", root->path.c_str() ));
+	// Read the whole index in one go, as much of it as there is
+	SCP_vector<VP_FILE> index;
 
-	// Read index info
-	fseek(fp, VP_header.index_offset, SEEK_SET);
+	if ( (VP_header.num_files > 0) && (VP_header.index_offset >= 0) && (VP_header.index_offset < pack_length) ) {
+		const auto available = static_cast<size_t>(pack_length - VP_header.index_offset) / sizeof(VP_FILE);
 
+		index.resize(std::min(static_cast<size_t>(VP_header.num_files), available));
+
+		fseek(fp, VP_header.index_offset, SEEK_SET);
+		index.resize(fread(index.data(), sizeof(VP_FILE), index.size(), fp));
+	}
+
+	fclose(fp);
 
 	SCP_string search_path;
 	SCP_string sub_path;
@@ -1017,16 +1043,12 @@ void cf_search_root_pack(int root_index)
 
 	files.reserve(256);		// should be set to a good baseline of files per path
 
-	// Go through all the files
-	int i;
-	for (i=0; i<VP_header.num_files; i++ )	{
-		VP_FILE find;
-
-		if (fread( &find, sizeof(VP_FILE), 1, fp ) != 1) {
-			mprintf(("Failed to read file entry (currently in directory %s)!\n", search_path.c_str()));
-			break;
-		}
+	if (static_cast<int>(index.size()) < VP_header.num_files) {
+		scan.log += "Failed to read file entry " + std::to_string(index.size()) + " of '" + root->path + "'!\n";
+	}
 
+	// Go through all the files
+	for (auto &find : index) {
 		find.offset = INTEL_INT( find.offset ); //-V570
 		find.size = INTEL_INT( find.size ); //-V570
 		find.write_time = INTEL_INT( find.write_time ); //-V570
@@ -1053,7 +1075,7 @@ void cf_search_root_pack(int root_index)
 
 			// if the pathtype root changed then add all of the files
 			if (rval != path_type) {
-				num_files += cf_add_pack_files(root_index, files);
+				cf_add_pack_files(root_index, files, scan);
 				files.clear();
 			}
 
@@ -1066,8 +1088,6 @@ void cf_search_root_pack(int root_index)
 			} else {
 				sub_path.clear();
 			}
-
-			//mprintf(( "Current dir = '%s'\n", search_path.c_str() ));
 		} else {
 			if (path_type != CF_TYPE_INVALID) {
 				char *ext = strrchr( find.filename, '.' );
@@ -1084,8 +1104,6 @@ void cf_search_root_pack(int root_index)
 						file.offset = find.offset;
 
 						files.push_back(std::move(file));
-
-						//mprintf(( "Found pack file '%s'\n", find.filename ));
 					}
 				}
 			}
@@ -1093,18 +1111,11 @@ void cf_search_root_pack(int root_index)
 	}
 
 	// add final set of files
-	num_files += cf_add_pack_files(root_index, files);
-	files.clear();
-
-	fclose(fp);
-
-	mprintf(( "%i files\n", num_files ));
+	cf_add_pack_files(root_index, files, scan);
 }
 
-void cf_search_memory_root(int root_index) {
-	int num_files = 0;
-	mprintf(( "Searching memory root ... " ));
-
+static void cf_search_memory_root(int root_index, cf_root_scan &scan)
+{
 	auto default_files = defaults_get_all();
 	for (auto& default_file : default_files) {
 		// Pure built in files have an empty path_type string
@@ -1129,7 +1140,8 @@ void cf_search_memory_root(int root_index) {
 				  DIR_SEPARATOR_STR,
 				  default_file.filename);
 
-		cf_file *file = cf_create_file();
+		scan.files.emplace_back();
+		cf_file *file = &scan.files.back();
 
 		file->name_ext = default_file.filename;
 		file->root_index = root_index;
@@ -1137,11 +1149,83 @@ void cf_search_memory_root(int root_index) {
 		file->write_time = time(nullptr); // Just assume that memory files were last written to just now
 		file->size = (int)default_file.size;
 		file->data = default_file.data;
+	}
+}
+
+static void cf_search_root(int root_index, cf_root_scan &scan)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	cf_root *root = cf_get_root(root_index);
+
+	if ( root->roottype == CF_ROOTTYPE_PATH ) {
+		cf_search_root_path(root_index, scan);
+	} else if ( root->roottype == CF_ROOTTYPE_PACK ) {
+		cf_search_root_pack(root_index, scan);
+	} else if (root->roottype == CF_ROOTTYPE_MEMORY) {
+		cf_search_memory_root(root_index, scan);
+	}
+
+	scan.time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Adds the files found in a root to the file list.  This has to happen in root order, which is the order of precedence.
+static void cf_add_root_files(int root_index, cf_root_scan &scan)
+{
+	cf_root *root = cf_get_root(root_index);
+
+	if ( root->roottype == CF_ROOTTYPE_PATH ) {
+		mprintf(( "Searching root '%s' ... ", root->path.c_str() ));
+	} else if ( root->roottype == CF_ROOTTYPE_PACK ) {
+		mprintf(( "Searching root pack '%s' ... ", root->path.c_str() ));
+	} else if (root->roottype == CF_ROOTTYPE_MEMORY) {
+		mprintf(( "Searching memory root ... " ));
+	}
+
+	for (auto &file : scan.files) {
+		if (root->roottype != CF_ROOTTYPE_MEMORY) {
+			const char *real_name = nullptr;
+
+			if ( !file.real_name.empty() ) {
+				real_name = file.real_name.c_str() + file.real_name.rfind(DIR_SEPARATOR_CHAR) + 1;
+			}
+
+			check_file_shadows(root_index, file.pathtype_index, file.name_ext, file.sub_path, real_name);
+		}
+
+		*cf_create_file() = std::move(file);
+	}
+
+	mprintf(( "%i files (%.1f ms)\n", static_cast<int>(scan.files.size()), scan.time_ms ));
 
-		num_files++;
+	if ( !scan.log.empty() ) {
+		mprintf(( "%s", scan.log.c_str() ));
 	}
 
-	mprintf(( "%i files\n", num_files ));
+	scan.files.clear();
+	scan.files.shrink_to_fit();
+}
+
+static void cf_build_file_index()
+{
+	File_name_index.clear();
+	File_name_index.reserve(Num_files);
+
+	for (uint i = 0; i < Num_files; ++i) {
+		File_name_index[cf_get_file(i)->name_ext].push_back(i);
+	}
+}
+
+// Returns the indices of all files called name_ext (in order of priority), or nullptr if there are none.
+static const SCP_vector<uint> *cf_find_indexed_files(const SCP_string &name_ext)
+{
+	auto it = File_name_index.find(name_ext);
+
+	if (it == File_name_index.end()) {
+		return nullptr;
+	}
+
+	return &it->second;
 }
 
 void cf_build_file_list()
@@ -1149,19 +1233,34 @@ void cf_build_file_list()
 	int i;
 
 	Num_files = 0;
+	File_name_index.clear();
 
-	// For each root, find all files...
 	for (i=0; i<Num_roots; i++ )	{
 		cf_root	*root = cf_get_root(i);
 		if ( root->roottype == CF_ROOTTYPE_PATH )	{
-			cf_search_root_path(i);
-		} else if ( root->roottype == CF_ROOTTYPE_PACK )	{
-			cf_search_root_pack(i);
-		} else if (root->roottype == CF_ROOTTYPE_MEMORY) {
-			cf_search_memory_root(i);
+			cf_check_root_path(root);
 		}
 	}
 
+	// For each root, find all files...
+	auto start = std::chrono::steady_clock::now();
+
+	SCP_vector<cf_root_scan> scans(Num_roots);
+
+	threading::parallel_for(0, scans.size(), 1, [&scans](size_t root_index) {
+		cf_search_root(static_cast<int>(root_index), scans[root_index]);
+	});
+
+	// ... and add them in root order so that the precedence rules stay the same
+	for (i=0; i<Num_roots; i++ )	{
+		cf_add_root_files(i, scans[i]);
+	}
+
+	mprintf(( "Searched %d roots in %.1f ms\n", Num_roots,
+		std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() ));
+
+	cf_build_file_index();
+
 #ifndef NDEBUG
 	// if some special/critical files might be shadowed then make sure the user knows about it
 	if ( !critical_shadowed.empty() && !running_unittests ) {
@@ -1208,6 +1307,34 @@ void cf_free_secondary_filelist()
 	// Free the file blocks
 	File_blocks.clear();
 	Num_files = 0;
+
+	File_name_index.clear();
+}
+
+std::shared_ptr<cfile::file_mapping> cf_get_pack_mapping(const SCP_string& pack_path)
+{
+	std::lock_guard<std::mutex> guard(Pack_mapping_mutex);
+
+	for (int i = 0; i < Num_roots; ++i) {
+		cf_root *root = cf_get_root(i);
+
+		if ( (root->roottype != CF_ROOTTYPE_PACK) || (root->path != pack_path) ) {
+			continue;
+		}
+
+		if ( !root->mapping && !root->mapping_failed ) {
+			root->mapping = cfile::file_mapping::map(root->path.c_str());
+
+			if ( !root->mapping ) {
+				mprintf(("Could not memory-map pack file '%s', reading it through stdio instead.\n", root->path.c_str()));
+				root->mapping_failed = true;
+			}
+		}
+
+		return root->mapping;
+	}
+
+	return nullptr;
 }
 
 static bool is_absolute_path(const char *path)
@@ -1380,8 +1507,14 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, uint32_t
 	}
 
 	// Search the pak files and CD-ROM.
-	for (ui = 0; ui < Num_files; ui++ )	{
-		cf_file *f = cf_get_file(ui);
+	auto candidates = cf_find_indexed_files(filename);
+
+	if (candidates == nullptr) {
+		return CFileLocation();
+	}
+
+	for (auto file_index : *candidates) {
+		cf_file *f = cf_get_file(file_index);
 
 		// only search paths we're supposed to...
 		if ( (pathtype != CF_TYPE_ANY) && (pathtype != f->pathtype_index) )
@@ -1401,46 +1534,40 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, uint32_t
 			continue;
 		}
 
-		// file either not localized or localized version not found
-		if ( !stricmp(filename.c_str(), f->name_ext.c_str()) ) {
-			CFileLocation res(true);
-			res.size = static_cast<size_t>(f->size);
-			res.offset = (size_t)f->pack_offset;
-			res.data_ptr = f->data;
-			res.name_ext = f->name_ext;
-			res.m_time = f->write_time;
-
-			if (f->data != nullptr) {
-				// This is an in-memory file so we just copy the pathtype name + file name
-				res.full_name = Pathtypes[f->pathtype_index].path;
-				res.full_name += DIR_SEPARATOR_STR;
-				res.full_name += f->sub_path;
-				res.full_name += f->name_ext;
-			} else if (f->pack_offset < 1) {
-				// This is a real file, return the actual file path
-				res.full_name = f->real_name;
-			} else {
-				// File is in a pack file
-				cf_root *r = cf_get_root(f->root_index);
-
-				res.full_name = r->path;
-			}
+		// the index only holds files with our name, so this is it
+		CFileLocation res(true);
+		res.size = static_cast<size_t>(f->size);
+		res.offset = (size_t)f->pack_offset;
+		res.data_ptr = f->data;
+		res.name_ext = f->name_ext;
+		res.m_time = f->write_time;
+
+		if (f->data != nullptr) {
+			// This is an in-memory file so we just copy the pathtype name + file name
+			res.full_name = Pathtypes[f->pathtype_index].path;
+			res.full_name += DIR_SEPARATOR_STR;
+			res.full_name += f->sub_path;
+			res.full_name += f->name_ext;
+		} else if (f->pack_offset < 1) {
+			// This is a real file, return the actual file path
+			res.full_name = f->real_name;
+		} else {
+			// File is in a pack file
+			cf_root *r = cf_get_root(f->root_index);
 
-			return res;
+			res.full_name = r->path;
 		}
+
+		return res;
 	}
 		
 	return CFileLocation();
 }
 
-// -- from parselo.cpp --
-extern char *stristr(char *str, const char *substr);
-
 /**
  * Searches for a file.
  *
  * @note Follows all rules and precedence and searches CD's and pack files. Searches all locations in order for first filename using filter list.
- * @note This function is exponentially slow, so don't use it unless truely needed
  *
  * @param filename      Filename & extension
  * @param ext_num       Number of extensions to look for
@@ -1567,11 +1694,28 @@ CFileLocationExt cf_find_file_location_ext(const char *filename, const int ext_n
 	int last_root_index = -1;
 	int last_path_index = -1;
 
-	file_list_index.reserve( MIN(ext_num * 4, (int)Num_files) );
+	// gather every file with our base name and one of our supported types from the index, and put
+	// them back into order of priority since each extension has its own list
+	SCP_vector<uint> candidates;
+
+	for (cur_ext = 0; cur_ext < ext_num; cur_ext++) {
+		filespec_ext = filespec + ext_list[cur_ext];
+
+		auto indexed = cf_find_indexed_files(filespec_ext);
+
+		if (indexed != nullptr) {
+			candidates.insert(candidates.end(), indexed->begin(), indexed->end());
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end());
+	candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+	file_list_index.reserve(candidates.size());
 
 	// next, run though and pick out base matches
-	for (ui = 0; ui < Num_files; ui++) {
-		cf_file *f = cf_get_file(ui);
+	for (auto file_index : candidates) {
+		cf_file *f = cf_get_file(file_index);
 
 		// ... only search paths that we're supposed to
 		if ( (num_search_dirs == 1) && (pathtype != f->pathtype_index) )
@@ -1586,22 +1730,6 @@ CFileLocationExt cf_find_file_location_ext(const char *filename, const int ext_n
 		if (f->name_ext.length() != filespec_len_big )
 			continue;
 
-		// ... check that we match the base filename
-		if ( strnicmp(f->name_ext.c_str(), filespec.c_str(), filespec.length()) != 0 )
-			continue;
-
-		// ... make sure that it's one of our supported types
-		bool found_one = false;
-		for (cur_ext = 0; cur_ext < ext_num; cur_ext++) {
-			if ( stristr(f->name_ext.c_str(), ext_list[cur_ext]) ) {
-				found_one = true;
-				break;
-			}
-		}
-
-		if ( !found_one )
-			continue;
-
 		// ... we check based on location, so if location changes after the first find then bail
 		if (last_root_index == -1) {
 			last_root_index = f->root_index;
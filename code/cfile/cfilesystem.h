@@ -13,6 +13,7 @@
 #define _CFILESYSTEM_H
 
 #include "cfile/cfile.h"
+#include "cfile/cfilemapping.h"
 
 // Builds a list of all the files
 void cf_build_secondary_filelist( const char *cdrom_path );
@@ -31,6 +32,10 @@ extern cf_pathtype Pathtypes[CF_MAX_PATH_TYPES];
 
 bool cf_check_location_flags(uint32_t check_flags, uint32_t desired_flags);
 
+// Returns the memory mapping of the pack file at pack_path, mapping it on first use.
+// Returns nullptr if pack_path isn't one of our pack files or if it can't be mapped.
+std::shared_ptr<cfile::file_mapping> cf_get_pack_mapping(const SCP_string& pack_path);
+
 // Returns the default storage path for files given a 
 // particular pathtype.   In other words, the path to 
 // the unpacked, non-cd'd, stored on hard drive path.
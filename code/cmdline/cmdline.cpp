@@ -176,6 +176,7 @@ Flag exe_params[] =
 
 	//flag					launcher text								FSO		on_flags							off_flags						category		reference URL
 	{ "-no_vsync",			"Disable vertical sync",					true,	0,									EASY_DEFAULT,					"Game Speed",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_vsync", },
+	{ "-mmap_vps",			"Memory-map VP files",						true,	0,									EASY_DEFAULT,					"Game Speed",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-mmap_vps", },
 
 	//flag					launcher text								FSO		on_flags							off_flags						category		reference URL
 	{ "-fps",				"Show frames per second on HUD",			false,	0,									EASY_DEFAULT,					"HUD",			"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-fps", },
@@ -381,9 +382,11 @@ int Cmdline_msaa_enabled = 0;
 // Game Speed related
 cmdline_parm no_fpscap("-no_fps_capping", "Don't limit frames-per-second", AT_NONE);	// Cmdline_NoFPSCap
 cmdline_parm no_vsync_arg("-no_vsync", NULL, AT_NONE);		// Cmdline_no_vsync
+cmdline_parm mmap_vps_arg("-mmap_vps", "Read packed files out of memory-mapped VP files", AT_NONE);	// Cmdline_mmap_vps
 
 int Cmdline_NoFPSCap = 0; // Disable FPS capping - kazan
 bool Cmdline_no_vsync = false;
+bool Cmdline_mmap_vps = false;
 
 // HUD related
 cmdline_parm ballistic_gauge("-ballistic_gauge", NULL, AT_NONE);	// Cmdline_ballistic_gauge
@@ -1620,6 +1623,11 @@ bool SetCmdlineParams()
 		Cmdline_NoFPSCap = 1;
 	}
 
+	if (mmap_vps_arg.found())
+	{
+		Cmdline_mmap_vps = true;
+	}
+
 	if(loadallweapons_arg.found())
 	{
 		Cmdline_load_all_weapons = 1;
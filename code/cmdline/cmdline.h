@@ -73,6 +73,7 @@ extern int Cmdline_msaa_enabled;
 // Game Speed related
 extern int Cmdline_NoFPSCap;
 extern bool Cmdline_no_vsync;
+extern bool Cmdline_mmap_vps;
 
 // HUD related
 extern int Cmdline_ballistic_gauge;
@@ -403,10 +403,8 @@ Done:
 	return retval;
 }
 
-static void (*decompress_dds)(const void *in, void *out, int pitch) = nullptr;
-static uint32_t BLOCK_SIZE = 0;
-
 //reads pixel info from a dds file
+//doesn't report errors itself since bitmaps are also read on worker threads while paging
 int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 {
 	int retval;
@@ -433,7 +431,6 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 
 	// read the header -- if its at this stage, it should be legal.
 	retval = _dds_read_header(cfp, dds_header);
-	Assert(retval == DDS_ERROR_NONE);
 
 	// this really shouldn't be needed but better safe than sorry
 	if (retval != DDS_ERROR_NONE) {
@@ -450,11 +447,21 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 		cfread(data, 1, (int)size, cfp);
 	} else {
 		// Compression format not supported, convert to BGRA
-		ubyte *comp_data = (ubyte*)vm_malloc(size);
+		ubyte *comp_data = nullptr;
+		const ubyte *src;
 
-		cfread(comp_data, 1, (int)size, cfp);
+		// decode straight out of the file if it's in memory
+		auto view = cf_get_view(cfp);
+		auto pos = static_cast<size_t>(cftell(cfp));
+
+		if (view.data != nullptr && pos + size <= view.size) {
+			src = view.data + pos;
+		} else {
+			comp_data = (ubyte*)vm_malloc(size);
+			cfread(comp_data, 1, (int)size, cfp);
+			src = comp_data;
+		}
 
-		ubyte *src = comp_data;
 		ubyte *dst = data;
 
 		uint d_width, d_height, d_depth;
@@ -467,26 +474,34 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 		const int num_faces = (dds_header.dwCaps2 & DDSCAPS2_CUBEMAP) ? 6 : 1;
 		const bool has_depth = (dds_header.dwFlags & DDSD_DEPTH) == DDSD_DEPTH;
 
+		// bitmaps are decoded on several threads while paging, so none of this may be static
+		void (*decompress_dds)(const void *in, void *out, int pitch) = nullptr;
+		uint32_t block_size = 0;
+
 		switch (dds_header.ddspf.dwFourCC) {
 			case FOURCC_DX10:
 				decompress_dds = bcdec_bc7;
-				BLOCK_SIZE = BCDEC_BC7_BLOCK_SIZE;
+				block_size = BCDEC_BC7_BLOCK_SIZE;
 				break;
 			case FOURCC_DXT5:
 				decompress_dds = bcdec_bc3;
-				BLOCK_SIZE = BCDEC_BC3_BLOCK_SIZE;
+				block_size = BCDEC_BC3_BLOCK_SIZE;
 				break;
 			case FOURCC_DXT1:
 				decompress_dds = bcdec_bc1;
-				BLOCK_SIZE = BCDEC_BC1_BLOCK_SIZE;
+				block_size = BCDEC_BC1_BLOCK_SIZE;
 				break;
 			case FOURCC_DXT3:
 				decompress_dds = bcdec_bc2;
-				BLOCK_SIZE = BCDEC_BC2_BLOCK_SIZE;
+				block_size = BCDEC_BC2_BLOCK_SIZE;
 				break;
 			default:
-				Error(LOCATION, "Invalid FourCC (%d) for DDS decompression!", dds_header.ddspf.dwFourCC);
-				break;
+				// this can run on a worker thread, so the caller reports the error
+				if (comp_data != nullptr) {
+					vm_free(comp_data);
+				}
+				cfclose(cfp);
+				return DDS_ERROR_INVALID_FORMAT;
 		}
 
 		for (int f = 0; f < num_faces; ++f) {
@@ -496,7 +511,7 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 				d_height = std::max(1U, dds_header.dwHeight << (mipmap_offset - x));
 				d_depth = has_depth ? std::max(1U, dds_header.dwDepth << (mipmap_offset - x)) : 1U;
 
-				src += ((d_width + 3) / 4) * ((d_height + 3) / 4) * d_depth * BLOCK_SIZE;
+				src += ((d_width + 3) / 4) * ((d_height + 3) / 4) * d_depth * block_size;
 			}
 
 			for (uint m = mipmap_offset; m < dds_header.dwMipMapCount; ++m) {
@@ -513,7 +528,7 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 							dst = data + data_offset + depth_offset + ((i * d_width + j) * 4);
 
 							decompress_dds(src, dst, d_width * 4);
-							src += BLOCK_SIZE;
+							src += block_size;
 						}
 					}
 				}
@@ -528,8 +543,10 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 			}
 		}
 
-		vm_free(comp_data);
-		comp_data = nullptr;
+		if (comp_data != nullptr) {
+			vm_free(comp_data);
+			comp_data = nullptr;
+		}
 
 		// switch to uncompressed format and reset vars (needed below to get correct bit count)
 		dds_header.ddspf.dwFlags &= ~DDPF_FOURCC;
@@ -304,6 +304,7 @@ int dds_read_header(const char *filename, CFILE *img_cfp = NULL, int *width = 0,
 
 //reads bitmap
 //size of the data it stored in size
+//errors are only returned, it's up to the caller to report them
 int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp = NULL, int cf_type = CF_TYPE_ANY);
 
 // Decompress just the top mip of a 2D FOURCC-compressed DDS (DXT1/3/5, BC7)
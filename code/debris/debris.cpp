@@ -914,9 +914,11 @@ void debris_hit(object *debris_obj, object * /*other_obj*/, vec3d *hitpos, float
 /**
  * See if poor debris object *obj got whacked by evil *other_obj at point *hitpos.
  * NOTE: debris_hit_info pointer NULL for debris:weapon collision, otherwise debris:ship collision.
+ * For debris:weapon collisions, the model collision is copied to weapon_mc if given.  Nothing is written
+ * to the debris or the weapon, so this is safe to call from the collision worker threads.
  * @return true if hit, else return false.
  */
-int debris_check_collision(object *pdebris, object *other_obj, vec3d *hitpos, collision_info_struct *debris_hit_info, vec3d* hitNormal)
+int debris_check_collision(object *pdebris, object *other_obj, vec3d *hitpos, collision_info_struct *debris_hit_info, vec3d* hitNormal, mc_info* weapon_mc)
 {
 	mc_info	mc;
 
@@ -956,9 +958,8 @@ int debris_check_collision(object *pdebris, object *other_obj, vec3d *hitpos, co
 			}
 		}
 
-		weapon *wp = &Weapons[other_obj->instance];
-		wp->collisionInfo = new mc_info;	// The weapon will free this memory later
-		*wp->collisionInfo = mc;
+		if (weapon_mc)
+			*weapon_mc = mc;
 
 		return mc.num_hits;
 	}
@@ -619,35 +619,7 @@ static void opengl_purge_shader_cache_type(const char* ext) {
 		}
 	}
 
-	SCP_vector<SCP_string> cache_files;
-	SCP_vector<file_list_info> file_info;
-	cf_get_file_list(cache_files, CF_TYPE_CACHE, filter.c_str(), CF_SORT_NONE, &file_info,
-	                 CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
-
-	Assertion(cache_files.size() == file_info.size(),
-			  "cf_get_file_list returned different sizes for file names and file informations!");
-
-	const auto TIMEOUT = 2.0 * 30.0 * 24.0 * 60.0 * 60.0; // purge timeout in seconds which is ~2 months
-	const SCP_string PREFIX = "ogl_shader-";
-
-	auto now = std::time(nullptr);
-	for (size_t i = 0; i < cache_files.size(); ++i) {
-		auto& name = cache_files[i];
-		auto write_time = file_info[i].write_time;
-
-		if (name.compare(0, PREFIX.size(), PREFIX) != 0) {
-			// Not an OpenGL cache file
-			continue;
-		}
-
-		auto diff = std::difftime(now, write_time);
-
-		if (diff > TIMEOUT) {
-			auto full_name = name + "." + ext;
-
-			cf_delete(full_name.c_str(), CF_TYPE_CACHE);
-		}
-	}
+	cf_purge_old_cache_files("ogl_shader-", ext);
 }
 
 static void opengl_purge_old_shader_cache()
@@ -334,31 +334,7 @@ SCP_vector<uint32_t> VulkanShaderCompiler::compile(const SCP_string& filename,
 
 void VulkanShaderCompiler::purgeOldCache()
 {
-	const SCP_string PREFIX = "vk_shader-";
-	const auto TIMEOUT = 2.0 * 30.0 * 24.0 * 60.0 * 60.0; // ~2 months in seconds
-
-	SCP_vector<SCP_string> cache_files;
-	SCP_vector<file_list_info> file_info;
-	cf_get_file_list(cache_files, CF_TYPE_CACHE, "*.spv", CF_SORT_NONE, &file_info,
-	                 CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
-
-	Assertion(cache_files.size() == file_info.size(),
-	          "cf_get_file_list returned different sizes for file names and file informations!");
-
-	auto now = std::time(nullptr);
-	for (size_t i = 0; i < cache_files.size(); ++i) {
-		auto& name = cache_files[i];
-
-		if (name.compare(0, PREFIX.size(), PREFIX) != 0) {
-			continue; // Not our cache file
-		}
-
-		auto diff = std::difftime(now, file_info[i].write_time);
-		if (diff > TIMEOUT) {
-			auto full_name = name + ".spv";
-			cf_delete(full_name.c_str(), CF_TYPE_CACHE);
-		}
-	}
+	cf_purge_old_cache_files("vk_shader-", "spv");
 }
 
 } // namespace graphics::vulkan
@@ -0,0 +1,233 @@
+#include "lighting/lightgrid.h"
+
+#include "lighting/lighting.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Cells are addressed with 20 bits per axis and 3 bits for the level, which covers far more than any mission uses
+constexpr int CELL_COORD_LIMIT = (1 << 19) - 1;
+
+// With fewer point lights than this, walking all of them is as quick as looking up cells
+constexpr size_t MIN_BINNED_LIGHTS = 32;
+
+// The cells of the finest level are this many times the radius that three out of four point lights stay within.  Larger
+// cells test more lights for nothing, smaller ones take more searches for the cells around a model.
+constexpr float CELL_SIZE_FACTOR = 4.0f;
+constexpr float MIN_CELL_SIZE = 1.0f;
+constexpr float LEVEL_FACTOR = 4.0f;
+
+// The cheap tube test subtracts two squares, which loses precision with the distance from the start of the tube.  It
+// only rules out tubes that are further away than this fraction of that distance on top of their range.
+constexpr float TUBE_TEST_SLACK = 1e-4f;
+}
+
+int light_grid::cell_coord(float value, float cell_size)
+{
+	auto coord = static_cast<int>(std::floor(value / cell_size));
+	CLAMP(coord, -CELL_COORD_LIMIT, CELL_COORD_LIMIT);
+	return coord;
+}
+
+uint64_t light_grid::cell_key(int level, int x, int y, int z)
+{
+	// coordinates are made positive, so that the cells along z with the same x and y follow each other in key order
+	constexpr int bias = CELL_COORD_LIMIT + 1;
+	return (static_cast<uint64_t>(level) << 60) | (static_cast<uint64_t>(x + bias) << 40) | (static_cast<uint64_t>(y + bias) << 20) | static_cast<uint64_t>(z + bias);
+}
+
+bool light_grid::point_in_range(const vec3d& light_pos, float radb, const vec3d& pos, float rad)
+{
+	vec3d to_light;
+	vm_vec_sub(&to_light, &light_pos, &pos);
+	float dist_squared = vm_vec_mag_squared(&to_light);
+
+	float max_dist_squared = radb + rad;
+	max_dist_squared *= max_dist_squared;
+
+	return dist_squared < max_dist_squared;
+}
+
+bool light_grid::in_range(const light& l, const vec3d& pos, float rad)
+{
+	switch (l.type) {
+		case Light_Type::Point:
+			return point_in_range(l.vec, l.radb, pos, rad);
+
+		case Light_Type::Tube: {
+			vec3d nearest;
+			// left alone by debug builds if both points of the tube are the same
+			float dist_squared = FLT_MAX;
+			vm_vec_dist_squared_to_line(&pos, &l.vec, &l.vec2, &nearest, &dist_squared);
+
+			float max_dist_squared = l.radb + rad;
+			max_dist_squared *= max_dist_squared;
+
+			return dist_squared < max_dist_squared;
+		}
+
+		default:
+			return false;
+	}
+}
+
+void light_grid::build(const SCP_vector<light>& lights)
+{
+	clear();
+
+	SCP_vector<float> radii;
+	for (const auto& l : lights) {
+		if (l.type == Light_Type::Point)
+			radii.push_back(l.radb);
+	}
+
+	if (radii.size() >= MIN_BINNED_LIGHTS) {
+		auto quartile = radii.begin() + radii.size() * 3 / 4;
+		std::nth_element(radii.begin(), quartile, radii.end());
+
+		float cell_size = std::max(*quartile * CELL_SIZE_FACTOR, MIN_CELL_SIZE);
+		for (auto& lvl : _levels) {
+			lvl.cell_size = cell_size;
+			cell_size *= LEVEL_FACTOR;
+		}
+	}
+
+	_keys.clear();
+	for (uint i = 0; i < static_cast<uint>(lights.size()); ++i) {
+		const auto& l = lights[i];
+
+		if (l.type == Light_Type::Point) {
+			int lvl = 0;
+			if (radii.size() >= MIN_BINNED_LIGHTS) {
+				while (lvl < MAX_LEVELS && l.radb > _levels[lvl].cell_size)
+					++lvl;
+			} else {
+				lvl = MAX_LEVELS;
+			}
+
+			if (lvl < MAX_LEVELS) {
+				const float cell_size = _levels[lvl].cell_size;
+				_keys.emplace_back(cell_key(lvl, cell_coord(l.vec.xyz.x, cell_size), cell_coord(l.vec.xyz.y, cell_size), cell_coord(l.vec.xyz.z, cell_size)), i);
+			} else {
+				_unbinned.push_back(i);
+			}
+		} else if (l.type == Light_Type::Tube) {
+			vec3d dir;
+			vm_vec_sub(&dir, &l.vec2, &l.vec);
+			float length = vm_vec_mag(&dir);
+
+			if (fl_near_zero(length)) {
+				_unbinned.push_back(i);
+			} else {
+				vm_vec_scale(&dir, 1.0f / length);
+				_tubes.push_back({l.vec, dir, l.radb, i});
+			}
+		}
+	}
+
+	// order within a cell stays the order of the lights
+	std::sort(_keys.begin(), _keys.end());
+
+	for (const auto& key : _keys) {
+		const auto& l = lights[key.second];
+		auto& lvl = _levels[key.first >> 60];
+
+		if (lvl.cells.empty() || lvl.cells.back().key != key.first) {
+			auto begin = static_cast<uint>(_items.size());
+			lvl.cells.push_back({key.first, begin, begin});
+		}
+
+		lvl.cells.back().end++;
+		lvl.max_radb = std::max(lvl.max_radb, l.radb);
+		_items.push_back({l.vec, l.radb, key.second});
+
+		_num_levels = std::max(_num_levels, static_cast<int>(key.first >> 60) + 1);
+	}
+}
+
+void light_grid::clear()
+{
+	for (auto& lvl : _levels) {
+		lvl.cell_size = MIN_CELL_SIZE;
+		lvl.max_radb = 0.0f;
+		lvl.cells.clear();
+	}
+
+	_num_levels = 0;
+	_items.clear();
+	_tubes.clear();
+	_unbinned.clear();
+}
+
+SCP_vector<light_grid::cell>::const_iterator light_grid::lower_bound(const level& lvl, uint64_t key)
+{
+	return std::lower_bound(lvl.cells.begin(), lvl.cells.end(), key, [](const cell& c, uint64_t k) { return c.key < k; });
+}
+
+void light_grid::find(const SCP_vector<light>& lights, const vec3d& pos, float rad, SCP_vector<size_t>& indices) const
+{
+	const size_t first = indices.size();
+
+	auto search_cell = [&](const cell& c) {
+		for (uint i = c.begin; i < c.end; ++i) {
+			const auto& it = _items[i];
+			if (point_in_range(it.pos, it.radb, pos, rad))
+				indices.push_back(it.index);
+		}
+	};
+
+	for (int l = 0; l < _num_levels; ++l) {
+		const auto& lvl = _levels[l];
+		if (lvl.cells.empty())
+			continue;
+
+		// lights are in the cell of their position, so the cells around the sphere have to cover the largest radius
+		const float search = rad + lvl.max_radb;
+		int low[3], high[3];
+		size_t num_searches = 1;
+		for (int i = 0; i < 3; ++i) {
+			low[i] = cell_coord(pos.a1d[i] - search, lvl.cell_size);
+			high[i] = cell_coord(pos.a1d[i] + search, lvl.cell_size);
+
+			// every column of cells along z takes one search, don't let huge searches overflow
+			if (i < 2)
+				num_searches = std::min(num_searches * static_cast<size_t>(high[i] - low[i] + 1), lvl.cells.size() + 1);
+		}
+
+		if (num_searches <= lvl.cells.size()) {
+			for (int x = low[0]; x <= high[0]; ++x) {
+				for (int y = low[1]; y <= high[1]; ++y) {
+					const auto last = cell_key(l, x, y, high[2]);
+					for (auto c = lower_bound(lvl, cell_key(l, x, y, low[2])); c != lvl.cells.end() && c->key <= last; ++c)
+						search_cell(*c);
+				}
+			}
+		} else {
+			// fewer cells are occupied than there are columns to search, which is also fine for the ones outside
+			for (const auto& c : lvl.cells)
+				search_cell(c);
+		}
+	}
+
+	for (const auto& t : _tubes) {
+		vec3d to_pos;
+		vm_vec_sub(&to_pos, &pos, &t.start);
+		float dist_squared = vm_vec_mag_squared(&to_pos);
+		float along = vm_vec_dot(&to_pos, &t.dir);
+
+		float max_dist = t.radb + rad;
+		if (dist_squared - along * along - TUBE_TEST_SLACK * dist_squared >= max_dist * max_dist)
+			continue;
+
+		if (in_range(lights[t.index], pos, rad))
+			indices.push_back(t.index);
+	}
+
+	for (auto index : _unbinned) {
+		if (in_range(lights[index], pos, rad))
+			indices.push_back(index);
+	}
+
+	std::sort(indices.begin() + first, indices.end());
+}
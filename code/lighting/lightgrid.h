@@ -0,0 +1,86 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "math/vecmat.h"
+
+struct light;
+
+/**
+ * @brief Uniform grids over the point lights of a scene, used by scene_lights::setLightFilter() to find the lights
+ * reaching a model without testing every light of the scene
+ *
+ * The grids are built once from all lights of the scene and then queried for every draw.  Point lights are sorted into
+ * the cells they are centered in, on the finest of several levels whose cells are at least as large as the radius of
+ * the light, so that a light never reaches further than the neighbouring cells.  The cells of the finest level follow
+ * the radii of the lights, every other level has cells four times as large as the one before.
+ *
+ * Tube lights light everything along the infinite line through their two points, so they can't be put into cells.
+ * Every query checks them instead, using a cheap test that can only rule out lights before the exact one.
+ *
+ * Queries use the exact same tests as walking all lights and return the lights in the order they were added in, so
+ * the lights a model gets don't depend on whether the grid is used.
+ */
+class light_grid
+{
+  public:
+	light_grid() = default;
+
+	// Replaces the contents of the grid with the point and tube lights of lights.  Other types are never returned.
+	void build(const SCP_vector<light>& lights);
+
+	void clear();
+
+	// Appends the indices of the lights that reach the sphere around pos, in the order of the lights passed to
+	// build().  lights has to be the same as when the grid was built.
+	void find(const SCP_vector<light>& lights, const vec3d& pos, float rad, SCP_vector<size_t>& indices) const;
+
+	// Whether l reaches the sphere around pos, which is what find() checks for every light
+	static bool in_range(const light& l, const vec3d& pos, float rad);
+
+	size_t num_binned() const { return _items.size(); }
+
+  private:
+	struct item {
+		vec3d pos;
+		float radb;
+		uint index;		// index of the light passed to build()
+	};
+
+	struct cell {
+		uint64_t key;
+		uint begin;
+		uint end;
+	};
+
+	struct level {
+		float cell_size;
+		float max_radb;
+		SCP_vector<cell> cells;	// sorted by key
+	};
+
+	struct tube {
+		vec3d start;
+		vec3d dir;		// unit vector along the tube
+		float radb;
+		uint index;
+	};
+
+	static constexpr int MAX_LEVELS = 8;
+
+	int _num_levels = 0;
+	level _levels[MAX_LEVELS];
+
+	SCP_vector<item> _items;	// sorted by level and cell
+	SCP_vector<tube> _tubes;
+	SCP_vector<uint> _unbinned;	// lights that get the exact test only
+
+	SCP_vector<std::pair<uint64_t, uint>> _keys;	// only used by build(), kept around so that it doesn't allocate
+
+	static int cell_coord(float value, float cell_size);
+	static uint64_t cell_key(int level, int x, int y, int z);
+
+	// first cell of lvl with a key that isn't less than key
+	static SCP_vector<cell>::const_iterator lower_bound(const level& lvl, uint64_t key);
+
+	static bool point_in_range(const vec3d& light_pos, float radb, const vec3d& pos, float rad);
+};
@@ -591,6 +591,7 @@ void scene_lights::addLight(const light *light_ptr)
 	Assert(light_ptr != NULL);
 
 	AllLights.push_back(*light_ptr);
+	LightGridDirty = true;
 
 	if ( light_ptr->type == Light_Type::Directional ) {
 		StaticLightIndices.push_back(AllLights.size() - 1);
@@ -599,51 +600,15 @@ void scene_lights::addLight(const light *light_ptr)
 
 void scene_lights::setLightFilter(const vec3d *pos, float rad)
 {
-	size_t i = 0;
+	if ( LightGridDirty ) {
+		LightGrid.build(AllLights);
+		LightGridDirty = false;
+	}
+
 	// clear out current filtered lights
 	FilteredLights.clear();
 
-	for ( auto& l : AllLights ) {
-		switch ( l.type ) {
-			case Light_Type::Directional:
-				++i;
-				continue;
-			case Light_Type::Point: {
-				vec3d to_light;
-				float dist_squared, max_dist_squared;
-				vm_vec_sub( &to_light, &l.vec, pos );
-				dist_squared = vm_vec_mag_squared(&to_light);
-
-				max_dist_squared = l.radb+rad;
-				max_dist_squared *= max_dist_squared;
-
-				if ( dist_squared < max_dist_squared )	{
-					FilteredLights.push_back(i);
-				}
-			}
-			break;
-			case Light_Type::Tube: {
-				vec3d nearest;
-				float dist_squared, max_dist_squared;
-				vm_vec_dist_squared_to_line(pos,&l.vec,&l.vec2,&nearest,&dist_squared);
-
-				max_dist_squared = l.radb+rad;
-				max_dist_squared *= max_dist_squared;
-
-				if ( dist_squared < max_dist_squared ) {
-					FilteredLights.push_back(i);
-				}
-			}
-			break;
-
-			case Light_Type::Cone:
-				break;
-
-			default:
-				break;
-		}
-		++i;
-	}
+	LightGrid.find(AllLights, *pos, rad, FilteredLights);
 }
 
 light_indexing_info scene_lights::bufferLights()
@@ -12,6 +12,7 @@
 
 #include "globalincs/pstypes.h"
 #include "graphics/color.h"
+#include "lighting/lightgrid.h"
 
 // Light stuff works like this:
 // At the start of the frame, call light_reset.
@@ -78,6 +79,10 @@ class scene_lights
 
 	SCP_vector<size_t> BufferedLights;
 
+	// built from AllLights by the first setLightFilter() after lights were added
+	light_grid LightGrid;
+	bool LightGridDirty = false;
+
 	size_t current_light_index;
 	size_t current_num_lights;
 public:
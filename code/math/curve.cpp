@@ -5,6 +5,12 @@
 
 SCP_vector<Curve> Curves;
 
+// Baking starts at this many samples and doubles the count until the error bound is met everywhere or the maximum is reached
+static constexpr size_t CURVE_BAKE_MIN_SAMPLES = 16;
+static constexpr size_t CURVE_BAKE_MAX_SAMPLES = 1024;
+// How many points between two samples the baked curve is checked at
+static constexpr size_t CURVE_BAKE_CHECKS_PER_SAMPLE = 16;
+
 int curve_get_by_name(const SCP_string& in_name) {
 	return find_item_with_field(Curves, &Curve::name, in_name);
 }
@@ -184,6 +190,7 @@ Curve::Curve(SCP_string in_name)
 void Curve::ParseData()
 {
 	keyframes.clear();
+	ClearBake();
 
 	required_string("$Keyframes:");
 	do
@@ -264,6 +271,28 @@ void Curve::ParseData()
 
 
 float Curve::GetValue(float x_val) const {
+	if (baked_values.empty())
+		return GetValueExact(x_val);
+
+	// outside of the keyframes the curve is flat, and this also keeps NaN away from the index computation
+	if (!(x_val < baked_end))
+		return keyframes.back().pos.y;
+	if (x_val < baked_start)
+		return keyframes.front().pos.y;
+
+	float sample = (x_val - baked_start) * baked_inv_step;
+	size_t index = static_cast<size_t>(sample);
+	if (index >= baked_values.size() - 1)
+		return baked_values.back();
+
+	if (baked_exact[index])
+		return GetValueExact(x_val);
+
+	float t = sample - static_cast<float>(index);
+	return baked_values[index] + t * (baked_values[index + 1] - baked_values[index]);
+}
+
+float Curve::GetValueExact(float x_val) const {
 	const curve_keyframe* kframe = &keyframes[0];
 	const vec2d* next_pos = &kframe->pos;
 	for (size_t i = 0; i < keyframes.size(); i++) {
@@ -298,7 +327,7 @@ float Curve::GetValue(float x_val) const {
 			return kframe->pos.y + out * (next_pos->y - kframe->pos.y);
 		case CurveInterpFunction::Curve:
 			// add 0.5 to ensure this behaves like rounding
-			out = Curves[fl2i(kframe->param1 + 0.5f)].GetValue(t);
+			out = Curves[fl2i(kframe->param1 + 0.5f)].GetValueExact(t);
 			return kframe->pos.y + out * (next_pos->y - kframe->pos.y);
 		default:
 			UNREACHABLE("Unrecognized curve function %d", static_cast<int>(kframe->interp_func));
@@ -362,3 +391,90 @@ float Curve::GetValueIntegrated(float x_val) const
 
 	return integrated_value;
 }
+
+bool Curve::Bake(float max_error)
+{
+	ClearBake();
+
+	if (keyframes.size() < 2)
+		return false;
+
+	float start = keyframes.front().pos.x;
+	float end = keyframes.back().pos.x;
+	if (!(end > start))
+		return false;
+
+	SCP_vector<float> samples;
+	SCP_vector<ubyte> exact;
+	size_t num_exact = 0;
+	float step = 0.0f;
+
+	for (size_t num_samples = CURVE_BAKE_MIN_SAMPLES; num_samples <= CURVE_BAKE_MAX_SAMPLES; num_samples *= 2) {
+		step = (end - start) / static_cast<float>(num_samples - 1);
+
+		samples.resize(num_samples);
+		for (size_t i = 0; i < num_samples; i++)
+			samples[i] = GetValueExact(start + static_cast<float>(i) * step);
+
+		// intervals where interpolating the samples is too far off (steps, infinite slopes) keep using the keyframes
+		exact.assign(num_samples - 1, 0);
+		num_exact = 0;
+		for (size_t i = 0; i < num_samples - 1; i++) {
+			for (size_t k = 1; k < CURVE_BAKE_CHECKS_PER_SAMPLE; k++) {
+				float t = static_cast<float>(k) / static_cast<float>(CURVE_BAKE_CHECKS_PER_SAMPLE);
+				float baked = samples[i] + t * (samples[i + 1] - samples[i]);
+
+				if (fabsf(baked - GetValueExact(start + (static_cast<float>(i) + t) * step)) > max_error) {
+					exact[i] = 1;
+					num_exact++;
+					break;
+				}
+			}
+		}
+
+		if (num_exact == 0)
+			break;
+	}
+
+	// not worth a lookup table if most of it would be skipped anyway
+	if (num_exact * 2 > exact.size())
+		return false;
+
+	baked_values = std::move(samples);
+	baked_exact = std::move(exact);
+	baked_start = start;
+	baked_end = end;
+	baked_inv_step = 1.0f / step;
+	return true;
+}
+
+void Curve::ClearBake()
+{
+	baked_values.clear();
+	baked_values.shrink_to_fit();
+	baked_exact.clear();
+	baked_exact.shrink_to_fit();
+	baked_start = 0.0f;
+	baked_end = 0.0f;
+	baked_inv_step = 0.0f;
+}
+
+void curves_bake(float max_error)
+{
+	if (max_error <= 0.0f) {
+		for (auto& curve : Curves)
+			curve.ClearBake();
+		return;
+	}
+
+	size_t num_baked = 0;
+	for (auto& curve : Curves) {
+		if (curve.Bake(max_error)) {
+			num_baked++;
+		} else if (curve.keyframes.size() > 1) {
+			nprintf(("Curves", "Curve '%s' can mostly not be baked within an error of %f, it will be evaluated from its keyframes\n", curve.name.c_str(), max_error));
+		}
+	}
+
+	mprintf(("Baked " SIZE_T_ARG " of " SIZE_T_ARG " curves into lookup tables\n", num_baked, Curves.size()));
+}
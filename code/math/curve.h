@@ -32,18 +32,38 @@ public :
 	SCP_string	name;
 	SCP_vector<curve_keyframe>		keyframes;
 
+private :
+	// Evenly spaced samples from the first to the last keyframe, see Bake()
+	SCP_vector<float>	baked_values;
+	// Per interval between two samples, whether it has to be evaluated from the keyframes instead
+	SCP_vector<ubyte>	baked_exact;
+	float	baked_start = 0.0f;
+	float	baked_end = 0.0f;
+	float	baked_inv_step = 0.0f;
+
 public :
 	// constructor
 	Curve(SCP_string in_name);
 
-	//Get
+	//Get, from the baked lookup table if there is one
 	float GetValue(float x_val) const;
 
+	//Get, always evaluating the keyframes
+	float GetValueExact(float x_val) const;
+
 	// Get
 	float GetValueIntegrated(float x_val) const;
 
 	//Set
 	void ParseData();
+
+	// Samples the curve into a lookup table which GetValue() then interpolates linearly instead of evaluating the keyframes.
+	// The resolution is raised until the table is within max_error of the keyframes everywhere, up to a fixed maximum.
+	// Intervals that are still off by more than that (steps, infinite slopes) are evaluated from the keyframes.
+	// Returns false, leaving the curve unbaked, if that would be the case for most of the curve.
+	bool Bake(float max_error);
+	void ClearBake();
+	bool IsBaked() const { return !baked_values.empty(); }
 };
 
 extern SCP_vector<Curve> Curves;
@@ -52,3 +72,6 @@ extern int curve_get_by_name(const SCP_string& in_name);
 extern int curve_parse(const char* err_msg);
 extern void curves_init();
 
+// Bakes every curve that can be baked within max_error, see Curve::Bake(). Call once all tables that define curves are parsed.
+extern void curves_bake(float max_error);
+
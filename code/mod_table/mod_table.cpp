@@ -189,6 +189,7 @@ float Min_radius_for_persistent_debris;
 bool Zero_radius_explosions_skip_fireballs;
 bool Render_insignias_as_decals;
 bool Link_special_point_subsystems_to_destroyed_submodels;
+float Curve_bake_max_error;
 
 
 #ifdef WITH_DISCORD
@@ -1681,6 +1682,15 @@ void parse_mod_table(const char *filename)
 				stuff_boolean(&Link_special_point_subsystems_to_destroyed_submodels);
 			}
 
+			if (optional_string("$Baked curve maximum error:")) {
+				stuff_float(&Curve_bake_max_error);
+				if (Curve_bake_max_error <= 0.0f) {
+					mprintf(("Game Settings Table: Curves will not be baked into lookup tables\n"));
+				} else {
+					mprintf(("Game Settings Table: Baked curves may deviate from their keyframes by up to %f\n", Curve_bake_max_error));
+				}
+			}
+
 			// end of options ----------------------------------------
 
 			// if we've been through once already and are at the same place, force a move
@@ -1962,6 +1972,7 @@ void mod_table_reset()
 	Zero_radius_explosions_skip_fireballs = false;
 	Render_insignias_as_decals = false;
 	Link_special_point_subsystems_to_destroyed_submodels = false;
+	Curve_bake_max_error = 0.0f;
 }
 
 void mod_table_set_version_flags()
@@ -442,6 +442,7 @@ namespace animation {
 
 		submodel->canonical_prev_orient = submodel->canonical_orient;
 		submodel->canonical_orient = data.orientation;
+		submodel->transform_version++;
 
 		matrix delta;
 		vm_copy_transpose(&delta, &submodel->canonical_prev_orient);
@@ -455,6 +456,7 @@ namespace animation {
 
 		submodel->canonical_prev_offset = submodel->canonical_offset;
 		submodel->canonical_offset = data.position;
+		submodel->transform_version++;
 		
 		vec3d delta_vec;
 		vm_vec_sub(&delta_vec, &submodel->canonical_offset, &submodel->canonical_prev_offset);
@@ -472,6 +474,7 @@ namespace animation {
 			return;
 
 		submodel->canonical_prev_orient = submodel->canonical_orient;
+		submodel->transform_version++;
 		submodel->current_turn_rate = 0.0f;
 	}
 
@@ -502,6 +505,7 @@ namespace animation {
 		if (isInitialType) {
 			submodel.first->canonical_prev_orient = submodel.first->canonical_orient;
 			submodel.first->canonical_prev_offset = submodel.first->canonical_offset;
+			submodel.first->transform_version++;
 		}
 
 		return true;
@@ -620,6 +624,7 @@ namespace animation {
 
 		submodel->canonical_prev_orient = submodel->canonical_orient;
 		submodel->canonical_orient = data.orientation;
+		submodel->transform_version++;
 
 		submodel->rotation_axis = sm->rotation_axis;
 
@@ -633,6 +638,7 @@ namespace animation {
 
 		submodel->canonical_prev_offset = submodel->canonical_offset;
 		submodel->canonical_offset = data.position;
+		submodel->transform_version++;
 
 		submodel->translation_axis = sm->translation_axis;
 
@@ -15,6 +15,8 @@
 #include "globalincs/globals.h" // for NAME_LENGTH
 #include "globalincs/pstypes.h"
 #include <array>
+#include <atomic>
+#include <mutex>
 #include <utility>
  
 #include "actions/Program.h"
@@ -22,6 +24,7 @@
 #include "graphics/2d.h"
 #include "io/timer.h"
 #include "model/model_flags.h"
+#include "model/modelcollidebvh.h"
 #include "object/object.h"
 #include "ship/ship_flags.h"
 #include "particle/particle.h"
@@ -146,6 +149,8 @@ struct submodel_instance
 	// similarly for translation
 	vec3d	canonical_offset = vmd_zero_vector;
 	vec3d	canonical_prev_offset = vmd_zero_vector;
+	// Must be bumped whenever any of the canonical fields change, so that the cached transforms of this submodel and its children are recomputed
+	uint	transform_version = 0;
 
 	SCP_vector<model_electrical_arc> electrical_arcs;
 
@@ -200,6 +205,22 @@ public:
 };
 
 // Data specific to a particular instance of a model.
+// The transform of a submodel into the frame of reference of the whole model, i.e. of all its parents combined:
+// a point in the model's frame of reference is vm_vec_unrotate(point, orient) + offset
+struct submodel_transform
+{
+	matrix	orient = vmd_identity_matrix;
+	vec3d	offset = vmd_zero_vector;
+	matrix	prev_orient = vmd_identity_matrix;	// the same, from the canonical_prev fields
+	vec3d	prev_offset = vmd_zero_vector;
+};
+
+struct submodel_transform_cache_entry
+{
+	std::atomic<uint> version{UINT_MAX};	// sum of the transform_versions of the submodels making up the transform
+	submodel_transform transform;
+};
+
 struct polymodel_instance
 {
 	int id = -1;							// global model_instance num index
@@ -209,6 +230,11 @@ struct polymodel_instance
 	std::shared_ptr<model_texture_replace> texture_replace = nullptr;
 
 	int objnum;								// id of the object using this pmi, or -1 if no object (e.g. skybox) 
+
+	// Mirrors the submodel array.  Filled in when a transform is first needed after the submodel or one of its parents
+	// moved, so it may be filled by several threads at once.  Null if the transforms are never cached.
+	mutable std::unique_ptr<submodel_transform_cache_entry[]> transform_cache;
+	mutable std::mutex transform_cache_mutex;
 };
 
 #define MAX_MODEL_SUBSYSTEMS		200				// used in ships.cpp (only place?) for local stack variable DTP; bumped to 200
@@ -412,11 +438,14 @@ struct bsp_collision_leaf {
 	ubyte tmap_num;
 
 	int next;
+
+	// a bit for the texture of this polygon and of every polygon before it in the same BSP leaf
+	uint64_t list_tmaps;
 };
 
 struct bsp_collision_tree {
-	bsp_collision_node *node_list;
-	int n_nodes;
+	// over the leaves, which are checked by model_collide() instead of walking the nodes of the BSP
+	collision_bvh bvh;
 
 	bsp_collision_leaf *leaf_list;
 	int n_leaves;
@@ -1201,6 +1230,16 @@ extern void model_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, int mo
 // If objorient and objpos are supplied, this will be world space; otherwise it will be the model's space.
 extern void model_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, const polymodel *pm, int submodel_num, const matrix *objorient = nullptr, const vec3d *objpos = nullptr);
 
+// Gets the transform of a submodel into the model's frame of reference, taking into account submodel rotations.  The
+// transform is cached in the instance until the submodel or one of its parents moves.
+extern void model_instance_get_submodel_transform(matrix *orient, vec3d *offset, const polymodel *pm, const polymodel_instance *pmi, int submodel_num, bool use_last_frame = false);
+
+// Allocates the transform cache of an instance with n_submodels submodels
+extern void model_instance_init_transform_cache(polymodel_instance *pmi, int n_submodels);
+
+// Has all instances of a model recompute the transforms involving a submodel, e.g. after its offset changed
+extern void model_invalidate_instance_transforms(int model_num, int submodel_num);
+
 // Given a point in a submodel's local frame of reference, transform it to a global frame of reference, taking into account submodel rotations.
 // If objorient and objpos are supplied, this will be world space; otherwise it will be the model's space.
 extern void model_instance_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, int model_instance_num, int submodel_num, const matrix *objorient = nullptr, const vec3d *objpos = nullptr, bool use_last_frame = false);
@@ -1421,8 +1460,34 @@ typedef struct mc_info {
 */
 
 int model_collide(mc_info *mc_info_obj);
+
+// A ray (or moving sphere) of model_collide_batch()
+struct mc_ray {
+	vec3d p0;
+	vec3d p1;
+};
+
+/*
+   Checks many rays against the same model at once, which is a lot faster than
+   calling model_collide() for each of them.  The submodels are only set up
+   once, and the rays go through the polygons of every submodel in packets.
+
+   mc_info_obj is filled in as for model_collide(), except for p0 and p1.
+   It is not changed, not even its collision_checked.
+   results gets one mc_info per ray with the same inputs, p0 and p1 pointing
+   into rays, and the return values of model_collide() for that ray.  The hit
+   lists of MC_COLLIDE_ALL are cleared first.  rays must stay around as long
+   as results is used.
+
+   Returns the number of rays that hit anything.
+*/
+int model_collide_batch(mc_info *mc_info_obj, const SCP_vector<mc_ray> &rays, SCP_vector<mc_info> &results);
+
 void model_collide_parse_bsp(bsp_collision_tree *tree, ubyte *bsp_data, int version);
 
+// Fills in list_tmaps of leaves whose next links are already set up, and which come in the order of their lists
+void model_collide_init_leaf_tmaps(bsp_collision_leaf *leaves, int n_leaves);
+
 bsp_collision_tree *model_get_bsp_collision_tree(int tree_index);
 void model_remove_bsp_collision_tree(int tree_index);
 int model_create_bsp_collision_tree();
@@ -48,6 +48,12 @@ thread_local static vec3d		Mc_direction;	// A vector from the ray's origin to it
 
 thread_local static vec3d 		**Mc_point_list = nullptr;		// A pointer to the current submodel's vertex list
 
+// While model_collide_batch() runs, Mc is Mc_batch_info, except while a face is checked for one of the rays
+thread_local static mc_info		Mc_batch_info;		// A copy of the inputs model_collide_batch() was passed, so that the caller's mc_info is left alone
+thread_local static mc_info		*Mc_batch_results;	// The results of every ray of the batch
+thread_local static SCP_vector<vec3d>	Mc_batch_p0;			// Mc_p0 of every ray
+thread_local static SCP_vector<vec3d>	Mc_batch_direction;	// Mc_direction of every ray
+
 
 
 void model_collide_free_point_list()
@@ -108,6 +114,17 @@ int mc_ray_boundingbox( vec3d *min, vec3d *max, vec3d * p0, vec3d *pdir, vec3d *
 
 
 
+// Whether a hit at dist is closer than the best hit of Mc so far.  Hits at the same distance go to the polygon that comes
+// first in the leaf list of the submodel, so that the hit doesn't depend on the order the polygons are checked in.
+static bool mc_closer_hit(float dist, const bsp_collision_leaf *bsp_leaf)
+{
+	if ( !Mc->num_hits || (dist < Mc->hit_dist) ) {
+		return true;
+	}
+
+	return (dist == Mc->hit_dist) && bsp_leaf && Mc->bsp_leaf && (Mc->hit_submodel == Mc_submodel) && (bsp_leaf < Mc->bsp_leaf);
+}
+
 // ----- 
 // mc_check_face
 // nv -- number of vertices
@@ -139,7 +156,7 @@ static void mc_check_face(int nv, vec3d **verts, vec3d *plane_pnt, vec3d *plane_
 	if ( !(Mc->flags & MC_CHECK_RAY) && (dist > 1.0f) ) return; // The ray isn't long enough to intersect the plane
 
 	// If the ray hits, but a closer intersection has already been found, return
-	if (!(Mc->flags & MC_COLLIDE_ALL) && Mc->num_hits && (dist >= Mc->hit_dist ) ) return;
+	if (!(Mc->flags & MC_COLLIDE_ALL) && !mc_closer_hit(dist, bsp_leaf) ) return;
 
 	// Find the hit point
 	vm_vec_scale_add( &hit_point, &Mc_p0, &Mc_direction, dist );
@@ -228,7 +245,7 @@ static void mc_check_sphereline_face( int nv, vec3d ** verts, vec3d * plane_pnt,
 	}
 
 	// If the ray hits, but a closer intersection has already been found, don't check face
-	if (!(Mc->flags & MC_COLLIDE_ALL) && Mc->num_hits && (face_t >= Mc->hit_dist ) ) {
+	if (!(Mc->flags & MC_COLLIDE_ALL) && !mc_closer_hit(face_t, bsp_leaf) ) {
 		check_face = 0;		// The ray isn't long enough to intersect the plane
 	}
 
@@ -319,7 +336,7 @@ static void mc_check_sphereline_face( int nv, vec3d ** verts, vec3d * plane_pnt,
 //			Assert( vm_vec_dot( &temp_dir, &Mc_direction ) > 0 );
 			*/
 
-			if ((Mc->flags & MC_COLLIDE_ALL) || (Mc->num_hits==0) || (sphere_time < Mc->hit_dist) ) {
+			if ((Mc->flags & MC_COLLIDE_ALL) || mc_closer_hit(sphere_time, bsp_leaf) ) {
 				// This is closer than best so far
 				Mc->hit_dist = sphere_time;
 				Mc->hit_point = hit_point;
@@ -346,6 +363,8 @@ static void mc_check_sphereline_face( int nv, vec3d ** verts, vec3d * plane_pnt,
 					Mc->f_poly = poly;
 				}
 
+				Mc->bsp_leaf = bsp_leaf;
+
 				Mc->num_hits++;
 
 			//	nprintf(("Physics", "edge sphere time: %f, normal: (%f, %f, %f) hit_point: (%f, %f, %f)\n", sphere_time,
@@ -381,81 +400,124 @@ int model_collide_parse_bsp_defpoints(ubyte * p)
 	return nverts;
 }
 
-void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
+// How far along the ray polygons still have to be checked.  Only the closest hit is kept, so whatever is behind it can
+// be skipped.  Hits are measured along the same ray in every submodel, so this also works with hits from submodels
+// checked before the current one.
+static float mc_bvh_max_t(float max_t)
+{
+	if ( !(Mc->flags & MC_COLLIDE_ALL) && Mc->num_hits > 0 ) {
+		return std::min(max_t, Mc->hit_dist);
+	}
+
+	return max_t;
+}
+
+static void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
 {
 	int i;
-	int tested_leaf = leaf_index;
 	uv_pair uvlist[TMAP_MAX_VERTS];
 	vec3d *points[TMAP_MAX_VERTS];
 
-	while ( tested_leaf >= 0 ) {
-		bsp_collision_leaf *leaf = &tree->leaf_list[tested_leaf];
+	bsp_collision_leaf *leaf = &tree->leaf_list[leaf_index];
 
-		bool flat_poly = false;
-		int vert_start = leaf->vert_start;
-		int nv = leaf->num_verts;
+	bool flat_poly = leaf->tmap_num >= MAX_MODEL_TEXTURES;
+	int vert_start = leaf->vert_start;
+	int nv = leaf->num_verts;
 
-		if ( leaf->tmap_num < MAX_MODEL_TEXTURES ) {
-			if ( (!(Mc->flags & MC_CHECK_INVISIBLE_FACES)) && (Mc_pm->maps[leaf->tmap_num].textures[TM_BASE_TYPE].GetTexture() < 0) )	{
-				// Don't check invisible polygons.
-				//SUSHI: Unless $collide_invisible is set.
-				if (!(Mc_pm->submodel[Mc_submodel].flags[Model::Submodel_flags::Collide_invisible]))
+	if ( leaf->list_tmaps && !(Mc->flags & MC_CHECK_INVISIBLE_FACES) ) {
+		// Don't check invisible polygons, nor the polygons after them in the same BSP leaf, which the BSP walk never
+		// got to either.
+		//SUSHI: Unless $collide_invisible is set.
+		if (!(Mc_pm->submodel[Mc_submodel].flags[Model::Submodel_flags::Collide_invisible])) {
+			uint64_t tmaps = leaf->list_tmaps;
+			for ( i = 0; tmaps; ++i, tmaps >>= 1 ) {
+				if ( (tmaps & 1) && (Mc_pm->maps[i].textures[TM_BASE_TYPE].GetTexture() < 0) )
 					return;
 			}
-		} else {
-			flat_poly = true;
 		}
+	}
 
-		int vert_num;
-		for ( i = 0; i < nv; ++i ) {
-			vert_num = tree->vert_list[vert_start+i].vertnum;
-			points[i] = &tree->point_list[vert_num];
+	int vert_num;
+	for ( i = 0; i < nv; ++i ) {
+		vert_num = tree->vert_list[vert_start+i].vertnum;
+		points[i] = &tree->point_list[vert_num];
 
-			uvlist[i].u = tree->vert_list[vert_start+i].u;
-			uvlist[i].v = tree->vert_list[vert_start+i].v;
-		}
+		uvlist[i].u = tree->vert_list[vert_start+i].u;
+		uvlist[i].v = tree->vert_list[vert_start+i].v;
+	}
 
-		if ( flat_poly ) {
-			if ( Mc->flags & MC_CHECK_SPHERELINE ) {
-				mc_check_sphereline_face(nv, points, points[0], &leaf->plane_norm, nullptr, -1, nullptr, leaf);
-			} else {
-				mc_check_face(nv, points, points[0], &leaf->plane_norm, nullptr, -1, nullptr, leaf);
-			}
+	if ( flat_poly ) {
+		if ( Mc->flags & MC_CHECK_SPHERELINE ) {
+			mc_check_sphereline_face(nv, points, points[0], &leaf->plane_norm, nullptr, -1, nullptr, leaf);
 		} else {
-			if ( Mc->flags & MC_CHECK_SPHERELINE ) {
-				mc_check_sphereline_face(nv, points, points[0], &leaf->plane_norm, uvlist, leaf->tmap_num, nullptr, leaf);
-			} else {
-				mc_check_face(nv, points, points[0], &leaf->plane_norm, uvlist, leaf->tmap_num, nullptr, leaf);
-			}
+			mc_check_face(nv, points, points[0], &leaf->plane_norm, nullptr, -1, nullptr, leaf);
 		}
+	} else {
+		if ( Mc->flags & MC_CHECK_SPHERELINE ) {
+			mc_check_sphereline_face(nv, points, points[0], &leaf->plane_norm, uvlist, leaf->tmap_num, nullptr, leaf);
+		} else {
+			mc_check_face(nv, points, points[0], &leaf->plane_norm, uvlist, leaf->tmap_num, nullptr, leaf);
+		}
+	}
+}
 
-		tested_leaf = leaf->next;
+// Checks the polygons of a submodel whose bounding boxes the ray or sphere passes through
+static void model_collide_bsp(bsp_collision_tree *tree)
+{
+	if ( tree->bvh.empty() || tree->n_verts <= 0 ) {
+		return;
 	}
+
+	// Mc_direction goes all the way to the end of the ray, so the end is at 1
+	const float max_t = (Mc->flags & MC_CHECK_RAY) ? FLT_MAX : 1.0f;
+	const float radius = (Mc->flags & MC_CHECK_SPHERELINE) ? Mc->radius : 0.0f;
+
+	tree->bvh.traverse(Mc_p0, Mc_direction, radius, mc_bvh_max_t(max_t), [tree, max_t](int leaf_index) {
+		model_collide_bsp_poly(tree, leaf_index);
+		return mc_bvh_max_t(max_t);
+	});
 }
 
-void model_collide_bsp(bsp_collision_tree *tree, int node_index)
+// Same as model_collide_bsp() for the rays of a batch that pass through the bounding box of the submodel
+static void model_collide_bsp_batch(bsp_collision_tree *tree, const SCP_vector<int> &rays)
 {
-	if ( tree->node_list == NULL || tree->n_verts <= 0) {
+	if ( tree->bvh.empty() || tree->n_verts <= 0 ) {
 		return;
 	}
 
-	bsp_collision_node *node = &tree->node_list[node_index];
-	vec3d hitpos;
+	const float max_t = (Mc->flags & MC_CHECK_RAY) ? FLT_MAX : 1.0f;
+	const float radius = (Mc->flags & MC_CHECK_SPHERELINE) ? Mc->radius : 0.0f;
 
-	// check the bounding box of this node. if it passes, check left and right children
-	if ( mc_ray_boundingbox( &node->min, &node->max, &Mc_p0, &Mc_direction, &hitpos ) ) {
-		if ( !(Mc->flags & MC_CHECK_RAY) && (vm_vec_dist(&hitpos, &Mc_p0) > Mc_mag) ) {
-			// The ray isn't long enough to intersect the bounding box
-			return;
-		}
+	mc_info *batch = Mc;
 
-		if ( node->leaf >= 0 ) {
-			model_collide_bsp_poly(tree, node->leaf);
-		} else {
-			if ( node->back >= 0 ) model_collide_bsp(tree, node->back);
-			if ( node->front >= 0 ) model_collide_bsp(tree, node->front);
+	vec3d p0[collision_bvh::PACKET_SIZE];
+	vec3d direction[collision_bvh::PACKET_SIZE];
+	float packet_max_t[collision_bvh::PACKET_SIZE];
+
+	for ( size_t first = 0; first < rays.size(); first += collision_bvh::PACKET_SIZE ) {
+		int count = static_cast<int>(std::min(rays.size() - first, static_cast<size_t>(collision_bvh::PACKET_SIZE)));
+
+		for ( int i = 0; i < count; ++i ) {
+			int ray = rays[first + i];
+			p0[i] = Mc_batch_p0[ray];
+			direction[i] = Mc_batch_direction[ray];
+
+			Mc = &Mc_batch_results[ray];
+			packet_max_t[i] = mc_bvh_max_t(max_t);
 		}
+
+		tree->bvh.traverse_packet(p0, direction, count, radius, packet_max_t, [&](int i, int leaf_index) {
+			// the face checks work on the globals, so point them at this ray
+			Mc = &Mc_batch_results[rays[first + i]];
+			Mc_p0 = p0[i];
+			Mc_direction = direction[i];
+
+			model_collide_bsp_poly(tree, leaf_index);
+			return mc_bvh_max_t(max_t);
+		});
 	}
+
+	Mc = batch;
 }
 
 void model_collide_parse_bsp_tmappoly(bsp_collision_leaf *leaf, SCP_vector<model_tmap_vert> *vert_buffer, void *model_ptr)
@@ -598,8 +660,7 @@ void model_collide_parse_bsp(bsp_collision_tree *tree, ubyte *bsp_data, int vers
 		tree->point_list = NULL;
 		tree->n_verts = 0;
 
-		tree->n_nodes = 0;
-		tree->node_list = NULL;
+		tree->bvh.clear();
 
 		tree->n_leaves = 0;
 		tree->leaf_list = NULL;
@@ -809,12 +870,34 @@ void model_collide_parse_bsp(bsp_collision_tree *tree, ubyte *bsp_data, int vers
 
 	tree->n_verts = n_verts;
 
-	// copy node info. this might be a good time to organize the nodes into a cache efficient tree layout.
-	tree->n_nodes = (int)node_buffer.size();
-	tree->node_list = (bsp_collision_node*)vm_malloc(sizeof(bsp_collision_node) * node_buffer.size());
-	memcpy(tree->node_list, &node_buffer[0], sizeof(bsp_collision_node) * node_buffer.size());
+	// the nodes are only needed to find the polygons
 	node_buffer.clear();
 
+	// Check collisions against a BVH over the polygons instead, which doesn't depend on how well the BSP is balanced.
+	// The boxes are grown a little so that rounding can't make a ray along the edge of a polygon miss its box.
+	SCP_vector<collision_bvh::bounds> poly_bounds(leaf_buffer.size());
+	for ( i = 0; i < leaf_buffer.size(); ++i ) {
+		auto &box = poly_bounds[i];
+		box.min = box.max = *Mc_point_list[vert_buffer[leaf_buffer[i].vert_start].vertnum];
+
+		for ( int j = 1; j < leaf_buffer[i].num_verts; ++j ) {
+			const vec3d *pnt = Mc_point_list[vert_buffer[leaf_buffer[i].vert_start + j].vertnum];
+			vm_vec_min(&box.min, &box.min, pnt);
+			vm_vec_max(&box.max, &box.max, pnt);
+		}
+
+		vec3d pad;
+		vm_vec_sub(&pad, &box.max, &box.min);
+		float pad_size = MAX(vm_vec_mag(&pad) * 1e-4f, 1e-4f);
+		pad = vm_vec_new(pad_size, pad_size, pad_size);
+		vm_vec_sub2(&box.min, &pad);
+		vm_vec_add2(&box.max, &pad);
+	}
+
+	tree->bvh.build(poly_bounds);
+
+	model_collide_init_leaf_tmaps(leaf_buffer.data(), (int)leaf_buffer.size());
+
 	// copy leaves.
 	tree->n_leaves = (int)leaf_buffer.size();
 	tree->leaf_list = (bsp_collision_leaf*)vm_malloc(sizeof(bsp_collision_leaf) * leaf_buffer.size());
@@ -827,6 +910,20 @@ void model_collide_parse_bsp(bsp_collision_tree *tree, ubyte *bsp_data, int vers
 	vert_buffer.clear();
 }
 
+void model_collide_init_leaf_tmaps(bsp_collision_leaf *leaves, int n_leaves)
+{
+	static_assert(MAX_MODEL_TEXTURES <= 64, "list_tmaps needs a bit for every texture of a model");
+
+	for ( int i = 0; i < n_leaves; ++i ) {
+		// a leaf continues the list of the one before it if that one links to it
+		leaves[i].list_tmaps = (i > 0 && leaves[i - 1].next == i) ? leaves[i - 1].list_tmaps : 0;
+
+		if ( leaves[i].tmap_num < MAX_MODEL_TEXTURES ) {
+			leaves[i].list_tmaps |= uint64_t(1) << leaves[i].tmap_num;
+		}
+	}
+}
+
 bool mc_shield_check_common(shield_tri	*tri)
 {
 	vec3d * points[3];
@@ -1061,9 +1158,9 @@ void mc_check_subobj( int mn )
 					}
 				}
 
-				model_collide_bsp(model_get_bsp_collision_tree(lod_sm->collision_tree_index), 0);
+				model_collide_bsp(model_get_bsp_collision_tree(lod_sm->collision_tree_index));
 			} else {
-				model_collide_bsp(model_get_bsp_collision_tree(sm->collision_tree_index), 0);
+				model_collide_bsp(model_get_bsp_collision_tree(sm->collision_tree_index));
 			}
 		}
 	}
@@ -1117,32 +1214,143 @@ NoHit:
 
 }
 
-MONITOR(NumFVI)
-
-// See model.h for usage.   I don't want to put the
-// usage here because you need to see the #defines and structures
-// this uses while reading the help.   
-int model_collide(mc_info *mc_info_obj)
+// Same as mc_check_subobj() for the rays of a batch.  The transforms of the submodels are set up once for all of them.
+static void mc_check_subobj_batch( int mn, const SCP_vector<int> &rays )
 {
-	Mc = mc_info_obj;
+	vec3d tempv;
+	bsp_info * sm;
+	int i;
 
-	MONITOR_INC(NumFVI,1);
+	Assert( mn >= 0 );
+	Assert( mn < Mc_pm->n_models );
+	if ( (mn < 0) || (mn>=Mc_pm->n_models) ) return;
+
+	sm = &Mc_pm->submodel[mn];
+	if (sm->flags[Model::Submodel_flags::No_collisions]) return; // don't do collisions
+
+	SCP_vector<int> child_rays;
+	bool check_this = !sm->flags[Model::Submodel_flags::Nocollide_this_only];
+
+	if (check_this && (Mc->flags & MC_RESPECT_DETAIL_BOX_SPHERE)) {
+		vec3d local;
+		vm_vec_sub(&local, &Eye_position, Mc->pos);
+		vm_vec_rotate(&local, &local, Mc->orient);
+		if (!model_render_check_detail_box(&local, Mc_pm, mn, MR_NORMAL))
+			check_this = false; //This submodel is a detail box that is not displayed, skip it
+	}
+
+	if (check_this) {
+		Mc_submodel = mn;
+
+		SCP_vector<int> box_rays;
+		for (int ray : rays) {
+			auto &p0 = Mc_batch_p0[ray];
+			auto &direction = Mc_batch_direction[ray];
+			vec3d p1;
+
+			vm_vec_sub(&tempv, Mc_batch_results[ray].p0, &Mc_base);
+			vm_vec_rotate(&p0, &tempv, &Mc_orient);
+
+			vm_vec_sub(&tempv, Mc_batch_results[ray].p1, &Mc_base);
+			vm_vec_rotate(&p1, &tempv, &Mc_orient);
+			vm_vec_sub(&direction, &p1, &p0);
+
+			// bail early if no ray exists
+			if ( IS_VEC_NULL(&direction) ) {
+				continue;
+			}
+
+			// Quickly bail if we aren't inside the full model bbox
+			if ( (Mc_pm->detail[0] == mn) && !mc_ray_boundingbox(&Mc_pm->mins, &Mc_pm->maxs, &p0, &direction, nullptr) ) {
+				continue;
+			}
+
+			child_rays.push_back(ray);
+
+			// Check if the ray intersects this subobject's bounding box
+			if ( mc_ray_boundingbox(&sm->min, &sm->max, &p0, &direction, nullptr) ) {
+				box_rays.push_back(ray);
+			}
+		}
+
+		if ( !box_rays.empty() ) {
+			bsp_info* lod_sm = sm;
+
+			if (Mc->lod > 0 && sm->num_details > 0) {
+				for (i = Mc->lod - 1; i >= 0; i--) {
+					if (sm->details[i] != -1) {
+						lod_sm = &Mc_pm->submodel[sm->details[i]];
+						break;
+					}
+				}
+			}
+
+			model_collide_bsp_batch(model_get_bsp_collision_tree(lod_sm->collision_tree_index), box_rays);
+		}
+	} else {
+		child_rays = rays;
+	}
+
+	// If we're only checking one submodel, return
+	if (Mc->flags & MC_SUBMODEL)	{
+		return;
+	}
+
+	// If this subobject doesn't have any children, or no ray is left, we're done checking it.
+	if ( sm->num_children < 1 || child_rays.empty() ) return;
+
+	// Save instance (Mc_orient, Mc_base, Mc_point_base)
+	matrix saved_orient = Mc_orient;
+	vec3d saved_base = Mc_base;
+
+	// Check all of this subobject's children
+	i = sm->first_child;
+	while ( i >= 0 )	{
+		auto csm = &Mc_pm->submodel[i];
+		matrix instance_orient = vmd_identity_matrix;
+		vec3d instance_offset = csm->offset;
+		bool blown_off = false;
+		bool collision_checked = false;
+
+		if ( Mc_pmi ) {
+			auto csmi = &Mc_pmi->submodel[i];
+			instance_orient = csmi->canonical_orient;
+			vm_vec_add2(&instance_offset, &csmi->canonical_offset);
+
+			blown_off = csmi->blown_off;
+			collision_checked = !Mc->collision_checked.empty() && Mc->collision_checked[i];
+		}
 
+		// Don't check it or its children if it is destroyed
+		// or if it's set to no collision
+		if ( !blown_off && !collision_checked && !csm->flags[Model::Submodel_flags::No_collisions] )	{
+			vm_vec_unrotate(&Mc_base, &instance_offset, &saved_orient);
+			vm_vec_add2(&Mc_base, &saved_base);
+
+			vm_matrix_x_matrix(&Mc_orient, &saved_orient, &instance_orient);
+
+			mc_check_subobj_batch( i, child_rays );
+		}
+
+		i = csm->next_sibling;
+	}
+}
+
+// Clears the return values of Mc
+static void mc_reset_hits()
+{
 	Mc->num_hits = 0;				// How many collisions were found
 	Mc->shield_hit_tri = -1;	// Assume we won't hit any shield polygons
 	Mc->hit_bitmap = -1;
 	Mc->edge_hit = false;
+}
 
-	if ( (Mc->flags & MC_CHECK_SHIELD) && (Mc->flags & MC_CHECK_MODEL) )	{
-		Error( LOCATION, "Checking both shield and model!\n" );
-		return 0;
-	}
-
-	//Fill in some global variables that all the model collide routines need internally.
+// Fills in the globals that all the model collide routines need internally from Mc
+static void mc_setup_globals()
+{
 	Mc_pm = model_get(Mc->model_num);
 	Mc_orient = *Mc->orient;
 	Mc_base = *Mc->pos;
-	Mc_mag = vm_vec_dist( Mc->p0, Mc->p1 );
 
 	if ( Mc->model_instance_num >= 0 ) {
 		Mc_pmi = model_get_instance(Mc->model_instance_num);
@@ -1154,63 +1362,112 @@ int model_collide(mc_info *mc_info_obj)
 		Assertion(Mc->collision_checked.empty(), "model_collide was called with a dirty mc_info state! Please report to the SCP.");
 		Mc->collision_checked.resize(Mc_pm->n_models, 0);
 	}
+}
 
-	// DA 11/19/98 - disable this check for rotating submodels
-	// Don't do check if for very small movement
-//	if (Mc_mag < 0.01f) {
-//		return 0;
-//	}
-
-	float model_radius;		// How big is the model we're checking against
-	int first_submodel;		// Which submodel gets returned as hit if MC_ONLY_SPHERE specified
-
+// Which submodel is checked first, and the radius of everything that gets checked
+static int mc_first_submodel(float *model_radius)
+{
 	if ( (Mc->flags & MC_SUBMODEL) || (Mc->flags & MC_SUBMODEL_INSTANCE) )	{
-		first_submodel = Mc->submodel_num;
-		model_radius = Mc_pm->submodel[first_submodel].rad;
+		*model_radius = Mc_pm->submodel[Mc->submodel_num].rad;
+		return Mc->submodel_num;
 	} else {
-		first_submodel = Mc_pm->detail[0];
-		model_radius = Mc_pm->rad;
+		*model_radius = Mc_pm->rad;
+		return Mc_pm->detail[0];
 	}
+}
 
+// Does a quick check of the ray of Mc against the bounding sphere, returns non-zero if it hits
+static int mc_check_bounding_sphere(float model_radius)
+{
 	if ( Mc->flags & MC_CHECK_SPHERELINE ) {
-		if ( Mc->radius <= 0.0f ) {
-			Warning(LOCATION, "Attempting to collide with a sphere, but the sphere's radius is <= 0.0f!\n\n(model file is %s; submodel is %d, mc_flags are %d)", Mc_pm->filename, first_submodel, Mc->flags);
-			return 0;
-		}
-
-		// Do a quick check on the Bounding Sphere
-		if (fvi_segment_sphere(&Mc->hit_point_world, Mc->p0, Mc->p1, Mc->pos, model_radius+Mc->radius) )	{
-			if ( Mc->flags & MC_ONLY_SPHERE )	{
-				Mc->hit_point = Mc->hit_point_world;
-				Mc->hit_submodel = first_submodel;
-				Mc->num_hits++;
-				return (Mc->num_hits > 0);
-			}
-			// continue checking polygons.
-		} else {
-			return 0;
-		}
+		return fvi_segment_sphere(&Mc->hit_point_world, Mc->p0, Mc->p1, Mc->pos, model_radius+Mc->radius);
+	} else if ( Mc->flags & MC_CHECK_RAY ) {
+		return fvi_ray_sphere(&Mc->hit_point_world, Mc->p0, Mc->p1, Mc->pos, model_radius);
 	} else {
-		int r;
+		return fvi_segment_sphere(&Mc->hit_point_world, Mc->p0, Mc->p1, Mc->pos, model_radius);
+	}
+}
 
-		// Do a quick check on the Bounding Sphere
-		if ( Mc->flags & MC_CHECK_RAY ) {
-			r = fvi_ray_sphere(&Mc->hit_point_world, Mc->p0, Mc->p1, Mc->pos, model_radius);
+// Rotates the hits of Mc into world coordinates
+static void mc_hits_to_world()
+{
+	if ( Mc->flags & MC_SUBMODEL )	{
+		// If we're just checking one submodel, don't use normal instancing to find world points
+		vm_vec_unrotate(&Mc->hit_point_world, &Mc->hit_point, Mc->orient);
+		vm_vec_add2(&Mc->hit_point_world, Mc->pos);
+	} else {
+		if ( Mc_pmi ) {
+			model_instance_local_to_global_point(&Mc->hit_point_world, &Mc->hit_point, Mc_pm, Mc_pmi, Mc->hit_submodel, Mc->orient, Mc->pos);
 		} else {
-			r = fvi_segment_sphere(&Mc->hit_point_world, Mc->p0, Mc->p1, Mc->pos, model_radius);
+			model_local_to_global_point(&Mc->hit_point_world, &Mc->hit_point, Mc_pm, Mc->hit_submodel, Mc->orient, Mc->pos);
 		}
-		if (r) {
-			if ( Mc->flags & MC_ONLY_SPHERE ) {
-				Mc->hit_point = Mc->hit_point_world;
-				Mc->hit_submodel = first_submodel;
-				Mc->num_hits++;
-				return (Mc->num_hits > 0);
+	}
+
+	// do the same for the list of hitpoints, if necessary
+	if (Mc->flags & MC_COLLIDE_ALL) {
+		for (size_t i = 0; i < Mc->hit_points_all.size(); i++) {
+			if (Mc->flags & MC_SUBMODEL) {
+				vm_vec_unrotate(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc->orient);
+				vm_vec_add2(&Mc->hit_points_all[i], Mc->pos);
+			} else {
+				if (Mc_pmi) {
+					model_instance_local_to_global_point(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc_pm, Mc_pmi, Mc->hit_submodels_all[i], Mc->orient, Mc->pos);
+				}
+				else {
+					model_local_to_global_point(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc_pm, Mc->hit_submodels_all[i], Mc->orient, Mc->pos);
+				}
 			}
-			// continue checking polygons.
-		} else {
-			return 0;
 		}
+	}
+}
+
+MONITOR(NumFVI)
+
+// See model.h for usage.   I don't want to put the
+// usage here because you need to see the #defines and structures
+// this uses while reading the help.   
+int model_collide(mc_info *mc_info_obj)
+{
+	Mc = mc_info_obj;
 
+	MONITOR_INC(NumFVI,1);
+
+	mc_reset_hits();
+
+	if ( (Mc->flags & MC_CHECK_SHIELD) && (Mc->flags & MC_CHECK_MODEL) )	{
+		Error( LOCATION, "Checking both shield and model!\n" );
+		return 0;
+	}
+
+	//Fill in some global variables that all the model collide routines need internally.
+	mc_setup_globals();
+	Mc_mag = vm_vec_dist( Mc->p0, Mc->p1 );
+
+	// DA 11/19/98 - disable this check for rotating submodels
+	// Don't do check if for very small movement
+//	if (Mc_mag < 0.01f) {
+//		return 0;
+//	}
+
+	float model_radius;		// How big is the model we're checking against
+	int first_submodel = mc_first_submodel(&model_radius);		// Which submodel gets returned as hit if MC_ONLY_SPHERE specified
+
+	if ( (Mc->flags & MC_CHECK_SPHERELINE) && (Mc->radius <= 0.0f) ) {
+		Warning(LOCATION, "Attempting to collide with a sphere, but the sphere's radius is <= 0.0f!\n\n(model file is %s; submodel is %d, mc_flags are %d)", Mc_pm->filename, first_submodel, Mc->flags);
+		return 0;
+	}
+
+	// Do a quick check on the Bounding Sphere
+	if ( mc_check_bounding_sphere(model_radius) ) {
+		if ( Mc->flags & MC_ONLY_SPHERE )	{
+			Mc->hit_point = Mc->hit_point_world;
+			Mc->hit_submodel = first_submodel;
+			Mc->num_hits++;
+			return (Mc->num_hits > 0);
+		}
+		// continue checking polygons.
+	} else {
+		return 0;
 	}
 
 	// Check only one subobject; or check submodel and any children
@@ -1233,36 +1490,113 @@ int model_collide(mc_info *mc_info_obj)
 
 	//If we found a hit, then rotate it into world coordinates	
 	if ( Mc->num_hits )	{
-		if ( Mc->flags & MC_SUBMODEL )	{
-			// If we're just checking one submodel, don't use normal instancing to find world points
-			vm_vec_unrotate(&Mc->hit_point_world, &Mc->hit_point, Mc->orient);
-			vm_vec_add2(&Mc->hit_point_world, Mc->pos);
-		} else {
-			if ( Mc_pmi ) {
-				model_instance_local_to_global_point(&Mc->hit_point_world, &Mc->hit_point, Mc_pm, Mc_pmi, Mc->hit_submodel, Mc->orient, Mc->pos);
-			} else {
-				model_local_to_global_point(&Mc->hit_point_world, &Mc->hit_point, Mc_pm, Mc->hit_submodel, Mc->orient, Mc->pos);
+		mc_hits_to_world();
+	}
+
+	return Mc->num_hits;
+}
+
+// See model.h for usage.
+int model_collide_batch(mc_info *mc_info_obj, const SCP_vector<mc_ray> &rays, SCP_vector<mc_info> &results)
+{
+	results.resize(rays.size());
+
+	for (size_t i = 0; i < rays.size(); ++i) {
+		auto &mc = results[i];
+
+		mc.model_instance_num = mc_info_obj->model_instance_num;
+		mc.model_num = mc_info_obj->model_num;
+		mc.submodel_num = mc_info_obj->submodel_num;
+		mc.orient = mc_info_obj->orient;
+		mc.pos = mc_info_obj->pos;
+		mc.p0 = &rays[i].p0;
+		mc.p1 = &rays[i].p1;
+		mc.flags = mc_info_obj->flags;
+		mc.radius = mc_info_obj->radius;
+		mc.lod = mc_info_obj->lod;
+
+		mc.hit_points_all.clear();
+		mc.hit_submodels_all.clear();
+	}
+
+	// The shield and the quick checks don't go through the polygons, so there is nothing to gain from checking the
+	// rays together
+	if ( !(mc_info_obj->flags & MC_CHECK_MODEL) || (mc_info_obj->flags & (MC_CHECK_SHIELD | MC_ONLY_SPHERE | MC_ONLY_BOUND_BOX)) ) {
+		int num_rays_hit = 0;
+		for (auto &mc : results) {
+			mc.collision_checked = mc_info_obj->collision_checked;
+			if ( model_collide(&mc) ) {
+				++num_rays_hit;
 			}
 		}
-		
-		// do the same for the list of hitpoints, if necessary
-		if (Mc->flags & MC_COLLIDE_ALL) {
-			for (size_t i = 0; i < Mc->hit_points_all.size(); i++) {
-				if (Mc->flags & MC_SUBMODEL) {
-					vm_vec_unrotate(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc->orient);
-					vm_vec_add2(&Mc->hit_points_all[i], Mc->pos);
-				} else {
-					if (Mc_pmi) {
-						model_instance_local_to_global_point(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc_pm, Mc_pmi, Mc->hit_submodels_all[i], Mc->orient, Mc->pos);
-					}
-					else {
-						model_local_to_global_point(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc_pm, Mc->hit_submodels_all[i], Mc->orient, Mc->pos);
-					}
-				}
-			}
+
+		return num_rays_hit;
+	}
+
+	// Work on a copy, so that setting up the globals doesn't resize the caller's collision_checked
+	Mc_batch_info.model_instance_num = mc_info_obj->model_instance_num;
+	Mc_batch_info.model_num = mc_info_obj->model_num;
+	Mc_batch_info.submodel_num = mc_info_obj->submodel_num;
+	Mc_batch_info.orient = mc_info_obj->orient;
+	Mc_batch_info.pos = mc_info_obj->pos;
+	Mc_batch_info.p0 = mc_info_obj->p0;
+	Mc_batch_info.p1 = mc_info_obj->p1;
+	Mc_batch_info.flags = mc_info_obj->flags;
+	Mc_batch_info.radius = mc_info_obj->radius;
+	Mc_batch_info.lod = mc_info_obj->lod;
+	Mc_batch_info.collision_checked.assign(mc_info_obj->collision_checked.begin(), mc_info_obj->collision_checked.end());
+
+	Mc = &Mc_batch_info;
+
+	MONITOR_INC(NumFVI, static_cast<int>(rays.size()));
+
+	mc_setup_globals();
+
+	float model_radius;
+	int first_submodel = mc_first_submodel(&model_radius);
+
+	if ( (Mc->flags & MC_CHECK_SPHERELINE) && (Mc->radius <= 0.0f) ) {
+		Warning(LOCATION, "Attempting to collide with a sphere, but the sphere's radius is <= 0.0f!\n\n(model file is %s; submodel is %d, mc_flags are %d)", Mc_pm->filename, first_submodel, Mc->flags);
+		return 0;
+	}
+
+	// Do a quick check on the Bounding Sphere
+	SCP_vector<int> active_rays;
+	for (size_t i = 0; i < results.size(); ++i) {
+		Mc = &results[i];
+		mc_reset_hits();
+
+		if ( mc_check_bounding_sphere(model_radius) ) {
+			active_rays.push_back(static_cast<int>(i));
 		}
+	}
+
+	Mc = &Mc_batch_info;
 
+	Mc_batch_results = results.data();
+	Mc_batch_p0.resize(rays.size());
+	Mc_batch_direction.resize(rays.size());
+
+	if ( active_rays.empty() ) {
+		// nothing to check
+	} else if ( (Mc->flags & MC_SUBMODEL) || (Mc->flags & MC_SUBMODEL_INSTANCE) ) {
+		mc_check_subobj_batch(Mc->submodel_num, active_rays);
+	} else if ( !Mc_pmi || !Mc_pmi->submodel[Mc_pm->detail[0]].blown_off ) {
+		mc_check_subobj_batch(Mc_pm->detail[0], active_rays);
 	}
 
-	return Mc->num_hits;
+	Mc_batch_results = nullptr;
+
+	int num_rays_hit = 0;
+	for (auto &mc : results) {
+		if ( mc.num_hits ) {
+			Mc = &mc;
+			mc_hits_to_world();
+			++num_rays_hit;
+		}
+	}
+
+	Mc = mc_info_obj;
+
+	return num_rays_hit;
 }
@@ -0,0 +1,235 @@
+#include "model/modelcollidebvh.h"
+
+#include <numeric>
+
+namespace {
+// Centers of the primitives are sorted into this many bins along each axis to find the best split
+constexpr int NUM_BINS = 12;
+// Leaves with more primitives are only made if the tree gets too deep or the primitives can't be told apart
+constexpr int MAX_LEAF_PRIMS = 4;
+// Cost of testing the boxes of a node, relative to checking a primitive
+constexpr float NODE_COST = 1.0f;
+
+collision_bvh::bounds empty_bounds()
+{
+	return {vm_vec_new(FLT_MAX, FLT_MAX, FLT_MAX), vm_vec_new(-FLT_MAX, -FLT_MAX, -FLT_MAX)};
+}
+
+void grow(collision_bvh::bounds& b, const collision_bvh::bounds& other)
+{
+	for (int i = 0; i < 3; ++i) {
+		b.min.a1d[i] = std::min(b.min.a1d[i], other.min.a1d[i]);
+		b.max.a1d[i] = std::max(b.max.a1d[i], other.max.a1d[i]);
+	}
+}
+
+void grow(collision_bvh::bounds& b, const vec3d& point)
+{
+	for (int i = 0; i < 3; ++i) {
+		b.min.a1d[i] = std::min(b.min.a1d[i], point.a1d[i]);
+		b.max.a1d[i] = std::max(b.max.a1d[i], point.a1d[i]);
+	}
+}
+
+float half_area(const collision_bvh::bounds& b)
+{
+	vec3d size;
+	vm_vec_sub(&size, &b.max, &b.min);
+	if (size.xyz.x < 0.0f)
+		return 0.0f;
+
+	return size.xyz.x * size.xyz.y + size.xyz.y * size.xyz.z + size.xyz.z * size.xyz.x;
+}
+}
+
+void collision_bvh::clear()
+{
+	_nodes.clear();
+	_prim_order.clear();
+}
+
+void collision_bvh::build(const SCP_vector<bounds>& prims)
+{
+	clear();
+
+	if (prims.empty())
+		return;
+
+	SCP_vector<vec3d> centers(prims.size());
+	for (size_t i = 0; i < prims.size(); ++i)
+		vm_vec_avg(&centers[i], &prims[i].min, &prims[i].max);
+
+	_prim_order.resize(prims.size());
+	std::iota(_prim_order.begin(), _prim_order.end(), 0);
+
+	SCP_vector<build_node> build_nodes;
+	build_nodes.reserve(prims.size() * 2);
+	int root = build_binary(build_nodes, prims, centers, 0, static_cast<int>(prims.size()), 0);
+
+	_nodes.reserve(build_nodes.size() / (WIDTH - 1) + 1);
+	collapse(build_nodes, root);
+}
+
+int collision_bvh::build_binary(SCP_vector<build_node>& build_nodes, const SCP_vector<bounds>& prims, const SCP_vector<vec3d>& centers, int first, int count, int depth)
+{
+	auto box = empty_bounds();
+	auto center_box = empty_bounds();
+	for (int p = first; p < first + count; ++p) {
+		grow(box, prims[_prim_order[p]]);
+		grow(center_box, centers[_prim_order[p]]);
+	}
+
+	const int index = static_cast<int>(build_nodes.size());
+	build_nodes.push_back({box, -1, -1, first, count});
+
+	if (count <= 1 || depth >= MAX_DEPTH)
+		return index;
+
+	// binned surface area heuristic, costs are scaled by the half area of box
+	float best_cost = FLT_MAX;
+	int best_axis = -1;
+	int best_bin = 0;
+
+	auto bin_of = [&center_box](const vec3d& center, int axis) {
+		float extent = center_box.max.a1d[axis] - center_box.min.a1d[axis];
+		int bin = static_cast<int>((center.a1d[axis] - center_box.min.a1d[axis]) * (NUM_BINS / extent));
+		return std::min(std::max(bin, 0), NUM_BINS - 1);
+	};
+
+	for (int axis = 0; axis < 3; ++axis) {
+		if (center_box.max.a1d[axis] - center_box.min.a1d[axis] <= 0.0f)
+			continue;
+
+		bounds bin_box[NUM_BINS];
+		int bin_count[NUM_BINS] = {};
+		for (auto& b : bin_box)
+			b = empty_bounds();
+
+		for (int p = first; p < first + count; ++p) {
+			int bin = bin_of(centers[_prim_order[p]], axis);
+			grow(bin_box[bin], prims[_prim_order[p]]);
+			bin_count[bin]++;
+		}
+
+		// cost of everything right of each split, then sweep from the left
+		float right_cost[NUM_BINS];
+		auto right_box = empty_bounds();
+		int right_count = 0;
+		for (int bin = NUM_BINS - 1; bin > 0; --bin) {
+			grow(right_box, bin_box[bin]);
+			right_count += bin_count[bin];
+			right_cost[bin] = right_count > 0 ? half_area(right_box) * right_count : -1.0f;
+		}
+
+		auto left_box = empty_bounds();
+		int left_count = 0;
+		for (int bin = 0; bin < NUM_BINS - 1; ++bin) {
+			grow(left_box, bin_box[bin]);
+			left_count += bin_count[bin];
+
+			if (left_count == 0 || right_cost[bin + 1] < 0.0f)
+				continue;
+
+			float cost = half_area(left_box) * left_count + right_cost[bin + 1];
+			if (cost < best_cost) {
+				best_cost = cost;
+				best_axis = axis;
+				best_bin = bin;
+			}
+		}
+	}
+
+	int mid;
+	if (best_axis < 0) {
+		// all centers are in the same spot, so just halve the primitives
+		if (count <= MAX_LEAF_PRIMS)
+			return index;
+
+		mid = first + count / 2;
+	} else {
+		float leaf_cost = half_area(box) * count;
+		if (count <= MAX_LEAF_PRIMS && leaf_cost <= NODE_COST * half_area(box) + best_cost)
+			return index;
+
+		auto split = std::partition(_prim_order.begin() + first, _prim_order.begin() + first + count,
+			[&](int prim) { return bin_of(centers[prim], best_axis) <= best_bin; });
+		mid = static_cast<int>(split - _prim_order.begin());
+	}
+
+	int left = build_binary(build_nodes, prims, centers, first, mid - first, depth + 1);
+	int right = build_binary(build_nodes, prims, centers, mid, first + count - mid, depth + 1);
+
+	build_nodes[index].left = left;
+	build_nodes[index].right = right;
+
+	return index;
+}
+
+int collision_bvh::collapse(const SCP_vector<build_node>& build_nodes, int index)
+{
+	// pull up grandchildren by opening the inner child with the largest area until all lanes are used
+	int children[WIDTH];
+	int num_children = 0;
+
+	if (build_nodes[index].left < 0) {
+		// the whole tree is a single leaf
+		children[num_children++] = index;
+	} else {
+		children[num_children++] = build_nodes[index].left;
+		children[num_children++] = build_nodes[index].right;
+
+		while (num_children < WIDTH) {
+			int best = -1;
+			float best_area = -1.0f;
+			for (int i = 0; i < num_children; ++i) {
+				const auto& child = build_nodes[children[i]];
+				if (child.left >= 0 && half_area(child.box) > best_area) {
+					best = i;
+					best_area = half_area(child.box);
+				}
+			}
+
+			if (best < 0)
+				break;
+
+			const auto& opened = build_nodes[children[best]];
+			children[best] = opened.left;
+			children[num_children++] = opened.right;
+		}
+	}
+
+	const int node_index = static_cast<int>(_nodes.size());
+	_nodes.emplace_back();
+
+	for (int i = 0; i < WIDTH; ++i) {
+		auto& n = _nodes[node_index];
+		n.child[i] = -1;
+		n.first[i] = 0;
+		n.count[i] = 0;
+
+		if (i >= num_children) {
+			n.min_x[i] = n.min_y[i] = n.min_z[i] = 0.0f;
+			n.max_x[i] = n.max_y[i] = n.max_z[i] = 0.0f;
+			continue;
+		}
+
+		const auto& child = build_nodes[children[i]];
+		n.min_x[i] = child.box.min.xyz.x;
+		n.min_y[i] = child.box.min.xyz.y;
+		n.min_z[i] = child.box.min.xyz.z;
+		n.max_x[i] = child.box.max.xyz.x;
+		n.max_y[i] = child.box.max.xyz.y;
+		n.max_z[i] = child.box.max.xyz.z;
+
+		if (child.left < 0) {
+			n.first[i] = child.first;
+			n.count[i] = child.count;
+		} else {
+			// _nodes may grow here, so don't hold on to n
+			int child_index = collapse(build_nodes, children[i]);
+			_nodes[node_index].child[i] = child_index;
+		}
+	}
+
+	return node_index;
+}
@@ -0,0 +1,289 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "math/vecmat.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief 4-wide bounding volume hierarchy over the polygons of a submodel, used by model_collide() to find the
+ * polygons a ray or swept sphere may hit
+ *
+ * The BSP trees that come with POFs are often badly balanced, so a BVH is built over the bounding boxes of the
+ * polygons when the model is loaded.  Splits are picked with the surface area heuristic, and the resulting binary tree
+ * is collapsed so that every node has up to four children.  The bounds of the children are stored per axis, so the
+ * four boxes of a node are tested together in one go.
+ *
+ * Traversal is iterative and visits the children nearest to the start of the ray first, which lets closest hit
+ * queries skip anything behind the best hit found so far.
+ */
+class collision_bvh
+{
+  public:
+	struct bounds {
+		vec3d min;
+		vec3d max;
+	};
+
+	collision_bvh() = default;
+
+	// Replaces the hierarchy with one over prims.  Traversal reports primitives by their index in prims.
+	void build(const SCP_vector<bounds>& prims);
+
+	void clear();
+
+	bool empty() const { return _nodes.empty(); }
+
+	size_t num_nodes() const { return _nodes.size(); }
+
+	// Calls func(prim) for every primitive whose box, grown by radius, the segment p0 + t * dir with 0 <= t <= max_t
+	// passes through.  func returns the max_t to use from then on, which may only ever get smaller.  Primitives in the
+	// same leaf are visited together, so func may also be called for primitives near ones that do pass.
+	template <typename Func>
+	void traverse(const vec3d& p0, const vec3d& dir, float radius, float max_t, Func&& func) const;
+
+	static constexpr int PACKET_SIZE = 64;
+
+	// Same as traverse() for a packet of up to PACKET_SIZE segments, which go down the tree together.  max_t holds the
+	// max_t of every segment.  Calls func(segment, prim) for the index of the segment in the packet, and stores what
+	// it returns in max_t[segment].  Children are visited in the order the packet enters them on average.
+	template <typename Func>
+	void traverse_packet(const vec3d* p0, const vec3d* dir, int count, float radius, float* max_t, Func&& func) const;
+
+  private:
+	static constexpr int WIDTH = 4;
+	// Deeper binary trees are cut off by making larger leaves, which keeps the traversal stack small
+	static constexpr int MAX_DEPTH = 48;
+
+	struct node {
+		float min_x[WIDTH], min_y[WIDTH], min_z[WIDTH];
+		float max_x[WIDTH], max_y[WIDTH], max_z[WIDTH];
+
+		int child[WIDTH];	// index of the child node, -1 for leaves and unused lanes
+		int first[WIDTH];	// index of the first primitive of a leaf in _prim_order
+		int count[WIDTH];	// number of primitives of a leaf, 0 for child nodes and unused lanes
+	};
+
+	struct build_node {
+		bounds box;
+		int left;		// -1 for leaves
+		int right;
+		int first;
+		int count;
+	};
+
+	SCP_vector<node> _nodes;
+	SCP_vector<int> _prim_order;	// primitives ordered by the leaf they are in
+
+	static void inverse_dir(const vec3d& dir, float* inv_dir);
+
+	int build_binary(SCP_vector<build_node>& build_nodes, const SCP_vector<bounds>& prims, const SCP_vector<vec3d>& centers, int first, int count, int depth);
+	int collapse(const SCP_vector<build_node>& build_nodes, int index);
+};
+
+inline void collision_bvh::inverse_dir(const vec3d& dir, float* inv_dir)
+{
+	// a huge factor instead of infinity for axes the ray is parallel to, which keeps 0 * inf from turning into NaN
+	for (int i = 0; i < 3; ++i)
+		inv_dir[i] = dir.a1d[i] != 0.0f ? 1.0f / dir.a1d[i] : (std::signbit(dir.a1d[i]) ? -1e30f : 1e30f);
+}
+
+template <typename Func>
+void collision_bvh::traverse(const vec3d& p0, const vec3d& dir, float radius, float max_t, Func&& func) const
+{
+	if (_nodes.empty())
+		return;
+
+	float inv_dir[3];
+	inverse_dir(dir, inv_dir);
+
+	struct stack_entry {
+		int node;
+		float t;	// where the segment enters the node
+	};
+
+	// every level of the tree pushes at most WIDTH - 1 more entries than it pops
+	stack_entry stack[MAX_DEPTH * (WIDTH - 1) + 1];
+	int stack_size = 0;
+	stack[stack_size++] = {0, 0.0f};
+
+	while (stack_size > 0) {
+		const auto entry = stack[--stack_size];
+		if (entry.t > max_t)
+			continue;
+
+		const auto& n = _nodes[entry.node];
+
+		// the four lanes are kept independent of each other so that the compiler can vectorize them
+		float t_enter[WIDTH];
+		bool hit[WIDTH];
+		for (int i = 0; i < WIDTH; ++i) {
+			float tx0 = (n.min_x[i] - radius - p0.xyz.x) * inv_dir[0];
+			float tx1 = (n.max_x[i] + radius - p0.xyz.x) * inv_dir[0];
+			float ty0 = (n.min_y[i] - radius - p0.xyz.y) * inv_dir[1];
+			float ty1 = (n.max_y[i] + radius - p0.xyz.y) * inv_dir[1];
+			float tz0 = (n.min_z[i] - radius - p0.xyz.z) * inv_dir[2];
+			float tz1 = (n.max_z[i] + radius - p0.xyz.z) * inv_dir[2];
+
+			float t_near = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+			float t_far = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), max_t));
+
+			t_enter[i] = t_near;
+			hit[i] = t_near <= t_far && (n.child[i] >= 0 || n.count[i] > 0);
+		}
+
+		// sort the lanes that were hit, nearest first
+		int order[WIDTH];
+		int num_hit = 0;
+		for (int i = 0; i < WIDTH; ++i) {
+			if (!hit[i])
+				continue;
+
+			int j = num_hit++;
+			for (; j > 0 && t_enter[order[j - 1]] > t_enter[i]; --j)
+				order[j] = order[j - 1];
+			order[j] = i;
+		}
+
+		// leaves are checked right away, child nodes are pushed so that the nearest is popped first
+		for (int k = 0; k < num_hit; ++k) {
+			int i = order[k];
+			if (n.child[i] >= 0 || t_enter[i] > max_t)
+				continue;
+
+			for (int p = n.first[i]; p < n.first[i] + n.count[i]; ++p)
+				max_t = func(_prim_order[p]);
+		}
+
+		for (int k = num_hit - 1; k >= 0; --k) {
+			int i = order[k];
+			if (n.child[i] >= 0)
+				stack[stack_size++] = {n.child[i], t_enter[i]};
+		}
+	}
+}
+
+template <typename Func>
+void collision_bvh::traverse_packet(const vec3d* p0, const vec3d* dir, int count, float radius, float* max_t, Func&& func) const
+{
+	Assertion(count <= PACKET_SIZE, "A packet can't have more than %d segments!", PACKET_SIZE);
+
+	if (_nodes.empty() || count <= 0)
+		return;
+
+	// the segments are stored per axis, so that testing all of them against a box vectorizes
+	float origin[3][PACKET_SIZE];
+	float inv_dir[3][PACKET_SIZE];
+
+	// a box around all segments, which skips boxes none of them come near without testing them one by one
+	vec3d packet_min = p0[0], packet_max = p0[0];
+
+	for (int r = 0; r < count; ++r) {
+		float inv[3];
+		inverse_dir(dir[r], inv);
+
+		for (int k = 0; k < 3; ++k) {
+			origin[k][r] = p0[r].a1d[k];
+			inv_dir[k][r] = inv[k];
+
+			// segments that go on forever just make the box endless
+			float end = dir[r].a1d[k] == 0.0f ? p0[r].a1d[k] : p0[r].a1d[k] + dir[r].a1d[k] * max_t[r];
+			packet_min.a1d[k] = std::min({packet_min.a1d[k], p0[r].a1d[k], end});
+			packet_max.a1d[k] = std::max({packet_max.a1d[k], p0[r].a1d[k], end});
+		}
+	}
+
+	struct stack_entry {
+		int node;
+		uint64_t mask;	// the segments that enter the node
+	};
+
+	stack_entry stack[MAX_DEPTH * (WIDTH - 1) + 1];
+	int stack_size = 0;
+	stack[stack_size++] = {0, count == PACKET_SIZE ? ~uint64_t(0) : (uint64_t(1) << count) - 1};
+
+	float t_enter[WIDTH][PACKET_SIZE];
+	bool hit[PACKET_SIZE];
+
+	while (stack_size > 0) {
+		const auto entry = stack[--stack_size];
+		const auto& n = _nodes[entry.node];
+
+		uint64_t lane_mask[WIDTH];
+		float lane_t[WIDTH];
+		int order[WIDTH];
+		int num_hit = 0;
+
+		for (int i = 0; i < WIDTH; ++i) {
+			lane_mask[i] = 0;
+			lane_t[i] = 0.0f;
+
+			if (n.child[i] < 0 && n.count[i] == 0)
+				continue;
+
+			const float box_min[3] = {n.min_x[i] - radius, n.min_y[i] - radius, n.min_z[i] - radius};
+			const float box_max[3] = {n.max_x[i] + radius, n.max_y[i] + radius, n.max_z[i] + radius};
+
+			if (box_min[0] > packet_max.xyz.x || box_min[1] > packet_max.xyz.y || box_min[2] > packet_max.xyz.z
+				|| box_max[0] < packet_min.xyz.x || box_max[1] < packet_min.xyz.y || box_max[2] < packet_min.xyz.z)
+				continue;
+
+			// every segment is tested, even those that didn't enter the node, as that is cheaper than picking them out
+			auto* t_lane = t_enter[i];
+			for (int r = 0; r < count; ++r) {
+				float tx0 = (box_min[0] - origin[0][r]) * inv_dir[0][r];
+				float tx1 = (box_max[0] - origin[0][r]) * inv_dir[0][r];
+				float ty0 = (box_min[1] - origin[1][r]) * inv_dir[1][r];
+				float ty1 = (box_max[1] - origin[1][r]) * inv_dir[1][r];
+				float tz0 = (box_min[2] - origin[2][r]) * inv_dir[2][r];
+				float tz1 = (box_max[2] - origin[2][r]) * inv_dir[2][r];
+
+				float t_near = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+				float t_far = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), max_t[r]));
+
+				t_lane[r] = t_near;
+				hit[r] = t_near <= t_far;
+			}
+
+			int num_entering = 0;
+			for (int r = 0; r < count; ++r) {
+				if (hit[r] && (entry.mask & (uint64_t(1) << r))) {
+					lane_mask[i] |= uint64_t(1) << r;
+					lane_t[i] += t_lane[r];
+					++num_entering;
+				}
+			}
+
+			if (num_entering == 0)
+				continue;
+
+			lane_t[i] /= num_entering;
+
+			int j = num_hit++;
+			for (; j > 0 && lane_t[order[j - 1]] > lane_t[i]; --j)
+				order[j] = order[j - 1];
+			order[j] = i;
+		}
+
+		// leaves are checked right away, child nodes are pushed so that the nearest is popped first
+		for (int k = 0; k < num_hit; ++k) {
+			int i = order[k];
+			if (n.child[i] >= 0)
+				continue;
+
+			for (int p = n.first[i]; p < n.first[i] + n.count[i]; ++p) {
+				for (int r = 0; r < count; ++r) {
+					if ((lane_mask[i] & (uint64_t(1) << r)) && t_enter[i][r] <= max_t[r])
+						max_t[r] = func(r, _prim_order[p]);
+				}
+			}
+		}
+
+		for (int k = num_hit - 1; k >= 0; --k) {
+			int i = order[k];
+			if (n.child[i] >= 0)
+				stack[stack_size++] = {n.child[i], lane_mask[i]};
+		}
+	}
+}
@@ -131,7 +131,7 @@ void model_set_subsys_path_nums(polymodel *pm, int n_subsystems, model_subsystem
 void model_set_bay_path_nums(polymodel *pm);
 
 uint align_bsp_data(ubyte* bsp_in, ubyte* bsp_out, uint bsp_size);
-uint convert_sldc_to_slc2(ubyte* sldc, ubyte* slc2, uint tree_size);
+uint convert_sldc_to_slc2(const ubyte* sldc, ubyte* slc2, uint tree_size);
 
 
 // Goober5000 - see SUBSYSTEM_X in model.h
@@ -2123,12 +2123,23 @@ modelread_status read_model_file_no_subsys(polymodel * pm, const char* filename,
 					//mprintf(("SLDC data is being converted to SLC2.\n"));
 					pm->sldc_size = cfread_int(fp);
 
-					std::unique_ptr<ubyte[]> sldc_tree(new ubyte[pm->sldc_size]);
+					std::unique_ptr<ubyte[]> sldc_tree;
 					std::unique_ptr<ubyte[]> slc2_tree(new ubyte[pm->sldc_size * 2]);
 
-					cfread(sldc_tree.get(), 1, pm->sldc_size, fp);
+					// convert straight out of the file if it's in memory, the chunk is skipped at the end anyway
+					const ubyte *sldc_data;
+					auto view = cf_get_view(fp);
+					auto pos = static_cast<size_t>(cftell(fp));
+
+					if (view.data != nullptr && pos + static_cast<size_t>(pm->sldc_size) <= view.size) {
+						sldc_data = view.data + pos;
+					} else {
+						sldc_tree.reset(new ubyte[pm->sldc_size]);
+						cfread(sldc_tree.get(), 1, pm->sldc_size, fp);
+						sldc_data = sldc_tree.get();
+					}
 					//mprintf(("SLDC Shield Collision Tree was %d bytes in size\n", pm->sldc_size));
-					pm->sldc_size = convert_sldc_to_slc2(sldc_tree.get(), slc2_tree.get(), pm->sldc_size);
+					pm->sldc_size = convert_sldc_to_slc2(sldc_data, slc2_tree.get(), pm->sldc_size);
 					//mprintf(("SLC2 Shield Collision Tree is %d bytes in size\n", pm->sldc_size));
 					pm->shield_collision_tree = make_shared<ubyte[]>(pm->sldc_size); //sldc_size is slc2 size, reused variable
 					memcpy(pm->shield_collision_tree.get(), slc2_tree.get(), pm->sldc_size);
@@ -3576,6 +3587,7 @@ int model_create_instance(int objnum, int model_num)
 
 	if (pm->n_models > 0) {
 		pmi->submodel = new submodel_instance[pm->n_models];
+		model_instance_init_transform_cache(pmi, pm->n_models);
 
 		// "damaged" submodels (like -destroyed variants, or debris) are blown-off by default
 		for (int i = 0; i < pm->n_models; i++) {
@@ -4043,6 +4055,7 @@ void model_get_rotating_submodel_axis(vec3d *model_axis, vec3d *world_axis, cons
 void submodel_canonicalize_rotation(bsp_info *sm, submodel_instance *smi, bool clamp)
 {
 	smi->canonical_prev_orient = smi->canonical_orient;
+	smi->transform_version++;
 
 	if (clamp)
 	{
@@ -4092,6 +4105,7 @@ void submodel_canonicalize_rotation(bsp_info *sm, submodel_instance *smi, bool c
 void submodel_canonicalize_translation(bsp_info *sm, submodel_instance *smi)
 {
 	smi->canonical_prev_offset = smi->canonical_offset;
+	smi->transform_version++;
 
 	// get the vector
 	switch (sm->translation_axis_id)
@@ -4280,6 +4294,7 @@ void submodel_look_at(polymodel *pm, polymodel_instance *pmi, int submodel_num)
 	// save last angles
 	smi->prev_angle = smi->cur_angle;
 	smi->canonical_prev_orient = smi->canonical_orient;
+	smi->transform_version++;
 
 	//------------
 	// Calculate the destination point in world coordinates
@@ -4451,6 +4466,7 @@ bool model_rotate_gun(const object *objp, const polymodel *pm, const polymodel_i
 		// Pretend the base is pointing directly at the target
 		save_base_orient = base_smi->canonical_orient;
 		vm_quaternion_rotate(&base_smi->canonical_orient, desired_base_angle, &base_sm->rotation_axis);
+		base_smi->transform_version++;
 
 		//------------
 		// Project the destination point onto the turret gun plane with the base in the desired orientation
@@ -4474,6 +4490,7 @@ bool model_rotate_gun(const object *objp, const polymodel *pm, const polymodel_i
 		//------------
 		// Restore the base
 		base_smi->canonical_orient = save_base_orient;
+		base_smi->transform_version++;
 
 	} else {
 		desired_base_angle = base_smi->turret_idle_angle;
@@ -4593,6 +4610,117 @@ void model_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, const polymod
 	}
 }
 
+// Sum of the transform versions of the submodels whose transforms make up the transform of submodel_num.  Versions only
+// ever go up, so the sum changes whenever any of them moves.
+static uint model_instance_transform_version(const polymodel *pm, const polymodel_instance *pmi, int submodel_num)
+{
+	uint version = 0;
+
+	for (int mn = submodel_num; (mn >= 0) && (pm->submodel[mn].parent >= 0); mn = pm->submodel[mn].parent)
+		version += pmi->submodel[mn].transform_version;
+
+	return version;
+}
+
+// Combines the transform of a submodel with the transform of its parent, or none if the parent is the top of the tree
+static void model_instance_combine_transform(submodel_transform *out, const bsp_info *sm, const submodel_instance *smi, const submodel_transform *parent)
+{
+	vec3d offset, prev_offset;
+	vm_vec_add(&offset, &smi->canonical_offset, &sm->offset);
+	vm_vec_add(&prev_offset, &smi->canonical_prev_offset, &sm->offset);
+
+	if (parent == nullptr) {
+		out->orient = smi->canonical_orient;
+		out->offset = offset;
+		out->prev_orient = smi->canonical_prev_orient;
+		out->prev_offset = prev_offset;
+		return;
+	}
+
+	out->orient = smi->canonical_orient * parent->orient;
+	vm_vec_unrotate(&out->offset, &offset, &parent->orient);
+	vm_vec_add2(&out->offset, &parent->offset);
+
+	out->prev_orient = smi->canonical_prev_orient * parent->prev_orient;
+	vm_vec_unrotate(&out->prev_offset, &prev_offset, &parent->prev_orient);
+	vm_vec_add2(&out->prev_offset, &parent->prev_offset);
+}
+
+// Must be called with the transform cache mutex of the instance held
+static const submodel_transform &model_instance_update_transform_cache(const polymodel *pm, const polymodel_instance *pmi, int submodel_num, uint version)
+{
+	auto &entry = pmi->transform_cache[submodel_num];
+	if (entry.version.load(std::memory_order_relaxed) == version)
+		return entry.transform;
+
+	auto sm = &pm->submodel[submodel_num];
+	auto smi = &pmi->submodel[submodel_num];
+
+	const submodel_transform *parent = nullptr;
+	if (pm->submodel[sm->parent].parent >= 0)
+		parent = &model_instance_update_transform_cache(pm, pmi, sm->parent, version - smi->transform_version);
+
+	model_instance_combine_transform(&entry.transform, sm, smi, parent);
+
+	// whoever sees the new version also sees the new transform
+	entry.version.store(version, std::memory_order_release);
+
+	return entry.transform;
+}
+
+void model_invalidate_instance_transforms(int model_num, int submodel_num)
+{
+	for (auto pmi : Polygon_model_instances) {
+		if (pmi && pmi->model_num == model_num)
+			pmi->submodel[submodel_num].transform_version++;
+	}
+}
+
+void model_instance_init_transform_cache(polymodel_instance *pmi, int n_submodels)
+{
+	pmi->transform_cache.reset(n_submodels > 0 ? new submodel_transform_cache_entry[n_submodels] : nullptr);
+}
+
+void model_instance_get_submodel_transform(matrix *orient, vec3d *offset, const polymodel *pm, const polymodel_instance *pmi, int submodel_num, bool use_last_frame)
+{
+	Assert(pm->id == pmi->model_num);
+
+	if ((submodel_num < 0) || (pm->submodel[submodel_num].parent < 0)) {
+		*orient = vmd_identity_matrix;
+		*offset = vmd_zero_vector;
+		return;
+	}
+
+	if (pmi->transform_cache) {
+		uint version = model_instance_transform_version(pm, pmi, submodel_num);
+		auto &entry = pmi->transform_cache[submodel_num];
+
+		if (entry.version.load(std::memory_order_acquire) != version) {
+			std::lock_guard<std::mutex> guard(pmi->transform_cache_mutex);
+			model_instance_update_transform_cache(pm, pmi, submodel_num, version);
+		}
+
+		*orient = use_last_frame ? entry.transform.prev_orient : entry.transform.orient;
+		*offset = use_last_frame ? entry.transform.prev_offset : entry.transform.offset;
+		return;
+	}
+
+	vec3d tpnt;
+	*orient = vmd_identity_matrix;
+	*offset = vmd_zero_vector;
+
+	//instance up the tree for this transform
+	for (int mn = submodel_num; (mn >= 0) && (pm->submodel[mn].parent >= 0); mn = pm->submodel[mn].parent) {
+		auto smi = &pmi->submodel[mn];
+
+		vm_vec_unrotate(&tpnt, offset, use_last_frame ? &smi->canonical_prev_orient : &smi->canonical_orient);
+		vm_vec_add(offset, &tpnt, use_last_frame ? &smi->canonical_prev_offset : &smi->canonical_offset);
+		vm_vec_add2(offset, &pm->submodel[mn].offset);
+
+		*orient = *orient * (use_last_frame ? smi->canonical_prev_orient : smi->canonical_orient);
+	}
+}
+
 void model_instance_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, int model_instance_num, int submodel_num, const matrix *objorient, const vec3d *objpos, bool use_last_frame)
 {
 	auto pmi = model_get_instance(model_instance_num);
@@ -4602,22 +4730,12 @@ void model_instance_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, int
 
 void model_instance_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, const polymodel *pm, const polymodel_instance *pmi, int submodel_num, const matrix *objorient, const vec3d *objpos, bool use_last_frame)
 {
-	vec3d pnt;
-	vec3d tpnt;
-	int mn;
-	Assert(pm->id == pmi->model_num);
-
-	pnt = *mpnt;
-	mn = submodel_num;
-
-	//instance up the tree for this point
-	while ( (mn >= 0) && (pm->submodel[mn].parent >= 0) ) {
-		vm_vec_unrotate(&tpnt, &pnt, use_last_frame ? &pmi->submodel[mn].canonical_prev_orient : &pmi->submodel[mn].canonical_orient);
-		vm_vec_add(&pnt, &tpnt, use_last_frame ? &pmi->submodel[mn].canonical_prev_offset : &pmi->submodel[mn].canonical_offset);
-		vm_vec_add2(&pnt, &pm->submodel[mn].offset);
+	matrix orient;
+	vec3d offset, pnt;
+	model_instance_get_submodel_transform(&orient, &offset, pm, pmi, submodel_num, use_last_frame);
 
-		mn = pm->submodel[mn].parent;
-	}
+	vm_vec_unrotate(&pnt, mpnt, &orient);
+	vm_vec_add2(&pnt, &offset);
 
 	//now instance for the entire object
 	if (objorient && objpos) {
@@ -4630,25 +4748,14 @@ void model_instance_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, cons
 
 void model_instance_local_to_global_point_dir(vec3d *out_pnt, vec3d *out_dir, const vec3d *in_pnt, const vec3d *in_dir, const polymodel *pm, const polymodel_instance *pmi, int submodel_num, const matrix *objorient, const vec3d *objpos)
 {
-	vec3d pnt, tpnt, dir, tdir;
-	int mn;
-	Assert(pm->id == pmi->model_num);
-
-	pnt = *in_pnt;
-	dir = *in_dir;
-	mn = submodel_num;
-
-	// instance up the tree for this point
-	while ( (mn >= 0) && (pm->submodel[mn].parent >= 0) ) {
-		vm_vec_unrotate(&tpnt, &pnt, &pmi->submodel[mn].canonical_orient);
-		vm_vec_add(&pnt, &tpnt, &pmi->submodel[mn].canonical_offset);
-		vm_vec_add2(&pnt, &pm->submodel[mn].offset);
+	matrix orient;
+	vec3d offset, pnt, dir;
+	model_instance_get_submodel_transform(&orient, &offset, pm, pmi, submodel_num);
 
-		vm_vec_unrotate(&tdir, &dir, &pmi->submodel[mn].canonical_orient);
-		dir = tdir;
+	vm_vec_unrotate(&pnt, in_pnt, &orient);
+	vm_vec_add2(&pnt, &offset);
 
-		mn = pm->submodel[mn].parent;
-	}
+	vm_vec_unrotate(&dir, in_dir, &orient);
 
 	// now instance for the entire object
 	if (objorient && objpos) {
@@ -4664,25 +4771,14 @@ void model_instance_local_to_global_point_dir(vec3d *out_pnt, vec3d *out_dir, co
 
 void model_instance_local_to_global_point_orient(vec3d *outpnt, matrix *outorient, const vec3d *submodel_pnt, const matrix *submodel_orient, const polymodel *pm, const polymodel_instance *pmi, int submodel_num, const matrix *objorient, const vec3d *objpos)
 {
-	vec3d pnt, tpnt;
 	matrix orient;
-	int mn;
-	Assert(pm->id == pmi->model_num);
-
-	pnt = *submodel_pnt;
-	orient = *submodel_orient;
-	mn = submodel_num;
-
-	// instance up the tree for this point
-	while ( (mn >= 0) && (pm->submodel[mn].parent >= 0) ) {
-		vm_vec_unrotate(&tpnt, &pnt, &pmi->submodel[mn].canonical_orient);
-		vm_vec_add(&pnt, &tpnt, &pmi->submodel[mn].canonical_offset);
-		vm_vec_add2(&pnt, &pm->submodel[mn].offset);
+	vec3d offset, pnt;
+	model_instance_get_submodel_transform(&orient, &offset, pm, pmi, submodel_num);
 
-		orient = orient * pmi->submodel[mn].canonical_orient;
+	vm_vec_unrotate(&pnt, submodel_pnt, &orient);
+	vm_vec_add2(&pnt, &offset);
 
-		mn = pm->submodel[mn].parent;
-	}
+	orient = *submodel_orient * orient;
 
 	// now instance for the entire object
 	if (objorient && objpos) {
@@ -4703,50 +4799,19 @@ void model_instance_global_to_local_point(vec3d* outpnt, const vec3d* mpnt, int
 }
 
 void model_instance_global_to_local_point(vec3d* outpnt, const vec3d* mpnt, const polymodel* pm, const polymodel_instance* pmi, int submodel_num, const matrix* objorient, const vec3d* objpos, bool use_last_frame) {
-	Assert(pm->id == pmi->model_num);
-
-	constexpr int preallocatedStackDepth = 5;
-	std::tuple<const matrix*, const vec3d*, const vec3d*> preallocatedStack[preallocatedStackDepth];
-
-	auto submodelStack = submodel_num < 0 || pm->submodel[submodel_num].depth <= preallocatedStackDepth ? preallocatedStack : new std::tuple<const matrix*, const vec3d*, const vec3d*>[pm->submodel[submodel_num].depth];
-	int stackCounter = 0;
-
-	int mn = submodel_num;
-
-	//Go up the chain of parents to build a stack of transformations from parent -> child
-	while ((mn >= 0) && (pm->submodel[mn].parent >= 0)) {
-		if(use_last_frame) {
-			std::get<0>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_prev_orient;
-			std::get<1>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_prev_offset;
-		} else {
-			std::get<0>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_orient;
-			std::get<1>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_offset;
-		}
-		std::get<2>(submodelStack[stackCounter++]) = &pm->submodel[mn].offset;
-		mn = pm->submodel[mn].parent;
-	}
+	matrix orient;
+	vec3d offset;
+	model_instance_get_submodel_transform(&orient, &offset, pm, pmi, submodel_num, use_last_frame);
 
-	if (objorient != nullptr && objpos != nullptr) {
-		std::get<0>(submodelStack[stackCounter]) = objorient;
-		std::get<1>(submodelStack[stackCounter]) = &vmd_zero_vector;
-		std::get<2>(submodelStack[stackCounter++]) = objpos;
-	}
-	stackCounter--;
-		
 	vec3d resultPnt = *mpnt;
 
-	while (stackCounter >= 0) {
-		const auto& transform = submodelStack[stackCounter--];
-
-		vm_vec_sub2(&resultPnt, std::get<2>(transform));
-		vm_vec_sub2(&resultPnt, std::get<1>(transform));
-		vm_vec_rotate(&resultPnt, &resultPnt, std::get<0>(transform));
+	if (objorient != nullptr && objpos != nullptr) {
+		vm_vec_sub2(&resultPnt, objpos);
+		vm_vec_rotate(&resultPnt, &resultPnt, objorient);
 	}
 
-	*outpnt = resultPnt;
-
-	if (submodel_num >= 0 && pm->submodel[submodel_num].depth > preallocatedStackDepth)
-		delete[] submodelStack;
+	vm_vec_sub2(&resultPnt, &offset);
+	vm_vec_rotate(outpnt, &resultPnt, &orient);
 }
 
 void model_instance_global_to_local_dir(vec3d* out_dir, const vec3d* in_dir, int model_instance_num, int submodel_num, const matrix* objorient, bool use_submodel_parent, bool use_last_frame) {
@@ -4756,87 +4821,35 @@ void model_instance_global_to_local_dir(vec3d* out_dir, const vec3d* in_dir, int
 }
 
 void model_instance_global_to_local_dir(vec3d* out_dir, const vec3d* in_dir, const polymodel* pm, const polymodel_instance* pmi, int submodel_num, const matrix* objorient, bool use_last_frame) {
-	Assert(pm->id == pmi->model_num);
-
-	constexpr int preallocatedStackDepth = 5;
-	const matrix* preallocatedStack[preallocatedStackDepth];
-
-	auto submodelStack = submodel_num < 0 || pm->submodel[submodel_num].depth <= preallocatedStackDepth ? preallocatedStack : new const matrix*[pm->submodel[submodel_num].depth];
-	int stackCounter = 0;
-
-	int mn = submodel_num;
-
-	//Go up the chain of parents to build a stack of transformations from parent -> child
-	while ((mn >= 0) && (pm->submodel[mn].parent >= 0)) {
-		if (use_last_frame)
-			submodelStack[stackCounter++] = &pmi->submodel[mn].canonical_prev_orient;
-		else
-			submodelStack[stackCounter++] = &pmi->submodel[mn].canonical_orient;
-		mn = pm->submodel[mn].parent;
-	}
-
-	if (objorient != nullptr)
-		submodelStack[stackCounter++] = objorient;
-
-	stackCounter--;
+	matrix orient;
+	vec3d offset;
+	model_instance_get_submodel_transform(&orient, &offset, pm, pmi, submodel_num, use_last_frame);
 
 	vec3d resultDir = *in_dir;
 
-	while (stackCounter >= 0) {
-		const auto& transform = submodelStack[stackCounter--];
-
-		vm_vec_rotate(&resultDir, &resultDir, transform);
-	}
-
-	*out_dir = resultDir;
+	if (objorient != nullptr)
+		vm_vec_rotate(&resultDir, &resultDir, objorient);
 
-	if (submodel_num >= 0 && pm->submodel[submodel_num].depth > preallocatedStackDepth)
-		delete[] submodelStack;
+	vm_vec_rotate(out_dir, &resultDir, &orient);
 }
 
 void model_instance_global_to_local_point_orient(vec3d* outpnt, matrix* outorient, const vec3d* submodel_pnt, const matrix* submodel_orient, const polymodel* pm, const polymodel_instance* pmi, int submodel_num, const matrix* objorient, const vec3d* objpos) {
-	Assert(pm->id == pmi->model_num);
-
-	constexpr int preallocatedStackDepth = 5;
-	std::tuple<const matrix*, const vec3d*, const vec3d*> preallocatedStack[preallocatedStackDepth];
-
-	auto submodelStack = submodel_num < 0 || pm->submodel[submodel_num].depth <= preallocatedStackDepth ? preallocatedStack : new std::tuple<const matrix*, const vec3d*, const vec3d*>[pm->submodel[submodel_num].depth];
-	int stackCounter = 0;
-
-	int mn = submodel_num;
-
-	//Go up the chain of parents to build a stack of transformations from parent -> child
-	while ((mn >= 0) && (pm->submodel[mn].parent >= 0)) {
-		std::get<0>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_orient;
-		std::get<1>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_offset;
-		std::get<2>(submodelStack[stackCounter++]) = &pm->submodel[mn].offset;
-		mn = pm->submodel[mn].parent;
-	}
-
-	if (objorient != nullptr && objpos != nullptr) {
-		std::get<0>(submodelStack[stackCounter]) = objorient;
-		std::get<1>(submodelStack[stackCounter]) = &vmd_zero_vector;
-		std::get<2>(submodelStack[stackCounter++]) = objpos;
-	}
-	stackCounter--;
+	matrix orient;
+	vec3d offset;
+	model_instance_get_submodel_transform(&orient, &offset, pm, pmi, submodel_num);
 
 	vec3d resultPnt = *submodel_pnt;
 	matrix resultMat = *submodel_orient;
 
-	while (stackCounter >= 0) {
-		const auto& transform = submodelStack[stackCounter--];
-
-		vm_vec_sub2(&resultPnt, std::get<2>(transform));
-		vm_vec_sub2(&resultPnt, std::get<1>(transform));
-		vm_vec_rotate(&resultPnt, &resultPnt, std::get<0>(transform));
-		resultMat = *std::get<0>(transform) * resultMat;
+	if (objorient != nullptr && objpos != nullptr) {
+		vm_vec_sub2(&resultPnt, objpos);
+		vm_vec_rotate(&resultPnt, &resultPnt, objorient);
+		resultMat = *objorient * resultMat;
 	}
 
-	*outpnt = resultPnt;
-	*outorient = resultMat;
-
-	if (submodel_num >= 0 && pm->submodel[submodel_num].depth > preallocatedStackDepth)
-		delete[] submodelStack;
+	vm_vec_sub2(&resultPnt, &offset);
+	vm_vec_rotate(outpnt, &resultPnt, &orient);
+	*outorient = orient * resultMat;
 }
 
 /*
@@ -4950,27 +4963,17 @@ void model_instance_local_to_global_dir(vec3d *out_dir, const vec3d *in_dir, int
 
 void model_instance_local_to_global_dir(vec3d *out_dir, const vec3d *in_dir, const polymodel *pm, const polymodel_instance *pmi, int submodel_num, const matrix *objorient)
 {
-	vec3d pnt;
-	vec3d tpnt;
-	int mn;
-	Assert(pm->id == pmi->model_num);
-
-	pnt = *in_dir;
-	mn = submodel_num;
+	matrix orient;
+	vec3d offset, dir;
+	model_instance_get_submodel_transform(&orient, &offset, pm, pmi, submodel_num);
 
-	// instance up the tree for this point
-	while ( (mn >= 0) && (pm->submodel[mn].parent >= 0) ) {
-		vm_vec_unrotate(&tpnt, &pnt, &pmi->submodel[mn].canonical_orient);
-		pnt = tpnt;
-
-		mn = pm->submodel[mn].parent;
-	}
+	vm_vec_unrotate(&dir, in_dir, &orient);
 
 	// now instance for the entire object
 	if (objorient) {
-		vm_vec_unrotate(out_dir, &pnt, objorient);
+		vm_vec_unrotate(out_dir, &dir, objorient);
 	} else {
-		*out_dir = pnt;
+		*out_dir = dir;
 	}
 }
 
@@ -5063,6 +5066,7 @@ void model_replicate_submodel_instance_sub(polymodel *pm, polymodel_instance *pm
 				r_smi->cur_offset = copy_from->cur_offset;
 				r_smi->canonical_offset = copy_from->canonical_offset;
 				r_smi->canonical_prev_offset = copy_from->canonical_prev_offset;
+				r_smi->transform_version++;
 			} else {
 				r_smi->cur_angle = smi->cur_angle;
 				r_smi->canonical_orient = smi->canonical_orient;
@@ -5071,6 +5075,7 @@ void model_replicate_submodel_instance_sub(polymodel *pm, polymodel_instance *pm
 				r_smi->cur_offset = smi->cur_offset;
 				r_smi->canonical_offset = smi->canonical_offset;
 				r_smi->canonical_prev_offset = smi->canonical_prev_offset;
+				r_smi->transform_version++;
 			}
 		}
 	} else {
@@ -5091,6 +5096,7 @@ void model_replicate_submodel_instance_sub(polymodel *pm, polymodel_instance *pm
 		smi->cur_offset = copy_from->cur_offset;
 		smi->canonical_offset = copy_from->canonical_offset;
 		smi->canonical_prev_offset = copy_from->canonical_prev_offset;
+		smi->transform_version++;
 	}
 
 	// For all the detail levels of this submodel, set them also.
@@ -5414,9 +5420,7 @@ void model_remove_bsp_collision_tree(int tree_index)
 {
 	Bsp_collision_tree_list[tree_index].used = false;
 
-	if ( Bsp_collision_tree_list[tree_index].node_list ) {
-		vm_free(Bsp_collision_tree_list[tree_index].node_list);
-	}
+	Bsp_collision_tree_list[tree_index].bvh.clear();
 
 	if ( Bsp_collision_tree_list[tree_index].leaf_list ) {
 		vm_free(Bsp_collision_tree_list[tree_index].leaf_list);
@@ -6133,7 +6137,7 @@ model_subsystem::model_subsystem() {
 	reset();
 }
 
-uint convert_sldc_to_slc2(ubyte* sldc, ubyte* slc2, uint tree_size)
+uint convert_sldc_to_slc2(const ubyte* sldc, ubyte* slc2, uint tree_size)
 {
 	//ShivanSpS SLDC must be converted to SLC2 in order to be used by shield collision system
 	//Convert SLDC to SLC2
@@ -6166,7 +6170,7 @@ uint convert_sldc_to_slc2(ubyte* sldc, ubyte* slc2, uint tree_size)
 		if (node_type_char == 0) {
 			//Front and back offsets must be adjusted
 			uint front, back, newback = 0;
-			ubyte* p;
+			const ubyte* p;
 
 			p = sldc - 29;
 			memcpy(&back, p + 33, 4);
@@ -1,12 +1,18 @@
 #include "volumetrics.h"
 
 #include "bmpman/bmpman.h"
+#include "cfile/cfile.h"
 #include "mission/missionparse.h"
 #include "model/model.h"
 #include "parse/parselo.h"
 #include "render/3d.h"
+#include "tracing/tracing.h"
+#include "utils/threading.h"
 
 #include <anl.h>
+#include <md5.h>
+
+#include <random>
 
 #define OFFSET_R 2
 #define OFFSET_G 1
@@ -400,10 +406,133 @@ static inline float getNebDistSquared(const ivec3& l, const ivec3& r, const vec3
 	return (dx < 0 ? 0 : dx) * scale.xyz.x * scale.xyz.x + (dy < 0 ? 0 : dy) * scale.xyz.y * scale.xyz.y + (dz < 0 ? 0 : dz) * scale.xyz.z * scale.xyz.z;
 }
 
-void volumetric_nebula::renderVolumeBitmap() {
-	Assertion(!hullPof.empty(), "Volumetric Nebula was not properly configured. Did you call parse_volumetric_nebula()?");
-	Assertion(!isVolumeBitmapValid(), "Volume bitmap was already rendered!");
+static constexpr uint VOLUME_CACHE_MAGIC = 0x4e565346; // "FSVN"
+// Increase whenever the file layout or the way the volumes are baked changes
+static constexpr uint VOLUME_CACHE_FORMAT_VERSION = 1;
+
+static const char* const VOLUME_CACHE_PREFIX = "neb-";
+static const char* const VOLUME_CACHE_EXT = "bin";
+
+static constexpr uint32_t VOLUME_CACHE_LOCATION = CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT;
+
+SCP_string volumetric_nebula::getVolumeCacheFilename() const {
+	uint hullChecksum;
+	if (!cf_chksum_long(hullPof.c_str(), &hullChecksum, -1, CF_TYPE_MODELS)) {
+		//Not a plain file, like a virtual POF
+		return "";
+	}
+
+	MD5 md5;
+	auto hashInt = [&md5](int value) {
+		md5.update(reinterpret_cast<const char*>(&value), sizeof(value));
+	};
+	auto hashString = [&md5, &hashInt](const SCP_string& value) {
+		hashInt(static_cast<int>(value.size()));
+		md5.update(value.c_str(), static_cast<MD5::size_type>(value.size()));
+	};
+
+	hashInt(static_cast<int>(VOLUME_CACHE_FORMAT_VERSION));
+	hashString(hullPof);
+	hashInt(static_cast<int>(hullChecksum));
+	hashInt(resolution);
+	hashInt(oversampling);
+	hashInt(getVolumeBitmapSmoothingSteps());
+
+	hashInt(noiseActive ? 1 : 0);
+	if (noiseActive) {
+		hashInt(noiseResolution);
+		for (const auto& func : {noiseColorFunc1, noiseColorFunc2}) {
+			hashInt(func ? 1 : 0);
+			if (func)
+				hashString(*func);
+		}
+	}
+
+	md5.finalize();
+
+	return SCP_string(VOLUME_CACHE_PREFIX) + md5.hexdigest() + "." + VOLUME_CACHE_EXT;
+}
+
+bool volumetric_nebula::loadVolumeCache(const SCP_string& filename) {
+	static bool purged = false;
+	if (!purged) {
+		cf_purge_old_cache_files(VOLUME_CACHE_PREFIX, VOLUME_CACHE_EXT);
+		purged = true;
+	}
+
+	auto fp = cfopen(filename.c_str(), "rb", CF_TYPE_CACHE, false, VOLUME_CACHE_LOCATION);
+	if (!fp) {
+		nprintf(("Volumetrics", "No cached volume for nebula hull %s.\n", hullPof.c_str()));
+		return false;
+	}
 
+	int n = 1 << resolution;
+	int nNoise = noiseActive ? 1 << noiseResolution : 0;
+	int volumeSize = n * n * n * 4;
+	int noiseVolumeSize = nNoise * nNoise * nNoise * 4;
+
+	auto magic = cfread_uint(fp);
+	auto version = cfread_uint(fp);
+	auto cachedN = cfread_int(fp);
+	auto cachedNNoise = cfread_int(fp);
+	vec3d cachedSize;
+	cfread_vector(&cachedSize, fp);
+	auto cachedUdfScale = cfread_float(fp);
+
+	bool valid = magic == VOLUME_CACHE_MAGIC && version == VOLUME_CACHE_FORMAT_VERSION && cachedN == n && cachedNNoise == nNoise
+		&& cfilelength(fp) - cftell(fp) == volumeSize + noiseVolumeSize;
+
+	if (valid) {
+		volumeBitmapData = make_unique<ubyte[]>(volumeSize);
+		valid = cfread(volumeBitmapData.get(), 1, volumeSize, fp) == volumeSize;
+	}
+
+	if (valid && noiseActive) {
+		noiseVolumeBitmapData = make_unique<ubyte[]>(noiseVolumeSize);
+		valid = cfread(noiseVolumeBitmapData.get(), 1, noiseVolumeSize, fp) == noiseVolumeSize;
+	}
+
+	cfclose(fp);
+
+	if (!valid) {
+		volumeBitmapData.reset();
+		noiseVolumeBitmapData.reset();
+		mprintf(("Volume cache file %s is invalid! Baking the volume of nebula hull %s instead...\n", filename.c_str(), hullPof.c_str()));
+		return false;
+	}
+
+	size = cachedSize;
+	udfScale = cachedUdfScale;
+
+	return true;
+}
+
+void volumetric_nebula::storeVolumeCache(const SCP_string& filename) const {
+	auto fp = cfopen(filename.c_str(), "wb", CF_TYPE_CACHE, false, VOLUME_CACHE_LOCATION);
+	if (!fp) {
+		mprintf(("Could not open volume cache file %s!\n", filename.c_str()));
+		return;
+	}
+
+	int n = 1 << resolution;
+	int nNoise = noiseActive ? 1 << noiseResolution : 0;
+
+	cfwrite_uint(VOLUME_CACHE_MAGIC, fp);
+	cfwrite_uint(VOLUME_CACHE_FORMAT_VERSION, fp);
+	cfwrite_int(n, fp);
+	cfwrite_int(nNoise, fp);
+	cfwrite_float(size.xyz.x, fp);
+	cfwrite_float(size.xyz.y, fp);
+	cfwrite_float(size.xyz.z, fp);
+	cfwrite_float(udfScale, fp);
+	cfwrite(volumeBitmapData.get(), 1, n * n * n * 4, fp);
+	if (noiseActive)
+		cfwrite(noiseVolumeBitmapData.get(), 1, nNoise * nNoise * nNoise * 4, fp);
+
+	cfclose(fp);
+}
+
+bool volumetric_nebula::bakeVolumeBitmapData() {
 	int n = 1 << resolution;
 	int nSample = (n << (oversampling - 1)) + 1;
 	auto volumeSampleCache = make_unique<bool[]>(nSample * nSample * nSample);
@@ -411,7 +540,7 @@ void volumetric_nebula::renderVolumeBitmap() {
 	int modelnum = model_load(hullPof.c_str(), nullptr, ErrorType::NONE);
 	if (modelnum < 0) {
 		Warning(LOCATION, "Could not load model '%s'.  Unable to render volume bitmap!", hullPof.c_str());
-		return;
+		return false;
 	}
 
 	const polymodel* pm = model_get(modelnum);
@@ -420,51 +549,63 @@ void volumetric_nebula::renderVolumeBitmap() {
 	size = pm->maxs - pm->mins;
 	size *= scaleFactor;
 
-	bb_min = pos - (size * 0.5f);
-	bb_max = pos + (size * 0.5f);
+	//Calculate minimum "bottom left" corner of scaled size box
+	vec3d bl = pm->mins - (size * ((scaleFactor - 1.0f) / 2.0f / scaleFactor));
 
-	mc_info mc;
+	//Go through sampling procedure to test where the nebula even is. Every row of rays along y is a task of its own, and goes through the model as one batch.
+	threading::parallel_for(0, nSample, 1, [&](size_t row) {
+		int x = static_cast<int>(row);
+		const float step_x = size.xyz.x / static_cast<float>(n << (oversampling - 1));
+		const float step_y = size.xyz.y / static_cast<float>(n << (oversampling - 1));
 
-	mc.model_num = modelnum;
-	mc.orient = &vmd_identity_matrix;
-	mc.pos = &vmd_zero_vector;
-	mc.p1 = &vmd_zero_vector;
+		mc_info mc;
 
-	mc.flags = MC_CHECK_MODEL | MC_COLLIDE_ALL | MC_CHECK_INVISIBLE_FACES;
+		mc.model_num = modelnum;
+		mc.orient = &vmd_identity_matrix;
+		mc.pos = &vmd_zero_vector;
 
-	//Calculate minimum "bottom left" corner of scaled size box
-	vec3d bl = pm->mins - (size * ((scaleFactor - 1.0f) / 2.0f / scaleFactor));
+		mc.flags = MC_CHECK_MODEL | MC_COLLIDE_ALL | MC_CHECK_INVISIBLE_FACES;
+
+		SCP_vector<mc_ray> rays(nSample);
+		for (int y = 0; y < nSample; y++) {
+			rays[y].p0 = bl;
+			rays[y].p0 += vec3d{ {{static_cast<float>(x) * step_x, static_cast<float>(y) * step_y, 0.0f }} };
+			rays[y].p1 = rays[y].p0;
+			rays[y].p1.xyz.z += size.xyz.z;
+		}
+
+		SCP_vector<mc_info> hits;
+		model_collide_batch(&mc, rays, hits);
+
+		//Odd rays are jittered with a generator of the row's own, so the result doesn't depend on how rows are spread over the threads
+		std::minstd_rand jitterGenerator(static_cast<unsigned int>(x + 1));
+		std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+
+		SCP_vector<int> collisionZIndices;
 
-	//Go through sampling procedure to test where the nebula even is
-	for (int x = 0; x < nSample; x++) {
 		for (int y = 0; y < nSample; y++) {
-			vec3d start = bl;
-			start += vec3d{ {{static_cast<float>(x) * size.xyz.x / static_cast<float>(n << (oversampling - 1)),
-							 static_cast<float>(y) * size.xyz.y / static_cast<float>(n << (oversampling - 1)),
-							 0.0f }} };
-			vec3d end = start;
-			end.xyz.z += size.xyz.z;
-
-			mc.p0 = &start;
-			mc.p1 = &end;
-			mc.hit_points_all.clear();
-			mc.hit_submodels_all.clear();
-			model_collide(&mc);
+			auto& hit = hits[y];
 
 			//Annoying hack cause sometimes, if edges of polygons get too close to the ray, the collisions are missed / too many. At least find odd rays and fix those, since these are very visible
-			while (mc.hit_points_all.size() % 2 != 0) {
-				start += vec3d{ {{ size.xyz.x / static_cast<float>(n << (oversampling - 1)) * (Random::INV_F_MAX_VALUE * Random::next() - 0.5f),
-								  size.xyz.y / static_cast<float>(n << (oversampling - 1)) * (Random::INV_F_MAX_VALUE * Random::next() - 0.5f), 0.0f }} };
-				end += vec3d{ {{ size.xyz.x / static_cast<float>(n << (oversampling - 1)) * (Random::INV_F_MAX_VALUE * Random::next() - 0.5f),
-								size.xyz.y / static_cast<float>(n << (oversampling - 1)) * (Random::INV_F_MAX_VALUE * Random::next() - 0.5f), 0.0f }} };
-				mc.hit_points_all.clear();
-				mc.hit_submodels_all.clear();
-				model_collide(&mc);
+			if (hit.hit_points_all.size() % 2 != 0) {
+				vec3d start = rays[y].p0;
+				vec3d end = rays[y].p1;
+				hit.p0 = &start;
+				hit.p1 = &end;
+
+				while (hit.hit_points_all.size() % 2 != 0) {
+					start += vec3d{ {{ step_x * jitter(jitterGenerator), step_y * jitter(jitterGenerator), 0.0f }} };
+					end += vec3d{ {{ step_x * jitter(jitterGenerator), step_y * jitter(jitterGenerator), 0.0f }} };
+					hit.hit_points_all.clear();
+					hit.hit_submodels_all.clear();
+					model_collide(&hit);
+				}
 			}
 
-			SCP_multiset<int> collisionZIndices;
-			for(const vec3d& hitpnt : mc.hit_points_all)
-				collisionZIndices.emplace(static_cast<int>((hitpnt.xyz.z - bl.xyz.z) / size.xyz.z * static_cast<float>(n << (oversampling - 1))));
+			collisionZIndices.clear();
+			for(const vec3d& hitpnt : hit.hit_points_all)
+				collisionZIndices.push_back(static_cast<int>((hitpnt.xyz.z - bl.xyz.z) / size.xyz.z * static_cast<float>(n << (oversampling - 1))));
+			std::sort(collisionZIndices.begin(), collisionZIndices.end());
 
 			size_t hitcnt = 0;
 			auto hitpntit = collisionZIndices.cbegin();
@@ -476,7 +617,7 @@ void volumetric_nebula::renderVolumeBitmap() {
 				volumeSampleCache[x * nSample * nSample + y * nSample + z] = hitcnt % 2 != 0;
 			}
 		}
-	}
+	});
 
 	model_unload(modelnum);
 
@@ -489,7 +630,8 @@ void volumetric_nebula::renderVolumeBitmap() {
 	int smoothStart = smoothing_steps / 2;
 	int smoothStop = (smoothing_steps / 2 + (1 & smoothing_steps));
 
-	for (int x = 0; x < n; x++) {
+	threading::parallel_for(0, n, 1, [&](size_t row) {
+		int x = static_cast<int>(row);
 		for (int y = 0; y < n; y++) {
 			for (int z = 0; z < n; z++) {
 				int sum = 0;
@@ -506,20 +648,20 @@ void volumetric_nebula::renderVolumeBitmap() {
 				volumeBitmapData[COLOR_3D_ARRAY_POS(n, A, x, y, z)] = static_cast<ubyte>(static_cast<float>(sum) * oversamplingDivisor);
 			}
 		}
-	}
+	});
 
 	// Test for edges in the nebula to compute the UDF
 	auto volumeEdgeCache = make_unique<ivec3[]>(n * n * n);
 	SCP_set<ivec3> udfBFS_checking, udfBFS_to_check;
 
-	for (int x = 0; x < n; x++) {
+	threading::parallel_for(0, n, 1, [&](size_t row) {
+		int x = static_cast<int>(row);
 		for (int y = 0; y < n; y++) {
 			for (int z = 0; z < n; z++) {
 				const ubyte& nebula_density = volumeBitmapData[COLOR_3D_ARRAY_POS(n, A, x, y, z)];
 
 				//If we have neither full nor no nebula presence, it's an edge.
 				if (nebula_density > 0 && nebula_density < 255) {
-					udfBFS_to_check.emplace(ivec3{x, y, z});
 					volumeEdgeCache[x * n * n + y * n + z] = ivec3{x, y, z};
 				}
 				else {
@@ -535,15 +677,19 @@ void volumetric_nebula::renderVolumeBitmap() {
 						}
 					}
 
-					if (found_edge) {
-						udfBFS_to_check.emplace(ivec3{x, y, z});
+					if (found_edge)
 						volumeEdgeCache[x * n * n + y * n + z] = ivec3{x, y, z};
-					}
 					else
 						volumeEdgeCache[x * n * n + y * n + z] = ivec3{-1, -1, -1};
 				}
 			}
 		}
+	});
+
+	//The set is ordered, so collecting the edges afterwards starts the BFS off the same as finding them in order
+	for (int i = 0; i < n * n * n; i++) {
+		if (volumeEdgeCache[i].x >= 0)
+			udfBFS_to_check.emplace(volumeEdgeCache[i]);
 	}
 
 	//BFS from the known nebula edges to find the distance to the closest edge
@@ -571,7 +717,8 @@ void volumetric_nebula::renderVolumeBitmap() {
 	//Compute the actual UDF from the BFS
 	//scale is the maximal distance possible.
 	udfScale = vm_vec_mag(&size);
-	for (int x = 0; x < n; x++) {
+	threading::parallel_for(0, n, 1, [&](size_t row) {
+		int x = static_cast<int>(row);
 		for (int y = 0; y < n; y++) {
 			for (int z = 0; z < n; z++) {
 				float dist = sqrtf(getNebDistSquared(ivec3{x, y, z}, volumeEdgeCache[x * n * n + y * n + z], size, true)) / static_cast<float>(n); //in meters
@@ -580,13 +727,12 @@ void volumetric_nebula::renderVolumeBitmap() {
 				volumeBitmapData[COLOR_3D_ARRAY_POS(n, B, x, y, z)] = 0; // Reserved
 			}
 		}
-	}
+	});
 
-	volumeBitmapHandle = bm_create_3d(32, n, n, n, volumeBitmapData.get());
-
-	if (!noiseActive)
-		return;
+	return true;
+}
 
+void volumetric_nebula::bakeNoiseVolumeBitmapData() {
 	int nNoise = 1 << noiseResolution;
 	noiseVolumeBitmapData = make_unique<ubyte[]>(nNoise * nNoise * nNoise * 4);
 
@@ -601,8 +747,26 @@ void volumetric_nebula::renderVolumeBitmap() {
 	anl::CInstructionIndex wispyNoise = noiseColorFunc1 ? getCustomNoise(kernel, *noiseColorFunc1) : getDefaultNoise(kernel, 0);
 	anl::CInstructionIndex wispyNoise2 = noiseColorFunc2 ? getCustomNoise(kernel, *noiseColorFunc2) : getDefaultNoise(kernel, 3);
 
-	anl::map3D(anl::SEAMLESS_XYZ, img, kernel, ranges, wispyNoise);
-	anl::map3D(anl::SEAMLESS_XYZ, img2, kernel, ranges, wispyNoise2);
+	//Same as anl::map3D, but with the slices along z spread over the task pool. Every chunk evaluates its own copy of the kernel.
+	auto mapNoise = [&](anl::CArray3Dd& target, anl::CInstructionIndex index) {
+		threading::parallel_for_ranges(0, nNoise, 1, [&](size_t zBegin, size_t zEnd) {
+			anl::SChunk3D chunk(index);
+			chunk.seamlessmode = anl::SEAMLESS_XYZ;
+			chunk.a = target.getData() + zBegin * nNoise * nNoise;
+			chunk.awidth = nNoise;
+			chunk.aheight = nNoise;
+			chunk.adepth = nNoise;
+			chunk.chunkdepth = static_cast<int>(zEnd - zBegin);
+			chunk.chunkzoffset = static_cast<int>(zBegin);
+			chunk.kernel = kernel;
+			chunk.ranges = ranges;
+
+			anl::map3DChunk(chunk);
+		});
+	};
+
+	mapNoise(img, wispyNoise);
+	mapNoise(img2, wispyNoise2);
 
 	for (int x = 0; x < nNoise; x++) {
 		for (int y = 0; y < nNoise; y++) {
@@ -616,6 +780,36 @@ void volumetric_nebula::renderVolumeBitmap() {
 			}
 		}
 	}
+}
+
+void volumetric_nebula::renderVolumeBitmap() {
+	TRACE_SCOPE(tracing::VolumetricsBake);
+
+	Assertion(!hullPof.empty(), "Volumetric Nebula was not properly configured. Did you call parse_volumetric_nebula()?");
+	Assertion(!isVolumeBitmapValid(), "Volume bitmap was already rendered!");
+
+	SCP_string cacheFilename = getVolumeCacheFilename();
+	if (cacheFilename.empty() || !loadVolumeCache(cacheFilename)) {
+		if (!bakeVolumeBitmapData())
+			return;
+
+		if (noiseActive)
+			bakeNoiseVolumeBitmapData();
+
+		if (!cacheFilename.empty())
+			storeVolumeCache(cacheFilename);
+	}
+
+	bb_min = pos - (size * 0.5f);
+	bb_max = pos + (size * 0.5f);
+
+	int n = 1 << resolution;
+	volumeBitmapHandle = bm_create_3d(32, n, n, n, volumeBitmapData.get());
+
+	if (!noiseActive)
+		return;
+
+	int nNoise = 1 << noiseResolution;
 	noiseVolumeBitmapHandle = bm_create_3d(32, nNoise, nNoise, nNoise, noiseVolumeBitmapData.get());
 }
 
@@ -85,6 +85,15 @@ class volumetric_nebula {
 
 	bool enabled = true;
 
+	//Bakes the volume bitmap data from the hull POF. Returns false if the POF couldn't be loaded.
+	bool bakeVolumeBitmapData();
+	void bakeNoiseVolumeBitmapData();
+
+	//Baked volumes are cached on disk, named after the hull POF's checksum and the settings that go into the bake. Empty if the POF can't be checksummed.
+	SCP_string getVolumeCacheFilename() const;
+	bool loadVolumeCache(const SCP_string& filename);
+	void storeVolumeCache(const SCP_string& filename) const;
+
 	//Friend things that are allowed to directly manipulate "current" volumetrics. Only FRED and the Lab. In all other cases, "sensibly constant" values behave properly RAII and stay constant afterwards.
 	friend class LabUi; //Lab
 	friend class Fred_mission_save; //FRED && QtFRED
@@ -19,16 +19,88 @@
 #include "scripting/api/objs/vecmath.h"
 #include "weapon/weapon.h"
 
+struct debris_weapon_collision_data {
+	vec3d hitpos;
+	vec3d hitnormal;
+	std::optional<mc_info> mc;	// debris only, handed to the weapon once the hit is processed
+};
 
 
-/**
- * Checks debris-weapon collisions.  
- * @param pair obj_pair pointer to the two objects. pair->a is debris and pair->b is weapon.
- * @return 1 if all future collisions between these can be ignored
- */
-int collide_debris_weapon( obj_pair * pair )
+static void debris_weapon_process_collision(obj_pair *pair, const std::any& collision_data)
+{
+	const auto& cd = std::any_cast<const debris_weapon_collision_data&>(collision_data);
+	object *pdebris = pair->a;
+	object *weapon_obj = pair->b;
+	vec3d hitpos = cd.hitpos;
+	vec3d hitnormal = cd.hitnormal;
+
+	// Deferred from debris_check_collision() since it is unsafe to do from worker threads
+	if (cd.mc.has_value()) {
+		weapon *wp = &Weapons[weapon_obj->instance];
+		wp->collisionInfo = new mc_info;	// The weapon will free this memory later
+		*wp->collisionInfo = *cd.mc;
+	}
+
+	bool weapon_override = false, debris_override = false;
+
+	if (scripting::hooks::OnDebrisCollision->isActive()) {
+		weapon_override = scripting::hooks::OnDebrisCollision->isOverride(scripting::hooks::CollisionConditions{ {weapon_obj, pdebris} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_obj),
+				scripting::hook_param("Object", 'o', pdebris),
+				scripting::hook_param("Weapon", 'o', weapon_obj),
+				scripting::hook_param("Debris", 'o', pdebris),
+				scripting::hook_param("Hitpos", 'o', hitpos)));
+	}
+	if (scripting::hooks::OnWeaponCollision->isActive()) {
+		debris_override = scripting::hooks::OnWeaponCollision->isOverride(scripting::hooks::CollisionConditions{ {weapon_obj, pdebris} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pdebris),
+				scripting::hook_param("Object", 'o', weapon_obj),
+				scripting::hook_param("Weapon", 'o', weapon_obj),
+				scripting::hook_param("Debris", 'o', pdebris),
+				scripting::hook_param("Hitpos", 'o', hitpos)));
+	}
+
+	if(!weapon_override && !debris_override)
+	{
+		vec3d force = weapon_obj->phys_info.vel * Weapon_info[Weapons[weapon_obj->instance].weapon_info_index].mass;
+		bool armed = weapon_hit( weapon_obj, pdebris, &hitpos, -1 );
+		float damage = Weapon_info[Weapons[weapon_obj->instance].weapon_info_index].damage;
+		std::array<std::optional<ConditionData>, NumHitTypes> impact_data = {};
+		impact_data[static_cast<std::underlying_type_t<HitType>>(HitType::HULL)] = ConditionData {
+			SpecialImpactCondition::DEBRIS,
+			HitType::HULL,
+			damage,
+			pdebris->hull_strength,
+			Debris[pdebris->instance].max_hull,
+		};
+		maybe_play_conditional_impacts(impact_data, weapon_obj, pdebris, armed, -1, &hitpos, nullptr, &hitnormal);
+		debris_hit( pdebris, weapon_obj, &hitpos, damage , &force);
+	}
+
+	if (scripting::hooks::OnDebrisCollision->isActive() && !(debris_override && !weapon_override))
+	{
+		scripting::hooks::OnDebrisCollision->run(scripting::hooks::CollisionConditions{ {weapon_obj, pdebris} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_obj),
+				scripting::hook_param("Object", 'o', pdebris),
+				scripting::hook_param("Weapon", 'o', weapon_obj),
+				scripting::hook_param("Debris", 'o', pdebris),
+				scripting::hook_param("Hitpos", 'o', hitpos)));
+	}
+
+	if (scripting::hooks::OnWeaponCollision->isActive() && ((debris_override && !weapon_override) || (!debris_override && !weapon_override)))
+	{
+		scripting::hooks::OnWeaponCollision->run(scripting::hooks::CollisionConditions{ {weapon_obj, pdebris} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pdebris),
+				scripting::hook_param("Object", 'o', weapon_obj),
+				scripting::hook_param("Weapon", 'o', weapon_obj),
+				scripting::hook_param("Debris", 'o', pdebris),
+				scripting::hook_param("Hitpos", 'o', hitpos)));
+	}
+}
+
+//returns never_hits, process_data
+collision_result collide_debris_weapon_check( obj_pair * pair )
 {
-	vec3d	hitpos, hitnormal;
 	object *pdebris = pair->a;
 	object *weapon_obj = pair->b;
 
@@ -36,92 +108,112 @@ int collide_debris_weapon( obj_pair * pair )
 	Assert( weapon_obj->type == OBJ_WEAPON );
 
 	if (reject_due_collision_groups(pdebris, weapon_obj))
-		return 0;
+		return {false, std::any(), &debris_weapon_process_collision};
 
 	// first check the bounding spheres of the two objects.
-	int hit = fvi_segment_sphere(&hitpos, &weapon_obj->last_pos, &weapon_obj->pos, &pdebris->pos, pdebris->radius);
+	debris_weapon_collision_data cd;
+	int hit = fvi_segment_sphere(&cd.hitpos, &weapon_obj->last_pos, &weapon_obj->pos, &pdebris->pos, pdebris->radius);
 	if (hit) {
-		hit = debris_check_collision(pdebris, weapon_obj, &hitpos, nullptr, &hitnormal );
+		mc_info mc;
+		hit = debris_check_collision(pdebris, weapon_obj, &cd.hitpos, nullptr, &cd.hitnormal, &mc);
 
 		if ( !hit )
-			return 0;
-
-		bool weapon_override = false, debris_override = false;
-
-		if (scripting::hooks::OnDebrisCollision->isActive()) {
-			weapon_override = scripting::hooks::OnDebrisCollision->isOverride(scripting::hooks::CollisionConditions{ {weapon_obj, pdebris} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_obj),
-					scripting::hook_param("Object", 'o', pdebris),
-					scripting::hook_param("Weapon", 'o', weapon_obj),
-					scripting::hook_param("Debris", 'o', pdebris),
-					scripting::hook_param("Hitpos", 'o', hitpos)));
-		}
-		if (scripting::hooks::OnWeaponCollision->isActive()) {
-			debris_override = scripting::hooks::OnWeaponCollision->isOverride(scripting::hooks::CollisionConditions{ {weapon_obj, pdebris} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pdebris),
-					scripting::hook_param("Object", 'o', weapon_obj),
-					scripting::hook_param("Weapon", 'o', weapon_obj),
-					scripting::hook_param("Debris", 'o', pdebris),
-					scripting::hook_param("Hitpos", 'o', hitpos)));
-		}
-
-		if(!weapon_override && !debris_override)
-		{
-			vec3d force = weapon_obj->phys_info.vel * Weapon_info[Weapons[weapon_obj->instance].weapon_info_index].mass;
-			bool armed = weapon_hit( weapon_obj, pdebris, &hitpos, -1 );
-			float damage = Weapon_info[Weapons[weapon_obj->instance].weapon_info_index].damage;
-			std::array<std::optional<ConditionData>, NumHitTypes> impact_data = {};
-			impact_data[static_cast<std::underlying_type_t<HitType>>(HitType::HULL)] = ConditionData {
-				SpecialImpactCondition::DEBRIS,
-				HitType::HULL,
-				damage,
-				pdebris->hull_strength,
-				Debris[pdebris->instance].max_hull,
-			};
-			maybe_play_conditional_impacts(impact_data, weapon_obj, pdebris, armed, -1, &hitpos, nullptr, &hitnormal);
-			debris_hit( pdebris, weapon_obj, &hitpos, damage , &force);
-		}
-
-		if (scripting::hooks::OnDebrisCollision->isActive() && !(debris_override && !weapon_override))
-		{
-			scripting::hooks::OnDebrisCollision->run(scripting::hooks::CollisionConditions{ {weapon_obj, pdebris} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_obj),
-					scripting::hook_param("Object", 'o', pdebris),
-					scripting::hook_param("Weapon", 'o', weapon_obj),
-					scripting::hook_param("Debris", 'o', pdebris),
-					scripting::hook_param("Hitpos", 'o', hitpos)));
-		}
-
-		if (scripting::hooks::OnWeaponCollision->isActive() && ((debris_override && !weapon_override) || (!debris_override && !weapon_override)))
-		{
-			scripting::hooks::OnWeaponCollision->run(scripting::hooks::CollisionConditions{ {weapon_obj, pdebris} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pdebris),
-					scripting::hook_param("Object", 'o', weapon_obj),
-					scripting::hook_param("Weapon", 'o', weapon_obj),
-					scripting::hook_param("Debris", 'o', pdebris),
-					scripting::hook_param("Hitpos", 'o', hitpos)));
-		}
-
-		return 0;
+			return {false, std::any(), &debris_weapon_process_collision};
 
+		cd.mc = mc;
+		return {false, cd, &debris_weapon_process_collision};
 	} else {
-		return weapon_will_never_hit( weapon_obj, pdebris, pair );
+		return {weapon_will_never_hit( weapon_obj, pdebris, pair ) != 0, std::any(), &debris_weapon_process_collision};
 	}
-}				
-
-
+}
 
 /**
  * Checks debris-weapon collisions.  
  * @param pair obj_pair pointer to the two objects. pair->a is debris and pair->b is weapon.
  * @return 1 if all future collisions between these can be ignored
  */
-int collide_asteroid_weapon( obj_pair * pair )
+int collide_debris_weapon( obj_pair * pair )
+{
+	const auto& [never_check_again, collision_data, process_fnc] = collide_debris_weapon_check(pair);
+
+	if (collision_data.has_value()) {
+		process_fnc(pair, collision_data);
+	}
+
+	return never_check_again ? 1 : 0;
+}
+
+static void asteroid_weapon_process_collision(obj_pair *pair, const std::any& collision_data)
+{
+	const auto& cd = std::any_cast<const debris_weapon_collision_data&>(collision_data);
+	object *pasteroid = pair->a;
+	object *weapon_obj = pair->b;
+	vec3d hitpos = cd.hitpos;
+	vec3d hitnormal = cd.hitnormal;
+
+	bool weapon_override = false, asteroid_override = false;
+
+	if (scripting::hooks::OnAsteroidCollision->isActive()) {
+		weapon_override = scripting::hooks::OnAsteroidCollision->isOverride(scripting::hooks::CollisionConditions{ {weapon_obj, pasteroid} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_obj),
+				scripting::hook_param("Object", 'o', pasteroid),
+				scripting::hook_param("Weapon", 'o', weapon_obj),
+				scripting::hook_param("Asteroid", 'o', pasteroid),
+				scripting::hook_param("Hitpos", 'o', hitpos)));
+	}
+	if (scripting::hooks::OnWeaponCollision->isActive()) {
+		asteroid_override = scripting::hooks::OnWeaponCollision->isOverride(scripting::hooks::CollisionConditions{ {weapon_obj, pasteroid} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pasteroid),
+				scripting::hook_param("Object", 'o', weapon_obj),
+				scripting::hook_param("Weapon", 'o', weapon_obj),
+				scripting::hook_param("Asteroid", 'o', pasteroid),
+				scripting::hook_param("Hitpos", 'o', hitpos)));
+	}
+
+	if(!weapon_override && !asteroid_override)
+	{
+		vec3d force = weapon_obj->phys_info.vel * Weapon_info[Weapons[weapon_obj->instance].weapon_info_index].mass;
+		bool armed = weapon_hit( weapon_obj, pasteroid, &hitpos, -1);
+		float damage = Weapon_info[Weapons[weapon_obj->instance].weapon_info_index].damage;
+		std::array<std::optional<ConditionData>, NumHitTypes> impact_data = {};
+		impact_data[static_cast<std::underlying_type_t<HitType>>(HitType::HULL)] = ConditionData {
+			SpecialImpactCondition::DEBRIS,
+			HitType::HULL,
+			damage,
+			pasteroid->hull_strength,
+			Asteroid_info[Asteroids[pasteroid->instance].asteroid_type].initial_asteroid_strength,
+		};
+		maybe_play_conditional_impacts(impact_data, weapon_obj, pasteroid, armed, -1, &hitpos, nullptr, &hitnormal);
+		asteroid_hit( pasteroid, weapon_obj, &hitpos, damage, &force );
+	}
+
+	if (scripting::hooks::OnAsteroidCollision->isActive() && !(asteroid_override && !weapon_override))
+	{
+		scripting::hooks::OnAsteroidCollision->run(scripting::hooks::CollisionConditions{ {weapon_obj, pasteroid} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_obj),
+				scripting::hook_param("Object", 'o', pasteroid),
+				scripting::hook_param("Weapon", 'o', weapon_obj),
+				scripting::hook_param("Asteroid", 'o', pasteroid),
+				scripting::hook_param("Hitpos", 'o', hitpos)));
+	}
+
+	if (scripting::hooks::OnWeaponCollision->isActive() && ((asteroid_override && !weapon_override) || (!asteroid_override && !weapon_override)))
+	{
+		scripting::hooks::OnWeaponCollision->run(scripting::hooks::CollisionConditions{ {weapon_obj, pasteroid} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pasteroid),
+				scripting::hook_param("Object", 'o', weapon_obj),
+				scripting::hook_param("Weapon", 'o', weapon_obj),
+				scripting::hook_param("Asteroid", 'o', pasteroid),
+				scripting::hook_param("Hitpos", 'o', hitpos)));
+	}
+}
+
+//returns never_hits, process_data
+collision_result collide_asteroid_weapon_check( obj_pair * pair )
 {
 	if (!Asteroids_enabled)
-		return 0;
+		return {false, std::any(), &asteroid_weapon_process_collision};
 
-	vec3d	hitpos, hitnormal;
 	object	*pasteroid = pair->a;
 	object	*weapon_obj = pair->b;
 
@@ -129,71 +221,31 @@ int collide_asteroid_weapon( obj_pair * pair )
 	Assert( weapon_obj->type == OBJ_WEAPON );
 
 	// first check the bounding spheres of the two objects.
-	int hit = fvi_segment_sphere(&hitpos, &weapon_obj->last_pos, &weapon_obj->pos, &pasteroid->pos, pasteroid->radius);
+	debris_weapon_collision_data cd;
+	int hit = fvi_segment_sphere(&cd.hitpos, &weapon_obj->last_pos, &weapon_obj->pos, &pasteroid->pos, pasteroid->radius);
 	if (hit) {
-		hit = asteroid_check_collision(pasteroid, weapon_obj, &hitpos, nullptr, &hitnormal);
+		hit = asteroid_check_collision(pasteroid, weapon_obj, &cd.hitpos, nullptr, &cd.hitnormal);
 		if ( !hit )
-			return 0;
-
-		bool weapon_override = false, asteroid_override = false;
-
-		if (scripting::hooks::OnAsteroidCollision->isActive()) {
-			weapon_override = scripting::hooks::OnAsteroidCollision->isOverride(scripting::hooks::CollisionConditions{ {weapon_obj, pasteroid} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_obj),
-					scripting::hook_param("Object", 'o', pasteroid),
-					scripting::hook_param("Weapon", 'o', weapon_obj),
-					scripting::hook_param("Asteroid", 'o', pasteroid),
-					scripting::hook_param("Hitpos", 'o', hitpos)));
-		}
-		if (scripting::hooks::OnWeaponCollision->isActive()) {
-			asteroid_override = scripting::hooks::OnWeaponCollision->isOverride(scripting::hooks::CollisionConditions{ {weapon_obj, pasteroid} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pasteroid),
-					scripting::hook_param("Object", 'o', weapon_obj),
-					scripting::hook_param("Weapon", 'o', weapon_obj),
-					scripting::hook_param("Asteroid", 'o', pasteroid),
-					scripting::hook_param("Hitpos", 'o', hitpos)));
-		}
-
-		if(!weapon_override && !asteroid_override)
-		{
-			vec3d force = weapon_obj->phys_info.vel * Weapon_info[Weapons[weapon_obj->instance].weapon_info_index].mass;
-			bool armed = weapon_hit( weapon_obj, pasteroid, &hitpos, -1);
-			float damage = Weapon_info[Weapons[weapon_obj->instance].weapon_info_index].damage;
-			std::array<std::optional<ConditionData>, NumHitTypes> impact_data = {};
-			impact_data[static_cast<std::underlying_type_t<HitType>>(HitType::HULL)] = ConditionData {
-				SpecialImpactCondition::DEBRIS,
-				HitType::HULL,
-				damage,
-				pasteroid->hull_strength,
-				Asteroid_info[Asteroids[pasteroid->instance].asteroid_type].initial_asteroid_strength,
-			};
-			maybe_play_conditional_impacts(impact_data, weapon_obj, pasteroid, armed, -1, &hitpos, nullptr, &hitnormal);
-			asteroid_hit( pasteroid, weapon_obj, &hitpos, damage, &force );
-		}
-
-		if (scripting::hooks::OnAsteroidCollision->isActive() && !(asteroid_override && !weapon_override))
-		{
-			scripting::hooks::OnAsteroidCollision->run(scripting::hooks::CollisionConditions{ {weapon_obj, pasteroid} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_obj),
-					scripting::hook_param("Object", 'o', pasteroid),
-					scripting::hook_param("Weapon", 'o', weapon_obj),
-					scripting::hook_param("Asteroid", 'o', pasteroid),
-					scripting::hook_param("Hitpos", 'o', hitpos)));
-		}
-
-		if (scripting::hooks::OnWeaponCollision->isActive() && ((asteroid_override && !weapon_override) || (!asteroid_override && !weapon_override)))
-		{
-			scripting::hooks::OnWeaponCollision->run(scripting::hooks::CollisionConditions{ {weapon_obj, pasteroid} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pasteroid),
-					scripting::hook_param("Object", 'o', weapon_obj),
-					scripting::hook_param("Weapon", 'o', weapon_obj),
-					scripting::hook_param("Asteroid", 'o', pasteroid),
-					scripting::hook_param("Hitpos", 'o', hitpos)));
-		}
-
-		return 0;
+			return {false, std::any(), &asteroid_weapon_process_collision};
 
+		return {false, cd, &asteroid_weapon_process_collision};
 	} else {
-		return weapon_will_never_hit( weapon_obj, pasteroid, pair );
+		return {weapon_will_never_hit( weapon_obj, pasteroid, pair ) != 0, std::any(), &asteroid_weapon_process_collision};
+	}
+}
+
+/**
+ * Checks asteroid-weapon collisions.  
+ * @param pair obj_pair pointer to the two objects. pair->a is asteroid and pair->b is weapon.
+ * @return 1 if all future collisions between these can be ignored
+ */
+int collide_asteroid_weapon( obj_pair * pair )
+{
+	const auto& [never_check_again, collision_data, process_fnc] = collide_asteroid_weapon_check(pair);
+
+	if (collision_data.has_value()) {
+		process_fnc(pair, collision_data);
 	}
-}				
+
+	return never_check_again ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+#include "object/collisionpaircache.h"
+
+namespace {
+// 2^32 / golden ratio, spreads the sequential object numbers making up the keys over the whole table
+constexpr uint FIBONACCI_MULTIPLIER = 2654435769u;
+}
+
+size_t collision_pair_cache::home_slot(uint key) const
+{
+	return static_cast<size_t>((key * FIBONACCI_MULTIPLIER) >> _shift);
+}
+
+collider_pair* collision_pair_cache::find(uint key)
+{
+	if (_slots.empty())
+		return nullptr;
+
+	const size_t mask = _slots.size() - 1;
+	for (size_t i = home_slot(key); _slots[i].generation == _generation; i = (i + 1) & mask) {
+		if (_slots[i].key == key)
+			return &_slots[i].pair;
+	}
+
+	return nullptr;
+}
+
+collider_pair* collision_pair_cache::find_or_insert(uint key, bool& inserted)
+{
+	auto existing = find(key);
+	if (existing != nullptr) {
+		inserted = false;
+		return existing;
+	}
+
+	// keep the load factor at or below 3/4 so that probe sequences stay short
+	if ((_size + 1) * 4 > _slots.size() * 3)
+		grow();
+
+	const size_t mask = _slots.size() - 1;
+	size_t i = home_slot(key);
+	while (_slots[i].generation == _generation)
+		i = (i + 1) & mask;
+
+	auto& slot = _slots[i];
+	slot.key = key;
+	slot.generation = _generation;
+	slot.pair = collider_pair();
+	++_size;
+
+	inserted = true;
+	return &slot.pair;
+}
+
+bool collision_pair_cache::erase(uint key)
+{
+	if (_slots.empty())
+		return false;
+
+	const size_t mask = _slots.size() - 1;
+	for (size_t i = home_slot(key); _slots[i].generation == _generation; i = (i + 1) & mask) {
+		if (_slots[i].key == key) {
+			erase_slot(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void collision_pair_cache::erase_slot(size_t index)
+{
+	const size_t mask = _slots.size() - 1;
+
+	// Walk the rest of the probe sequence and move back every entry that may legally live in the hole,
+	// i.e. every entry whose home slot does not lie between the hole and its current position.
+	size_t hole = index;
+	for (size_t next = (hole + 1) & mask; _slots[next].generation == _generation; next = (next + 1) & mask) {
+		const size_t home = home_slot(_slots[next].key);
+		if (((next - home) & mask) >= ((next - hole) & mask)) {
+			_slots[hole] = _slots[next];
+			hole = next;
+		}
+	}
+
+	_slots[hole].generation = 0;
+	--_size;
+}
+
+void collision_pair_cache::clear()
+{
+	_size = 0;
+
+	++_generation;
+	if (_generation == 0) {
+		// the generation wrapped around, so old slots could look live again
+		for (auto& slot : _slots)
+			slot.generation = 0;
+		_generation = 1;
+	}
+}
+
+void collision_pair_cache::grow()
+{
+	const size_t new_capacity = _slots.empty() ? MIN_CAPACITY : _slots.size() * 2;
+
+	SCP_vector<slot> old_slots(new_capacity);
+	old_slots.swap(_slots);
+	const uint old_generation = _generation;
+
+	_shift = 32;
+	for (size_t capacity = new_capacity; capacity > 1; capacity >>= 1)
+		--_shift;
+
+	_size = 0;
+	_generation = 1;
+
+	const size_t mask = _slots.size() - 1;
+	for (const auto& old : old_slots) {
+		if (old.generation != old_generation)
+			continue;
+
+		size_t i = home_slot(old.key);
+		while (_slots[i].generation == _generation)
+			i = (i + 1) & mask;
+
+		_slots[i] = old;
+		_slots[i].generation = _generation;
+		++_size;
+	}
+}
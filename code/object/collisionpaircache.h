@@ -0,0 +1,108 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "object/objcollide.h"
+
+class object;
+
+// A pair of objects which have been through the collision broadphase together, along with when they
+// next need to be checked.  A next_check_time of -1 means the pair never needs to be checked again.
+struct collider_pair
+{
+	object *a = nullptr;
+	object *b = nullptr;
+	int signature_a = -1;
+	int signature_b = -1;
+	int next_check_time = -1;
+};
+
+// Builds the cache key of an ordered object pair from their object numbers.
+constexpr uint collision_pair_key(int objnum_a, int objnum_b)
+{
+	return (static_cast<uint>(objnum_a) << collision_cache_bitshift) + static_cast<uint>(objnum_b);
+}
+
+/**
+ * @brief Flat, open-addressed table of collider_pairs keyed by collision_pair_key()
+ *
+ * Entries live in one contiguous array and are found by linear probing, so a lookup normally touches
+ * a single cache line and inserting never allocates unless the table has to grow.  Erasing shifts the
+ * following entries of the probe sequence back instead of leaving tombstones behind, so lookups don't
+ * slow down over the course of a mission.
+ *
+ * A slot holds a live entry only if it carries the current generation of the table.  Bumping the
+ * generation therefore empties the whole table without touching its memory.
+ *
+ * Pointers returned by find() and find_or_insert() are invalidated by the next insertion or erasure,
+ * so anything that needs to get back to an entry later (e.g. the threaded collision results) has to
+ * hold on to the key instead.
+ */
+class collision_pair_cache
+{
+  public:
+	collision_pair_cache() = default;
+
+	// Returns the entry for key, or nullptr if there is none.
+	collider_pair* find(uint key);
+
+	// Returns the entry for key, default constructing it first if there is none.  inserted is set to
+	// whether that happened.
+	collider_pair* find_or_insert(uint key, bool& inserted);
+
+	// Removes the entry for key, if there is one.  Returns whether something was removed.
+	bool erase(uint key);
+
+	// Calls func(key, pair) for every entry and removes all entries for which it returned true.
+	// The function may see an entry more than once if earlier erasures moved it around.
+	template <typename Func>
+	void erase_if(Func&& func)
+	{
+		size_t i = 0;
+		while (i < _slots.size()) {
+			auto& slot = _slots[i];
+			if (slot.generation == _generation && func(slot.key, slot.pair)) {
+				// the hole is now filled with a later entry, if any, so look at this slot again
+				erase_slot(i);
+			} else {
+				++i;
+			}
+		}
+	}
+
+	// Calls func(key, pair) for every entry.
+	template <typename Func>
+	void for_each(Func&& func)
+	{
+		for (auto& slot : _slots) {
+			if (slot.generation == _generation)
+				func(slot.key, slot.pair);
+		}
+	}
+
+	// Removes all entries, keeping the allocated memory around.
+	void clear();
+
+	size_t size() const { return _size; }
+	size_t capacity() const { return _slots.size(); }
+	bool empty() const { return _size == 0; }
+
+  private:
+	struct slot {
+		uint key = 0;
+		uint generation = 0;
+		collider_pair pair;
+	};
+
+	static constexpr size_t MIN_CAPACITY = 1024;
+
+	SCP_vector<slot> _slots;
+	size_t _size = 0;
+	uint _generation = 1;
+	int _shift = 32;
+
+	size_t home_slot(uint key) const;
+
+	void erase_slot(size_t index);
+
+	void grow();
+};
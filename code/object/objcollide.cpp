@@ -11,6 +11,7 @@
 #include "cmdline/cmdline.h"
 #include "globalincs/linklist.h"
 #include "io/timer.h"
+#include "object/collisionpaircache.h"
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
@@ -19,6 +20,7 @@
 #include "weapon/beam.h"
 #include "weapon/weapon.h"
 #include "tracing/Monitor.h"
+#include "utils/spsc_queue.h"
 #include "utils/threading.h"
 
 #include <limits>
@@ -33,25 +35,8 @@ SCP_vector<int> Collision_sort_list;
 
 static_assert(1 << collision_cache_bitshift > MAX_OBJECTS, "Collision pair caching currently relies on the highest possible objnum being less than 2^collision_cache_bitshift.");
 
-class collider_pair
-{
-public:
-	object *a;
-	object *b;
-	int signature_a;
-	int signature_b;
-	int next_check_time;
-	bool initialized;
-
-	// we need to define a constructor because the hash map can
-	// implicitly insert an object when we use the [] operator
-	collider_pair()
-		: a(nullptr), b(nullptr), signature_a(-1), signature_b(-1), next_check_time(-1), initialized(false)
-	{}
-};
-
 static SCP_set<object*> Collision_cache_stale_objects;
-static SCP_unordered_map<uint, collider_pair> Collision_cached_pairs;
+static collision_pair_cache Collision_cached_pairs;
 
 class checkobject;
 extern checkobject CheckObjects[MAX_OBJECTS];
@@ -511,29 +496,27 @@ int collide_remove_weapons( )
 	}
 
 	// first pass is to see if any of the weapons don't have collision pairs.
-	for (auto& pair : Collision_cached_pairs) {
-        collider_pair* pair_obj = &pair.second;
-
-		if (!pair_obj->initialized) {
-			continue;
-		}
+	Collision_cached_pairs.erase_if([](uint, collider_pair& pair_obj) {
+		bool remove = false;
 
-		if (pair_obj->a->type == OBJ_WEAPON && pair_obj->signature_a == pair_obj->a->signature) {
-			crw_check_weapon(pair_obj->a->instance, pair_obj->next_check_time);
+		if (pair_obj.a->type == OBJ_WEAPON && pair_obj.signature_a == pair_obj.a->signature) {
+			crw_check_weapon(pair_obj.a->instance, pair_obj.next_check_time);
 
-			if (crw_status[pair_obj->a->instance] == CRW_CAN_DELETE) {
-				pair_obj->initialized = false;
+			if (crw_status[pair_obj.a->instance] == CRW_CAN_DELETE) {
+				remove = true;
 			}
 		}
 
-		if (pair_obj->b->type == OBJ_WEAPON && pair_obj->signature_b == pair_obj->b->signature) {
-			crw_check_weapon(pair_obj->b->instance, pair_obj->next_check_time);
+		if (pair_obj.b->type == OBJ_WEAPON && pair_obj.signature_b == pair_obj.b->signature) {
+			crw_check_weapon(pair_obj.b->instance, pair_obj.next_check_time);
 
-			if (crw_status[pair_obj->b->instance] == CRW_CAN_DELETE) {
-				pair_obj->initialized = false;
+			if (crw_status[pair_obj.b->instance] == CRW_CAN_DELETE) {
+				remove = true;
 			}
 		}
-	}
+
+		return remove;
+	});
 
 	// for each weapon which could be removed, delete the object
 	int num_deleted = 0;
@@ -570,6 +553,52 @@ void init_collision_info_struct(collision_info_struct *cis)
 	cis->is_landing = false;
 }
 
+// The broadphase keeps one list of colliders per axis, sorted by the minimum endpoint on that axis.
+// The lists persist between frames, so since objects only move a little each frame, re-sorting them
+// is close to linear.  Collision_sort_list doubles as the x axis list.
+static SCP_vector<int> Collision_sort_list_y;
+static SCP_vector<int> Collision_sort_list_z;
+
+// number of leading entries of each axis list that were sorted last frame; anything after that
+// was added by obj_add_collider since and still needs to be merged in
+static size_t Collision_sorted_count[3] = { 0, 0, 0 };
+
+// obj_remove_collider only marks objects, the lists drop them in one pass when they are sorted next
+static bool Collider_removed[MAX_OBJECTS];
+static SCP_vector<int> Collider_removed_list;
+
+static void obj_compact_sort_list(SCP_vector<int> &list, size_t &sorted_count)
+{
+	size_t kept = 0;
+	size_t kept_sorted = 0;
+
+	for (size_t i = 0; i < list.size(); ++i) {
+		if (Collider_removed[list[i]])
+			continue;
+
+		if (i < sorted_count)
+			++kept_sorted;
+		list[kept++] = list[i];
+	}
+
+	list.resize(kept);
+	sorted_count = kept_sorted;
+}
+
+static void obj_compact_colliders()
+{
+	if (Collider_removed_list.empty())
+		return;
+
+	obj_compact_sort_list(Collision_sort_list, Collision_sorted_count[0]);
+	obj_compact_sort_list(Collision_sort_list_y, Collision_sorted_count[1]);
+	obj_compact_sort_list(Collision_sort_list_z, Collision_sorted_count[2]);
+
+	for (int obj_index : Collider_removed_list)
+		Collider_removed[obj_index] = false;
+	Collider_removed_list.clear();
+}
+
 void obj_add_collider(int obj_index)
 {
 	object *objp = &Objects[obj_index];
@@ -585,7 +614,14 @@ void obj_add_collider(int obj_index)
 		return;
 	}
 
-	Collision_sort_list.push_back(obj_index);
+	if (Collider_removed[obj_index]) {
+		// removed since the last sort, so its entries are still in the lists
+		Collider_removed[obj_index] = false;
+	} else {
+		Collision_sort_list.push_back(obj_index);
+		Collision_sort_list_y.push_back(obj_index);
+		Collision_sort_list_z.push_back(obj_index);
+	}
 
 	objp->flags.remove(Object::Object_Flags::Not_in_coll);
 }
@@ -596,12 +632,10 @@ void obj_remove_collider(int obj_index)
     CheckObjects[obj_index].flags.set(Object::Object_Flags::Not_in_coll);
 #endif	
 
-	for (size_t i = 0; i < Collision_sort_list.size(); ++i ) {
-		if ( Collision_sort_list[i] == obj_index ) {
-			Collision_sort_list[i] = Collision_sort_list.back();
-			Collision_sort_list.pop_back();
-			break;
-		}
+	// the entries stay in place until the next sort, which keeps the remaining colliders in order
+	if (!Objects[obj_index].flags[Object::Object_Flags::Not_in_coll] && !Collider_removed[obj_index]) {
+		Collider_removed[obj_index] = true;
+		Collider_removed_list.push_back(obj_index);
 	}
 
 	Objects[obj_index].flags.set(Object::Object_Flags::Not_in_coll);
@@ -610,6 +644,13 @@ void obj_remove_collider(int obj_index)
 void obj_reset_colliders()
 {
 	Collision_sort_list.clear();
+	Collision_sort_list_y.clear();
+	Collision_sort_list_z.clear();
+	for (auto& count : Collision_sorted_count)
+		count = 0;
+	for (int obj_index : Collider_removed_list)
+		Collider_removed[obj_index] = false;
+	Collider_removed_list.clear();
 	Collision_cached_pairs.clear();
 }
 
@@ -617,17 +658,14 @@ void obj_collide_retime_stale_pairs()
 {
 	TRACE_SCOPE(tracing::RetimeCollisionCache);
 
-	auto it = Collision_cached_pairs.begin();
-	while (it != Collision_cached_pairs.end()) {
-		auto &pair = it->second;
-		if (pair.signature_a != pair.a->signature || pair.signature_b != pair.b->signature) {
-			it = Collision_cached_pairs.erase(it);
-		} else {
-			if (pair.a->flags[Object::Object_Flags::Collision_cache_stale] || pair.b->flags[Object::Object_Flags::Collision_cache_stale])
-				pair.next_check_time = timestamp(0);
-			it++;
-		}
-	}
+	Collision_cached_pairs.erase_if([](uint, collider_pair& pair) {
+		if (pair.signature_a != pair.a->signature || pair.signature_b != pair.b->signature)
+			return true;
+
+		if (pair.a->flags[Object::Object_Flags::Collision_cache_stale] || pair.b->flags[Object::Object_Flags::Collision_cache_stale])
+			pair.next_check_time = timestamp(0);
+		return false;
+	});
 
 	for (auto objp : Collision_cache_stale_objects)
 		objp->flags.remove(Object::Object_Flags::Collision_cache_stale);
@@ -691,39 +729,81 @@ float obj_get_collider_endpoint(int obj_num, int axis, bool min)
     }
 }
 
-void obj_quicksort_colliders(SCP_vector<int> *list, int left, int right, int axis)
+// endpoints of every collider, computed once per frame before sorting
+struct collider_bounds {
+	float min[3];
+	float max[3];
+};
+
+static collider_bounds Collider_bounds[MAX_OBJECTS];
+
+// objects found to overlap another object on the current sweep axis are stamped with the id of
+// that sweep, which lets the next axis filter its list without a separate set
+static int Collider_overlap_stamp[MAX_OBJECTS];
+static int Collider_overlap_sweep = 0;
+
+static void obj_update_collider_bounds(int obj_num)
+{
+	auto &bounds = Collider_bounds[obj_num];
+
+	for (int axis = 0; axis < 3; ++axis) {
+		bounds.min[axis] = obj_get_collider_endpoint(obj_num, axis, true);
+		bounds.max[axis] = obj_get_collider_endpoint(obj_num, axis, false);
+	}
+}
+
+static int obj_next_overlap_sweep()
 {
-    Assert( axis >= 0 );
-    Assert( axis <= 2 );
+	if (Collider_overlap_sweep == std::numeric_limits<int>::max()) {
+		std::fill(std::begin(Collider_overlap_stamp), std::end(Collider_overlap_stamp), 0);
+		Collider_overlap_sweep = 0;
+	}
 
-    if ( right > left ) {
-        int pivot_index = left + (right - left) / 2;
+	return ++Collider_overlap_sweep;
+}
 
-        float pivot_value = obj_get_collider_endpoint((*list)[pivot_index], axis, true);
+// Sorts list by minimum endpoint on axis.  The first sorted_count entries are assumed to still be in
+// last frame's order, which is nearly sorted, so they get an insertion sort.  The remaining entries
+// are new colliders which are sorted on their own and merged in.
+static void obj_sort_colliders(SCP_vector<int> &list, size_t &sorted_count, int axis)
+{
+	Assert( axis >= 0 );
+	Assert( axis <= 2 );
 
-        // swap!
-        int temp = (*list)[pivot_index];
-        (*list)[pivot_index] = (*list)[right];
-        (*list)[right] = temp;
+	auto by_min = [axis](int a, int b) { return Collider_bounds[a].min[axis] < Collider_bounds[b].min[axis]; };
 
-        int store_index = left;
+	sorted_count = std::min(sorted_count, list.size());
+	auto middle = list.begin() + sorted_count;
 
-        for (int i = left; i < right; ++i ) {
-            if ( obj_get_collider_endpoint((*list)[i], axis, true) <= pivot_value ) {
-                temp = (*list)[i];
-                (*list)[i] = (*list)[store_index];
-                (*list)[store_index] = temp;
-                store_index++;
-            }
-        }
+	for (size_t i = 1; i < sorted_count; ++i) {
+		const int obj_num = list[i];
+		const float key = Collider_bounds[obj_num].min[axis];
+
+		size_t j = i;
+		while (j > 0 && Collider_bounds[list[j - 1]].min[axis] > key) {
+			list[j] = list[j - 1];
+			--j;
+		}
+		list[j] = obj_num;
+	}
 
-        temp = (*list)[right];
-        (*list)[right] = (*list)[store_index];
-        (*list)[store_index] = temp;
+	if (middle != list.end()) {
+		std::sort(middle, list.end(), by_min);
+		std::inplace_merge(list.begin(), middle, list.end(), by_min);
+	}
 
-        obj_quicksort_colliders(list, left, store_index - 1, axis);
-        obj_quicksort_colliders(list, store_index + 1, right, axis);
-    }
+	sorted_count = list.size();
+}
+
+// copies the colliders from list which overlapped something during the given sweep
+static void obj_filter_overlap_colliders(SCP_vector<int> &list_out, const SCP_vector<int> &list, int sweep)
+{
+	list_out.clear();
+
+	for (int obj_num : list) {
+		if (Collider_overlap_stamp[obj_num] == sweep)
+			list_out.push_back(obj_num);
+	}
 }
 
 struct collision_thread_data {
@@ -738,32 +818,40 @@ struct collision_thread_data {
 		void (*process_collision)( obj_pair *pair,  const std::any& collision_data );
 	};
 
-	std::atomic_size_t queue_length, result_length;
-	std::mutex queue_mutex, result_mutex;
-	std::unique_ptr<SCP_vector<collision_queue_item>> queue_load, queue_process;
-	std::unique_ptr<SCP_vector<collision_queue_result>> queue_results, queue_send;
-
-	collision_thread_data() :
-		queue_length(0),
-		result_length(0),
-		queue_load(std::make_unique<SCP_vector<collision_queue_item>>()),
-		queue_process(std::make_unique<SCP_vector<collision_queue_item>>()),
-		queue_results(std::make_unique<SCP_vector<collision_queue_result>>()),
-		queue_send(std::make_unique<SCP_vector<collision_queue_result>>()) {}
+	// checks handed from the main thread to this worker, and their results handed back
+	util::spsc_queue<collision_queue_item> queue;
+	util::spsc_queue<collision_queue_result> results;
+
+	// number of queued checks this worker has not started yet, used to balance the load between workers
+	std::atomic_size_t queue_length = 0;
+
+	threading::wakeup_signal work_available;
 };
 
 std::unique_ptr<collision_thread_data[]> collision_thread_data_buffer;
 std::atomic_bool collision_processing_done = false;
+threading::task_group collision_tasks;
+
+// number of queued checks whose results have not been handed back yet
+std::atomic_size_t collision_results_pending = 0;
+threading::wakeup_signal collision_results_available;
+
+void collide_mp_worker_thread(size_t threadIdx);
 
+// Starts one long running task per worker, which processes collision checks as they are queued by the main thread.
+// Each task ends once spin_down_mp_collision() has been called and its queue is drained. task_group::wait() only runs
+// tasks of its own group, so a thread waiting on other work in the meantime can never pick one of these up.
 void spin_up_mp_collision() {
 	collision_processing_done.store(false);
-	threading::spin_up_threaded_task(threading::WorkerThreadTask::COLLISION);
+	for (size_t i = 0; i < threading::get_num_workers(); i++) {
+		collision_tasks.run([i]() { collide_mp_worker_thread(i); });
+	}
 }
 
 void spin_down_mp_collision() {
-	threading::spin_down_threaded_task();
-	collision_processing_done.store(true);
-	threading::spin_down_wait_complete();
+	collision_processing_done.store(true, std::memory_order_release);
+	for (size_t i = 0; i < threading::get_num_workers(); i++)
+		collision_thread_data_buffer[i].work_available.notify();
 }
 
 void queue_mp_collision(uint ctype, const obj_pair& colliding) {
@@ -780,56 +868,63 @@ void queue_mp_collision(uint ctype, const obj_pair& colliding) {
 			min_queue_length = queue_length;
 		}
 	}
-	{
-		auto& thread = collision_thread_data_buffer[target_thread];
-		std::scoped_lock lock(thread.queue_mutex);
-		thread.queue_load->emplace_back( collision_thread_data::collision_queue_item{colliding, ctype} );
-		thread.queue_length.fetch_add(1, std::memory_order_release);
+
+	auto& thread = collision_thread_data_buffer[target_thread];
+	collision_results_pending.fetch_add(1, std::memory_order_relaxed);
+	thread.queue_length.fetch_add(1, std::memory_order_relaxed);
+	thread.queue.push( collision_thread_data::collision_queue_item{colliding, ctype} );
+	thread.work_available.notify();
+}
+
+void process_threaded_collision_result(collision_thread_data::collision_queue_result& collision) {
+	if (collision.collision_data.has_value())
+		collision.process_collision(&collision.objs, collision.collision_data);
+
+	collider_pair *collision_info = Collision_cached_pairs.find(collision_pair_key(OBJ_INDEX(collision.objs.a), OBJ_INDEX(collision.objs.b)));
+	if (collision_info == nullptr)
+		return;
+
+	if (collision.never_recheck) {
+		collision_info->next_check_time = -1;
+	} else {
+		collision_info->next_check_time = collision.objs.next_check_time;
 	}
 }
 
 void post_process_threaded_collisions() {
-	SCP_map<size_t, size_t> workerThreads;
-	for (size_t i = 0; i < threading::get_num_workers(); i++)
-		workerThreads.emplace(i, 0);
+	// everything has been queued at this point, so workers can stop once their queues run dry
+	spin_down_mp_collision();
 
-	while (!workerThreads.empty()) {
-		for(auto& [i, processed] : workerThreads) {
-			auto& thread = collision_thread_data_buffer[i];
+	const size_t num_workers = threading::get_num_workers();
+	auto results_ready = [num_workers]() {
+		if (collision_results_pending.load(std::memory_order_acquire) == 0)
+			return true;
 
-			size_t queue_length = thread.queue_length.load(std::memory_order_acquire);
-			size_t result_length = thread.result_length.load(std::memory_order_acquire);
+		for (size_t i = 0; i < num_workers; i++) {
+			if (!collision_thread_data_buffer[i].results.empty())
+				return true;
+		}
+		return false;
+	};
 
-			if (result_length > processed) {
-				{
-					std::scoped_lock lock(thread.result_mutex);
-					thread.queue_results.swap(thread.queue_send);
-				}
-				for (auto& collision : *thread.queue_send) {
-					uint key = (OBJ_INDEX(collision.objs.a) << collision_cache_bitshift) + OBJ_INDEX(collision.objs.b);
-					collider_pair *collision_info = &Collision_cached_pairs[key];
-
-					if (collision.collision_data.has_value())
-						collision.process_collision(&collision.objs, collision.collision_data);
-
-					if (collision.never_recheck) {
-						collision_info->next_check_time = -1;
-					} else {
-						collision_info->next_check_time = collision.objs.next_check_time;
-					}
-				}
-				processed += thread.queue_send->size();
-				thread.queue_send->clear();
-			}
-			else if (queue_length == 0) {
-				thread.queue_results->clear();
-				workerThreads.erase(i);
-				break;
-			}
+	collision_thread_data::collision_queue_result collision;
+	while (true) {
+		// a zero count means every result has been pushed, so the drain after reading it is the last one needed
+		const bool all_done = collision_results_pending.load(std::memory_order_acquire) == 0;
+
+		for (size_t i = 0; i < num_workers; i++) {
+			auto& thread = collision_thread_data_buffer[i];
+			while (thread.results.try_pop(collision))
+				process_threaded_collision_result(collision);
 		}
+
+		if (all_done)
+			break;
+
+		collision_results_available.wait_until(results_ready);
 	}
 
-	spin_down_mp_collision();
+	collision_tasks.wait();
 }
 
 void obj_collide_pair(object *A, object *B)
@@ -871,44 +966,56 @@ void obj_collide_pair(object *A, object *B)
             break;
         case COLLISION_OF(OBJ_DEBRIS, OBJ_WEAPON):
             check_collision = collide_debris_weapon;
+			support_mp = true;
             break;
         case COLLISION_OF(OBJ_WEAPON, OBJ_DEBRIS):
             swapped = 1;
             check_collision = collide_debris_weapon;
+			support_mp = true;
             break;
         case COLLISION_OF(OBJ_DEBRIS, OBJ_SHIP):
             check_collision = collide_debris_ship;
+			support_mp = true;
             break;
         case COLLISION_OF(OBJ_SHIP, OBJ_DEBRIS):
             check_collision = collide_debris_ship;
+			support_mp = true;
             swapped = 1;
             break;
 		case COLLISION_OF(OBJ_DEBRIS, OBJ_PROP):
 			check_collision = collide_debris_prop;
+			support_mp = true;
 			break;
 		case COLLISION_OF(OBJ_PROP, OBJ_DEBRIS):
 			check_collision = collide_debris_prop;
+			support_mp = true;
 			swapped = 1;
 			break;
         case COLLISION_OF(OBJ_ASTEROID, OBJ_WEAPON):
             check_collision = collide_asteroid_weapon;
+			support_mp = true;
             break;
         case COLLISION_OF(OBJ_WEAPON, OBJ_ASTEROID):
             swapped = 1;
             check_collision = collide_asteroid_weapon;
+			support_mp = true;
             break;
         case COLLISION_OF(OBJ_ASTEROID, OBJ_SHIP):
             check_collision = collide_asteroid_ship;
+			support_mp = true;
             break;
         case COLLISION_OF(OBJ_SHIP, OBJ_ASTEROID):
             check_collision = collide_asteroid_ship;
+			support_mp = true;
             swapped = 1;
             break;
 		case COLLISION_OF(OBJ_ASTEROID, OBJ_PROP):
 			check_collision = collide_asteroid_prop;
+			support_mp = true;
 			break;
 		case COLLISION_OF(OBJ_PROP, OBJ_ASTEROID):
 			check_collision = collide_asteroid_prop;
+			support_mp = true;
 			swapped = 1;
 			break;
         case COLLISION_OF(OBJ_SHIP,OBJ_SHIP):
@@ -938,6 +1045,7 @@ void obj_collide_pair(object *A, object *B)
             }
             swapped = 1;
             check_collision = beam_collide_ship;
+			support_mp = true;
             break;
 
         case COLLISION_OF(OBJ_BEAM, OBJ_SHIP):
@@ -945,6 +1053,7 @@ void obj_collide_pair(object *A, object *B)
                 return;
             }
             check_collision = beam_collide_ship;
+			support_mp = true;
             break;
 
         case COLLISION_OF(OBJ_ASTEROID, OBJ_BEAM):
@@ -953,6 +1062,7 @@ void obj_collide_pair(object *A, object *B)
             }
             swapped = 1;
             check_collision = beam_collide_asteroid;
+			support_mp = true;
             break;
 
         case COLLISION_OF(OBJ_BEAM, OBJ_ASTEROID):
@@ -960,6 +1070,7 @@ void obj_collide_pair(object *A, object *B)
                 return;
             }
             check_collision = beam_collide_asteroid;
+			support_mp = true;
             break;
         case COLLISION_OF(OBJ_DEBRIS, OBJ_BEAM):
             if(beam_collide_early_out(B, A)) {
@@ -967,12 +1078,14 @@ void obj_collide_pair(object *A, object *B)
             }
             swapped = 1;
             check_collision = beam_collide_debris;
+			support_mp = true;
             break;
         case COLLISION_OF(OBJ_BEAM, OBJ_DEBRIS):
             if(beam_collide_early_out(A, B)){
                 return;
             }
             check_collision = beam_collide_debris;
+			support_mp = true;
             break;
         case COLLISION_OF(OBJ_WEAPON, OBJ_BEAM):
             if(beam_collide_early_out(B, A)) {
@@ -980,6 +1093,7 @@ void obj_collide_pair(object *A, object *B)
             }
             swapped = 1;
             check_collision = beam_collide_missile;
+			support_mp = true;
             break;
 
         case COLLISION_OF(OBJ_BEAM, OBJ_WEAPON):
@@ -987,6 +1101,7 @@ void obj_collide_pair(object *A, object *B)
                 return;
             }
             check_collision = beam_collide_missile;
+			support_mp = true;
             break;
 		case COLLISION_OF(OBJ_PROP, OBJ_BEAM):
 			if (beam_collide_early_out(B, A)) {
@@ -994,6 +1109,7 @@ void obj_collide_pair(object *A, object *B)
 			}
 			swapped = 1;
 			check_collision = beam_collide_prop;
+			support_mp = true;
 			break;
 
 		case COLLISION_OF(OBJ_BEAM, OBJ_PROP):
@@ -1001,6 +1117,7 @@ void obj_collide_pair(object *A, object *B)
 				return;
 			}
 			check_collision = beam_collide_prop;
+			support_mp = true;
 			break;
 
         case COLLISION_OF(OBJ_WEAPON, OBJ_WEAPON): {
@@ -1010,9 +1127,11 @@ void obj_collide_pair(object *A, object *B)
             if ((awip->weapon_hitpoints > 0) || (bwip->weapon_hitpoints > 0)) {
                 if (bwip->weapon_hitpoints == 0) {
                     check_collision = collide_weapon_weapon;
+                    support_mp = true;
                     swapped=1;
                 } else {
                     check_collision = collide_weapon_weapon;
+                    support_mp = true;
                 }
             }
 
@@ -1031,28 +1150,20 @@ void obj_collide_pair(object *A, object *B)
     }
 
     bool valid = false;
-    uint key = (OBJ_INDEX(A) << collision_cache_bitshift) + OBJ_INDEX(B);
+    bool inserted;
 
-    collider_pair* collision_info = &Collision_cached_pairs[key];
+    collider_pair* collision_info = Collision_cached_pairs.find_or_insert(collision_pair_key(OBJ_INDEX(A), OBJ_INDEX(B)), inserted);
 
-    if ( collision_info->initialized ) {
-        // make sure we're referring to the correct objects in case the original pair was deleted
-        if ( collision_info->signature_a == collision_info->a->signature &&
-             collision_info->signature_b == collision_info->b->signature ) {
-            valid = true;
-        } else {
-            collision_info->a = A;
-            collision_info->b = B;
-            collision_info->signature_a = A->signature;
-            collision_info->signature_b = B->signature;
-            collision_info->next_check_time = timestamp(0);
-        }
+    // make sure we're referring to the correct objects in case the original pair was deleted
+    if ( !inserted &&
+         collision_info->signature_a == collision_info->a->signature &&
+         collision_info->signature_b == collision_info->b->signature ) {
+        valid = true;
     } else {
         collision_info->a = A;
         collision_info->b = B;
         collision_info->signature_a = A->signature;
         collision_info->signature_b = B->signature;
-        collision_info->initialized = true;
         collision_info->next_check_time = timestamp(0);
     }
 
@@ -1142,30 +1253,29 @@ void obj_collide_pair(object *A, object *B)
 	}
 }
 
-void obj_find_overlap_colliders(SCP_vector<int> &overlap_list_out, SCP_vector<int> &list, int axis, bool collide)
+// Sweeps a list sorted along axis and stamps every collider overlapping another one with the given sweep.
+// If collide is set, the overlapping pairs are also sent on to obj_collide_pair().
+static void obj_find_overlap_colliders(const SCP_vector<int> &list, int axis, int sweep, bool collide)
 {
     TRACE_SCOPE(tracing::FindOverlapColliders);
 
-    bool first_not_added = true;
     SCP_vector<int> overlappers;
 
     for (int in_index : list){
-        bool overlapped = false;
-
-        const float min = obj_get_collider_endpoint(in_index, axis, true);
+        const float min = Collider_bounds[in_index].min[axis];
 
         for (size_t j = 0; j < overlappers.size(); ) {
-            const float overlap_max = obj_get_collider_endpoint(overlappers[j], axis, false);
+            const float overlap_max = Collider_bounds[overlappers[j]].max[axis];
             if ( min <= overlap_max ) {
-                overlapped = true;
-
-                if ( overlappers.size() == 1 && first_not_added ) {
-                    first_not_added = false;
-                    overlap_list_out.push_back(overlappers[j]);
-                }
+                Collider_overlap_stamp[overlappers[j]] = sweep;
+                Collider_overlap_stamp[in_index] = sweep;
 
                 if ( collide ) {
                     obj_collide_pair(&Objects[in_index], &Objects[overlappers[j]]);
+
+                    // the collision response may have moved either object, so keep testing against where they are now
+                    obj_update_collider_bounds(in_index);
+                    obj_update_collider_bounds(overlappers[j]);
                 }
             } else {
                 overlappers[j] = overlappers.back();
@@ -1176,64 +1286,102 @@ void obj_find_overlap_colliders(SCP_vector<int> &overlap_list_out, SCP_vector<in
             ++j;
         }
 
-        if ( overlappers.empty() ) {
-            first_not_added = true;
-        }
-
-        if ( overlapped ) {
-            overlap_list_out.push_back(in_index);
-        }
-
         overlappers.push_back(in_index);
     }
 }
 
-} //anon namespace
-
 void collide_mp_worker_thread(size_t threadIdx) {
 	auto& thread = collision_thread_data_buffer[threadIdx];
-	thread.result_length.store(0);
-
-	while (!thread.queue_process->empty() || thread.queue_length.load(std::memory_order_acquire) > 0 || !collision_processing_done.load(std::memory_order_acquire)) {
-		if (!thread.queue_process->empty()) {
-
-			for (auto& collision_check : *thread.queue_process) {
-				collision_result (*check_collision)( obj_pair *pair ) = nullptr;
-
-				switch( collision_check.ctype )	{
-					case COLLISION_OF(OBJ_WEAPON, OBJ_SHIP):
-					case COLLISION_OF(OBJ_SHIP, OBJ_WEAPON):
-						check_collision = collide_ship_weapon_check;
-						break;
-					case COLLISION_OF(OBJ_SHIP, OBJ_SHIP):
-						check_collision = collide_ship_ship_check;
-						break;
-					default:
-						UNREACHABLE("Got non MP-compatible collision type %d!", collision_check.ctype);
-						thread.queue_length.fetch_sub(1, std::memory_order_release); // keep the counter balanced
-						continue;                                                    // skip the bad pair
-				}
+	auto work_ready = [&thread]() { return !thread.queue.empty() || collision_processing_done.load(std::memory_order_acquire); };
 
-				auto&& [never_check_again, collision_data_maybe, collision_fnc] = check_collision(&collision_check.objs);
+	collision_thread_data::collision_queue_item collision_check;
+	while (true) {
+		if (!thread.queue.try_pop(collision_check)) {
+			// the main thread only sets the done flag after queueing everything, so an empty queue is final then
+			if (collision_processing_done.load(std::memory_order_acquire) && thread.queue.empty())
+				break;
 
-				{
-					std::scoped_lock lock{thread.result_mutex};
-					thread.queue_results->emplace_back(collision_thread_data::collision_queue_result{collision_check.objs, never_check_again, collision_data_maybe, collision_fnc});
-				}
-				thread.result_length.fetch_add(1, std::memory_order_release);
-				thread.queue_length.fetch_sub(1, std::memory_order_release);
-			}
-			thread.queue_process->clear();
+			thread.work_available.wait_until(work_ready);
+			continue;
 		}
-		else if (thread.queue_length.load(std::memory_order_acquire) > 0) {
-			//We must have data in the load queue then.
-			std::scoped_lock lock(thread.queue_mutex);
-			thread.queue_load.swap(thread.queue_process);
-			thread.queue_load->clear();
+
+		thread.queue_length.fetch_sub(1, std::memory_order_relaxed);
+
+		collision_result (*check_collision)( obj_pair *pair ) = nullptr;
+
+		switch( collision_check.ctype )	{
+			case COLLISION_OF(OBJ_WEAPON, OBJ_SHIP):
+			case COLLISION_OF(OBJ_SHIP, OBJ_WEAPON):
+				check_collision = collide_ship_weapon_check;
+				break;
+			case COLLISION_OF(OBJ_SHIP, OBJ_SHIP):
+				check_collision = collide_ship_ship_check;
+				break;
+			case COLLISION_OF(OBJ_DEBRIS, OBJ_WEAPON):
+			case COLLISION_OF(OBJ_WEAPON, OBJ_DEBRIS):
+				check_collision = collide_debris_weapon_check;
+				break;
+			case COLLISION_OF(OBJ_DEBRIS, OBJ_SHIP):
+			case COLLISION_OF(OBJ_SHIP, OBJ_DEBRIS):
+				check_collision = collide_debris_ship_check;
+				break;
+			case COLLISION_OF(OBJ_DEBRIS, OBJ_PROP):
+			case COLLISION_OF(OBJ_PROP, OBJ_DEBRIS):
+				check_collision = collide_debris_prop_check;
+				break;
+			case COLLISION_OF(OBJ_ASTEROID, OBJ_WEAPON):
+			case COLLISION_OF(OBJ_WEAPON, OBJ_ASTEROID):
+				check_collision = collide_asteroid_weapon_check;
+				break;
+			case COLLISION_OF(OBJ_ASTEROID, OBJ_SHIP):
+			case COLLISION_OF(OBJ_SHIP, OBJ_ASTEROID):
+				check_collision = collide_asteroid_ship_check;
+				break;
+			case COLLISION_OF(OBJ_ASTEROID, OBJ_PROP):
+			case COLLISION_OF(OBJ_PROP, OBJ_ASTEROID):
+				check_collision = collide_asteroid_prop_check;
+				break;
+			case COLLISION_OF(OBJ_WEAPON, OBJ_WEAPON):
+				check_collision = collide_weapon_weapon_check;
+				break;
+			case COLLISION_OF(OBJ_SHIP, OBJ_BEAM):
+			case COLLISION_OF(OBJ_BEAM, OBJ_SHIP):
+				check_collision = beam_collide_ship_check;
+				break;
+			case COLLISION_OF(OBJ_ASTEROID, OBJ_BEAM):
+			case COLLISION_OF(OBJ_BEAM, OBJ_ASTEROID):
+				check_collision = beam_collide_asteroid_check;
+				break;
+			case COLLISION_OF(OBJ_DEBRIS, OBJ_BEAM):
+			case COLLISION_OF(OBJ_BEAM, OBJ_DEBRIS):
+				check_collision = beam_collide_debris_check;
+				break;
+			case COLLISION_OF(OBJ_WEAPON, OBJ_BEAM):
+			case COLLISION_OF(OBJ_BEAM, OBJ_WEAPON):
+				check_collision = beam_collide_missile_check;
+				break;
+			case COLLISION_OF(OBJ_PROP, OBJ_BEAM):
+			case COLLISION_OF(OBJ_BEAM, OBJ_PROP):
+				check_collision = beam_collide_prop_check;
+				break;
+			default:
+				UNREACHABLE("Got non MP-compatible collision type %d!", collision_check.ctype);
+				// keep the counter balanced and skip the bad pair
+				collision_results_pending.fetch_sub(1, std::memory_order_acq_rel);
+				collision_results_available.notify();
+				continue;
 		}
+
+		auto&& [never_check_again, collision_data_maybe, collision_fnc] = check_collision(&collision_check.objs);
+
+		thread.results.push(collision_thread_data::collision_queue_result{collision_check.objs, never_check_again, std::move(collision_data_maybe), collision_fnc});
+		collision_results_pending.fetch_sub(1, std::memory_order_acq_rel);
+		collision_results_available.notify();
 	}
 }
 
+} //anon namespace
+
 void collide_init() {
 	if (threading::is_threading())
 		collision_thread_data_buffer = std::make_unique<collision_thread_data[]>(threading::get_num_workers());
@@ -1242,6 +1390,7 @@ void collide_init() {
 // used only in obj_sort_and_collide()
 static SCP_vector<int> sort_list_y;
 static SCP_vector<int> sort_list_z;
+static SCP_vector<int> overlap_list;
 
 void obj_sort_and_collide(SCP_vector<int>* Collision_list)
 {
@@ -1258,32 +1407,61 @@ void obj_sort_and_collide(SCP_vector<int>* Collision_list)
 		obj_collide_retime_stale_pairs();
 	}
 
-	// the main use case is to go through the main Collision detection list, so use that if
-	// nothing is defined.
+	// the main use case is to go through the main Collision detection list, which keeps its
+	// per-axis orderings from frame to frame.  Any other list is sorted from scratch.
+	SCP_vector<int> *list_x, *list_y, *list_z;
+	size_t *sorted_x, *sorted_y, *sorted_z;
+	size_t unsorted[3] = { 0, 0, 0 };
+
+	obj_compact_colliders();
+
 	if (Collision_list == nullptr) {
-		Collision_list = &Collision_sort_list;
+		list_x = &Collision_sort_list;
+		list_y = &Collision_sort_list_y;
+		list_z = &Collision_sort_list_z;
+		sorted_x = &Collision_sorted_count[0];
+		sorted_y = &Collision_sorted_count[1];
+		sorted_z = &Collision_sorted_count[2];
+	} else {
+		sort_list_y = *Collision_list;
+		sort_list_z = *Collision_list;
+
+		list_x = Collision_list;
+		list_y = &sort_list_y;
+		list_z = &sort_list_z;
+		sorted_x = &unsorted[0];
+		sorted_y = &unsorted[1];
+		sorted_z = &unsorted[2];
+	}
+
+	for (int obj_num : *list_x) {
+		obj_update_collider_bounds(obj_num);
 	}
 
-	sort_list_y.clear();
+	// only objects overlapping something on x are considered on y, and only those overlapping
+	// something on y as well are considered on z, where the actual collision checks happen
+	int sweep = obj_next_overlap_sweep();
 	{
 		TRACE_SCOPE(tracing::SortColliders);
-		obj_quicksort_colliders(Collision_list, 0, (int)(Collision_list->size() - 1), 0);
+		obj_sort_colliders(*list_x, *sorted_x, 0);
 	}
-	obj_find_overlap_colliders(sort_list_y, *Collision_list, 0, false);
+	obj_find_overlap_colliders(*list_x, 0, sweep, false);
 
-	sort_list_z.clear();
 	{
 		TRACE_SCOPE(tracing::SortColliders);
-		obj_quicksort_colliders(&sort_list_y, 0, (int)(sort_list_y.size() - 1), 1);
+		obj_sort_colliders(*list_y, *sorted_y, 1);
 	}
-	obj_find_overlap_colliders(sort_list_z, sort_list_y, 1, false);
+	obj_filter_overlap_colliders(overlap_list, *list_y, sweep);
+	sweep = obj_next_overlap_sweep();
+	obj_find_overlap_colliders(overlap_list, 1, sweep, false);
 
-	sort_list_y.clear();
 	{
 		TRACE_SCOPE(tracing::SortColliders);
-		obj_quicksort_colliders(&sort_list_z, 0, (int)(sort_list_z.size() - 1), 2);
+		obj_sort_colliders(*list_z, *sorted_z, 2);
 	}
-	obj_find_overlap_colliders(sort_list_y, sort_list_z, 2, true);
+	obj_filter_overlap_colliders(overlap_list, *list_z, sweep);
+	sweep = obj_next_overlap_sweep();
+	obj_find_overlap_colliders(overlap_list, 2, sweep, true);
 
 	if (threading::is_threading())
 		post_process_threaded_collisions();
@@ -32,6 +32,7 @@
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "observer/observer.h"
@@ -1590,6 +1591,12 @@ void obj_move_all(float frametime)
 
 	obj_merge_created_list();
 
+	// turrets look up their targets in the grid while objects are being moved below
+	obj_grid_rebuild(frametime);
+
+	// pick turret targets in parallel while nothing is moving
+	ai_turret_think_all();
+
 	// Clear the table that tells which groups of weapons have cast light so far.
 	if(!(Game_mode & GM_MULTIPLAYER) || (MULTIPLAYER_MASTER)) {
 		obj_clear_weapon_group_id_list();
@@ -0,0 +1,453 @@
+#include "object/objectgrid.h"
+
+#include "asteroid/asteroid.h"
+#include "cfile/cfile.h"
+#include "debugconsole/console.h"
+#include "iff_defs/iff_defs.h"
+#include "model/model.h"
+#include "object/object.h"
+#include "ship/ship.h"
+#include "weapon/weapon.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+object_grid Object_grid;
+
+namespace {
+// Cells are addressed with 21 bits per axis, which covers far more than any mission uses
+constexpr int CELL_COORD_LIMIT = (1 << 20) - 1;
+
+// Objects can speed up during the frame, so allow for more than their current speed
+constexpr float REACH_SPEED_SLACK = 2.0f;
+
+// signatures of the objects when the grid was built, to leave out objects deleted since then
+int Grid_signatures[MAX_OBJECTS];
+
+// objects added to the ship, missile and asteroid lists since the grid was built
+struct late_object {
+	int objnum;
+	int signature;
+};
+SCP_vector<late_object> Grid_late_objects;
+
+// see DCF(grid_snapshot)
+SCP_string Grid_snapshot_pending;
+CFILE* Grid_snapshot_file = nullptr;
+std::mutex Grid_snapshot_mutex;
+}
+
+int object_grid::cell_coord(float value)
+{
+	auto coord = static_cast<int>(std::floor(value / CELL_SIZE));
+	CLAMP(coord, -CELL_COORD_LIMIT, CELL_COORD_LIMIT);
+	return coord;
+}
+
+uint64_t object_grid::cell_key(int x, int y, int z)
+{
+	constexpr uint64_t mask = (1 << 21) - 1;
+	return ((static_cast<uint64_t>(x) & mask) << 42) | ((static_cast<uint64_t>(y) & mask) << 21) | (static_cast<uint64_t>(z) & mask);
+}
+
+bool object_grid::cell_overlaps(const cell& c, const vec3d& center, float radius)
+{
+	// distance from the sphere to the box of the cell, grown by the reach of its entries
+	const int coords[3] = {c.x, c.y, c.z};
+	float dist_squared = 0.0f;
+	for (int i = 0; i < 3; ++i) {
+		float low = coords[i] * CELL_SIZE - c.max_reach;
+		float high = (coords[i] + 1) * CELL_SIZE + c.max_reach;
+		float value = center.a1d[i];
+
+		if (value < low)
+			dist_squared += (low - value) * (low - value);
+		else if (value > high)
+			dist_squared += (value - high) * (value - high);
+	}
+
+	return dist_squared <= radius * radius;
+}
+
+bool object_grid::cell_matches(const cell& c, const filter& filter)
+{
+	if (!(c.type_mask & filter.type_mask))
+		return false;
+
+	return filter.team_mask == -1 || (c.team_mask & filter.team_mask);
+}
+
+bool object_grid::entry_matches(const entry& e, const vec3d& center, float radius, const filter& filter)
+{
+	if (!(type_bit(e.type) & filter.type_mask))
+		return false;
+
+	if (filter.team_mask != -1 && !(e.team_mask & filter.team_mask))
+		return false;
+
+	if ((e.flags & filter.required_flags) != filter.required_flags || (e.flags & filter.excluded_flags))
+		return false;
+
+	float max_dist = radius + e.reach;
+	return vm_vec_dist_squared(&center, &e.pos) <= max_dist * max_dist;
+}
+
+bool object_grid::item_matches(const item& it, const filter& filter)
+{
+	if (!(it.type_mask & filter.type_mask))
+		return false;
+
+	if (filter.team_mask != -1 && !(it.team_mask & filter.team_mask))
+		return false;
+
+	return (it.flags & filter.required_flags) == filter.required_flags && !(it.flags & filter.excluded_flags);
+}
+
+void object_grid::build(const SCP_vector<entry>& entries)
+{
+	clear();
+
+	_keys.clear();
+	for (uint i = 0; i < static_cast<uint>(entries.size()); ++i) {
+		const auto& pos = entries[i].pos;
+		_keys.emplace_back(cell_key(cell_coord(pos.xyz.x), cell_coord(pos.xyz.y), cell_coord(pos.xyz.z)), i);
+
+		_objnums.push_back(entries[i].objnum);
+	}
+
+	// order within a cell stays the order of the entries
+	std::sort(_keys.begin(), _keys.end());
+
+	for (const auto& key : _keys) {
+		const auto& e = entries[key.second];
+
+		if (_cells.empty() || _cells.back().key != key.first) {
+			auto begin = static_cast<uint>(_items.size());
+			_cells.push_back({key.first, cell_coord(e.pos.xyz.x), cell_coord(e.pos.xyz.y), cell_coord(e.pos.xyz.z), begin, begin, 0, 0, 0.0f});
+		}
+
+		auto& c = _cells.back();
+		c.end++;
+		c.type_mask |= type_bit(e.type);
+		c.team_mask |= e.team_mask;
+		c.max_reach = std::max(c.max_reach, e.reach);
+
+		_items.push_back({e.pos, e.reach, type_bit(e.type), e.team_mask, e.flags, key.second});
+		_max_reach = std::max(_max_reach, e.reach);
+	}
+}
+
+void object_grid::clear()
+{
+	_items.clear();
+	_objnums.clear();
+	_cells.clear();
+	_max_reach = 0.0f;
+}
+
+const object_grid::cell* object_grid::find_cell(uint64_t key) const
+{
+	auto it = std::lower_bound(_cells.begin(), _cells.end(), key, [](const cell& c, uint64_t k) { return c.key < k; });
+	if (it == _cells.end() || it->key != key)
+		return nullptr;
+
+	return &*it;
+}
+
+template <typename Func>
+void object_grid::for_each_overlapping(const vec3d& center, float radius, const filter& filter, Func&& func) const
+{
+	auto search_cell = [&](const cell& c) {
+		if (!cell_matches(c, filter) || !cell_overlaps(c, center, radius))
+			return;
+
+		for (uint i = c.begin; i < c.end; ++i) {
+			const auto& it = _items[i];
+			if (!item_matches(it, filter))
+				continue;
+
+			float max_dist = radius + it.reach;
+			if (vm_vec_dist_squared(&center, &it.pos) <= max_dist * max_dist)
+				func(it);
+		}
+	};
+
+	// entries are in the cell of their position, so the cells around the sphere have to cover the largest reach
+	const float search = radius + _max_reach;
+	int low[3], high[3];
+	size_t num_search_cells = 1;
+	for (int i = 0; i < 3; ++i) {
+		low[i] = cell_coord(center.a1d[i] - search);
+		high[i] = cell_coord(center.a1d[i] + search);
+		num_search_cells *= static_cast<size_t>(high[i] - low[i] + 1);
+
+		// don't let huge searches overflow
+		num_search_cells = std::min(num_search_cells, _cells.size() + 1);
+	}
+
+	if (num_search_cells <= _cells.size()) {
+		for (int x = low[0]; x <= high[0]; ++x) {
+			for (int y = low[1]; y <= high[1]; ++y) {
+				for (int z = low[2]; z <= high[2]; ++z) {
+					auto c = find_cell(cell_key(x, y, z));
+					if (c != nullptr)
+						search_cell(*c);
+				}
+			}
+		}
+	} else {
+		// fewer cells are occupied than the search would have to look up
+		for (const auto& c : _cells)
+			search_cell(c);
+	}
+}
+
+void object_grid::find(const vec3d& center, float radius, const filter& filter, SCP_vector<int>& objnums) const
+{
+	const size_t first = objnums.size();
+
+	for_each_overlapping(center, radius, filter, [&objnums](const item& it) { objnums.push_back(static_cast<int>(it.order)); });
+
+	std::sort(objnums.begin() + first, objnums.end());
+	for (size_t i = first; i < objnums.size(); ++i)
+		objnums[i] = _objnums[objnums[i]];
+}
+
+void object_grid::find_nearest(const vec3d& center, float radius, size_t count, const filter& filter, SCP_vector<int>& objnums) const
+{
+	static thread_local SCP_vector<std::pair<float, uint>> found;
+	found.clear();
+
+	for_each_overlapping(center, radius, filter, [&center](const item& it) { found.emplace_back(vm_vec_dist_squared(&center, &it.pos), it.order); });
+
+	count = std::min(count, found.size());
+	std::partial_sort(found.begin(), found.begin() + count, found.end());
+
+	for (size_t i = 0; i < count; ++i)
+		objnums.push_back(_objnums[found[i].second]);
+}
+
+// Fills in the entry of a ship, missile or asteroid, allowing for it to move for frametime seconds.  Returns false for
+// objects the grid leaves out.
+static bool obj_grid_make_entry(const object* objp, float frametime, object_grid::entry& e)
+{
+	if (objp->flags[Object::Object_Flags::Should_be_dead])
+		return false;
+
+	int team = -1;
+	int flags = 0;
+	float extent = 0.0f;
+
+	switch (objp->type) {
+	case OBJ_SHIP: {
+		auto shipp = &Ships[objp->instance];
+		auto sip = &Ship_info[shipp->ship_info_index];
+
+		team = shipp->team;
+		if (shipp->flags[Ship::Ship_Flags::Dying])
+			flags |= OGF_DYING;
+		if (sip->flags[Ship::Info_Flags::No_ship_type] || sip->flags[Ship::Info_Flags::Navbuoy])
+			flags |= OGF_NOT_A_TARGET_CLASS;
+
+		// distances to big ships are measured to their bounding box, whose corners can stick out of the radius
+		if (sip->model_num >= 0) {
+			auto pm = model_get(sip->model_num);
+			vec3d corner;
+			for (int i = 0; i < 3; ++i)
+				corner.a1d[i] = std::max(fabsf(pm->mins.a1d[i]), fabsf(pm->maxs.a1d[i]));
+			extent = vm_vec_mag(&corner);
+		}
+		break;
+	}
+
+	case OBJ_WEAPON: {
+		auto wp = &Weapons[objp->instance];
+		auto wip = &Weapon_info[wp->weapon_info_index];
+
+		team = wp->team;
+		if (wip->wi_flags[Weapon::Info_Flags::Bomb] || wip->wi_flags[Weapon::Info_Flags::Fighter_Interceptable])
+			flags |= OGF_FIGHTER_INTERCEPTABLE;
+		break;
+	}
+
+	case OBJ_ASTEROID:
+		break;
+
+	default:
+		return false;
+	}
+
+	const auto& pi = objp->phys_info;
+	float max_speed = std::max({vm_vec_mag(&pi.vel), vm_vec_mag(&pi.max_vel), vm_vec_mag(&pi.afterburner_max_vel)});
+
+	e.objnum = OBJ_INDEX(objp);
+	e.type = objp->type;
+	e.team_mask = team >= 0 ? iff_get_mask(team) : 0;
+	e.flags = flags;
+	e.pos = objp->pos;
+	e.reach = std::max(objp->radius, extent) + max_speed * frametime * REACH_SPEED_SLACK;
+	return true;
+}
+
+static void obj_grid_snapshot_puts(const char* line)
+{
+	std::lock_guard<std::mutex> guard(Grid_snapshot_mutex);
+	cfputs(line, Grid_snapshot_file);
+}
+
+static void obj_grid_snapshot_filter(char* line, size_t size, const object_grid::filter& filter)
+{
+	snprintf(line, size, " %d %d %d %d\n", filter.type_mask, filter.team_mask, filter.required_flags, filter.excluded_flags);
+}
+
+// Writes the entries of the grid to the snapshot file started with DCF(grid_snapshot)
+static void obj_grid_snapshot_entries(float frametime, const SCP_vector<object_grid::entry>& entries)
+{
+	char line[256];
+
+	obj_grid_snapshot_puts("; object grid snapshot, see DCF(grid_snapshot)\n");
+	snprintf(line, sizeof(line), "frametime %f\n", frametime);
+	obj_grid_snapshot_puts(line);
+
+	for (const auto& e : entries) {
+		snprintf(line, sizeof(line), "entry %d %d %d %d %f %f %f %f\n", e.objnum, e.type, e.team_mask, e.flags, e.pos.xyz.x, e.pos.xyz.y, e.pos.xyz.z, e.reach);
+		obj_grid_snapshot_puts(line);
+	}
+}
+
+// Writes a query to the snapshot file, count is -1 for obj_grid_find()
+static void obj_grid_snapshot_query(const vec3d& center, float radius, int count, const object_grid::filter& filter)
+{
+	char line[256];
+
+	int len;
+	if (count < 0)
+		len = snprintf(line, sizeof(line), "find %f %f %f %f", center.xyz.x, center.xyz.y, center.xyz.z, radius);
+	else
+		len = snprintf(line, sizeof(line), "nearest %f %f %f %f %d", center.xyz.x, center.xyz.y, center.xyz.z, radius, count);
+	obj_grid_snapshot_filter(line + len, sizeof(line) - len, filter);
+
+	obj_grid_snapshot_puts(line);
+}
+
+void obj_grid_rebuild(float frametime)
+{
+	static SCP_vector<object_grid::entry> entries;
+	entries.clear();
+
+	// a snapshot covers the queries of one frame
+	if (Grid_snapshot_file != nullptr) {
+		cfclose(Grid_snapshot_file);
+		Grid_snapshot_file = nullptr;
+		mprintf(("Saved the object grid snapshot\n"));
+	}
+
+	auto add_entry = [frametime](const object* objp) {
+		object_grid::entry e;
+		if (!obj_grid_make_entry(objp, frametime, e))
+			return;
+
+		entries.push_back(e);
+		Grid_signatures[e.objnum] = objp->signature;
+	};
+
+	for (auto so : list_range(&Ship_obj_list))
+		add_entry(&Objects[so->objnum]);
+
+	for (auto mo : list_range(&Missile_obj_list))
+		add_entry(&Objects[mo->objnum]);
+
+	for (auto ao : list_range(&Asteroid_obj_list))
+		add_entry(&Objects[ao->objnum]);
+
+	Object_grid.build(entries);
+	Grid_late_objects.clear();
+
+	if (!Grid_snapshot_pending.empty()) {
+		Grid_snapshot_file = cfopen(Grid_snapshot_pending.c_str(), "wt", CF_TYPE_DATA);
+		if (Grid_snapshot_file != nullptr)
+			obj_grid_snapshot_entries(frametime, entries);
+		else
+			mprintf(("Couldn't open %s for the object grid snapshot\n", Grid_snapshot_pending.c_str()));
+
+		Grid_snapshot_pending.clear();
+	}
+}
+
+void obj_grid_add_late(int objnum)
+{
+	Grid_late_objects.push_back({objnum, Objects[objnum].signature});
+}
+
+static void obj_grid_remove_deleted(SCP_vector<int>& objnums, size_t first)
+{
+	auto end = std::remove_if(objnums.begin() + first, objnums.end(), [](int objnum) {
+		const auto& obj = Objects[objnum];
+		return obj.type == OBJ_NONE || obj.signature != Grid_signatures[objnum];
+	});
+	objnums.erase(end, objnums.end());
+}
+
+// Appends the objects created since the grid was built that match the query where they are now.  Returns how many.
+static size_t obj_grid_find_late(const vec3d& center, float radius, const object_grid::filter& filter, SCP_vector<int>& objnums)
+{
+	size_t found = 0;
+
+	for (const auto& late : Grid_late_objects) {
+		auto objp = &Objects[late.objnum];
+		if (objp->signature != late.signature)
+			continue;
+
+		object_grid::entry e;
+		if (obj_grid_make_entry(objp, 0.0f, e) && object_grid::entry_matches(e, center, radius, filter)) {
+			objnums.push_back(late.objnum);
+			++found;
+		}
+	}
+
+	return found;
+}
+
+void obj_grid_find(const vec3d& center, float radius, const object_grid::filter& filter, SCP_vector<int>& objnums)
+{
+	if (Grid_snapshot_file != nullptr)
+		obj_grid_snapshot_query(center, radius, -1, filter);
+
+	const size_t first = objnums.size();
+	Object_grid.find(center, radius, filter, objnums);
+	obj_grid_remove_deleted(objnums, first);
+
+	// they were added to the end of the object lists, so they come last there too
+	obj_grid_find_late(center, radius, filter, objnums);
+}
+
+void obj_grid_find_nearest(const vec3d& center, float radius, size_t count, const object_grid::filter& filter, SCP_vector<int>& objnums)
+{
+	if (Grid_snapshot_file != nullptr)
+		obj_grid_snapshot_query(center, radius, static_cast<int>(count), filter);
+
+	const size_t first = objnums.size();
+	Object_grid.find_nearest(center, radius, count, filter, objnums);
+	obj_grid_remove_deleted(objnums, first);
+
+	if (obj_grid_find_late(center, radius, filter, objnums) > 0) {
+		// the objects created since the grid was built may be nearer, so order everything by where it is now
+		std::stable_sort(objnums.begin() + first, objnums.end(), [&center](int a, int b) {
+			return vm_vec_dist_squared(&center, &Objects[a].pos) < vm_vec_dist_squared(&center, &Objects[b].pos);
+		});
+		objnums.resize(std::min(objnums.size(), first + count));
+	}
+}
+
+DCF(grid_snapshot, "Saves the object grid and all queries of it during the next frame to a file in data, for the object grid benchmark")
+{
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: grid_snapshot <filename>\n");
+		dc_printf("Saves the object grid and the queries of the next frame to data/<filename>.  Put it into test/test_data/objectgrid/DISABLED_snapshotBenchmark/data to have ObjectGridSnapshotTest.DISABLED_snapshotBenchmark replay it.\n");
+		return;
+	}
+
+	dc_stuff_string_white(Grid_snapshot_pending);
+	dc_printf("The next frame will be saved to data/%s\n", Grid_snapshot_pending.c_str());
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "math/vecmat.h"
+
+// Flags of grid entries, taken from the object when the grid is built
+#define OGF_DYING					(1<<0)	// ship is in its death throes
+#define OGF_NOT_A_TARGET_CLASS		(1<<1)	// ship class is flagged no ship type or navbuoy
+#define OGF_FIGHTER_INTERCEPTABLE	(1<<2)	// weapon is a bomb or fighter interceptable
+
+/**
+ * @brief Uniform grid over the ships, missiles and asteroids of the mission, used to find the objects near a point
+ * without walking the object lists
+ *
+ * The grid is rebuilt by obj_move_all() at the start of every frame, before anything moves.  Each entry keeps the
+ * position of its object at that time and a reach covering its extent plus how far it can move during the frame, so
+ * queries made while objects are being moved still find everything they should.  Queries return candidates only,
+ * callers still have to check the current positions.  Objects created later in the frame are checked one by one by the
+ * obj_grid_find*() queries until the next rebuild, see obj_grid_add_late().
+ *
+ * Entries are sorted into the cells they are centered in.  Every cell knows the combined type and team mask and the
+ * largest reach of its entries, so cells without anything matching are skipped as a whole.  Results come back in the
+ * order the entries were added in (i.e. object list order), so using the grid doesn't change which of two equally good
+ * candidates wins.
+ */
+class object_grid
+{
+  public:
+	struct entry {
+		int objnum = -1;
+		int type = 0;		// OBJ_* type of the object
+		int team_mask = 0;	// iff_get_mask() of the object's team, 0 if it doesn't have one
+		int flags = 0;		// OGF_* flags
+		vec3d pos = vmd_zero_vector;
+		float reach = 0.0f;
+	};
+
+	struct filter {
+		int type_mask = -1;			// type_bit()s of the types to find, -1 for all types
+		int team_mask = -1;			// teams to find, -1 for all objects including those without a team
+		int required_flags = 0;		// OGF_* flags all found entries have
+		int excluded_flags = 0;		// OGF_* flags no found entry has
+	};
+
+	static constexpr int type_bit(int type) { return 1 << type; }
+
+	// Whether the entry passes the filter and its reach overlaps the sphere around center, as the queries decide it
+	static bool entry_matches(const entry& e, const vec3d& center, float radius, const filter& filter);
+
+	object_grid() = default;
+
+	// Replaces the contents of the grid.  Query results come back in the order of entries.
+	void build(const SCP_vector<entry>& entries);
+
+	void clear();
+
+	// Appends the object numbers of all entries passing the filter whose reach overlaps the sphere around center, in
+	// the order they were added in.
+	void find(const vec3d& center, float radius, const filter& filter, SCP_vector<int>& objnums) const;
+
+	// Appends the object numbers of up to count entries passing the filter whose reach overlaps the sphere around
+	// center, nearest position first.  Entries at the same distance come in the order they were added in.
+	void find_nearest(const vec3d& center, float radius, size_t count, const filter& filter, SCP_vector<int>& objnums) const;
+
+	size_t size() const { return _items.size(); }
+
+  private:
+	struct item {
+		vec3d pos;
+		float reach;
+		int type_mask;
+		int team_mask;
+		int flags;
+		uint order;	// index of the entry in the order it was added in
+	};
+
+	struct cell {
+		uint64_t key;
+		int x, y, z;
+		uint begin;
+		uint end;
+		int type_mask;
+		int team_mask;
+		float max_reach;
+	};
+
+	static constexpr float CELL_SIZE = 2048.0f;
+
+	SCP_vector<item> _items;	// sorted by cell
+	SCP_vector<int> _objnums;	// in the order the entries were added in
+	SCP_vector<cell> _cells;	// sorted by key
+	float _max_reach = 0.0f;
+
+	SCP_vector<std::pair<uint64_t, uint>> _keys;	// only used by build(), kept around so that it doesn't allocate
+
+	static int cell_coord(float value);
+	static uint64_t cell_key(int x, int y, int z);
+
+	static bool cell_overlaps(const cell& c, const vec3d& center, float radius);
+	static bool cell_matches(const cell& c, const filter& filter);
+	static bool item_matches(const item& it, const filter& filter);
+
+	const cell* find_cell(uint64_t key) const;
+
+	// Calls func(item) for every entry passing the filter whose reach overlaps the sphere, in no particular order
+	template <typename Func>
+	void for_each_overlapping(const vec3d& center, float radius, const filter& filter, Func&& func) const;
+};
+
+extern object_grid Object_grid;
+
+// Rebuilds Object_grid from the ship, missile and asteroid lists, allowing for objects to move for frametime seconds
+void obj_grid_rebuild(float frametime);
+
+// Called when an object is added to the ship, missile or asteroid list.  Until the next rebuild, queries check it at
+// its current position on top of what the grid finds.  Not safe while queries run on other threads.
+void obj_grid_add_late(int objnum);
+
+// Queries Object_grid, see object_grid::find() and object_grid::find_nearest().  Objects deleted since the grid was
+// built are left out, objects created since then are added.  Safe to call from several threads at once.
+void obj_grid_find(const vec3d& center, float radius, const object_grid::filter& filter, SCP_vector<int>& objnums);
+void obj_grid_find_nearest(const vec3d& center, float radius, size_t count, const object_grid::filter& filter, SCP_vector<int>& objnums);
@@ -11,6 +11,7 @@
 #include <cstdarg>
 #include <cstring>
 #include <algorithm>
+#include <mutex>
 
 #ifdef WIN32
 #include <direct.h>
@@ -51,6 +52,9 @@ static SCP_deque<OutwndLogEntry>& log_history()
 	return history;
 }
 
+// Log lines may also come from worker threads. Recursive since outwnd_print() calls itself for the filter warning.
+static std::recursive_mutex Outwnd_mutex;
+
 // used for file logging
 bool Log_debug_output_to_file = true;
 
@@ -206,6 +210,8 @@ void outwnd_print(const char *id, const char *tmp)
 	if (!outwnd_inited)
 		return;
 
+	std::scoped_lock lock {Outwnd_mutex};
+
 	if (Outwnd_no_filter_file == 1) {
 		Outwnd_no_filter_file = 2;
 
@@ -360,6 +366,7 @@ const SCP_deque<OutwndLogEntry>& outwnd_get_log_history()
 
 void outwnd_clear_log_history()
 {
+	std::scoped_lock lock {Outwnd_mutex};
 	log_history().clear();
 }
 
@@ -81,6 +81,9 @@ public:
 
 	virtual float getHostRadius() const { return 0.f; }
 
+	// Whether the host is small enough around its position that its sources may be culled by it
+	virtual bool isCompact() const { return true; }
+
 	virtual bool isValid() const { return true; }
 
 	virtual void setupProcessing() {}
@@ -142,6 +142,15 @@ float ParticleEffect::getApproximatePixelSize(const vec3d& pos) const {
 		gr_screen.max_w);
 }
 
+bool ParticleEffect::isCullable() const {
+	// A one-time effect only gets to emit once, so whatever it doesn't emit now would be gone for good
+	return m_duration != Duration::ONETIME && !m_light_source && !m_particleTrail.isValid() && !m_deathEffect.isValid();
+}
+
+float ParticleEffect::getApproximateRadius(float parentRadius) const {
+	return m_parentScale ? parentRadius * m_radius.avg() : m_radius.avg();
+}
+
 float ParticleEffect::getCurrentFrequencyMult(decltype(modular_curves_definition)::input_type_t source) const {
 	return m_modular_curves.get_output(ParticleEffect::ParticleCurvesOutput::PARTICLE_FREQ_MULT, source);
 }
@@ -235,15 +244,18 @@ auto ParticleEffect::processSourceInternal(float interp, const ParticleSource& s
 	if (m_affectedByDetail){
 		if (Detail.num_particles > 0)
 			particle_percent *= (0.5f + (0.25f * static_cast<float>(Detail.num_particles - 1)));
+		else
+			particle_percent = 0.f;
+	}
+
+	//Will not emit on current detail settings or because the source has been culled, but may in the future.
+	if (particle_percent <= 0.f) {
+		if constexpr (isPersistent)
+			return createdParticles;
 		else {
-			//Will not emit on current detail settings, but may in the future.
-			if constexpr (isPersistent)
-				return createdParticles;
-			else {
-				const auto& [pos, hostOrientation] = source.m_host->getPositionAndOrientation(m_parent_local, interp, m_manual_offset);
-				auto modularCurvesInput = std::forward_as_tuple(source, effectNumber, pos);
-				return getCurrentFrequencyMult(modularCurvesInput);
-			}
+			const auto& [pos, hostOrientation] = source.m_host->getPositionAndOrientation(m_parent_local, interp, m_manual_offset);
+			auto modularCurvesInput = std::forward_as_tuple(source, effectNumber, pos);
+			return getCurrentFrequencyMult(modularCurvesInput);
 		}
 	}
 
@@ -33,6 +33,8 @@ namespace anl {
 
 namespace particle {
 
+struct particle_group;
+
 /**
  * @brief Defines a particle effect
  *
@@ -134,8 +136,8 @@ public:
 	friend class ParticleManager;
 	friend int ::parse_weapon(int, bool, const char*);
 	friend ParticleEffectHandle scripting::api::getLegacyScriptingParticleEffect(int bitmap, bool reversed);
-	friend bool move_particle(float frametime, particle* part);
 	friend bool render_particle(particle* part);
+	friend struct particle_group;
 
 	SCP_string m_name; //!< The name of this effect
 
@@ -258,6 +260,13 @@ public:
 
 	float getApproximatePixelSize(const vec3d& pos) const;
 
+	// Whether sources of this effect may emit less when they can't be seen. Only effects that keep emitting may do so,
+	// and not those that light up their surroundings or start other effects.
+	bool isCullable() const;
+
+	// The average radius of the particles this effect creates for a host of the given scale
+	float getApproximateRadius(float parentRadius) const;
+
 	constexpr static auto modular_curves_definition = make_modular_curve_definition<ParticleSource, ParticleCurvesOutput>(
 		std::array {
 			std::pair {"Particle Number Mult", ParticleCurvesOutput::PARTICLE_NUM_MULT},
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <memory>
+#include <numeric>
 
 #include "particle/ParticleEffect.h"
 
@@ -8,11 +9,17 @@
 #include "bmpman/bmpman.h"
 #include "globalincs/systemvars.h"
 #include "tracing/tracing.h"
+#include "utils/threading.h"
 
 /**
  * @defgroup particleSystems Particle System
  */
 
+namespace {
+// Determining validity and emission is cheap, so only hand out larger chunks of sources
+constexpr size_t SOURCE_EVALUATION_GRAIN_SIZE = 256;
+}
+
 namespace particle {
 std::unique_ptr<ParticleManager> ParticleManager::m_manager = nullptr;
 
@@ -74,6 +81,49 @@ ParticleEffectHandle ParticleManager::getEffectByName(const SCP_string& name)
 	return ParticleEffectHandle(distance(m_effects.begin(), foundIterator));
 }
 
+void ParticleManager::updateEffectBatches() {
+	SCP_vector<size_t> parent(m_effects.size());
+	std::iota(parent.begin(), parent.end(), static_cast<size_t>(0));
+
+	auto find_root = [&parent](size_t effect) {
+		while (parent[effect] != effect) {
+			parent[effect] = parent[parent[effect]];
+			effect = parent[effect];
+		}
+		return effect;
+	};
+
+	// Copies of an effect (e.g. in legacy composite effects) share their volumes and noise with the original
+	SCP_unordered_map<const void*, size_t> owners;
+	for (size_t i = 0; i < m_effects.size(); i++) {
+		for (const auto& subeffect : m_effects[i]) {
+			for (const void* shared : {static_cast<const void*>(subeffect.m_spawnVolume.get()),
+				     static_cast<const void*>(subeffect.m_velocityVolume.get()),
+				     static_cast<const void*>(subeffect.m_spawnNoise.get()),
+				     static_cast<const void*>(subeffect.m_velocityNoise.get())}) {
+				if (shared == nullptr)
+					continue;
+
+				auto [owner, inserted] = owners.emplace(shared, i);
+				if (!inserted)
+					parent[find_root(i)] = find_root(owner->second);
+			}
+		}
+	}
+
+	m_effectBatch.resize(m_effects.size());
+	m_batchIsSerial.assign(m_effects.size(), false);
+	for (size_t i = 0; i < m_effects.size(); i++) {
+		m_effectBatch[i] = find_root(i);
+
+		// Trails create persistent particles and new sources
+		for (const auto& subeffect : m_effects[i]) {
+			if (subeffect.m_particleTrail.isValid())
+				m_batchIsSerial[m_effectBatch[i]] = true;
+		}
+	}
+}
+
 void ParticleManager::doFrame(float) {
 	if (Is_standalone) {
 		return;
@@ -81,28 +131,70 @@ void ParticleManager::doFrame(float) {
 
 	TRACE_SCOPE(tracing::ProcessParticleEffects);
 
+	if (m_effectBatch.size() != m_effects.size())
+		updateEffectBatches();
+
 	m_processingSources = true;
 	bool changehappened = false;
 
-	for (auto source = std::begin(m_sources); source != std::end(m_sources);) {
-		if (!source->isValid() || !source->process()) {
-			changehappened = true;
+	// Hosts are only read here, so all sources can be looked at in parallel
+	m_sourceEmission.resize(m_sources.size());
+	threading::parallel_for(0, m_sources.size(), SOURCE_EVALUATION_GRAIN_SIZE, [this](size_t i) {
+		const auto& source = m_sources[i];
+		m_sourceEmission[i] = source.isValid() ? source.getEmissionMultiplier() : -1.f;
+	});
+
+	// Group the valid sources by batch, keeping them in order within a batch
+	m_sourceKeepRunning.assign(m_sources.size(), 0);
+	m_sourceOrder.clear();
+	for (size_t i = 0; i < m_sources.size(); i++) {
+		if (m_sourceEmission[i] >= 0.f)
+			m_sourceOrder.emplace_back(m_effectBatch[m_sources[i].getEffectHandle().value()], i);
+	}
+	std::sort(m_sourceOrder.begin(), m_sourceOrder.end());
 
-			// if we're sitting on the very last source, popping-back will invalidate the iterator!
-			if (std::next(source) == m_sources.end()) {
-				m_sources.pop_back();
-				break;
-			}
+	auto process_range = [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			size_t index = m_sourceOrder[i].second;
+			m_sourceKeepRunning[index] = m_sources[index].process(m_sourceEmission[index]) ? 1 : 0;
+		}
+	};
+
+	begin_buffered_creation();
+
+	m_batchRanges.clear();
+	for (size_t begin = 0; begin < m_sourceOrder.size();) {
+		size_t batch = m_sourceOrder[begin].first;
+		size_t end = begin + 1;
+		while (end < m_sourceOrder.size() && m_sourceOrder[end].first == batch)
+			++end;
 
-			*source = std::move(m_sources.back());
-			m_sources.pop_back();
+		if (m_batchIsSerial[batch])
+			process_range(begin, end);
+		else
+			m_batchRanges.emplace_back(begin, end);
+
+		begin = end;
+	}
+
+	threading::parallel_for(0, m_batchRanges.size(), 1, [this, &process_range](size_t i) {
+		process_range(m_batchRanges[i].first, m_batchRanges[i].second);
+	});
+
+	end_buffered_creation();
+
+	size_t kept = 0;
+	for (size_t i = 0; i < m_sources.size(); i++) {
+		if (!m_sourceKeepRunning[i]) {
+			changehappened = true;
 			continue;
 		}
 
-		// source is only incremented here as elements would be skipped in
-		// the case that a source needs to be removed
-		++source;
+		if (kept != i)
+			m_sources[kept] = std::move(m_sources[i]);
+		++kept;
 	}
+	m_sources.erase(m_sources.begin() + kept, m_sources.end());
 
 	m_processingSources = false;
 
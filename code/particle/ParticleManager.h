@@ -39,6 +39,20 @@ class ParticleManager {
 	bool m_processingSources = false; //!< @c true if sources are currently being processed
 
 	uint32_t m_sourceValidityCounter = 0;
+
+	/**
+	 * Effects which share state that is modified when particles are created (e.g. the random number generators of
+	 * their volumes) are put in the same batch. Sources of different batches can be processed in parallel.
+	 */
+	SCP_vector<size_t> m_effectBatch;
+	SCP_vector<bool> m_batchIsSerial; //!< Whether sources of a batch can only be processed on the main thread
+
+	// Per-frame scratch space of doFrame()
+	SCP_vector<float> m_sourceEmission;
+	SCP_vector<ubyte> m_sourceKeepRunning;
+	SCP_vector<std::pair<size_t, size_t>> m_sourceOrder;
+	SCP_vector<std::pair<size_t, size_t>> m_batchRanges;
+
 	/**
 	 * If the sources are currently being processed, no additional sources can be added. Instead, they are added to this
 	 * vector and then added to the main vector when processing is done.
@@ -61,6 +75,11 @@ class ParticleManager {
 	 * @return The source pointer
 	 */
 	ParticleSource* createSource();
+
+	/**
+	 * @brief Recomputes #m_effectBatch and #m_batchIsSerial for all effects
+	 */
+	void updateEffectBatches();
  public:
 	ParticleManager();
 
@@ -1,9 +1,49 @@
 #include <math/bitarray.h>
 #include "freespace.h"
+#include "debugconsole/console.h"
+#include "model/modelrender.h"
 #include "particle/ParticleSource.h"
 #include "particle/ParticleEffect.h"
+#include "render/3d.h"
 #include "weapon/weapon.h"
 
+namespace {
+bool Particle_source_culling = true;
+
+// Sources whose particles are smaller than this on screen emit proportionally fewer of them
+constexpr float SOURCE_FULL_EMISSION_PIXEL_SIZE = 1.0f;
+// Particles may still drift into view, so sources outside of the view frustum aren't culled completely
+constexpr float SOURCE_OFFSCREEN_EMISSION = 0.25f;
+// Below this, the few particles which would still be created are not worth processing the source for
+constexpr float SOURCE_MIN_EMISSION = 0.05f;
+
+bool sphere_in_view(const vec3d& pos, float radius) {
+	vec3d to_pos;
+	vm_vec_sub(&to_pos, &pos, &Eye_position);
+
+	float z = vm_vec_dot(&to_pos, &Eye_matrix.vec.fvec);
+	if (z < -radius)
+		return false;
+
+	float half_hfov = g3_get_hfov(Eye_fov) * 0.5f;
+	float aspect = gr_screen.clip_aspect > 0.0f ? gr_screen.clip_aspect : 1.0f;
+	float half_vfov = atanf(tanf(half_hfov) / aspect);
+
+	// distance of the center to each side plane, with the planes' normals pointing into the frustum
+	float x = vm_vec_dot(&to_pos, &Eye_matrix.vec.rvec);
+	float y = vm_vec_dot(&to_pos, &Eye_matrix.vec.uvec);
+	if (z * sinf(half_hfov) - fl_abs(x) * cosf(half_hfov) < -radius)
+		return false;
+	if (z * sinf(half_vfov) - fl_abs(y) * cosf(half_vfov) < -radius)
+		return false;
+
+	return true;
+}
+}
+
+DCF_BOOL2(particle_source_culling, Particle_source_culling, "Turns scaling down particle sources which can't be seen on/off",
+		  "Usage: particle_source_culling [bool]\nTurns scaling down the emission of tiny or offscreen particle sources on/off.  If nothing passed, then toggles it.\n");
+
 namespace particle {
 
 ParticleSource::ParticleSource() : m_normal(std::nullopt), m_effect(ParticleEffectHandle::invalid()) {
@@ -50,7 +90,40 @@ const SCP_vector<ParticleEffect>& ParticleSource::getEffect() const {
 	return ParticleManager::get()->getEffect(m_effect);
 }
 
-bool ParticleSource::process() {
+float ParticleSource::getEmissionMultiplier() const {
+	Assertion(m_host != nullptr, "Particle Source has no host!");
+	if (!Particle_source_culling || !m_host->isCompact())
+		return 1.f;
+
+	const auto& effectList = getEffect();
+
+	float parent_radius = m_host->getScale();
+	float particle_radius = 0.f;
+	for (const auto& effect : effectList) {
+		if (!effect.isCullable())
+			return 1.f;
+
+		particle_radius = std::max(particle_radius, effect.getApproximateRadius(parent_radius));
+	}
+
+	const auto& pos = m_host->getPositionAndOrientation(false, 0.f, std::nullopt).first;
+	float distance_to_eye = vm_vec_dist(&Eye_position, &pos);
+
+	float multiplier = 1.f;
+	if (distance_to_eye > particle_radius) {
+		float pixel_size = convert_distance_and_diameter_to_pixel_size(distance_to_eye, particle_radius * 2.f, g3_get_hfov(Eye_fov), gr_screen.max_w);
+		if (pixel_size < SOURCE_FULL_EMISSION_PIXEL_SIZE)
+			multiplier = pixel_size / SOURCE_FULL_EMISSION_PIXEL_SIZE;
+	}
+
+	// leave some room for the spread of the particles around the host
+	if (!sphere_in_view(pos, m_host->getHostRadius() + particle_radius * 4.f))
+		multiplier *= SOURCE_OFFSCREEN_EMISSION;
+
+	return multiplier < SOURCE_MIN_EMISSION ? 0.f : multiplier;
+}
+
+bool ParticleSource::process(float emissionMultiplier) {
 	Assertion(m_host != nullptr, "Particle Source has no host!");
 	const auto& effectList = getEffect();
 
@@ -58,7 +131,7 @@ bool ParticleSource::process() {
 	const auto& attachment = m_host->getParentAttachment();
 	float parent_radius = m_host->getScale();
 	float parent_lifetime = m_host->getLifetime();
-	float particleMultiplier = m_host->getParticleMultiplier();
+	float particleMultiplier = m_host->getParticleMultiplier() * emissionMultiplier;
 
 	bool result = false;
 	for (size_t i = 0; i < effectList.size(); i++) {
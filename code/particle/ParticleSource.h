@@ -99,11 +99,23 @@ class ParticleSource {
 	 */
 	void finishCreation();
 
+	/**
+	 * @brief Determines how much of its particles this source should currently emit
+	 *
+	 * Sources which are tiny on screen emit proportionally fewer particles and sources outside of the view frustum only
+	 * emit a fraction of them. One-time effects and effects which light up their surroundings or start other effects
+	 * are never scaled.
+	 *
+	 * @return A multiplier in [0, 1] for the particle count of this source
+	 */
+	float getEmissionMultiplier() const;
+
 	/**
 	 * @brief Does one processing step for this source
+	 * @param emissionMultiplier The value of getEmissionMultiplier() for this frame
 	 * @return @c true if the source should continue to be processed
 	 */
-	bool process();
+	bool process(float emissionMultiplier = 1.f);
 
 	/**
 	 * @brief Determines if the source is valid
@@ -20,5 +20,8 @@ public:
 
 	float getHostRadius() const override;
 
+	// particles are spread along the whole beam
+	bool isCompact() const override { return false; }
+
 	bool isValid() const override;
 };
\ No newline at end of file
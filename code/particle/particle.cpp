@@ -27,17 +27,163 @@
 #include "tracing/tracing.h"
 #include "tracing/Monitor.h"
 #include "utils/Random.h"
+#include "utils/threading.h"
 #include "nebula/neb.h"
 #include "mission/missionparse.h"
 #include "mod_table/mod_table.h"
 
+namespace particle
+{
+	// A light emitted by a particle during the current frame
+	struct particle_light {
+		enum class shape : ubyte {
+			POINT,
+			TUBE,
+			CONE
+		} type = shape::POINT;
+
+		vec3d pos = ZERO_VECTOR;
+		vec3d end = ZERO_VECTOR;	// end point of a tube, direction of a cone
+		float radius = 0.0f;
+		float source_radius = 0.0f;
+		float intensity = 0.0f;
+		float r = 0.0f, g = 0.0f, b = 0.0f;
+		float cone_angle = 0.0f;
+		float cone_inner_angle = 0.0f;
+	};
+
+	// A death effect which has to be started for a particle that expired during the current frame
+	struct particle_death {
+		ParticleEffectHandle effect;
+		vec3d pos;
+		vec3d velocity;
+	};
+
+	// Everything move_all() can't do while particles are being moved concurrently. Filled per thread and applied on the main thread afterwards.
+	struct particle_move_output {
+		SCP_vector<particle_light> lights;
+		SCP_vector<particle_death> deaths;
+	};
+
+	/**
+	 * @brief The non-persistent particles of one (sub)effect, stored as one array per particle member
+	 *
+	 * Moving a particle mostly needs its position, velocity, age and lifetime, so keeping each of those in its own packed array
+	 * turns the common case of move_all() into plain loops over floats. Everything that depends on the effect only has to be
+	 * looked up once per group. Code that needs a whole particle (like the lifetime curves) works on a copy made by get().
+	 */
+	struct particle_group {
+		enum : ubyte {
+			LOOPING = 1 << 0,
+			REVERSE = 1 << 1,
+			USE_ANGLE = 1 << 2,
+		};
+
+		ParticleSubeffectHandle effect;
+
+		// Refreshed before the group is moved, since adding effects may reallocate them
+		const ParticleEffect* source_effect = nullptr;
+
+		SCP_vector<vec3d> pos;
+		SCP_vector<vec3d> velocity;
+		SCP_vector<float> age;
+		SCP_vector<float> max_life;
+
+		SCP_vector<float> radius;
+		SCP_vector<float> length;
+		SCP_vector<float> angle;
+		SCP_vector<int> bitmap;
+		SCP_vector<int> nframes;
+		SCP_vector<ubyte> flags;
+		SCP_vector<effects::EffectAttachment> attachment;
+
+		// Set by move_range() for particles that have to be removed by remove_dead()
+		SCP_vector<ubyte> dead;
+
+		// Only attached particles can become invalid, so the check is skipped for groups without any
+		size_t num_attached = 0;
+
+		size_t size() const { return pos.size(); }
+
+		void add(particle&& part);
+		void get(size_t index, particle& out) const;
+		void clear();
+
+		// Ages and moves the particles in [begin, end). Safe to call concurrently for disjoint ranges.
+		void move_range(size_t begin, size_t end, float frametime, particle_move_output& out);
+
+		// Removes the particles marked as dead, keeping the order of the remaining ones
+		void remove_dead();
+
+		static void queue_death(const ParticleEffect& source_effect, const effects::EffectAttachment& part_attachment, const vec3d& part_pos, const vec3d& part_velocity, particle_move_output& out);
+		static void queue_light(const ParticleEffect& source_effect, const particle& part, const vec3d& prev_pos, float post_curve_velocity, particle_move_output& out);
+
+		// Works out where and how a particle is drawn this frame. Returns false if it isn't drawn by the main render pass.
+		// Particles rendered as decals are handed to the decal system, so this must be called on the main thread for those.
+		static bool build_instance(const particle& part, const ParticleEffect& source_effect, batch_particle_instance& instance);
+
+		// Whether build_instance() may be called concurrently for the particles of an effect
+		static bool can_build_concurrently(const ParticleEffect& source_effect);
+	};
+}
+
 using namespace particle;
 
 namespace
 {
-	SCP_vector<::particle::particle> Particles;
+	// Number of particles of a group that are moved by one task
+	constexpr size_t PARTICLE_MOVE_CHUNK_SIZE = 4096;
+
+	SCP_vector<particle_group> Particle_groups;
+	// Groups are only ever removed by close(), so indices into Particle_groups stay valid for the whole game
+	SCP_unordered_map<uint64_t, size_t> Particle_group_index;
+	size_t Num_group_particles = 0;
+
 	SCP_vector<ParticlePtr> Persistent_particles;
 
+	struct particle_move_job {
+		size_t group;
+		size_t begin;
+		size_t end;
+	};
+
+	// Kept around between frames so that moving the particles doesn't allocate
+	SCP_vector<particle_move_job> Particle_move_jobs;
+	SCP_vector<particle_move_output> Particle_move_outputs;
+
+	struct particle_render_job {
+		size_t group;
+		size_t begin;
+		size_t end;
+		size_t first_instance;
+	};
+
+	SCP_vector<particle_render_job> Particle_render_jobs;
+	SCP_vector<batch_particle_instance> Particle_instances;
+
+	// Set between begin_buffered_creation() and end_buffered_creation()
+	bool Buffering_creation = false;
+	SCP_vector<SCP_vector<::particle::particle>> Created_particles;
+
+	uint64_t particle_group_key(const ParticleSubeffectHandle& effect)
+	{
+		return (static_cast<uint64_t>(effect.handle.value()) << 32) | static_cast<uint64_t>(effect.subeffect);
+	}
+
+	particle_group& find_particle_group(const ParticleSubeffectHandle& effect)
+	{
+		auto key = particle_group_key(effect);
+
+		auto it = Particle_group_index.find(key);
+		if (it != Particle_group_index.end())
+			return Particle_groups[it->second];
+
+		Particle_group_index.emplace(key, Particle_groups.size());
+		auto& group = Particle_groups.emplace_back();
+		group.effect = effect;
+		return group;
+	}
+
 	static int Particles_enabled = 1;
 
 	float get_current_alpha(vec3d* pos, float rad)
@@ -127,11 +273,13 @@ namespace particle
 	void close()
 	{
 		Persistent_particles.clear();
-		Particles.clear();
+		Particle_groups.clear();
+		Particle_group_index.clear();
+		Num_group_particles = 0;
 	}
 
 	size_t get_particle_count() {
-		return Particles.size() + Persistent_particles.size();
+		return Num_group_particles + Persistent_particles.size();
 	}
 
 	void page_in()
@@ -180,12 +328,20 @@ namespace particle
 		if (maybe_cull_particle(new_particle))
 			return;
 
-		Particles.push_back(new_particle);
+		if (Buffering_creation) {
+			Created_particles[threading::get_thread_index()].push_back(std::move(new_particle));
+			return;
+		}
+
+		find_particle_group(new_particle.parent_effect).add(std::move(new_particle));
+		++Num_group_particles;
 	}
 
 	// Creates a single particle. See the PARTICLE_?? defines for types.
 	WeakParticlePtr createPersistent(particle&& new_particle)
 	{
+		Assertion(!Buffering_creation || threading::get_thread_index() == 0, "Persistent particles can only be created on the main thread!");
+
 		if (maybe_cull_particle(new_particle))
 			return {};
 
@@ -196,6 +352,28 @@ namespace particle
 		return {new_particle_ptr};
 	}
 
+	void begin_buffered_creation()
+	{
+		Assertion(!Buffering_creation, "Particle creation is already being buffered!");
+
+		Created_particles.resize(threading::get_num_workers() + 1);
+		Buffering_creation = true;
+	}
+
+	void end_buffered_creation()
+	{
+		Assertion(Buffering_creation, "Particle creation is not being buffered!");
+		Buffering_creation = false;
+
+		for (auto& buffer : Created_particles) {
+			for (auto& new_particle : buffer) {
+				find_particle_group(new_particle.parent_effect).add(std::move(new_particle));
+			}
+			Num_group_particles += buffer.size();
+			buffer.clear();
+		}
+	}
+
 	float getPixelSize(const particle& subject_particle) {
 		vec3d world_pos = subject_particle.attachment.local_pos_to_global(subject_particle.pos);
 
@@ -208,13 +386,248 @@ namespace particle
 			gr_screen.max_w);
 	}
 
+	void particle_group::add(particle&& part)
+	{
+		pos.push_back(part.pos);
+		velocity.push_back(part.velocity);
+		age.push_back(part.age);
+		max_life.push_back(part.max_life);
+
+		radius.push_back(part.radius);
+		length.push_back(part.length);
+		angle.push_back(part.angle);
+		bitmap.push_back(part.bitmap);
+		nframes.push_back(part.nframes);
+		flags.push_back(static_cast<ubyte>((part.looping ? LOOPING : 0) | (part.reverse ? REVERSE : 0) | (part.use_angle ? USE_ANGLE : 0)));
+
+		if (!part.attachment.is_not_attached())
+			++num_attached;
+		attachment.push_back(std::move(part.attachment));
+
+		dead.push_back(0);
+	}
+
+	void particle_group::get(size_t index, particle& out) const
+	{
+		out.pos = pos[index];
+		out.velocity = velocity[index];
+		out.age = age[index];
+		out.max_life = max_life[index];
+		out.looping = (flags[index] & LOOPING) != 0;
+		out.radius = radius[index];
+		out.bitmap = bitmap[index];
+		out.nframes = nframes[index];
+		out.attachment = attachment[index];
+		out.reverse = (flags[index] & REVERSE) != 0;
+		out.length = length[index];
+		out.angle = angle[index];
+		out.use_angle = (flags[index] & USE_ANGLE) != 0;
+		out.parent_effect = effect;
+	}
+
+	void particle_group::clear()
+	{
+		pos.clear();
+		velocity.clear();
+		age.clear();
+		max_life.clear();
+
+		radius.clear();
+		length.clear();
+		angle.clear();
+		bitmap.clear();
+		nframes.clear();
+		flags.clear();
+		attachment.clear();
+
+		dead.clear();
+		num_attached = 0;
+	}
+
+	void particle_group::queue_death(const ParticleEffect& source_effect, const effects::EffectAttachment& part_attachment, const vec3d& part_pos, const vec3d& part_velocity, particle_move_output& out)
+	{
+		if (!source_effect.m_deathEffect.isValid())
+			return;
+
+		auto& death = out.deaths.emplace_back();
+		death.effect = source_effect.m_deathEffect;
+		death.pos = part_attachment.local_pos_to_global(part_pos);
+		death.velocity = part_attachment.local_vel_to_global(part_velocity);
+	}
+
+	void particle_group::queue_light(const ParticleEffect& source_effect, const particle& part, const vec3d& prev_pos, float post_curve_velocity, particle_move_output& out)
+	{
+		if (Detail.lighting <= 3 || !source_effect.m_light_source)
+			return;
+
+		const auto& light_source = *source_effect.m_light_source;
+		const auto& curves = source_effect.m_lifetime_curves;
+		const auto& curve_input = std::forward_as_tuple(part, post_curve_velocity);
+
+		particle_light light;
+		light.pos = part.attachment.local_pos_to_global(part.pos);
+		light.radius = light_source.light_radius * curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_RADIUS_MULT, curve_input);
+		light.source_radius = light_source.source_radius * curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_SOURCE_RADIUS_MULT, curve_input);
+		light.intensity = light_source.intensity * curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_INTENSITY_MULT, curve_input);
+		light.r = light_source.r * curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_R_MULT, curve_input);
+		light.g = light_source.g * curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_G_MULT, curve_input);
+		light.b = light_source.b * curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_B_MULT, curve_input);
+
+		if (light.radius <= 0.0f || light.intensity <= 0.0f) {
+			return;
+		}
+
+		switch (light_source.light_source_mode) {
+		case ParticleEffect::LightInformation::LightSourceMode::POINT:
+			light.type = particle_light::shape::POINT;
+			break;
+		case ParticleEffect::LightInformation::LightSourceMode::TO_LAST_POS:
+			light.type = particle_light::shape::TUBE;
+			light.end = light.pos;
+			light.pos = part.attachment.local_last_pos_to_global(prev_pos);
+			break;
+		case ParticleEffect::LightInformation::LightSourceMode::AS_PARTICLE:
+			if (part.length != 0.0f) {
+				vec3d p1 = part.attachment.local_vel_to_global(part.velocity);
+				vm_vec_normalize_safe(&p1);
+				p1 *= part.length * curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LENGTH_MULT, curve_input);
+				p1 += light.pos;
+
+				light.type = particle_light::shape::TUBE;
+				light.end = p1;
+			}
+			else {
+				light.type = particle_light::shape::POINT;
+			}
+			break;
+		case ParticleEffect::LightInformation::LightSourceMode::CONE:
+			light.type = particle_light::shape::CONE;
+			light.cone_angle = light_source.cone_angle * curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_CONE_ANGLE_MULT, curve_input);
+			light.cone_inner_angle = light_source.cone_inner_angle * curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_CONE_INNER_ANGLE_MULT, curve_input);
+			light.end = part.attachment.local_vel_to_global(part.velocity);
+			vm_vec_normalize_safe(&light.end);
+			break;
+		}
+
+		out.lights.push_back(light);
+	}
+
+	void particle_group::move_range(size_t begin, size_t end, float frametime, particle_move_output& out)
+	{
+		const auto& curves = source_effect->m_lifetime_curves;
+
+		for (size_t i = begin; i < end; ++i) {
+			age[i] = (age[i] == 0.0f) ? 0.00001f : (age[i] + frametime);
+		}
+
+		// if its time expired, remove it. If the particle is looping then it will never be removed due to age
+		// special case, if max_life is 0 then we want it to render at least once
+		for (size_t i = begin; i < end; ++i) {
+			dead[i] = (age[i] > max_life[i] && !(flags[i] & LOOPING) && (age[i] > frametime || max_life[i] > 0.0f)) ? 1 : 0;
+		}
+
+		// if the particle is attached to an object which has become invalid, kill it
+		if (num_attached > 0) {
+			for (size_t i = begin; i < end; ++i) {
+				if (!attachment[i].is_valid())
+					dead[i] = 1;
+			}
+		}
+
+		if (source_effect->m_deathEffect.isValid()) {
+			for (size_t i = begin; i < end; ++i) {
+				if (dead[i])
+					queue_death(*source_effect, attachment[i], pos[i], velocity[i], out);
+			}
+		}
+
+		const bool has_velocity_curve = curves.has_curve(ParticleEffect::ParticleLifetimeCurvesOutput::VELOCITY_MULT);
+		const bool has_light = Detail.lighting > 3 && source_effect->m_light_source;
+
+		if (!has_velocity_curve && !has_light) {
+			// Dead particles are moved as well. They are removed anyway, and this way the loop doesn't branch.
+			for (size_t i = begin; i < end; ++i) {
+				pos[i].xyz.x += velocity[i].xyz.x * frametime;
+				pos[i].xyz.y += velocity[i].xyz.y * frametime;
+				pos[i].xyz.z += velocity[i].xyz.z * frametime;
+			}
+			return;
+		}
+
+		particle part;
+		for (size_t i = begin; i < end; ++i) {
+			if (dead[i])
+				continue;
+
+			get(i, part);
+
+			float part_velocity = vm_vec_mag_quick(&part.velocity);
+			float vel_scalar = has_velocity_curve ? curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::VELOCITY_MULT, std::forward_as_tuple(part, part_velocity)) : 1.0f;
+
+			vec3d prev_pos = pos[i];
+			pos[i] += (velocity[i] * vel_scalar) * frametime;
+
+			if (has_light) {
+				part.pos = pos[i];
+				queue_light(*source_effect, part, prev_pos, part_velocity * vel_scalar, out);
+			}
+		}
+	}
+
+	void particle_group::remove_dead()
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < size(); ++i) {
+			if (dead[i]) {
+				if (!attachment[i].is_not_attached())
+					--num_attached;
+				continue;
+			}
+
+			if (kept != i) {
+				pos[kept] = pos[i];
+				velocity[kept] = velocity[i];
+				age[kept] = age[i];
+				max_life[kept] = max_life[i];
+
+				radius[kept] = radius[i];
+				length[kept] = length[i];
+				angle[kept] = angle[i];
+				bitmap[kept] = bitmap[i];
+				nframes[kept] = nframes[i];
+				flags[kept] = flags[i];
+				attachment[kept] = std::move(attachment[i]);
+			}
+			++kept;
+		}
+
+		if (kept == size())
+			return;
+
+		pos.resize(kept);
+		velocity.resize(kept);
+		age.resize(kept);
+		max_life.resize(kept);
+
+		radius.resize(kept);
+		length.resize(kept);
+		angle.resize(kept);
+		bitmap.resize(kept);
+		nframes.resize(kept);
+		flags.resize(kept);
+		attachment.resize(kept);
+
+		dead.resize(kept);
+	}
+
 	/**
-	 * @brief Moves a single particle
+	 * @brief Moves a single persistent particle
 	 * @param frametime The length of the current frame
 	 * @param part The particle to process for movement
+	 * @param out Receives the lights and death effects of the particle
 	 * @return @c true if the particle has expired and should be removed, @c false otherwise
 	 */
-	bool move_particle(float frametime, particle* part) {
+	static bool move_particle(float frametime, particle* part, particle_move_output& out) {
 		if (part->age == 0.0f)
 		{
 			part->age = 0.00001f;
@@ -246,20 +659,7 @@ namespace particle
 
 		if (remove_particle)
 		{
-			if (source_effect.m_deathEffect.isValid()) {
-				vec3d world_pos = part->attachment.local_pos_to_global(part->pos);
-				vec3d world_vel = part->attachment.local_vel_to_global(part->velocity);
-
-				matrix orient = vmd_identity_matrix;
-				if (vm_vec_mag_squared(&world_vel) > 0.0f) {
-					vm_vector_2_matrix(&orient, &world_vel);
-				}
-
-				auto deathSource = ParticleManager::get()->createSource(source_effect.m_deathEffect);
-				deathSource->setHost(std::make_unique<EffectHostVector>(world_pos, orient, world_vel));
-				deathSource->finishCreation();
-			}
-
+			particle_group::queue_death(source_effect, part->attachment, part->pos, part->velocity, out);
 			return true;
 		}
 
@@ -270,59 +670,40 @@ namespace particle
 		vec3d prev_pos = part->pos;
 		part->pos += (part->velocity * vel_scalar) * frametime;
 
-		const auto& curve_input = std::forward_as_tuple(*part, part_velocity * vel_scalar);
-
-		if (Detail.lighting > 3 && source_effect.m_light_source) {
-			const auto& light_source = *source_effect.m_light_source;
+		particle_group::queue_light(source_effect, *part, prev_pos, part_velocity * vel_scalar, out);
 
-			vec3d p_pos = part->attachment.local_pos_to_global(part->pos);
-			
-			float light_radius = light_source.light_radius * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_RADIUS_MULT, curve_input);
-			float source_radius = light_source.source_radius * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_SOURCE_RADIUS_MULT, curve_input);
-			float intensity = light_source.intensity * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_INTENSITY_MULT, curve_input);
-			float r = light_source.r * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_R_MULT, curve_input);
-			float g = light_source.g * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_G_MULT, curve_input);
-			float b = light_source.b * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_B_MULT, curve_input);
-
-			// after this point it is only lighting code, so we can early return
-			if (light_radius <= 0.0f || intensity <= 0.0f) {
-				return false;
-			}
+		return false;
+	}
 
-			switch (light_source.light_source_mode) {
-			case ParticleEffect::LightInformation::LightSourceMode::POINT:
-				light_add_point(&p_pos, light_radius, light_radius, intensity, r, g, b, source_radius);
+	static void apply_move_output(particle_move_output& out)
+	{
+		for (const auto& light : out.lights) {
+			switch (light.type) {
+			case particle_light::shape::POINT:
+				light_add_point(&light.pos, light.radius, light.radius, light.intensity, light.r, light.g, light.b, light.source_radius);
 				break;
-			case ParticleEffect::LightInformation::LightSourceMode::TO_LAST_POS: {
-			vec3d p_prev_pos = part->attachment.local_last_pos_to_global(prev_pos);
-				light_add_tube(&p_prev_pos, &p_pos, light_radius, light_radius, intensity, r, g, b, source_radius);
-			}
-			break;
-			case ParticleEffect::LightInformation::LightSourceMode::AS_PARTICLE:
-				if (part->length != 0.0f) {
-					vec3d p1 = part->attachment.local_vel_to_global(part->velocity);
-					vm_vec_normalize_safe(&p1);
-					p1 *= part->length * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LENGTH_MULT, curve_input);
-					p1 += p_pos;
-					light_add_tube(&p_pos, &p1, light_radius, light_radius, intensity, r, g, b, source_radius);
-				}
-				else {
-					light_add_point(&p_pos, light_radius, light_radius, intensity, r, g, b, source_radius);
-				}
+			case particle_light::shape::TUBE:
+				light_add_tube(&light.pos, &light.end, light.radius, light.radius, light.intensity, light.r, light.g, light.b, light.source_radius);
+				break;
+			case particle_light::shape::CONE:
+				light_add_cone(&light.pos, &light.end, light.cone_angle, light.cone_inner_angle, false, light.radius, light.radius, light.intensity, light.r, light.g, light.b, light.source_radius);
 				break;
-			case ParticleEffect::LightInformation::LightSourceMode::CONE: {
-				float cone_angle = light_source.cone_angle * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_CONE_ANGLE_MULT, curve_input);
-				float cone_inner_angle = light_source.cone_inner_angle * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LIGHT_CONE_INNER_ANGLE_MULT, curve_input);
-				vec3d p1 = part->attachment.local_vel_to_global(part->velocity);
-				vm_vec_normalize_safe(&p1);
-
-				light_add_cone(&p_pos, &p1, cone_angle, cone_inner_angle, false, light_radius, light_radius, intensity, r, g, b, source_radius);
 			}
-			break;
+		}
+
+		for (const auto& death : out.deaths) {
+			matrix orient = vmd_identity_matrix;
+			if (vm_vec_mag_squared(&death.velocity) > 0.0f) {
+				vm_vector_2_matrix(&orient, &death.velocity);
 			}
+
+			auto deathSource = ParticleManager::get()->createSource(death.effect);
+			deathSource->setHost(std::make_unique<EffectHostVector>(death.pos, orient, death.velocity));
+			deathSource->finishCreation();
 		}
 
-		return false;
+		out.lights.clear();
+		out.deaths.clear();
 	}
 
 	void move_all(float frametime)
@@ -332,13 +713,18 @@ namespace particle
 		if (!Particles_enabled)
 			return;
 
-		if (Persistent_particles.empty() && Particles.empty())
+		if (Persistent_particles.empty() && Num_group_particles == 0)
 			return;
 
+		const size_t num_outputs = threading::get_num_workers() + 1;
+		if (Particle_move_outputs.size() < num_outputs)
+			Particle_move_outputs.resize(num_outputs);
+
+		// Persistent particles can be the parents of other particles, so they are done before anything runs concurrently
 		for (auto p = Persistent_particles.begin(); p != Persistent_particles.end();)
 		{
 			ParticlePtr part = *p;
-			if (move_particle(frametime, part.get()))
+			if (move_particle(frametime, part.get(), Particle_move_outputs[0]))
 			{
 				// if we're sitting on the very last particle, popping-back will invalidate the iterator!
 				if (p + 1 == Persistent_particles.end())
@@ -356,24 +742,41 @@ namespace particle
 			++p;
 		}
 
-		for (auto p = Particles.begin(); p != Particles.end();)
-		{
-			if (move_particle(frametime, &(*p)))
-			{
-				// if we're sitting on the very last particle, popping-back will invalidate the iterator!
-				if (p + 1 == Particles.end())
-				{
-					Particles.pop_back();
-					break;
-				}
+		Particle_move_jobs.clear();
+		for (size_t i = 0; i < Particle_groups.size(); ++i) {
+			auto& group = Particle_groups[i];
+			if (group.size() == 0)
+				continue;
+
+			group.source_effect = &group.effect.getParticleEffect();
 
-				*p = Particles.back();
-				Particles.pop_back();
+			// Randomized curve entries share a generator, so evaluating them concurrently would race
+			if (group.source_effect->m_lifetime_curves.has_random_entries()) {
+				group.move_range(0, group.size(), frametime, Particle_move_outputs[0]);
 				continue;
 			}
 
-			// next particle
-			++p;
+			for (size_t begin = 0; begin < group.size(); begin += PARTICLE_MOVE_CHUNK_SIZE) {
+				Particle_move_jobs.push_back({i, begin, std::min(begin + PARTICLE_MOVE_CHUNK_SIZE, group.size())});
+			}
+		}
+
+		threading::parallel_for(0, Particle_move_jobs.size(), 1, [frametime](size_t i) {
+			const auto& job = Particle_move_jobs[i];
+			Particle_groups[job.group].move_range(job.begin, job.end, frametime, Particle_move_outputs[threading::get_thread_index()]);
+		});
+
+		threading::parallel_for(0, Particle_groups.size(), 1, [](size_t i) {
+			Particle_groups[i].remove_dead();
+		});
+
+		Num_group_particles = 0;
+		for (const auto& group : Particle_groups) {
+			Num_group_particles += group.size();
+		}
+
+		for (auto& out : Particle_move_outputs) {
+			apply_move_output(out);
 		}
 	}
 
@@ -381,23 +784,19 @@ namespace particle
 	void kill_all()
 	{
 		// kill all active particles
-		Particles.clear();
+		for (auto& group : Particle_groups) {
+			group.clear();
+		}
+		Num_group_particles = 0;
 		Persistent_particles.clear();
 	}
 
-	/**
-	 * @brief Renders a single particle
-	 * @param part The particle to render
-	 * @return @c true if the particle has been added to the rendering batch (notably, this only includes main-render pass, alternative dispatch through decals is not true), @c false otherwise
-	 */
-	bool render_particle(particle* part) {
+	bool particle_group::build_instance(const particle& part, const ParticleEffect& source_effect, batch_particle_instance& instance) {
 		// skip back-facing particles (ripped from fullneb code)
 		// Wanderer - add support for attached particles
-		vec3d p_pos = part->attachment.local_pos_to_global(part->pos);
+		vec3d p_pos = part.attachment.local_pos_to_global(part.pos);
 
-		bool part_has_length = part->length != 0.0f;
-
-		const auto& source_effect = part->parent_effect.getParticleEffect();
+		bool part_has_length = part.length != 0.0f;
 
 		if (!source_effect.m_renderAsDecal && !part_has_length && vm_vec_dot_to_point(&Eye_matrix.vec.fvec, &Eye_position, &p_pos) <= 0.0f)
 		{
@@ -405,19 +804,19 @@ namespace particle
 		}
 
 		//For anything apart from the velocity curve, "Post-Curves Velocity" is well defined. This is needed to facilitate complex but common particle scaling and appearance curves.
-		const auto& curve_input = std::forward_as_tuple(*part,
-			vm_vec_mag_quick(&part->velocity) * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::VELOCITY_MULT, std::forward_as_tuple(*part, vm_vec_mag_quick(&part->velocity))));
+		const auto& curve_input = std::forward_as_tuple(part,
+			vm_vec_mag_quick(&part.velocity) * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::VELOCITY_MULT, std::forward_as_tuple(part, vm_vec_mag_quick(&part.velocity))));
 
 		// figure out which frame we should be using
 		int framenum;
 		int cur_frame;
-		if (part->nframes > 1) {
+		if (part.nframes > 1) {
 			if (source_effect.m_lifetime_curves.has_curve(ParticleEffect::ParticleLifetimeCurvesOutput::ANIM_STATE)) {
-				cur_frame = fl2i(i2fl(part->nframes - 1) * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::ANIM_STATE, curve_input));
+				cur_frame = fl2i(i2fl(part.nframes - 1) * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::ANIM_STATE, curve_input));
 			}
 			else {
-				framenum = bm_get_anim_frame(part->bitmap, part->age, part->max_life, part->looping);
-				cur_frame = part->reverse ? (part->nframes - framenum - 1) : framenum;
+				framenum = bm_get_anim_frame(part.bitmap, part.age, part.max_life, part.looping);
+				cur_frame = part.reverse ? (part.nframes - framenum - 1) : framenum;
 			}
 		}
 		else
@@ -425,8 +824,8 @@ namespace particle
 			cur_frame = 0;
 		}
 
-		framenum = part->bitmap;
-		Assert( (cur_frame < part->nframes) || (part->nframes == 0 && cur_frame == 0) );
+		framenum = part.bitmap;
+		Assert( (cur_frame < part.nframes) || (part.nframes == 0 && cur_frame == 0) );
 
 		int actual_frame = cur_frame + framenum;
 
@@ -435,13 +834,13 @@ namespace particle
 				return false;
 			}
 
-			const auto& obj = part->attachment.extract_object();
+			const auto& obj = part.attachment.extract_object();
 
 			if (!obj || obj->objnum < 0 || Objects[obj->objnum].signature != obj->sig || Objects[obj->objnum].type != OBJ_SHIP) {
 				return false;
 			}
 
-			float radius = part->radius * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::RADIUS_MULT, curve_input);
+			float radius = part.radius * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::RADIUS_MULT, curve_input);
 
 			decals::Decal decalInfo;
 
@@ -455,13 +854,13 @@ namespace particle
 			decalInfo.submodel      = -1;
 			decalInfo.creation_time = f2fl(Missiontime);
 			decalInfo.lifetime      = 1.0f;
-			decalInfo.position      = part->pos;
+			decalInfo.position      = part.pos;
 			decalInfo.scale         = {{{ radius, radius, radius }}};
 			decalInfo.orig_obj_type = OBJ_SHIP;
 
 			switch (source_effect.m_decalOrientationMode) {
 			case ParticleEffect::DecalOrientationMode::TOWARDS_CENTER:
-				vm_vector_2_matrix(&decalInfo.orientation, &part->pos, nullptr, nullptr);
+				vm_vector_2_matrix(&decalInfo.orientation, &part.pos, nullptr, nullptr);
 				break;
 			default:
 				decalInfo.orientation = vmd_identity_matrix;
@@ -475,9 +874,9 @@ namespace particle
 		vec3d p1 = vmd_x_vector;
 
 		if (part_has_length) {
-			p1 = part->attachment.local_vel_to_global(part->velocity);
+			p1 = part.attachment.local_vel_to_global(part.velocity);
 			vm_vec_normalize_safe(&p1);
-			p1 *= part->length * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LENGTH_MULT, curve_input);
+			p1 *= part.length * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::LENGTH_MULT, curve_input);
 			p1 += p_pos;
 
 			float dot0 = vm_vec_dot_to_point(&Eye_matrix.vec.fvec, &Eye_position, &p_pos);
@@ -489,7 +888,7 @@ namespace particle
 		}
 
 		// calculate the alpha to draw at
-		auto alpha = get_current_alpha(&p_pos, part->radius);
+		auto alpha = get_current_alpha(&p_pos, part.radius);
 
 		// if it's transparent then just skip it
 		if (alpha <= 0.0f)
@@ -497,14 +896,12 @@ namespace particle
 			return false;
 		}
 
-		vertex pos;
-		auto flags = g3_rotate_vertex(&pos, &p_pos);
+		auto flags = g3_get_vertex_codes(&p_pos);
 
 		if (flags)
 		{
 			if (part_has_length) {
-				vertex pos2;
-				auto flags2 = g3_rotate_vertex(&pos2, &p1);
+				auto flags2 = g3_get_vertex_codes(&p1);
 				if (flags & flags2) {
 					return false;
 				}
@@ -513,17 +910,40 @@ namespace particle
 			}
 		}
 
-		g3_transfer_vertex(&pos, &p_pos);
+		instance.position = p_pos;
+		instance.end = p1;
+		instance.radius = part.radius * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::RADIUS_MULT, curve_input);
+		// it will subtract Physics_viewer_bank, so without the flag we counter that and make it screen-aligned again
+		instance.angle = part.use_angle ? part.angle : Physics_viewer_bank;
+		instance.alpha = alpha;
+		instance.texture = actual_frame;
+		instance.is_laser = part_has_length;
+
+		return true;
+	}
 
-		float radius = part->radius * source_effect.m_lifetime_curves.get_output(ParticleEffect::ParticleLifetimeCurvesOutput::RADIUS_MULT, curve_input);
+	bool particle_group::can_build_concurrently(const ParticleEffect& source_effect) {
+		// Decals go straight to the decal system, and randomized curve entries share a generator
+		return !source_effect.m_renderAsDecal && !source_effect.m_lifetime_curves.has_random_entries();
+	}
 
-		if (part_has_length) {
-			vec3d p0 = p_pos;
-			batching_add_laser(actual_frame, &p0, radius, &p1, radius);
+	/**
+	 * @brief Renders a single particle
+	 * @param part The particle to render
+	 * @return @c true if the particle has been added to the rendering batch (notably, this only includes main-render pass, alternative dispatch through decals is not true), @c false otherwise
+	 */
+	bool render_particle(particle* part) {
+		batch_particle_instance instance;
+		if (!particle_group::build_instance(*part, part->parent_effect.getParticleEffect(), instance))
+			return false;
+
+		if (instance.is_laser) {
+			batching_add_laser(instance.texture, &instance.position, instance.radius, &instance.end, instance.radius);
 		}
 		else {
-			// it will subtract Physics_viewer_bank, so without the flag we counter that and make it screen-aligned again
-			batching_add_volume_bitmap_rotated(actual_frame, &pos, part->use_angle ? part->angle : Physics_viewer_bank, radius, alpha);
+			vertex pos;
+			g3_transfer_vertex(&pos, &instance.position);
+			batching_add_volume_bitmap_rotated(instance.texture, &pos, instance.angle, instance.radius, instance.alpha);
 		}
 
 		return true;
@@ -537,16 +957,54 @@ namespace particle
 		if (!Particles_enabled)
 			return;
 
-		if (Persistent_particles.empty() && Particles.empty())
+		if (Persistent_particles.empty() && Num_group_particles == 0)
 			return;
 
 		for (auto& part : Persistent_particles) {
 			render_particle(part.get());
 		}
 
-		for (auto& part : Particles) {
-			render_particle(&part);
+		Particle_render_jobs.clear();
+		size_t num_instances = 0;
+
+		particle part;
+		for (size_t i = 0; i < Particle_groups.size(); ++i) {
+			auto& group = Particle_groups[i];
+			if (group.size() == 0)
+				continue;
+
+			group.source_effect = &group.effect.getParticleEffect();
+
+			if (!particle_group::can_build_concurrently(*group.source_effect)) {
+				for (size_t j = 0; j < group.size(); ++j) {
+					group.get(j, part);
+					render_particle(&part);
+				}
+				continue;
+			}
+
+			for (size_t begin = 0; begin < group.size(); begin += PARTICLE_MOVE_CHUNK_SIZE) {
+				size_t end = std::min(begin + PARTICLE_MOVE_CHUNK_SIZE, group.size());
+				Particle_render_jobs.push_back({i, begin, end, num_instances});
+				num_instances += end - begin;
+			}
 		}
 
+		Particle_instances.resize(num_instances);
+		threading::parallel_for(0, Particle_render_jobs.size(), 1, [](size_t i) {
+			const auto& job = Particle_render_jobs[i];
+			const auto& group = Particle_groups[job.group];
+
+			particle job_part;
+			for (size_t j = job.begin; j < job.end; ++j) {
+				auto& instance = Particle_instances[job.first_instance + (j - job.begin)];
+
+				group.get(j, job_part);
+				if (!particle_group::build_instance(job_part, *group.source_effect, instance))
+					instance.texture = -1;
+			}
+		});
+
+		batching_add_particle_instances(Particle_instances);
 	}
 }
@@ -122,6 +122,16 @@ namespace particle
 	 */
 	WeakParticlePtr createPersistent(particle&& new_particle);
 
+	/**
+	 * @brief Allows create() to be called from task pool workers
+	 *
+	 * Until end_buffered_creation() is called, particles passed to create() are collected in one buffer per thread instead
+	 * of being added right away. end_buffered_creation() then adds them in thread order. Persistent particles can only be
+	 * created on the main thread in the meantime.
+	 */
+	void begin_buffered_creation();
+	void end_buffered_creation();
+
 	float getPixelSize(const particle& subject_particle);
 }
 
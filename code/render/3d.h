@@ -127,6 +127,12 @@ int g3_check_normal_facing(const vec3d *v, const vec3d *norm);
  */
 ubyte g3_rotate_vertex(vertex *dest, const vec3d *src);
 
+/**
+ * Returns the codes g3_rotate_vertex() would return for a point.  Doesn't touch any global state, so this may be
+ * called from the task pool.
+ */
+ubyte g3_get_vertex_codes(const vec3d *src);
+
 /**
  * Use this for stars, etc
  */
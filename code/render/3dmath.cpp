@@ -108,7 +108,7 @@ static inline void g3_compensate_asymmetric_fov(vec3d& rotated) {
 
 MONITOR( NumRotations )
 
-ubyte g3_rotate_vertex(vertex *dest, const vec3d *src)
+static ubyte g3_rotate_vertex_internal(vertex *dest, const vec3d *src)
 {
 #if 0
 	vec3d tempv;
@@ -121,8 +121,6 @@ ubyte g3_rotate_vertex(vertex *dest, const vec3d *src)
 	float tx, ty, tz, x,y,z;
 	ubyte codes;
 
-	MONITOR_INC( NumRotations, 1 );	
-
 	tx = src->xyz.x - View_position.xyz.x;
 	ty = src->xyz.y - View_position.xyz.y;
 	tz = src->xyz.z - View_position.xyz.z;
@@ -168,6 +166,20 @@ ubyte g3_rotate_vertex(vertex *dest, const vec3d *src)
 #endif
 }	
 
+ubyte g3_rotate_vertex(vertex *dest, const vec3d *src)
+{
+	MONITOR_INC( NumRotations, 1 );
+
+	return g3_rotate_vertex_internal(dest, src);
+}
+
+ubyte g3_get_vertex_codes(const vec3d *src)
+{
+	vertex rotated;
+
+	return g3_rotate_vertex_internal(&rotated, src);
+}
+
 
 ubyte g3_rotate_faraway_vertex(vertex *dest, const vec3d *src)
 {	
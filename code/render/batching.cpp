@@ -14,11 +14,28 @@
 #include "render/3d.h"
 #include "graphics/material.h"
 #include "tracing/tracing.h"
+#include "utils/threading.h"
+
+#include <algorithm>
 
 static SCP_map<batch_info, primitive_batch> Batching_primitives;
 static SCP_map<batch_buffer_key, primitive_batch_buffer> Batching_buffers;
 static int lineTexture = -1;
 
+// A range of particle instances which all go into the same batch, see batching_add_particle_instances()
+struct particle_instance_job {
+	size_t begin;
+	size_t end;
+	batch_vertex *verts;
+	int base_texture;
+};
+
+static constexpr size_t PARTICLE_INSTANCE_CHUNK_SIZE = 1024;
+
+// The batch key (material in the upper half, base texture in the lower half) and index of each instance
+static SCP_vector<std::pair<uint64_t, size_t>> Particle_instance_order;
+static SCP_vector<particle_instance_job> Particle_instance_jobs;
+
 void primitive_batch::add_triangle(batch_vertex* v0, batch_vertex* v1, batch_vertex *v2)
 {
 	Vertices.push_back(*v0);
@@ -31,6 +48,14 @@ void primitive_batch::add_point_sprite(batch_vertex *p)
 	Vertices.push_back(*p);
 }
 
+batch_vertex* primitive_batch::add_vertices(size_t n_verts)
+{
+	size_t offset = Vertices.size();
+	Vertices.resize(offset + n_verts);
+
+	return &Vertices[offset];
+}
+
 size_t primitive_batch::load_buffer(batch_vertex* buffer, size_t n_verts)
 {
 	size_t verts_to_render = Vertices.size();
@@ -268,10 +293,9 @@ void batching_add_bitmap_internal(primitive_batch *batch, int texture, vertex *p
 	batch->add_triangle(&verts[2], &verts[1], &verts[0]);
 }
 
-void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, vertex *pnt, float angle, float rad, color *clr, float depth)
+// Writes the two triangles of a rotated bitmap to verts[0] to verts[5]
+static void batching_build_bitmap_rotated(batch_vertex *verts, int array_index, const vec3d *pnt, float angle, float rad, const color *clr, float depth)
 {
-	Assert(batch->get_render_info().prim_type == PRIM_TYPE_TRIS);
-
 	float radius = rad;
 	rad *= 1.41421356f;//1/0.707, becase these are the points of a square or width and height rad
 
@@ -283,10 +307,9 @@ void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, v
 	else if ( angle > PI2 )
 		angle -= PI2;
 
-	vec3d PNT(pnt->world);
+	vec3d PNT(*pnt);
 	vec3d p[4];
 	vec3d fvec, rvec, uvec;
-	batch_vertex verts[6];
 
 	vm_vec_sub(&fvec, &View_position, &PNT);
 	vm_vec_normalize_safe(&fvec);
@@ -328,7 +351,6 @@ void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, v
 	verts[1].tex_coord.xyzw.x = 1.0f;	verts[1].tex_coord.xyzw.y = 1.0f;
 	verts[0].tex_coord.xyzw.x = 0.0f;	verts[0].tex_coord.xyzw.y = 1.0f;
 
-	auto array_index = texture - batch->get_render_info().texture;
 	for (int i = 0; i < 6 ; i++) {
 		verts[i].r = clr->red;
 		verts[i].g = clr->green;
@@ -339,6 +361,14 @@ void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, v
 		verts[i].tex_coord.xyzw.z = (float)array_index;
 		verts[i].tex_coord.xyzw.w = 1.0f;
 	}
+}
+
+void batching_add_bitmap_rotated_internal(primitive_batch *batch, int texture, vertex *pnt, float angle, float rad, color *clr, float depth)
+{
+	Assert(batch->get_render_info().prim_type == PRIM_TYPE_TRIS);
+
+	batch_vertex verts[6];
+	batching_build_bitmap_rotated(verts, texture - batch->get_render_info().texture, &pnt->world, angle, rad, clr, depth);
 
 	batch->add_triangle(&verts[0], &verts[1], &verts[2]);
 	batch->add_triangle(&verts[3], &verts[4], &verts[5]);
@@ -603,10 +633,9 @@ void batching_add_line_internal(primitive_batch *batch, int texture, vec3d *star
 	batch->add_triangle(&verts[3], &verts[4], &verts[5]);
 }
 
-void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3d *p0, float width1, const vec3d *p1, float width2, int r, int g, int b)
+// Writes the two triangles of a laser to verts[0] to verts[5]
+static void batching_build_laser(batch_vertex *verts, int array_index, const vec3d *p0, float width1, const vec3d *p1, float width2, int r, int g, int b)
 {
-	Assert(batch->get_render_info().prim_type == PRIM_TYPE_TRIS);
-
 	width1 *= 0.5f;
 	width2 *= 0.5f;
 
@@ -637,7 +666,6 @@ void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3
 	vm_vec_scale_add(&end, p1, &fvec, width2);
 
 	vec3d vecs[4];
-	batch_vertex verts[6];
 
 	vm_vec_scale_add( &vecs[0], &end, &uvec, width2 );
 	vm_vec_scale_add( &vecs[1], &start, &uvec, width1 );
@@ -652,8 +680,6 @@ void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3
 	verts[4].position = vecs[2];
 	verts[5].position = vecs[3];
 
-	auto array_index = texture - batch->get_render_info().texture;
-
 	float ratio = width2 / width1;
 	if (width1 <= 0.0f)
 		ratio = 999.0f;
@@ -665,12 +691,21 @@ void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3
 	verts[4].tex_coord = vm_vec4_new(0.0f, 1.0f, (float)array_index, 1.0f);
 	verts[5].tex_coord = vm_vec4_new(1.0f, ratio, (float)array_index, ratio);
 
-	for (auto& vert : verts) {
+	for (int i = 0; i < 6; i++) {
+		auto& vert = verts[i];
 		vert.r = (ubyte)r;
 		vert.g = (ubyte)g;
 		vert.b = (ubyte)b;
 		vert.a = 255;
 	}
+}
+
+void batching_add_laser_internal(primitive_batch *batch, int texture, const vec3d *p0, float width1, const vec3d *p1, float width2, int r, int g, int b)
+{
+	Assert(batch->get_render_info().prim_type == PRIM_TYPE_TRIS);
+
+	batch_vertex verts[6];
+	batching_build_laser(verts, texture - batch->get_render_info().texture, p0, width1, p1, width2, r, g, b);
 
 	batch->add_triangle(&verts[0], &verts[1], &verts[2]);
 	batch->add_triangle(&verts[3], &verts[4], &verts[5]);
@@ -931,6 +966,77 @@ void batching_add_tri(int texture, vertex *verts, primitive_batch *batch)
 	batching_add_tri_internal(batch, texture, verts);
 }
 
+void batching_add_particle_instances(const SCP_vector<batch_particle_instance>& instances)
+{
+	TRACE_SCOPE(tracing::ParticlesBatch);
+
+	auto volume_material = gr_is_capable(gr_capability::CAPABILITY_SOFT_PARTICLES) ? batch_info::VOLUME_EMISSIVE : batch_info::FLAT_EMISSIVE;
+
+	Particle_instance_order.resize(instances.size());
+	threading::parallel_for(0, instances.size(), PARTICLE_INSTANCE_CHUNK_SIZE, [&instances, volume_material](size_t i) {
+		const auto& instance = instances[i];
+		uint64_t key = UINT64_MAX;
+
+		if (instance.texture >= 0) {
+			auto material = instance.is_laser ? batch_info::FLAT_EMISSIVE : volume_material;
+			key = (static_cast<uint64_t>(material) << 32) | static_cast<uint32_t>(bm_get_base_frame(instance.texture));
+		}
+
+		Particle_instance_order[i] = std::make_pair(key, i);
+	});
+
+	// Vertices within a batch keep the order of the instances
+	std::sort(Particle_instance_order.begin(), Particle_instance_order.end());
+
+	Particle_instance_jobs.clear();
+	for (size_t begin = 0; begin < Particle_instance_order.size();) {
+		uint64_t key = Particle_instance_order[begin].first;
+		if (key == UINT64_MAX)
+			break;
+
+		size_t end = begin + 1;
+		while (end < Particle_instance_order.size() && Particle_instance_order[end].first == key)
+			++end;
+
+		const auto& first = instances[Particle_instance_order[begin].second];
+		auto material = static_cast<batch_info::material_type>(key >> 32);
+		primitive_batch *batch = batching_find_batch(first.texture, material);
+		Assert(batch->get_render_info().prim_type == PRIM_TYPE_TRIS);
+
+		batch_vertex *verts = batch->add_vertices(6 * (end - begin));
+		for (size_t job_begin = begin; job_begin < end; job_begin += PARTICLE_INSTANCE_CHUNK_SIZE) {
+			particle_instance_job job;
+			job.begin = job_begin;
+			job.end = std::min(job_begin + PARTICLE_INSTANCE_CHUNK_SIZE, end);
+			job.verts = verts + 6 * (job_begin - begin);
+			job.base_texture = batch->get_render_info().texture;
+
+			Particle_instance_jobs.push_back(job);
+		}
+
+		begin = end;
+	}
+
+	threading::parallel_for(0, Particle_instance_jobs.size(), 1, [&instances](size_t i) {
+		const auto& job = Particle_instance_jobs[i];
+		batch_vertex *verts = job.verts;
+
+		for (size_t j = job.begin; j < job.end; ++j, verts += 6) {
+			const auto& instance = instances[Particle_instance_order[j].second];
+			int array_index = instance.texture - job.base_texture;
+
+			if (instance.is_laser) {
+				batching_build_laser(verts, array_index, &instance.position, instance.radius, &instance.end, instance.radius, 255, 255, 255);
+			} else {
+				color clr;
+				batching_determine_blend_color(&clr, instance.texture, instance.alpha);
+
+				batching_build_bitmap_rotated(verts, array_index, &instance.position, instance.angle, instance.radius, &clr, 0.0f);
+			}
+		}
+	});
+}
+
 void batching_render_batch_item(primitive_batch_item* item,
 	vertex_layout* layout,
 	primitive_type prim_type,
@@ -83,6 +83,9 @@ public:
 	void add_triangle(batch_vertex* v0, batch_vertex* v1, batch_vertex* v2);
 	void add_point_sprite(batch_vertex *p);
 
+	// Appends n_verts default initialized vertices and returns the first one for the caller to fill in
+	batch_vertex* add_vertices(size_t n_verts);
+
 	size_t load_buffer(batch_vertex* buffer, size_t n_verts);
 
 	size_t num_verts() { return Vertices.size();  }
@@ -112,6 +115,22 @@ struct primitive_batch_buffer {
 	SCP_vector<primitive_batch_item> items;
 };
 
+/**
+ * @brief A particle as it is passed to batching_add_particle_instances()
+ *
+ * A particle is either a camera facing bitmap rotated by angle, like in batching_add_volume_bitmap_rotated(), or if
+ * is_laser is set, a laser from position to end like in batching_add_laser().
+ */
+struct batch_particle_instance {
+	vec3d position;
+	vec3d end;
+	float radius;
+	float angle;
+	float alpha;
+	int texture;	// the bitmap frame to draw, instances with a negative texture are skipped
+	bool is_laser;
+};
+
 primitive_batch* batching_find_batch(int texture, batch_info::material_type material_id, primitive_type prim_type = PRIM_TYPE_TRIS, bool thruster = false);
 
 void batching_add_bitmap(int texture, vertex *pnt, int orient, float rad, float alpha = 1.0f, float depth = 0.0f);
@@ -131,6 +150,10 @@ void batching_add_tri(int texture, vertex *verts);
 void batching_add_quad(int texture, vertex *verts, primitive_batch* batch, float trapezoidal_correction = 1.0f);
 void batching_add_tri(int texture, vertex *verts, primitive_batch* batch);
 
+// Adds many particles at once, with the same vertices as adding them one by one in order.  Only finding the batches
+// happens on the calling thread, the vertices are written on the task pool.
+void batching_add_particle_instances(const SCP_vector<batch_particle_instance>& instances);
+
 void batching_render_all(bool render_distortions = false);
 
 void batching_shutdown();
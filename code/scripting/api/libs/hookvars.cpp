@@ -24,18 +24,13 @@ ADE_INDEXER(l_HookVar,
 
 	const auto scriptSystem = script_state::GetScriptState(L);
 
-	const auto& hookVars = scriptSystem->GetHookVariableReferences();
-	const auto iter = hookVars.find(name);
-	if (iter == hookVars.end()) {
-		return ADE_RETURN_NIL;
-	}
-	if (iter->second.empty()) {
-		// Hook variable existed at some point but was removed again
+	// nullptr if the hook variable doesn't exist or existed at some point but was removed again
+	const auto value = scriptSystem->GetHookVariableReference(name);
+	if (value == nullptr) {
 		return ADE_RETURN_NIL;
 	}
 
-	// Use the value on top of the stack
-	iter->second.back()->pushValue(L);
+	(*value)->pushValue(L);
 	return 1;
 }
 
@@ -63,14 +58,14 @@ ADE_INDEXER(l_HookVar_Globals,
 
 	// List 'em
 	int count = 1;
-	for (const auto& pair : hookVars) {
-		if (pair.second.empty()) {
+	for (int slot = 0; slot < static_cast<int>(hookVars.size()); ++slot) {
+		if (hookVars[slot].empty()) {
 			// Skip empty value stacks
 			continue;
 		}
 
 		if (count == idx) {
-			return ade_set_args(L, "s", pair.first);
+			return ade_set_args(L, "s", script_hook_var_name(slot).c_str());
 		}
 		count++;
 	}
@@ -84,10 +79,10 @@ ADE_FUNC(__len, l_HookVar_Globals, NULL, "Number of HookVariables", "number", "N
 
 	const auto& hookVars = scriptSystem->GetHookVariableReferences();
 
-	// Since the values are on a stack, it is possible to have entries in the map that have no values at the moment
+	// Since the values are on a stack, it is possible to have slots that have no values at the moment
 	auto validHookVars = std::count_if(hookVars.cbegin(),
 		hookVars.cend(),
-		[](const std::pair<SCP_string, SCP_vector<luacpp::LuaReference>>& values) { return !values.second.empty(); });
+		[](const SCP_vector<luacpp::LuaReference>& values) { return !values.empty(); });
 
 	return ade_set_args(L, "i", validHookVars);
 }
@@ -176,6 +176,7 @@ ADE_VIRTVAR(Orientation, l_Subsystem, "orientation", "Orientation of subobject o
 
 		smi->canonical_prev_orient = smi->canonical_orient;
 		smi->canonical_orient = *mh->GetMatrix();
+		smi->transform_version++;
 
 		float angle = 0.0f;
 		vm_closest_angle_to_matrix(&smi->canonical_orient, &sm->rotation_axis, &angle);
@@ -205,6 +206,7 @@ ADE_VIRTVAR(GunOrientation, l_Subsystem, "orientation", "Orientation of turret g
 	{
 		smi->canonical_prev_orient = smi->canonical_orient;
 		smi->canonical_orient = *mh->GetMatrix();
+		smi->transform_version++;
 	}
 
 	return ade_set_args(L, "o", l_Matrix.Set(matrix_h(&smi->canonical_orient)));
@@ -233,6 +235,7 @@ ADE_VIRTVAR(TranslationOffset,
 	{
 		smi->canonical_prev_offset = smi->canonical_offset;
 		smi->canonical_offset = *vec;
+		smi->transform_version++;
 
 		smi->cur_offset = vm_vec_mag(vec);
 	}
@@ -339,8 +342,10 @@ ADE_VIRTVAR(GunPosition, l_Subsystem, "vector", "Subsystem gun position with reg
 
 	bsp_info *sm = &pm->submodel[sso->ss->system_info->turret_gun_sobj];
 
-	if(ADE_SETTING_VAR && v != NULL)
+	if(ADE_SETTING_VAR && v != NULL) {
 		sm->offset = *v;
+		model_invalidate_instance_transforms(pm->id, sso->ss->system_info->turret_gun_sobj);
+	}
 
 	return ade_set_args(L, "o", l_Vector.Set(sm->offset));
 }
@@ -75,6 +75,10 @@ HookBase::HookBase(SCP_string hookName,
 				   int32_t hookId)
 	: _conditions(conditions), _hookName(std::move(hookName)), _description(std::move(description)), _parameters(std::move(parameters)), _deprecation(std::move(deprecation))
 {
+	for (const auto& param : _parameters) {
+		_parameterSlots.push_back(script_hook_var_slot(param.name));
+	}
+
 	// If we specify a forced id then use that. This is for special hooks that need a guaranteed id
 	if (hookId >= 0) {
 		_hookId = hookId;
@@ -13,6 +13,8 @@
 
 namespace scripting {
 
+class HookBase;
+
 namespace detail {
 ade_odata_setter<object_h> convert_arg_type(object* objp);
 ade_odata_setter<vec3d> convert_arg_type(vec3d vec);
@@ -23,23 +25,30 @@ T&& convert_arg_type(T&& arg)
 	return std::forward<T>(arg);
 }
 
+int find_hook_param_slot(const HookBase& hook, const char* name);
+
 template <typename T>
 struct HookParameterInstance {
-	SCP_string name;
+	const char* name = nullptr;
 	char type = '\0';
 	T value;
 	bool enabled = true;
 
-	HookParameterInstance(SCP_string name_, char type_, T&& value_, bool enabled_)
-		: name(std::move(name_)), type(type_), value(std::forward<T>(value_)), enabled(enabled_)
+	HookParameterInstance(const char* name_, char type_, T&& value_, bool enabled_)
+		: name(name_), type(type_), value(std::forward<T>(value_)), enabled(enabled_)
 	{
 	}
 };
 
 struct SetSingleHookVarHelper {
-	SCP_vector<SCP_string>& paramNames;
+	const HookBase& hook;
+	int* paramSlots;
+	size_t& numParams;
 
-	SetSingleHookVarHelper(SCP_vector<SCP_string>& paramNames_) : paramNames(paramNames_) {}
+	SetSingleHookVarHelper(const HookBase& hook_, int* paramSlots_, size_t& numParams_)
+		: hook(hook_), paramSlots(paramSlots_), numParams(numParams_)
+	{
+	}
 
 	template <typename T>
 	void operator()(HookParameterInstance<T>&& instance)
@@ -49,9 +58,10 @@ struct SetSingleHookVarHelper {
 			return;
 		}
 
-		paramNames.push_back(instance.name);
+		const auto slot = find_hook_param_slot(hook, instance.name);
+		paramSlots[numParams++] = slot;
 
-		Script_system.SetHookVar(instance.name.c_str(),
+		Script_system.SetHookVar(slot,
 								 instance.type,
 								 detail::convert_arg_type(std::move(instance.value)));
 	}
@@ -66,20 +76,33 @@ struct HookParameterInstanceList {
 	{
 	}
 
-	void setHookVars(SCP_vector<SCP_string>& paramNames)
+	// Room for the slots of all parameters, which never leaves a zero sized array
+	static constexpr size_t MAX_PARAMS = sizeof...(Args) + 1;
+
+	// Sets the enabled parameters as hook variables and stores their slots in paramSlots. Returns how many were set.
+	size_t setHookVars(const HookBase& hook, int (&paramSlots)[MAX_PARAMS])
 	{
+		size_t numParams = 0;
 		util::tuples::for_each<0, SetSingleHookVarHelper, HookParameterInstance<Args>...>(
 			std::move(params),
-			SetSingleHookVarHelper(paramNames));
+			SetSingleHookVarHelper(hook, paramSlots, numParams));
+		return numParams;
+	}
+
+	static void remHookVars(const int (&paramSlots)[MAX_PARAMS], size_t numParams)
+	{
+		for (size_t i = 0; i < numParams; ++i) {
+			Script_system.RemHookVar(paramSlots[i]);
+		}
 	}
 };
 
 } // namespace detail
 
 template <typename T>
-detail::HookParameterInstance<T> hook_param(SCP_string name_, char type_, T&& value_, bool enabled = true)
+detail::HookParameterInstance<T> hook_param(const char* name_, char type_, T&& value_, bool enabled = true)
 {
-	return detail::HookParameterInstance<T>(std::move(name_), type_, std::forward<T>(value_), enabled);
+	return detail::HookParameterInstance<T>(name_, type_, std::forward<T>(value_), enabled);
 }
 
 template <typename... Args>
@@ -126,23 +149,44 @@ class HookBase {
 	virtual bool isActive() const = 0;
 	virtual bool isOverridable() const = 0;
 
+	// The slot of the hook variable for a parameter of this hook, see script_hook_var_slot()
+	int getParameterSlot(const char* name) const;
+
 	const SCP_unordered_map<SCP_string, const std::unique_ptr<const ParseableCondition>>& _conditions;
 
   protected:
 	SCP_string _hookName;
 	SCP_string _description;
 	SCP_vector<HookVariableDocumentation> _parameters;
+	SCP_vector<int> _parameterSlots;	// interned when the hook is created, same order as _parameters
 	std::optional<HookDeprecationOptions> _deprecation;
 	int32_t _hookId = 0;
-	
-	bool hasParameter(const SCP_string& param) const
-	{
-		return std::find_if(_parameters.begin(), _parameters.end(), [&param](const HookVariableDocumentation& test) {
-				   return test.name == param;
-			   }) != _parameters.end();
-	}
 };
 
+inline int HookBase::getParameterSlot(const char* name) const
+{
+	for (size_t i = 0; i < _parameters.size(); ++i) {
+		// identical string literals are usually merged, which saves comparing the names most of the time
+		if (_parameters[i].name == name || !strcmp(_parameters[i].name, name)) {
+			return _parameterSlots[i];
+		}
+	}
+
+#ifndef NDEBUG
+	Assertion(false, "Hook '%s' does not accept parameter '%s'.", _hookName.c_str(), name);
+#endif
+
+	// release builds still set the variable, as they did before the parameters had slots
+	return script_hook_var_slot(name);
+}
+
+namespace detail {
+inline int find_hook_param_slot(const HookBase& hook, const char* name)
+{
+	return hook.getParameterSlot(name);
+}
+} // namespace detail
+
 template<typename condition_t>
 class HookImpl : public HookBase {
   protected:
@@ -152,26 +196,16 @@ class HookImpl : public HookBase {
 	template <typename... Args>
 	int run(condition_t condition, detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
-		if (!Scripting_game_init_run)
+		// nothing to marshal if no script is listening
+		if (!Scripting_game_init_run || !Script_system.IsActiveAction(this->_hookId))
 			return 0;
 
-		SCP_vector<SCP_string> paramNames;
-		argsList.setHookVars(paramNames);
-
-#ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
-				"Hook '%s' does not accept parameter '%s'.",
-				this->_hookName.c_str(),
-				param.c_str());
-			});
-#endif
+		int paramSlots[detail::HookParameterInstanceList<Args...>::MAX_PARAMS];
+		const auto numParams = argsList.setHookVars(*this, paramSlots);
 
 		const auto num_run = Script_system.RunCondition(this->_hookId, std::any(std::move(condition)));
 
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
-		}
+		detail::HookParameterInstanceList<Args...>::remHookVars(paramSlots, numParams);
 
 		return num_run;
 	}
@@ -186,26 +220,16 @@ class HookImpl<void> : public HookBase {
 	template <typename... Args>
 	int run(detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
-		if (!Scripting_game_init_run)
+		// nothing to marshal if no script is listening
+		if (!Scripting_game_init_run || !Script_system.IsActiveAction(this->_hookId))
 			return 0;
 
-		SCP_vector<SCP_string> paramNames;
-		argsList.setHookVars(paramNames);
-
-#ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
-				"Hook '%s' does not accept parameter '%s'.",
-				this->_hookName.c_str(),
-				param.c_str());
-			});
-#endif
+		int paramSlots[detail::HookParameterInstanceList<Args...>::MAX_PARAMS];
+		const auto numParams = argsList.setHookVars(*this, paramSlots);
 
 		const auto num_run = Script_system.RunCondition(this->_hookId, std::any{});
 
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
-		}
+		detail::HookParameterInstanceList<Args...>::remHookVars(paramSlots, numParams);
 
 		return num_run;
 	}
@@ -245,26 +269,16 @@ class OverridableHookImpl : public Hook<condition_t> {
 	template <typename... Args>
 	bool isOverride(condition_t condition, detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
-		if (!Scripting_game_init_run)
+		// nothing to marshal if no script is listening
+		if (!Scripting_game_init_run || !Script_system.IsActiveAction(this->_hookId))
 			return false;
 
-		SCP_vector<SCP_string> paramNames;
-		argsList.setHookVars(paramNames);
-
-#ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
-				"Hook '%s' does not accept parameter '%s'.",
-				this->_hookName.c_str(),
-				param.c_str());
-			});
-#endif
+		int paramSlots[detail::HookParameterInstanceList<Args...>::MAX_PARAMS];
+		const auto numParams = argsList.setHookVars(*this, paramSlots);
 
 		const auto ret_val = Script_system.IsConditionOverride(this->_hookId, std::any(std::move(condition)));
 
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
-		}
+		detail::HookParameterInstanceList<Args...>::remHookVars(paramSlots, numParams);
 
 		return ret_val;
 	}
@@ -279,26 +293,16 @@ protected:
 	template <typename... Args>
 	bool isOverride(detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
-		if (!Scripting_game_init_run)
+		// nothing to marshal if no script is listening
+		if (!Scripting_game_init_run || !Script_system.IsActiveAction(this->_hookId))
 			return false;
 
-		SCP_vector<SCP_string> paramNames;
-		argsList.setHookVars(paramNames);
-
-#ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
-				"Hook '%s' does not accept parameter '%s'.",
-				this->_hookName.c_str(),
-				param.c_str());
-			});
-#endif
+		int paramSlots[detail::HookParameterInstanceList<Args...>::MAX_PARAMS];
+		const auto numParams = argsList.setHookVars(*this, paramSlots);
 
 		const auto ret_val = Script_system.IsConditionOverride(this->_hookId, std::any{});
 
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
-		}
+		detail::HookParameterInstanceList<Args...>::remHookVars(paramSlots, numParams);
 
 		return ret_val;
 	}
@@ -404,6 +404,51 @@ int cache_condition(ConditionalType type, const SCP_string& value){
 	}
 }
 
+namespace {
+struct hook_var_names {
+	SCP_vector<SCP_string> names;
+	SCP_unordered_map<SCP_string, int> slots;
+};
+
+// hooks intern their variables when they are constructed, which may be before any other global is initialized
+hook_var_names& get_hook_var_names()
+{
+	static hook_var_names names;
+	return names;
+}
+}
+
+int script_hook_var_slot(const char* name)
+{
+	auto& names = get_hook_var_names();
+
+	auto iter = names.slots.find(name);
+	if (iter != names.slots.end())
+		return iter->second;
+
+	const auto slot = static_cast<int>(names.names.size());
+	names.names.emplace_back(name);
+	names.slots.emplace(name, slot);
+
+	return slot;
+}
+
+int script_find_hook_var_slot(const char* name)
+{
+	const auto& names = get_hook_var_names();
+
+	auto iter = names.slots.find(name);
+	return iter != names.slots.end() ? iter->second : -1;
+}
+
+const SCP_string& script_hook_var_name(int slot)
+{
+	const auto& names = get_hook_var_names();
+
+	Assertion(slot >= 0 && slot < static_cast<int>(names.names.size()), "Invalid hook variable slot %d!", slot);
+	return names.names[slot];
+}
+
 //*************************CLASS: script_state*************************
 //Most of the icky stuff is here. Lots of #ifdefs
 
@@ -430,7 +475,11 @@ void script_state::SetHookObjects(int num, ...)
 		auto reference = luacpp::UniqueLuaReference::create(LuaState);
 		lua_pop(LuaState, 1); // Remove object value from the stack
 
-		HookVariableValues[name].push_back(std::move(reference));
+		auto slot = script_hook_var_slot(name);
+		if (slot >= static_cast<int>(HookVariableValues.size()))
+			HookVariableValues.resize(slot + 1);
+
+		HookVariableValues[slot].push_back(std::move(reference));
 	}
 
 	va_end(vl);
@@ -438,22 +487,43 @@ void script_state::SetHookObjects(int num, ...)
 
 void script_state::RemHookVar(const char* name)
 {
-	this->RemHookVars({name});
+	// a name that was never interned was never set either
+	auto slot = script_find_hook_var_slot(name);
+	if (slot >= 0) {
+		RemHookVar(slot);
+	}
 }
 
-void script_state::RemHookVars(std::initializer_list<SCP_string> names)
+void script_state::RemHookVar(int slot)
 {
 	if (LuaState != nullptr) {
-		for (const auto& hookVar : names) {
-			if (HookVariableValues[hookVar].empty()) {
-				// Nothing to do
-				continue;
-			}
-			HookVariableValues[hookVar].pop_back();
+		if (slot >= static_cast<int>(HookVariableValues.size()) || HookVariableValues[slot].empty()) {
+			// Nothing to do
+			return;
 		}
+		HookVariableValues[slot].pop_back();
+	}
+}
+
+void script_state::RemHookVars(std::initializer_list<SCP_string> names)
+{
+	for (const auto& hookVar : names) {
+		RemHookVar(hookVar.c_str());
+	}
+}
+
+const luacpp::LuaReference* script_state::GetHookVariableReference(const char* name) const
+{
+	auto slot = script_find_hook_var_slot(name);
+	if (slot < 0 || slot >= static_cast<int>(HookVariableValues.size()) || HookVariableValues[slot].empty()) {
+		return nullptr;
 	}
+
+	// Use the value on top of the stack
+	return &HookVariableValues[slot].back();
 }
-const SCP_unordered_map<SCP_string, SCP_vector<luacpp::LuaReference>>& script_state::GetHookVariableReferences()
+
+const SCP_vector<SCP_vector<luacpp::LuaReference>>& script_state::GetHookVariableReferences()
 {
 	return HookVariableValues;
 }
@@ -887,6 +957,7 @@ void script_state::ParseGlobalChunk(ConditionalActions hookType, const char* deb
 	}
 
 	ConditionalHooks[hookType].emplace_back(std::move(sat));
+	AssayActions();
 }
 bool script_state::ParseCondition(const char *filename)
 {
@@ -1015,14 +1086,19 @@ void script_state::AssayActions() {
 	ActiveActions.clear();
 
 	for (const auto &hook : ConditionalHooks) {
+		if (hook.first < 0)
+			continue;
+
+		if (hook.first >= static_cast<int>(ActiveActions.size()))
+			ActiveActions.resize(hook.first + 1, false);
+
 		ActiveActions[hook.first] = !hook.second.empty();
 	}
 }
 
 bool script_state::IsActiveAction(int action_id) {
-	auto entry = ActiveActions.find(action_id);
-	if (entry != ActiveActions.end())
-		return entry->second;
+	if (action_id >= 0 && action_id < static_cast<int>(ActiveActions.size()))
+		return ActiveActions[action_id];
 	else
 		return false;
 }
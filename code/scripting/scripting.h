@@ -33,6 +33,13 @@ struct script_function {
 	luacpp::LuaFunction function;
 };
 
+// Hook variable names are interned into slots, so that hooks can set and remove their variables without hashing the
+// names every time they run. Slots are never released, the same name always gets the same slot.
+int script_hook_var_slot(const char* name);
+// The slot of name if it has been interned before, -1 otherwise
+int script_find_hook_var_slot(const char* name);
+const SCP_string& script_hook_var_name(int slot);
+
 //-WMC
 struct script_hook
 {
@@ -139,11 +146,12 @@ class script_state
 	// advanced features of LuaValue
 	// values are a vector to provide a stack of values. This is necessary to ensure consistent behavior if a scripting
 	// hook is called from within another script (e.g. calls to createShip)
-	SCP_unordered_map<SCP_string, SCP_vector<luacpp::LuaReference>> HookVariableValues;
+	// Indexed by the slot of the variable name, see script_hook_var_slot()
+	SCP_vector<SCP_vector<luacpp::LuaReference>> HookVariableValues;
 
 	// ActiveActions lets code that might run scripting hooks know whether any scripts are even registered for it.
-	// AssayActions is responsible for keeping it up to date.
-	SCP_unordered_map<int, bool> ActiveActions;
+	// AssayActions is responsible for keeping it up to date. Indexed by hook id, since it is checked very often.
+	SCP_vector<bool> ActiveActions;
 
 	void ParseChunkSub(script_function& out_func, const char* debug_str=NULL);
 
@@ -183,12 +191,18 @@ public:
 
 	template<typename T>
 	void SetHookVar(const char *name, char format, T&& value);
+	template<typename T>
+	void SetHookVar(int slot, char format, T&& value);
 	void SetHookObject(const char *name, object *objp);
 	void SetHookObjects(int num, ...);
 	void RemHookVar(const char *name);
+	void RemHookVar(int slot);
 	void RemHookVars(std::initializer_list<SCP_string> names);
 
-	const SCP_unordered_map<SCP_string, SCP_vector<luacpp::LuaReference>>& GetHookVariableReferences();
+	// The current value of a hook variable, or nullptr if it isn't set
+	const luacpp::LuaReference* GetHookVariableReference(const char* name) const;
+	// The value stacks of all hook variables, indexed by slot
+	const SCP_vector<SCP_vector<luacpp::LuaReference>>& GetHookVariableReferences();
 
 	//***Hook creation functions
 	template <typename T>
@@ -223,6 +237,12 @@ public:
 
 template<typename T>
 void script_state::SetHookVar(const char *name, char format, T&& value)
+{
+	SetHookVar(script_hook_var_slot(name), format, std::forward<T>(value));
+}
+
+template<typename T>
+void script_state::SetHookVar(int slot, char format, T&& value)
 {
 	if(format == '\0')
 		return;
@@ -234,7 +254,10 @@ void script_state::SetHookVar(const char *name, char format, T&& value)
 		auto reference = luacpp::UniqueLuaReference::create(LuaState);
 		lua_pop(LuaState, 1); // Remove object value from the stack
 
-		HookVariableValues[name].push_back(std::move(reference));
+		if (slot >= static_cast<int>(HookVariableValues.size()))
+			HookVariableValues.resize(slot + 1);
+
+		HookVariableValues[slot].push_back(std::move(reference));
 	}
 }
 
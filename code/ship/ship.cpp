@@ -64,6 +64,7 @@
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "object/waypoint.h"
@@ -842,6 +843,7 @@ static int ship_obj_list_add(int objnum)
 	Ship_objs[i].objnum = objnum;
 	list_append(&Ship_obj_list, &Ship_objs[i]);
 	Ship_objs[i].flags |= SHIP_OBJ_USED;
+	obj_grid_add_late(objnum);
 
 	return i;
 }
@@ -7677,6 +7679,15 @@ void ship_subsys::clear()
 	favor_current_facing = 0.0f;
 	targeted_subsys = NULL;
 	scripting_target_override = false;
+	turret_thought_generation = -1;
+	turret_thought_enemy_objnum = -1;
+	turret_thought_enemy_sig = 0;
+	turret_thought_enemy_team = -1;
+	turret_thought_current_enemy = -1;
+	turret_thought_team_mask = 0;
+	turret_thought_target_flags = 0;
+	turret_thought_attackers = 0;
+	turret_thought_num_attackers = 0;
 	last_fired_weapon_info_index = -1;
 	shared_fire_direction_beam_objnum = -1;
 
@@ -7876,6 +7887,7 @@ static int subsys_set(int objnum, int ignore_subsys_info)
 		ship_system->disruption_timestamp=timestamp(0);
 		ship_system->turret_pick_big_attack_point_timestamp = timestamp(0);
 		ship_system->scripting_target_override = false;
+		ship_system->turret_thought_generation = -1;
 		ship_system->last_fired_weapon_info_index = -1;
 		ship_system->shared_fire_direction_beam_objnum = -1;
 
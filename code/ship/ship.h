@@ -378,6 +378,18 @@ public:
 	float	favor_current_facing;					        
 	ship_subsys	*targeted_subsys;					//	subsystem this turret is attacking
 	bool	scripting_target_override;
+
+	// target picked for this turret by ai_turret_think_all() from the state at the start of the frame
+	int		turret_thought_generation;			//	which ai_turret_think_all() the pick is from
+	int		turret_thought_enemy_objnum;
+	int		turret_thought_enemy_sig;
+	int		turret_thought_enemy_team;
+	int		turret_thought_current_enemy;		//	turret_enemy_objnum the pick was made with
+	int		turret_thought_team_mask;			//	enemy team mask and weapon restrictions of the turret when the pick was made
+	int		turret_thought_target_flags;
+	int		turret_thought_attackers;			//	first of the turret counts the pick depended on, in aiturret.cpp
+	int		turret_thought_num_attackers;
+
 	int		last_fired_weapon_info_index;		// which weapon class was last fired
 	int		shared_fire_direction_beam_objnum;		// reference beam for shared fire direction
 
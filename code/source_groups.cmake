@@ -131,6 +131,8 @@ add_file_folder("CFile"
 	cfile/cfilearchive.cpp
 	cfile/cfilearchive.h
 	cfile/cfilelist.cpp
+	cfile/cfilemapping.cpp
+	cfile/cfilemapping.h
 	cfile/cfilesystem.cpp
 	cfile/cfilesystem.h
 	cfile/cfilecompression.cpp
@@ -825,6 +827,8 @@ add_file_folder("Libs\\\\RenderDoc"
 
 # Lighting files
 add_file_folder("Lighting"
+	lighting/lightgrid.cpp
+	lighting/lightgrid.h
 	lighting/lighting.cpp
 	lighting/lighting.h
 	lighting/lighting_profiles.cpp
@@ -967,6 +971,8 @@ add_file_folder("mod_table"
 add_file_folder("Model"
 	model/model.h
 	model/modelcollide.cpp
+	model/modelcollidebvh.cpp
+	model/modelcollidebvh.h
 	model/modelinterp.cpp
 	model/modelread.cpp
 	model/modelrender.h
@@ -1105,6 +1111,8 @@ add_file_folder("Object"
 	object/collideshipship.cpp
 	object/collideshipweapon.cpp
 	object/collideweaponweapon.cpp
+	object/collisionpaircache.cpp
+	object/collisionpaircache.h
 	object/deadobjectdock.cpp
 	object/deadobjectdock.h
 	object/objcollide.cpp
@@ -1113,6 +1121,8 @@ add_file_folder("Object"
 	object/object.h
 	object/objectdock.cpp
 	object/objectdock.h
+	object/objectgrid.cpp
+	object/objectgrid.h
 	object/objectshield.cpp
 	object/objectshield.h
 	object/objectsnd.cpp
@@ -1833,6 +1843,7 @@ add_file_folder("Utils"
 	utils/Random.h
 	utils/RandomRange.h
 	utils/reset_on_move.h
+	utils/spsc_queue.h
 	utils/string_utils.cpp
 	utils/string_utils.h
 	utils/table_viewer.cpp
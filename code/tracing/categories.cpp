@@ -43,12 +43,16 @@ Category FindOverlapColliders("Find overlap colliders", false);
 Category CollidePair("Collide Pair", false);
 Category RetimeCollisionCache("Retime Collision Cache", false);
 
+Category JobSystemTask("Job system task", false);
+Category JobSystemWait("Job system wait", false);
+
 Category WeaponPostMove("Weapon post move", false);
 Category ShipPostMove("Ship post move", false);
 Category FireballPostMove("Fireball post move", false);
 Category DebrisPostMove("Debris post move", false);
 Category AsteroidPostMove("Asteroid post move", false);
 Category PreMove("Pre Move", false);
+Category AiTurretThink("AI turret think", false);
 Category Physics("Physics", false);
 Category PostMove("Post Move", false);
 Category CollisionDetection("Collision Detection", false);
@@ -62,6 +66,7 @@ Category SubmitDraws("Submit Draws", true);
 Category ApplyLights("Apply Lights", true);
 Category DrawEffects("Draw Effects", true);
 Category SetupNebula("Setup Nebula", true);
+Category VolumetricsBake("Bake volumetric nebula", true);
 Category DrawPoofs("Draw Poofs", true);
 Category DrawStars("Draw Stars", true);
 Category DrawShields("Draw Shields", true);
@@ -78,6 +83,7 @@ Category NonrepeatingEvents("Nonrepeating events", false);
 
 Category ParticlesRenderAll("Render particles", true);
 Category ParticlesMoveAll("Move particles", false);
+Category ParticlesBatch("Batch particles", true);
 
 Category EnvironmentMapping("Environment Mapping", true);
 Category BuildShadowMap("Build Shadow Map", true);
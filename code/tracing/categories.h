@@ -56,12 +56,16 @@ extern Category FindOverlapColliders;
 extern Category CollidePair;
 extern Category RetimeCollisionCache;
 
+extern Category JobSystemTask;
+extern Category JobSystemWait;
+
 extern Category WeaponPostMove;
 extern Category ShipPostMove;
 extern Category FireballPostMove;
 extern Category DebrisPostMove;
 extern Category AsteroidPostMove;
 extern Category PreMove;
+extern Category AiTurretThink;
 extern Category Physics;
 extern Category PostMove;
 extern Category CollisionDetection;
@@ -75,6 +79,7 @@ extern Category SubmitDraws;
 extern Category ApplyLights;
 extern Category DrawEffects;
 extern Category SetupNebula;
+extern Category VolumetricsBake;
 extern Category DrawPoofs;
 extern Category DrawStars;
 extern Category DrawShields;
@@ -91,6 +96,7 @@ extern Category NonrepeatingEvents;
 
 extern Category ParticlesRenderAll;
 extern Category ParticlesMoveAll;
+extern Category ParticlesBatch;
 
 extern Category EnvironmentMapping;
 extern Category BuildShadowMap;
@@ -7,10 +7,22 @@
 #include <cstdint>
 
 #include "globalincs/pstypes.h"
+#include "utils/threading.h"
 
 namespace util {
 
-thread_local std::mt19937 seeder {std::random_device()()};
+namespace {
+// Task pool workers get fixed seeds, so that what they generate doesn't depend on the machine or the run
+constexpr unsigned int WORKER_SEED_BASE = 0x5eed0000;
+
+unsigned int initial_seed()
+{
+	auto index = threading::get_thread_index();
+	return index == 0 ? std::random_device()() : WORKER_SEED_BASE + static_cast<unsigned int>(index);
+}
+} // namespace
+
+thread_local std::mt19937 seeder {initial_seed()};
 
 namespace {
 template <typename RngType>
@@ -44,6 +56,20 @@ private:
 };
 
 RandomImpl<std::mt19937> SCP_rng;
+
+// Task pool workers draw from generators of their own, so that they neither race with the main thread nor shift its sequence
+RandomImpl<std::mt19937>& current_rng()
+{
+	if (threading::get_thread_index() == 0)
+		return SCP_rng;
+
+	thread_local RandomImpl<std::mt19937> worker_rng = []() {
+		RandomImpl<std::mt19937> rng;
+		rng.seed(seeder());
+		return rng;
+	}();
+	return worker_rng;
+}
 } // namespace
 
 Random::Random() = default;
@@ -51,19 +77,19 @@ Random::Random() = default;
 void Random::seed(unsigned int val)
 {
 	Assert(val > 0);
-	SCP_rng.seed(val);
+	current_rng().seed(val);
 }
 
 int Random::next()
 {
-	return SCP_rng.next();
+	return current_rng().next();
 }
 
 int Random::next(int modulus)
 {
 	Assert(modulus > 0);
 
-	return SCP_rng.next() % modulus;
+	return current_rng().next() % modulus;
 }
 
 int Random::next(int low, int high)
@@ -71,17 +97,17 @@ int Random::next(int low, int high)
 	const int range = high - low + 1;
 	Assert(range > 0);
 
-	return low + (SCP_rng.next() % range);
+	return low + (current_rng().next() % range);
 }
 
 bool Random::flip_coin()
 {
 	// [0, HALF_MAX_VALUE] and [HALF_MAX_VALUE+1,MAX_VALUE] are the same size
-	return SCP_rng.next() <= Random::HALF_MAX_VALUE;
+	return current_rng().next() <= Random::HALF_MAX_VALUE;
 }
 
 void Random::advance(unsigned long long distance)
 {
-	SCP_rng.advance(distance);
+	current_rng().advance(distance);
 }
 } // namespace util
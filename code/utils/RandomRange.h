@@ -161,6 +161,18 @@ class RandomRange {
 
 		m_generator.seed(new_seed);
 	}
+
+	/**
+	 * @brief Whether this range always returns the same value
+	 *
+	 * next() only touches the generator of ranges that aren't constant, so only those are unsafe to share between threads.
+	 *
+	 * @return @c true if the range is constant
+	 */
+	bool is_constant() const
+	{
+		return m_constant;
+	}
 };
 
 /**
@@ -583,6 +595,9 @@ class ParsedRandomRange {
 	inline void seed(unsigned int new_seed) const {
 		std::visit([new_seed](auto& range) {return range.seed(new_seed);}, m_random_range);
 	}
+	inline bool is_constant() const {
+		return std::visit([](auto& range) {return range.is_constant();}, m_random_range);
+	}
 	static ParsedRandomRange parseRandomRange(float min = std::numeric_limits<float>::lowest()/2.1f, float max = std::numeric_limits<float>::max()/2.1f) {
 		switch (optional_string_either("NORMAL", "CURVE")) {
 			case 0: {
@@ -645,6 +645,17 @@ public:
 		return result;
 	}
 
+	// Whether get_output() draws random numbers for any curve of this set. Those curves are not safe to evaluate from several threads at once.
+	bool has_random_entries() const {
+		for (const auto& curve_list : curves) {
+			for (const auto& [input_idx, curve_entry] : curve_list) {
+				if (!curve_entry.scaling_factor.is_constant() || !curve_entry.translation.is_constant())
+					return true;
+			}
+		}
+		return false;
+	}
+
 	float get_output_or_default(output_enum output, const input_type& input, float default_val, const modular_curves_entry_instance* instance = nullptr) const {
 		if (has_curve(output))
 			return get_output(output, input, instance);
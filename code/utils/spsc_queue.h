@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace util {
+
+/**
+ * @brief Unbounded, lock-free queue between exactly one producer thread and one consumer thread
+ *
+ * Items are stored in fixed size blocks which are chained together as the queue grows.  The producer
+ * publishes each item with a single release store, so pushing never blocks or takes a lock and the
+ * consumer can drain whatever has been published so far in one go.  Blocks the consumer is done with
+ * are kept as spares for the producer, so after warming up the queue stops allocating.
+ *
+ * push() may only be called by the producer, try_pop() and empty() only by the consumer.  Neither
+ * side may run while the queue is destroyed.
+ *
+ * @tparam T The item type, must be default constructible and move assignable
+ * @tparam BLOCK_SIZE The number of items per block
+ */
+template <typename T, size_t BLOCK_SIZE = 256>
+class spsc_queue {
+	struct block {
+		std::array<T, BLOCK_SIZE> items;
+		// number of items in this block that are ready to be consumed, only written by the producer
+		std::atomic_size_t written = 0;
+		std::atomic<block*> next = nullptr;
+	};
+
+	// consumer side
+	block* _head;
+	size_t _read = 0;
+
+	// producer side
+	block* _tail;
+
+	// a single block retired by the consumer which the producer may reuse
+	std::atomic<block*> _spare = nullptr;
+
+  public:
+	spsc_queue() : _head(new block()), _tail(_head) {}
+
+	~spsc_queue()
+	{
+		while (_head != nullptr) {
+			auto next = _head->next.load(std::memory_order_relaxed);
+			delete _head;
+			_head = next;
+		}
+		delete _spare.load(std::memory_order_relaxed);
+	}
+
+	spsc_queue(const spsc_queue&) = delete;
+	spsc_queue& operator=(const spsc_queue&) = delete;
+
+	void push(T&& item)
+	{
+		size_t index = _tail->written.load(std::memory_order_relaxed);
+		if (index == BLOCK_SIZE) {
+			block* next = _spare.exchange(nullptr, std::memory_order_acquire);
+			if (next == nullptr)
+				next = new block();
+
+			// the new block must look empty before the consumer can reach it
+			next->written.store(0, std::memory_order_relaxed);
+			next->next.store(nullptr, std::memory_order_relaxed);
+			_tail->next.store(next, std::memory_order_release);
+			_tail = next;
+			index = 0;
+		}
+
+		_tail->items[index] = std::move(item);
+		_tail->written.store(index + 1, std::memory_order_release);
+	}
+
+	bool try_pop(T& out)
+	{
+		while (true) {
+			if (_read < _head->written.load(std::memory_order_acquire)) {
+				out = std::move(_head->items[_read]);
+				_head->items[_read] = T();
+				++_read;
+				return true;
+			}
+
+			// the producer only moves on to the next block once this one is full
+			if (_read < BLOCK_SIZE)
+				return false;
+
+			block* next = _head->next.load(std::memory_order_acquire);
+			if (next == nullptr)
+				return false;
+
+			block* old = _head;
+			_head = next;
+			_read = 0;
+
+			// the producer never looks at a block again after linking its successor
+			delete _spare.exchange(old, std::memory_order_release);
+		}
+	}
+
+	bool empty() const
+	{
+		if (_read < _head->written.load(std::memory_order_acquire))
+			return false;
+
+		if (_read < BLOCK_SIZE)
+			return true;
+
+		block* next = _head->next.load(std::memory_order_acquire);
+		return next == nullptr || next->written.load(std::memory_order_acquire) == 0;
+	}
+};
+
+}
@@ -1,11 +1,12 @@
 #include "threading.h"
 
 #include "cmdline/cmdline.h"
-#include "object/objcollide.h"
 #include "globalincs/pstypes.h"
+#include "tracing/tracing.h"
 
 #include <atomic>
 #include <condition_variable>
+#include <iterator>
 #include <mutex>
 #include <thread>
 
@@ -16,55 +17,113 @@
 #endif
 
 namespace threading {
-	static size_t num_threads = 1;
-
-	static std::condition_variable wait_for_task;
-	static std::mutex wait_for_task_mutex;
-	static bool wait_for_task_condition;
+	struct job {
+		std::function<void()> func;
+		task_group* group;
+	};
+
+	//Each worker owns a deque. The owner pushes and pops at the back, so it works on the most recently queued (and most likely cache-hot) job, while other threads steal from the front.
+	//Slot 0 is shared by all threads that are not part of the pool, i.e. the main thread.
+	struct job_queue {
+		std::mutex mutex;
+		SCP_deque<job> jobs;
+	};
 
-	static std::condition_variable wait_for_spindown_tasks;
-	static std::mutex wait_for_spindown_task_mutex;
-	static size_t wait_for_spindown_tasks_counter;
+	static size_t num_threads = 1;
 
-	static std::condition_variable wait_for_spinup_tasks;
-	static std::mutex wait_for_spinup_task_mutex;
-	static size_t wait_for_spinup_tasks_counter;
+	static std::unique_ptr<job_queue[]> job_queues;
+	static std::atomic_size_t num_queued_jobs = 0;
 
-	static std::atomic<WorkerThreadTask> worker_task;
+	static std::mutex wait_for_job_mutex;
+	static std::condition_variable wait_for_job;
+	static bool shutting_down = false;
 
 	static SCP_vector<std::thread> worker_threads;
 
+	static thread_local size_t current_thread_index = 0;
+
 	//Internal Functions
-	static void mp_worker_thread_main(size_t threadIdx) {
-		while(true) {
-			{
-				std::scoped_lock lock {wait_for_spindown_task_mutex};
-				++wait_for_spindown_tasks_counter;
-				wait_for_spindown_tasks.notify_all();
-			}
-			//We're waiting for a new task, so spindown was successful
-			{
-				std::unique_lock<std::mutex> lk(wait_for_task_mutex);
-				wait_for_task.wait(lk, []() { return wait_for_task_condition; });
-			}
-			//Notify that we passed the wait and can now start processing. This is necessary, as slow thread wakeups in very low workloads could cause the wait_for_task_condition to be false, never waking up the thread, locking on spindown wait
-			{
-				std::scoped_lock lock {wait_for_spinup_task_mutex};
-				++wait_for_spinup_tasks_counter;
-				wait_for_spinup_tasks.notify_all();
+	static void push_job(job&& new_job) {
+		//Count the job before it becomes visible, so that the counter never drops below the number of jobs that can actually be popped
+		{
+			std::scoped_lock lock {wait_for_job_mutex};
+			num_queued_jobs.fetch_add(1, std::memory_order_release);
+		}
+		{
+			auto& queue = job_queues[current_thread_index];
+			std::scoped_lock lock {queue.mutex};
+			queue.jobs.push_back(std::move(new_job));
+		}
+		wait_for_job.notify_one();
+	}
+
+	//Pops a job, or only a job of the given group if one is passed. Waiting threads must not pick up jobs of other groups,
+	//as those may block until the waiting thread has moved on (e.g. the collision workers).
+	static bool pop_job(job& out, const task_group* only_group = nullptr) {
+		if (num_queued_jobs.load(std::memory_order_acquire) == 0)
+			return false;
+
+		const size_t num_queues = num_threads + 1;
+		const size_t own = current_thread_index;
+
+		auto in_group = [only_group](const job& queued) { return only_group == nullptr || queued.group == only_group; };
+
+		{
+			auto& queue = job_queues[own];
+			std::scoped_lock lock {queue.mutex};
+			auto it = std::find_if(queue.jobs.rbegin(), queue.jobs.rend(), in_group);
+			if (it != queue.jobs.rend()) {
+				out = std::move(*it);
+				queue.jobs.erase(std::next(it).base());
+				num_queued_jobs.fetch_sub(1, std::memory_order_acq_rel);
+				return true;
 			}
+		}
 
-			switch (worker_task.load(std::memory_order_acquire)) {
-				case WorkerThreadTask::EXIT:
-					//We're done and will quit, so ensure we report this.
-					return;
-				case WorkerThreadTask::COLLISION:
-					collide_mp_worker_thread(threadIdx);
-					break;
-				default:
-					UNREACHABLE("Invalid threaded worker task!");
+		for (size_t offset = 1; offset < num_queues; offset++) {
+			auto& queue = job_queues[(own + offset) % num_queues];
+			std::scoped_lock lock {queue.mutex};
+			auto it = std::find_if(queue.jobs.begin(), queue.jobs.end(), in_group);
+			if (it != queue.jobs.end()) {
+				out = std::move(*it);
+				queue.jobs.erase(it);
+				num_queued_jobs.fetch_sub(1, std::memory_order_acq_rel);
+				return true;
 			}
 		}
+
+		return false;
+	}
+
+	static void execute_job(job& to_run) {
+		{
+			TRACE_SCOPE(tracing::JobSystemTask);
+			to_run.func();
+		}
+		to_run.group->task_done();
+	}
+
+	static bool try_execute_job(const task_group* only_group = nullptr) {
+		job to_run;
+		if (!pop_job(to_run, only_group))
+			return false;
+
+		execute_job(to_run);
+		return true;
+	}
+
+	static void mp_worker_thread_main(size_t threadIdx) {
+		current_thread_index = threadIdx + 1;
+
+		while (true) {
+			if (try_execute_job())
+				continue;
+
+			std::unique_lock<std::mutex> lk(wait_for_job_mutex);
+			wait_for_job.wait(lk, []() { return shutting_down || num_queued_jobs.load(std::memory_order_acquire) > 0; });
+			if (shutting_down)
+				return;
+		}
 	}
 
 	static size_t get_number_of_physical_cores_fallback() {
@@ -166,39 +225,38 @@ namespace threading {
 
 	//External Functions
 
-	void spin_up_threaded_task(WorkerThreadTask task) {
-		{
-			std::scoped_lock lock {wait_for_spindown_task_mutex};
-			wait_for_spindown_tasks_counter = 0;
-			//No notify here cause we only ever lock, never unlock the wait here.
-		}
-		worker_task.store(task);
-		{
-			std::scoped_lock lock {wait_for_task_mutex};
-			wait_for_task_condition = true;
-			wait_for_task.notify_all();
-		}
+	task_group::~task_group() {
+		wait();
 	}
 
-	void spin_down_threaded_task() {
-		//Make sure all threads are actually running before stopping the pool again
-		{
-			std::unique_lock<std::mutex> lk(wait_for_spinup_task_mutex);
-			wait_for_spinup_tasks.wait(lk, []() { return wait_for_spinup_tasks_counter >= num_threads; });
-			wait_for_spinup_tasks_counter = 0;
+	void task_group::run(std::function<void()> task) {
+		if (get_num_workers() == 0) {
+			task();
+			return;
 		}
-		{
-			std::scoped_lock lock {wait_for_task_mutex};
-			wait_for_task_condition = false;
+
+		_pending.fetch_add(1, std::memory_order_relaxed);
+		push_job(job{std::move(task), this});
+	}
+
+	void task_group::wait() {
+		if (_pending.load(std::memory_order_acquire) > 0) {
+			TRACE_SCOPE(tracing::JobSystemWait);
+
+			//Help out with the queued tasks of this group until none are left, then sleep until the workers finish the rest
+			while (_pending.load(std::memory_order_acquire) > 0 && try_execute_job(this))
+				;
 		}
+
+		//Always go through the mutex, so that the last task_done() has let go of this group before it can be destroyed
+		std::unique_lock<std::mutex> lk(_mutex);
+		_done.wait(lk, [this]() { return _pending.load(std::memory_order_acquire) == 0; });
 	}
 
-	void spin_down_wait_complete() {
-		//Technically, spindowns should only occur when the actual code is confirmed to be complete. So we shouldn't be waiting for long here
-		{
-			std::unique_lock<std::mutex> lk(wait_for_spindown_task_mutex);
-			wait_for_spindown_tasks.wait(lk, []() { return wait_for_spindown_tasks_counter >= num_threads; });
-		};
+	void task_group::task_done() {
+		std::scoped_lock lock {_mutex};
+		if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			_done.notify_all();
 	}
 
 	void init_task_pool() {
@@ -217,19 +275,28 @@ namespace threading {
 
 		mprintf(("Spinning up threadpool with %d threads...\n", static_cast<int>(num_threads)));
 
+		job_queues = std::make_unique<job_queue[]>(num_threads + 1);
+		shutting_down = false;
+
 		for (size_t i = 0; i < num_threads; i++) {
 			worker_threads.emplace_back([i](){ mp_worker_thread_main(i); });
 		}
 	}
 
 	void shut_down_task_pool() {
-		spin_up_threaded_task(WorkerThreadTask::EXIT);
-
-		//Technically we could await spin_down_wait_complete here, but since we're returning and joining the threads here, there is no need
+		{
+			std::scoped_lock lock {wait_for_job_mutex};
+			shutting_down = true;
+		}
+		wait_for_job.notify_all();
 
 		for(auto& thread : worker_threads) {
 			thread.join();
 		}
+
+		worker_threads.clear();
+		job_queues.reset();
+		num_queued_jobs.store(0);
 	}
 
 	bool is_threading() {
@@ -239,4 +306,8 @@ namespace threading {
 	size_t get_num_workers() {
 		return worker_threads.size();
 	}
+
+	size_t get_thread_index() {
+		return current_thread_index;
+	}
 }
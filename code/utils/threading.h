@@ -1,22 +1,133 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <mutex>
 
 namespace threading {
-	enum class WorkerThreadTask : uint8_t { EXIT, COLLISION };
+	/**
+	 * @brief A set of tasks that run on the task pool and can be waited on together
+	 *
+	 * Tasks may themselves start more tasks in the same or in other groups.  A thread waiting for a group
+	 * executes pending tasks of that group while it waits, so waiting from within a task does not block a worker.
+	 * It never runs tasks of other groups, which may block on something the waiting thread has yet to do.
+	 * When there are no workers (i.e. threading is disabled), run() executes the task immediately.
+	 */
+	class task_group {
+	  public:
+		task_group() = default;
+		~task_group();
 
-	//Call this to start a task on the task pool. Note that task-specific data must be set up before calling this.
-	void spin_up_threaded_task(WorkerThreadTask task);
+		task_group(const task_group&) = delete;
+		task_group& operator=(const task_group&) = delete;
 
-	//This _must_ be called on the main thread BEFORE a task completes on a thread of the task pool.
-	void spin_down_threaded_task();
+		//Queues a task. Anything the task uses must stay alive until wait() returns.
+		void run(std::function<void()> task);
 
-	//This should be called AFTER the command to finish a given task is given. This will block until all threads have returned into a state where they are able to listen to new commands.
-	void spin_down_wait_complete();
+		//Blocks until every task started with run() so far has completed.
+		void wait();
 
+		//Used by the task pool once a task of this group has finished.
+		void task_done();
+
+	  private:
+		std::mutex _mutex;
+		std::condition_variable _done;
+		std::atomic_size_t _pending = 0;
+	};
+
+	/**
+	 * @brief Lets one thread sleep until another one signals that the condition it waits for may have changed
+	 *
+	 * Signalling is a fence and a relaxed load unless the other thread is actually asleep, so it is cheap enough to do
+	 * for every item handed over between two threads.  There may only be one waiting thread at a time.
+	 */
+	class wakeup_signal {
+	  public:
+		//Blocks until ready() returns true. ready() must only depend on state that is published before notify() is called.
+		template<typename Pred>
+		void wait_until(Pred&& ready) {
+			if (ready())
+				return;
+
+			std::unique_lock<std::mutex> lk(_mutex);
+			_waiting.store(true, std::memory_order_relaxed);
+			//Either ready() sees what the notifying thread published, or that thread sees _waiting and has to go through the mutex
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			_wakeup.wait(lk, ready);
+			_waiting.store(false, std::memory_order_relaxed);
+		}
+
+		void notify() {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (_waiting.load(std::memory_order_relaxed)) {
+				std::scoped_lock lock {_mutex};
+				_wakeup.notify_all();
+			}
+		}
+
+	  private:
+		std::mutex _mutex;
+		std::condition_variable _wakeup;
+		std::atomic_bool _waiting = false;
+	};
+
+	//Call this on the main thread once cmdline options are known.
 	void init_task_pool();
 	void shut_down_task_pool();
 
 	bool is_threading();
 	size_t get_num_workers();
-}
\ No newline at end of file
+
+	//Returns 0 on the main thread (and any other thread not owned by the task pool), or 1 + the worker index on a worker.
+	//Useful for indexing per-thread buffers sized get_num_workers() + 1.
+	size_t get_thread_index();
+
+	/**
+	 * @brief Calls func(range_begin, range_end) on the task pool for disjoint ranges covering [begin, end)
+	 *
+	 * Ranges contain at least grain_size indices (except possibly the last one).  Returns once all of them
+	 * have been processed.  Runs func(begin, end) directly if there is nothing to split.
+	 */
+	template<typename Func>
+	void parallel_for_ranges(size_t begin, size_t end, size_t grain_size, Func&& func) {
+		if (end <= begin)
+			return;
+
+		const size_t count = end - begin;
+		if (grain_size == 0)
+			grain_size = 1;
+
+		//A few chunks per thread so that stealing can even out chunks of uneven cost
+		size_t num_chunks = std::min((count + grain_size - 1) / grain_size, (get_num_workers() + 1) * 4);
+		if (get_num_workers() == 0 || num_chunks <= 1) {
+			func(begin, end);
+			return;
+		}
+
+		const size_t chunk_size = (count + num_chunks - 1) / num_chunks;
+
+		task_group group;
+		for (size_t chunk_begin = begin + chunk_size; chunk_begin < end; chunk_begin += chunk_size) {
+			const size_t chunk_end = std::min(chunk_begin + chunk_size, end);
+			group.run([&func, chunk_begin, chunk_end]() { func(chunk_begin, chunk_end); });
+		}
+
+		//The calling thread takes the first chunk itself
+		func(begin, std::min(begin + chunk_size, end));
+
+		group.wait();
+	}
+
+	//Calls func(i) on the task pool for every i in [begin, end). See parallel_for_ranges.
+	template<typename Func>
+	void parallel_for(size_t begin, size_t end, size_t grain_size, Func&& func) {
+		parallel_for_ranges(begin, end, grain_size, [&func](size_t range_begin, size_t range_end) {
+			for (size_t i = range_begin; i < range_end; i++)
+				func(i);
+		});
+	}
+}
@@ -11,6 +11,7 @@
 
 
 #include <algorithm>
+#include <atomic>
 
 #include "asteroid/asteroid.h"
 #include "cmdline/cmdline.h"
@@ -79,9 +80,9 @@ int Beam_count = 0;					// how many beams are in use
 // debug stuff - keep track of how many collision tests we perform a second and how many we toss a second
 #define BEAM_TEST_STAMP_TIME		4000	// every 4 seconds
 int Beam_test_stamp = -1;
-int Beam_test_ints = 0;
-int Beam_test_ship = 0;
-int Beam_test_ast = 0;
+std::atomic_int Beam_test_ints = 0;	// atomic since the collision checks may run on worker threads
+std::atomic_int Beam_test_ship = 0;
+std::atomic_int Beam_test_ast = 0;
 int Beam_test_framecount = 0;
 
 // beam warmup completion %
@@ -3058,11 +3059,85 @@ void beam_jitter_aim(beam *b, float aim)
 // BEAM COLLISION FUNCTIONS
 // -----------------------------===========================------------------------------
 
-// collide a beam with a ship, returns 1 if we can ignore all future collisions between the 2 objects
-int beam_collide_ship(obj_pair *pair)
+// what a beam collision check found, applied to the beam on the main thread by the matching process function
+struct beam_collision_check_data {
+	mc_info hits[2];		// the entry hit, followed by the exit hole if the beam tools the target
+	int num_hits = 0;
+	int quadrant_num = -1;
+	int shield_tri_hit = -1;	// deferred add_shield_point()
+	vec3d shield_hitpos = vmd_zero_vector;
+};
+
+static void beam_ship_process_collision(obj_pair *pair, const std::any& collision_data)
+{
+	const auto& cd = std::any_cast<const beam_collision_check_data&>(collision_data);
+	object *weapon_objp = pair->a;
+	object *ship_objp = pair->b;
+	beam *a_beam = &Beams[weapon_objp->instance];
+
+	if (cd.shield_tri_hit >= 0)
+		add_shield_point(OBJ_INDEX(ship_objp), cd.shield_tri_hit, &cd.shield_hitpos, Weapon_info[a_beam->weapon_info_index].shield_impact_effect_radius);
+
+	for (int i = 0; i < cd.num_hits; ++i)
+	{
+		mc_info hit = cd.hits[i];
+		bool ship_override = false, weapon_override = false;
+
+		// get submodel handle if scripting needs it
+		bool has_submodel = (hit.hit_submodel >= 0);
+		scripting::api::submodel_h smh(hit.model_num, hit.hit_submodel);
+
+		if (scripting::hooks::OnBeamCollision->isActive()) {
+			ship_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {ship_objp, weapon_objp} },
+				scripting::hook_param_list(scripting::hook_param("Self", 'o', ship_objp),
+					scripting::hook_param("Object", 'o', weapon_objp),
+					scripting::hook_param("Ship", 'o', ship_objp),
+					scripting::hook_param("Beam", 'o', weapon_objp),
+					scripting::hook_param("Hitpos", 'o', hit.hit_point_world)));
+		}
+
+		if (scripting::hooks::OnShipCollision->isActive()) {
+			weapon_override = scripting::hooks::OnShipCollision->isOverride(scripting::hooks::CollisionConditions{{ship_objp, weapon_objp}},
+				scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_objp),
+					scripting::hook_param("Object", 'o', ship_objp),
+					scripting::hook_param("Ship", 'o', ship_objp),
+					scripting::hook_param("Beam", 'o', weapon_objp),
+					scripting::hook_param("Hitpos", 'o', hit.hit_point_world),
+					scripting::hook_param("ShipSubmodel", 'o', scripting::api::l_Submodel.Set(smh), has_submodel)));
+		}
+
+		if (!ship_override && !weapon_override)
+		{
+			// add to the collision_list
+			// if we got "tooled", add an exit hole too
+			beam_add_collision(a_beam, ship_objp, &hit, cd.quadrant_num, i != 0);
+		}
+
+		if (scripting::hooks::OnBeamCollision->isActive() && !(weapon_override && !ship_override)) {
+			scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{ {ship_objp, weapon_objp} },
+				scripting::hook_param_list(scripting::hook_param("Self", 'o', ship_objp),
+					scripting::hook_param("Object", 'o', weapon_objp),
+					scripting::hook_param("Ship", 'o', ship_objp),
+					scripting::hook_param("Beam", 'o', weapon_objp),
+					scripting::hook_param("Hitpos", 'o', hit.hit_point_world)));
+		}
+		if (scripting::hooks::OnShipCollision->isActive() && ((weapon_override && !ship_override) || (!weapon_override && !ship_override)))
+		{
+			scripting::hooks::OnShipCollision->run(scripting::hooks::CollisionConditions{{ship_objp, weapon_objp}},
+				scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_objp),
+					scripting::hook_param("Object", 'o', ship_objp),
+					scripting::hook_param("Ship", 'o', ship_objp),
+					scripting::hook_param("Beam", 'o', weapon_objp),
+					scripting::hook_param("Hitpos", 'o', hit.hit_point_world),
+					scripting::hook_param("ShipSubmodel", 'o', scripting::api::l_Submodel.Set(smh), has_submodel)));
+		}
+	}
+}
+
+// check a beam against a ship without touching either of them, so that this can run on the collision worker threads
+collision_result beam_collide_ship_check(obj_pair *pair)
 {
 	beam * a_beam;
-	object *weapon_objp;
 	object *ship_objp;
 	ship *shipp;
 	ship_info *sip;
@@ -3073,44 +3148,43 @@ int beam_collide_ship(obj_pair *pair)
 
 	// bogus
 	if (pair == NULL) {
-		return 0;
+		return {false, std::any(), &beam_ship_process_collision};
 	}
 
 	if (reject_due_collision_groups(pair->a, pair->b))
-		return 0;
+		return {false, std::any(), &beam_ship_process_collision};
 
 	// get the beam
 	Assert(pair->a->instance >= 0);
 	Assert(pair->a->type == OBJ_BEAM);
 	Assert(Beams[pair->a->instance].objnum == OBJ_INDEX(pair->a));
-	weapon_objp = pair->a;
 	a_beam = &Beams[pair->a->instance];
 
 	// Don't check collisions for warping out player if past stage 1.
 	if (Player->control_mode >= PCM_WARPOUT_STAGE1) {
-		if ( pair->a == Player_obj ) return 0;
-		if ( pair->b == Player_obj ) return 0;
+		if ( pair->a == Player_obj ) return {false, std::any(), &beam_ship_process_collision};
+		if ( pair->b == Player_obj ) return {false, std::any(), &beam_ship_process_collision};
 	}
 
 	// if the "warming up" timestamp has not expired
 	if ((a_beam->warmup_stamp != -1) || (a_beam->warmdown_stamp != -1)) {
-		return 0;
+		return {false, std::any(), &beam_ship_process_collision};
 	}
 
 	// if the beam is on "safety", don't collide with anything
 	if (a_beam->flags & BF_SAFETY) {
-		return 0;
+		return {false, std::any(), &beam_ship_process_collision};
 	}
 	
 	// if the colliding object is the shooting object, return 1 so this is culled
 	if (!pair->a->flags[Object::Object_Flags::Collides_with_parent] && pair->b == a_beam->objp) {
-		return 1;
+		return {true, std::any(), &beam_ship_process_collision};
 	}	
 
 	// try and get a model
 	model_num = beam_get_model(pair->b);
 	if (model_num < 0) {
-		return 1;
+		return {true, std::any(), &beam_ship_process_collision};
 	}
 	
 #ifndef NDEBUG
@@ -3123,13 +3197,14 @@ int beam_collide_ship(obj_pair *pair)
 	Assert(pair->b->type == OBJ_SHIP);
 	Assert(Ships[pair->b->instance].objnum == OBJ_INDEX(pair->b));
 	if ((pair->b->type != OBJ_SHIP) || (pair->b->instance < 0))
-		return 1;
+		return {true, std::any(), &beam_ship_process_collision};
 	ship_objp = pair->b;
 	shipp = &Ships[ship_objp->instance];
 
 	if (shipp->flags[Ship::Ship_Flags::Arriving_stage_1])
-		return 0;
+		return {false, std::any(), &beam_ship_process_collision};
 
+	beam_collision_check_data cd;
 	int quadrant_num = -1;
 	bool valid_hit_occurred = false;
 	sip = &Ship_info[shipp->ship_info_index];
@@ -3172,19 +3247,29 @@ int beam_collide_ship(obj_pair *pair)
 		shield_collision = 0;
 	}
 
-	if (beam_will_tool_target(a_beam, ship_objp)) {
-		mc_hull_exit = mc_hull_enter;
-		mc_hull_exit.flags |= MC_CHECK_MODEL;
+	mc_hull_enter.flags |= MC_CHECK_MODEL;
 
+	if (beam_will_tool_target(a_beam, ship_objp)) {
 		// reverse this vector so that we check for exit holes as opposed to entrance holes
-		std::swap(mc_hull_exit.p0, mc_hull_exit.p1);
-		hull_exit_collision = model_collide(&mc_hull_exit);
+		// both go through the model as one batch
+		thread_local SCP_vector<mc_ray> hull_rays(2);
+		thread_local SCP_vector<mc_info> hull_hits;
+		hull_rays[0] = {a_beam->last_start, a_beam->last_shot};
+		hull_rays[1] = {a_beam->last_shot, a_beam->last_start};
+		model_collide_batch(&mc_hull_enter, hull_rays, hull_hits);
+
+		// the hits are handed over to be processed later, so they have to point at the beam rather than the batch
+		mc_hull_enter = hull_hits[0];
+		mc_hull_exit = hull_hits[1];
+		mc_hull_exit.p0 = mc_hull_enter.p1 = &a_beam->last_shot;
+		mc_hull_exit.p1 = mc_hull_enter.p0 = &a_beam->last_start;
+
+		hull_enter_collision = mc_hull_enter.num_hits;
+		hull_exit_collision = mc_hull_exit.num_hits;
 	} else {
 		hull_exit_collision = 0;
+		hull_enter_collision = model_collide(&mc_hull_enter);
 	}
-
-	mc_hull_enter.flags |= MC_CHECK_MODEL;
-	hull_enter_collision = model_collide(&mc_hull_enter);
 	// ---
 
     // If we have a range less than the "far" range, check if the ray actually hit within the range
@@ -3255,7 +3340,8 @@ int beam_collide_ship(obj_pair *pair)
 			// do the hit effect
 			if (shield_collision) {
 				if (mc_shield.shield_hit_tri != -1) {
-					add_shield_point(OBJ_INDEX(ship_objp), mc_shield.shield_hit_tri, &mc_shield.hit_point, bwi->shield_impact_effect_radius);
+					cd.shield_tri_hit = mc_shield.shield_hit_tri;
+					cd.shield_hitpos = mc_shield.hit_point;
 				}
 			} else {
 				/* TODO */;
@@ -3287,83 +3373,97 @@ int beam_collide_ship(obj_pair *pair)
 	// if we got a hit
 	if (valid_hit_occurred)
 	{
-		// since we might have two collisions handled the same way, let's loop over both of them
-		mc_info *mc_array[2];
-		int mc_size = 1;
-		mc_array[0] = mc;
+		// since we might have two collisions handled the same way, let's hand over both of them
+		cd.hits[cd.num_hits++] = *mc;
 		if (hull_exit_collision)
-		{
-			mc_array[1] = &mc_hull_exit;
-			++mc_size;
-		}
+			cd.hits[cd.num_hits++] = mc_hull_exit;
+	}
+	cd.quadrant_num = quadrant_num;
 
-		for (int i = 0; i < mc_size; ++i)
-		{
-			bool ship_override = false, weapon_override = false;
-
-			// get submodel handle if scripting needs it
-			bool has_submodel = (mc_array[i]->hit_submodel >= 0);
-			scripting::api::submodel_h smh(mc_array[i]->model_num, mc_array[i]->hit_submodel);
-
-			if (scripting::hooks::OnBeamCollision->isActive()) {
-				ship_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {ship_objp, weapon_objp} },
-					scripting::hook_param_list(scripting::hook_param("Self", 'o', ship_objp),
-						scripting::hook_param("Object", 'o', weapon_objp),
-						scripting::hook_param("Ship", 'o', ship_objp),
-						scripting::hook_param("Beam", 'o', weapon_objp),
-						scripting::hook_param("Hitpos", 'o', mc_array[i]->hit_point_world)));
-			}
+	// reset timestamp to timeout immediately
+	pair->next_check_time = timestamp(0);
 
-			if (scripting::hooks::OnShipCollision->isActive()) {
-				weapon_override = scripting::hooks::OnShipCollision->isOverride(scripting::hooks::CollisionConditions{{ship_objp, weapon_objp}},
-					scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_objp),
-						scripting::hook_param("Object", 'o', ship_objp),
-						scripting::hook_param("Ship", 'o', ship_objp),
-						scripting::hook_param("Beam", 'o', weapon_objp),
-						scripting::hook_param("Hitpos", 'o', mc_array[i]->hit_point_world),
-						scripting::hook_param("ShipSubmodel", 'o', scripting::api::l_Submodel.Set(smh), has_submodel)));
-			}
+	if (cd.num_hits > 0 || cd.shield_tri_hit >= 0)
+		return {false, cd, &beam_ship_process_collision};
 
-			if (!ship_override && !weapon_override)
-			{
-				// add to the collision_list
-				// if we got "tooled", add an exit hole too
-				beam_add_collision(a_beam, ship_objp, mc_array[i], quadrant_num, i != 0);
-			}
+	return {false, std::any(), &beam_ship_process_collision};
+}
 
-			if (scripting::hooks::OnBeamCollision->isActive() && !(weapon_override && !ship_override)) {
-				scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{ {ship_objp, weapon_objp} },
-					scripting::hook_param_list(scripting::hook_param("Self", 'o', ship_objp),
-						scripting::hook_param("Object", 'o', weapon_objp),
-						scripting::hook_param("Ship", 'o', ship_objp),
-						scripting::hook_param("Beam", 'o', weapon_objp),
-						scripting::hook_param("Hitpos", 'o', mc_array[i]->hit_point_world)));
-			}
-			if (scripting::hooks::OnShipCollision->isActive() && ((weapon_override && !ship_override) || (!weapon_override && !ship_override)))
-			{
-				scripting::hooks::OnShipCollision->run(scripting::hooks::CollisionConditions{{ship_objp, weapon_objp}},
-					scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_objp),
-						scripting::hook_param("Object", 'o', ship_objp),
-						scripting::hook_param("Ship", 'o', ship_objp),
-						scripting::hook_param("Beam", 'o', weapon_objp),
-						scripting::hook_param("Hitpos", 'o', mc_array[i]->hit_point_world),
-						scripting::hook_param("ShipSubmodel", 'o', scripting::api::l_Submodel.Set(smh), has_submodel)));
-			}
-		}
+// collide a beam with a ship, returns 1 if we can ignore all future collisions between the 2 objects
+int beam_collide_ship(obj_pair *pair)
+{
+	const auto& [never_check_again, collision_data, process_fnc] = beam_collide_ship_check(pair);
+
+	if (collision_data.has_value()) {
+		process_fnc(pair, collision_data);
 	}
 
-	// reset timestamp to timeout immediately
-	pair->next_check_time = timestamp(0);
-		
-	return 0;
+	return never_check_again ? 1 : 0;
 }
 
+static void beam_prop_process_collision(obj_pair *pair, const std::any& collision_data)
+{
+	const auto& cd = std::any_cast<const beam_collision_check_data&>(collision_data);
+	object *weapon_objp = pair->a;
+	object *prop_objp = pair->b;
+	beam *a_beam = &Beams[weapon_objp->instance];
+	mc_info mc = cd.hits[0];
+
+	bool prop_override = false, weapon_override = false;
+
+	// get submodel handle if scripting needs it
+	bool has_submodel = (mc.hit_submodel >= 0);
+	scripting::api::submodel_h smh(mc.model_num, mc.hit_submodel);
+
+	if (scripting::hooks::OnBeamCollision->isActive()) {
+		prop_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {prop_objp, weapon_objp} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', prop_objp),
+				scripting::hook_param("Object", 'o', weapon_objp),
+				scripting::hook_param("Prop", 'o', prop_objp),
+				scripting::hook_param("Beam", 'o', weapon_objp),
+				scripting::hook_param("Hitpos", 'o', mc.hit_point_world)));
+	}
+
+	if (scripting::hooks::OnPropCollision->isActive()) {
+		weapon_override = scripting::hooks::OnPropCollision->isOverride(scripting::hooks::CollisionConditions{ {prop_objp, weapon_objp} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_objp),
+				scripting::hook_param("Object", 'o', prop_objp),
+				scripting::hook_param("Prop", 'o', prop_objp),
+				scripting::hook_param("Beam", 'o', weapon_objp),
+				scripting::hook_param("Hitpos", 'o', mc.hit_point_world),
+				scripting::hook_param("PropSubmodel", 'o', scripting::api::l_Submodel.Set(smh), has_submodel)));
+	}
+
+	if (!prop_override && !weapon_override)
+	{
+		// add to the collision_list
+		// if we got "tooled", add an exit hole too
+		beam_add_collision(a_beam, prop_objp, &mc, MISS_SHIELDS, false);
+	}
+
+	if (scripting::hooks::OnBeamCollision->isActive() && (!weapon_override || prop_override)) {
+		scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{{prop_objp, weapon_objp}},
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', prop_objp),
+				scripting::hook_param("Object", 'o', weapon_objp),
+				scripting::hook_param("Prop", 'o', prop_objp),
+				scripting::hook_param("Beam", 'o', weapon_objp),
+				scripting::hook_param("Hitpos", 'o', mc.hit_point_world)));
+	}
+	if (scripting::hooks::OnPropCollision->isActive() && ((weapon_override && !prop_override) || (!weapon_override && !prop_override))) {
+		scripting::hooks::OnPropCollision->run(scripting::hooks::CollisionConditions{{prop_objp, weapon_objp}},
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_objp),
+				scripting::hook_param("Object", 'o', prop_objp),
+				scripting::hook_param("Prop", 'o', prop_objp),
+				scripting::hook_param("Beam", 'o', weapon_objp),
+				scripting::hook_param("Hitpos", 'o', mc.hit_point_world),
+				scripting::hook_param("PropSubmodel", 'o', scripting::api::l_Submodel.Set(smh), has_submodel)));
+	}
+}
 
-// collide a beam with a prop, returns 1 if we can ignore all future collisions between the 2 objects
-int beam_collide_prop(obj_pair* pair)
+// check a beam against a prop without touching either of them, so that this can run on the collision worker threads
+collision_result beam_collide_prop_check(obj_pair* pair)
 {
 	beam* a_beam;
-	object* weapon_objp;
 	object* prop_objp;
 	mc_info mc;
 	int model_num;
@@ -3371,33 +3471,32 @@ int beam_collide_prop(obj_pair* pair)
 
 	// bogus
 	if (pair == nullptr) {
-		return 0;
+		return {false, std::any(), &beam_prop_process_collision};
 	}
 
 	if (reject_due_collision_groups(pair->a, pair->b))
-		return 0;
+		return {false, std::any(), &beam_prop_process_collision};
 
 	// get the beam
 	Assert(pair->a->instance >= 0);
 	Assert(pair->a->type == OBJ_BEAM);
 	Assert(Beams[pair->a->instance].objnum == OBJ_INDEX(pair->a));
-	weapon_objp = pair->a;
 	a_beam = &Beams[pair->a->instance];
 
 	// if the "warming up" timestamp has not expired
 	if ((a_beam->warmup_stamp != -1) || (a_beam->warmdown_stamp != -1)) {
-		return 0;
+		return {false, std::any(), &beam_prop_process_collision};
 	}
 
 	// if the beam is on "safety", don't collide with anything
 	if (a_beam->flags & BF_SAFETY) {
-		return 0;
+		return {false, std::any(), &beam_prop_process_collision};
 	}
 
 	// try and get a model
 	model_num = beam_get_model(pair->b);
 	if (model_num < 0) {
-		return 1;
+		return {true, std::any(), &beam_prop_process_collision};
 	}
 
 #ifndef NDEBUG
@@ -3409,7 +3508,7 @@ int beam_collide_prop(obj_pair* pair)
 	Assert(pair->b->type == OBJ_PROP);
 	Assert(prop_id_lookup(pair->b->instance)->objnum == OBJ_INDEX(pair->b));
 	if ((pair->b->type != OBJ_PROP) || (pair->b->instance < 0))
-		return 1;
+		return {true, std::any(), &beam_prop_process_collision};
 	prop_objp = pair->b;
 	prop* propp = prop_id_lookup(prop_objp->instance);
 
@@ -3449,77 +3548,106 @@ int beam_collide_prop(obj_pair* pair)
 		}
 	}
 
+	// reset timestamp to timeout immediately
+	pair->next_check_time = timestamp(0);
+
 	// if we got a hit
 	if (hit)
 	{
+		beam_collision_check_data cd;
+		cd.hits[cd.num_hits++] = mc;
+		return {false, cd, &beam_prop_process_collision};
+	}
 
-		bool prop_override = false, weapon_override = false;
+	return {false, std::any(), &beam_prop_process_collision};
+}
 
-		// get submodel handle if scripting needs it
-		bool has_submodel = (mc.hit_submodel >= 0);
-		scripting::api::submodel_h smh(mc.model_num, mc.hit_submodel);
+// collide a beam with a prop, returns 1 if we can ignore all future collisions between the 2 objects
+int beam_collide_prop(obj_pair* pair)
+{
+	const auto& [never_check_again, collision_data, process_fnc] = beam_collide_prop_check(pair);
 
-		if (scripting::hooks::OnBeamCollision->isActive()) {
-			prop_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {prop_objp, weapon_objp} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', prop_objp),
-					scripting::hook_param("Object", 'o', weapon_objp),
-					scripting::hook_param("Prop", 'o', prop_objp),
-					scripting::hook_param("Beam", 'o', weapon_objp),
-					scripting::hook_param("Hitpos", 'o', mc.hit_point_world)));
-		}
+	if (collision_data.has_value()) {
+		process_fnc(pair, collision_data);
+	}
 
-		if (scripting::hooks::OnPropCollision->isActive()) {
-			weapon_override = scripting::hooks::OnPropCollision->isOverride(scripting::hooks::CollisionConditions{ {prop_objp, weapon_objp} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_objp),
-					scripting::hook_param("Object", 'o', prop_objp),
-					scripting::hook_param("Prop", 'o', prop_objp),
-					scripting::hook_param("Beam", 'o', weapon_objp),
-					scripting::hook_param("Hitpos", 'o', mc.hit_point_world),
-					scripting::hook_param("PropSubmodel", 'o', scripting::api::l_Submodel.Set(smh), has_submodel)));
-		}
+	return never_check_again ? 1 : 0;
+}
 
-		if (!prop_override && !weapon_override)
-		{
-			// add to the collision_list
-			// if we got "tooled", add an exit hole too
-			beam_add_collision(a_beam, prop_objp, &mc, MISS_SHIELDS, false);
-		}
+// checks a beam against an asteroid, debris or missile model with a plain ray
+static bool beam_collide_model_ray(const beam *a_beam, object *objp, int model_num, mc_info *test_collide)
+{
+	test_collide->model_instance_num = -1;
+	test_collide->model_num = model_num;
+	test_collide->submodel_num = -1;
+	test_collide->orient = &objp->orient;
+	test_collide->pos = &objp->pos;
+	test_collide->p0 = &a_beam->last_start;
+	test_collide->p1 = &a_beam->last_shot;
+	test_collide->flags = MC_CHECK_MODEL | MC_CHECK_RAY;
+	model_collide(test_collide);
+
+	return test_collide->num_hits > 0;
+}
 
-		if (scripting::hooks::OnBeamCollision->isActive() && (!weapon_override || prop_override)) {
-			scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{{prop_objp, weapon_objp}},
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', prop_objp),
-					scripting::hook_param("Object", 'o', weapon_objp),
-					scripting::hook_param("Prop", 'o', prop_objp),
-					scripting::hook_param("Beam", 'o', weapon_objp),
-					scripting::hook_param("Hitpos", 'o', mc.hit_point_world)));
-		}
-		if (scripting::hooks::OnPropCollision->isActive() && ((weapon_override && !prop_override) || (!weapon_override && !prop_override))) {
-			scripting::hooks::OnPropCollision->run(scripting::hooks::CollisionConditions{{prop_objp, weapon_objp}},
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', weapon_objp),
-					scripting::hook_param("Object", 'o', prop_objp),
-					scripting::hook_param("Prop", 'o', prop_objp),
-					scripting::hook_param("Beam", 'o', weapon_objp),
-					scripting::hook_param("Hitpos", 'o', mc.hit_point_world),
-					scripting::hook_param("PropSubmodel", 'o', scripting::api::l_Submodel.Set(smh), has_submodel)));
-		}
+static void beam_asteroid_process_collision(obj_pair *pair, const std::any& collision_data)
+{
+	const auto& cd = std::any_cast<const beam_collision_check_data&>(collision_data);
+	beam *a_beam = &Beams[pair->a->instance];
+	mc_info test_collide = cd.hits[0];
+
+	// add to the collision list
+	bool weapon_override = false, asteroid_override = false;
+
+	if (scripting::hooks::OnAsteroidCollision->isActive()) {
+		weapon_override = scripting::hooks::OnAsteroidCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
+				scripting::hook_param("Object", 'o', pair->b),
+				scripting::hook_param("Asteroid", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+	if (scripting::hooks::OnBeamCollision->isActive()) {
+		asteroid_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
+				scripting::hook_param("Object", 'o', pair->a),
+				scripting::hook_param("Asteroid", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+
+	if (!weapon_override && !asteroid_override)
+	{
+		beam_add_collision(a_beam, pair->b, &test_collide);
 	}
 
-	// reset timestamp to timeout immediately
-	pair->next_check_time = timestamp(0);
-
-	return 0;
+	if (scripting::hooks::OnAsteroidCollision->isActive() && !(asteroid_override && !weapon_override)) {
+		scripting::hooks::OnAsteroidCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
+				scripting::hook_param("Object", 'o', pair->b),
+				scripting::hook_param("Asteroid", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+	if (scripting::hooks::OnBeamCollision->isActive() && ((asteroid_override && !weapon_override) || (!asteroid_override && !weapon_override))) {
+		scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
+				scripting::hook_param("Object", 'o', pair->a),
+				scripting::hook_param("Asteroid", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
 }
 
-
-// collide a beam with an asteroid, returns 1 if we can ignore all future collisions between the 2 objects
-int beam_collide_asteroid(obj_pair *pair)
+// check a beam against an asteroid without touching either of them, so that this can run on the collision worker threads
+collision_result beam_collide_asteroid_check(obj_pair *pair)
 {
 	beam * a_beam;
 	int model_num;
 
 	// bogus
 	if(pair == NULL){
-		return 0;
+		return {false, std::any(), &beam_asteroid_process_collision};
 	}
 
 	// get the beam
@@ -3530,24 +3658,24 @@ int beam_collide_asteroid(obj_pair *pair)
 
 	// if the "warming up" timestamp has not expired
 	if((a_beam->warmup_stamp != -1) || (a_beam->warmdown_stamp != -1)){
-		return 0;
+		return {false, std::any(), &beam_asteroid_process_collision};
 	}
 
 	// if the beam is on "safety", don't collide with anything
 	if(a_beam->flags & BF_SAFETY){
-		return 0;
+		return {false, std::any(), &beam_asteroid_process_collision};
 	}
 	
 	// if the colliding object is the shooting object, return 1 so this is culled
 	if(pair->b == a_beam->objp){
-		return 1;
+		return {true, std::any(), &beam_asteroid_process_collision};
 	}	
 
 	// try and get a model
 	model_num = beam_get_model(pair->b);
 	if(model_num < 0){
 		Int3();
-		return 1;
+		return {true, std::any(), &beam_asteroid_process_collision};
 	}	
 
 #ifndef NDEBUG
@@ -3556,80 +3684,89 @@ int beam_collide_asteroid(obj_pair *pair)
 #endif
 
 	// do the collision
-	mc_info test_collide;
-	test_collide.model_instance_num = -1;
-	test_collide.model_num = model_num;
-	test_collide.submodel_num = -1;
-	test_collide.orient = &pair->b->orient;
-	test_collide.pos = &pair->b->pos;
-	test_collide.p0 = &a_beam->last_start;
-	test_collide.p1 = &a_beam->last_shot;
-	test_collide.flags = MC_CHECK_MODEL | MC_CHECK_RAY;
-	model_collide(&test_collide);
-
-	// if we got a hit
-	if (test_collide.num_hits)
+	beam_collision_check_data cd;
+	if (beam_collide_model_ray(a_beam, pair->b, model_num, &cd.hits[0]))
 	{
-		// add to the collision list
-		bool weapon_override = false, asteroid_override = false;
-
-		if (scripting::hooks::OnAsteroidCollision->isActive()) {
-			weapon_override = scripting::hooks::OnAsteroidCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
-					scripting::hook_param("Object", 'o', pair->b),
-					scripting::hook_param("Asteroid", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
-		if (scripting::hooks::OnBeamCollision->isActive()) {
-			asteroid_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
-					scripting::hook_param("Object", 'o', pair->a),
-					scripting::hook_param("Asteroid", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
-
-		if (!weapon_override && !asteroid_override)
-		{
-			beam_add_collision(a_beam, pair->b, &test_collide);
-		}
-
-		if (scripting::hooks::OnAsteroidCollision->isActive() && !(asteroid_override && !weapon_override)) {
-			scripting::hooks::OnAsteroidCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
-					scripting::hook_param("Object", 'o', pair->b),
-					scripting::hook_param("Asteroid", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
-		if (scripting::hooks::OnBeamCollision->isActive() && ((asteroid_override && !weapon_override) || (!asteroid_override && !weapon_override))) {
-			scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
-					scripting::hook_param("Object", 'o', pair->a),
-					scripting::hook_param("Asteroid", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
-
-		return 0;
+		cd.num_hits = 1;
+		return {false, cd, &beam_asteroid_process_collision};
 	}
 
 	// reset timestamp to timeout immediately
 	pair->next_check_time = timestamp(0);
 		
-	return 0;	
+	return {false, std::any(), &beam_asteroid_process_collision};
 }
 
-// collide a beam with a missile, returns 1 if we can ignore all future collisions between the 2 objects
-int beam_collide_missile(obj_pair *pair)
+// collide a beam with an asteroid, returns 1 if we can ignore all future collisions between the 2 objects
+int beam_collide_asteroid(obj_pair *pair)
+{
+	const auto& [never_check_again, collision_data, process_fnc] = beam_collide_asteroid_check(pair);
+
+	if (collision_data.has_value()) {
+		process_fnc(pair, collision_data);
+	}
+
+	return never_check_again ? 1 : 0;
+}
+
+static void beam_missile_process_collision(obj_pair *pair, const std::any& collision_data)
+{
+	const auto& cd = std::any_cast<const beam_collision_check_data&>(collision_data);
+	beam *a_beam = &Beams[pair->a->instance];
+	mc_info test_collide = cd.hits[0];
+
+	// add to the collision list
+	bool a_override = false, b_override = false;
+
+	if (scripting::hooks::OnWeaponCollision->isActive()) {
+		a_override = scripting::hooks::OnWeaponCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
+				scripting::hook_param("Object", 'o', pair->b),
+				scripting::hook_param("Weapon", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+	if (scripting::hooks::OnBeamCollision->isActive()) {
+		b_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
+				scripting::hook_param("Object", 'o', pair->a),
+				scripting::hook_param("Weapon", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+
+	if(!a_override && !b_override)
+	{
+		beam_add_collision(a_beam, pair->b, &test_collide);
+	}
+
+	if (scripting::hooks::OnWeaponCollision->isActive() && !(b_override && !a_override)) {
+		scripting::hooks::OnWeaponCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
+				scripting::hook_param("Object", 'o', pair->b),
+				scripting::hook_param("Weapon", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+	if (scripting::hooks::OnBeamCollision->isActive() && ((b_override && !a_override) || (!b_override && !a_override))) {
+		scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
+				scripting::hook_param("Object", 'o', pair->a),
+				scripting::hook_param("Weapon", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+}
+
+// check a beam against a missile without touching either of them, so that this can run on the collision worker threads
+collision_result beam_collide_missile_check(obj_pair *pair)
 {
 	beam *a_beam;	
 	int model_num;
 
 	// bogus
 	if(pair == NULL){
-		return 0;
+		return {false, std::any(), &beam_missile_process_collision};
 	}
 
 	// get the beam
@@ -3640,106 +3777,117 @@ int beam_collide_missile(obj_pair *pair)
 
 	// if the "warming up" timestamp has not expired
 	if((a_beam->warmup_stamp != -1) || (a_beam->warmdown_stamp != -1)){
-		return 0;
+		return {false, std::any(), &beam_missile_process_collision};
 	}
 
 	// if the beam is on "safety", don't collide with anything
 	if(a_beam->flags & BF_SAFETY){
-		return 0;
+		return {false, std::any(), &beam_missile_process_collision};
 	}
 	
 	// don't collide if the beam and missile share their parent
 	if (pair->b->parent_sig >= 0 && a_beam->objp && pair->b->parent_sig == a_beam->objp->signature) {
-		return 1;
+		return {true, std::any(), &beam_missile_process_collision};
 	}
 
 	// try and get a model
 	model_num = beam_get_model(pair->b);
 	if(model_num < 0){
-		return 1;
+		return {true, std::any(), &beam_missile_process_collision};
 	}
 
 #ifndef NDEBUG
 	Beam_test_ints++;
 #endif
 
-	// do the collision
-	mc_info test_collide;
-	test_collide.model_instance_num = -1;
-	test_collide.model_num = model_num;
-	test_collide.submodel_num = -1;
-	test_collide.orient = &pair->b->orient;
-	test_collide.pos = &pair->b->pos;
-	test_collide.p0 = &a_beam->last_start;
-	test_collide.p1 = &a_beam->last_shot;
-	test_collide.flags = MC_CHECK_MODEL | MC_CHECK_RAY;
-	model_collide(&test_collide);
+	// reset timestamp to timeout immediately
+	pair->next_check_time = timestamp(0);
 
-	// if we got a hit
-	if(test_collide.num_hits)
+	// do the collision
+	beam_collision_check_data cd;
+	if (beam_collide_model_ray(a_beam, pair->b, model_num, &cd.hits[0]))
 	{
-		// add to the collision list
-		bool a_override = false, b_override = false;
-
-		if (scripting::hooks::OnWeaponCollision->isActive()) {
-			a_override = scripting::hooks::OnWeaponCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
-					scripting::hook_param("Object", 'o', pair->b),
-					scripting::hook_param("Weapon", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
-		if (scripting::hooks::OnBeamCollision->isActive()) {
-			b_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
-					scripting::hook_param("Object", 'o', pair->a),
-					scripting::hook_param("Weapon", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
+		cd.num_hits = 1;
+		return {false, cd, &beam_missile_process_collision};
+	}
 
-		if(!a_override && !b_override)
-		{
-			beam_add_collision(a_beam, pair->b, &test_collide);
-		}
+	return {false, std::any(), &beam_missile_process_collision};
+}
 
-		if (scripting::hooks::OnWeaponCollision->isActive() && !(b_override && !a_override)) {
-			scripting::hooks::OnWeaponCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
-					scripting::hook_param("Object", 'o', pair->b),
-					scripting::hook_param("Weapon", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
-		if (scripting::hooks::OnBeamCollision->isActive() && ((b_override && !a_override) || (!b_override && !a_override))) {
-			scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
-					scripting::hook_param("Object", 'o', pair->a),
-					scripting::hook_param("Weapon", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
+// collide a beam with a missile, returns 1 if we can ignore all future collisions between the 2 objects
+int beam_collide_missile(obj_pair *pair)
+{
+	const auto& [never_check_again, collision_data, process_fnc] = beam_collide_missile_check(pair);
+
+	if (collision_data.has_value()) {
+		process_fnc(pair, collision_data);
 	}
 
-	// reset timestamp to timeout immediately
-	pair->next_check_time = timestamp(0);
+	return never_check_again ? 1 : 0;
+}
 
-	return 0;
+static void beam_debris_process_collision(obj_pair *pair, const std::any& collision_data)
+{
+	const auto& cd = std::any_cast<const beam_collision_check_data&>(collision_data);
+	beam *a_beam = &Beams[pair->a->instance];
+	mc_info test_collide = cd.hits[0];
+
+	bool weapon_override = false, debris_override = false;
+
+	if (scripting::hooks::OnDebrisCollision->isActive()) {
+		weapon_override = scripting::hooks::OnWeaponCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
+				scripting::hook_param("Object", 'o', pair->b),
+				scripting::hook_param("Debris", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+	if (scripting::hooks::OnBeamCollision->isActive()) {
+		debris_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
+				scripting::hook_param("Object", 'o', pair->a),
+				scripting::hook_param("Debris", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+
+	if(!weapon_override && !debris_override)
+	{
+		// add to the collision list
+		beam_add_collision(a_beam, pair->b, &test_collide);
+	}
+
+	if (scripting::hooks::OnDebrisCollision->isActive() && !(debris_override && !weapon_override)) {
+		scripting::hooks::OnWeaponCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
+				scripting::hook_param("Object", 'o', pair->b),
+				scripting::hook_param("Debris", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
+	if (scripting::hooks::OnBeamCollision->isActive() && ((debris_override && !weapon_override) || (!debris_override && !weapon_override))) {
+		scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
+			scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
+				scripting::hook_param("Object", 'o', pair->a),
+				scripting::hook_param("Debris", 'o', pair->b),
+				scripting::hook_param("Beam", 'o', pair->a),
+				scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
+	}
 }
 
-// collide a beam with debris, returns 1 if we can ignore all future collisions between the 2 objects
-int beam_collide_debris(obj_pair *pair)
+// check a beam against debris without touching either of them, so that this can run on the collision worker threads
+collision_result beam_collide_debris_check(obj_pair *pair)
 {	
 	beam * a_beam;
 	int model_num;
 
 	// bogus
 	if(pair == NULL){
-		return 0;
+		return {false, std::any(), &beam_debris_process_collision};
 	}
 
 	if (reject_due_collision_groups(pair->a, pair->b))
-		return 0;
+		return {false, std::any(), &beam_debris_process_collision};
 
 	// get the beam
 	Assert(pair->a->instance >= 0);
@@ -3749,91 +3897,53 @@ int beam_collide_debris(obj_pair *pair)
 
 	// if the "warming up" timestamp has not expired
 	if((a_beam->warmup_stamp != -1) || (a_beam->warmdown_stamp != -1)){
-		return 0;
+		return {false, std::any(), &beam_debris_process_collision};
 	}
 
 	// if the beam is on "safety", don't collide with anything
 	if(a_beam->flags & BF_SAFETY){
-		return 0;
+		return {false, std::any(), &beam_debris_process_collision};
 	}
 	
 	// if the colliding object is the shooting object, return 1 so this is culled
 	if(pair->b == a_beam->objp){
-		return 1;
+		return {true, std::any(), &beam_debris_process_collision};
 	}	
 
 	// try and get a model
 	model_num = beam_get_model(pair->b);
 	if(model_num < 0){
-		return 1;
+		return {true, std::any(), &beam_debris_process_collision};
 	}	
 
 #ifndef NDEBUG
 	Beam_test_ints++;
 #endif
 
-	// do the collision
-	mc_info test_collide;
-	test_collide.model_instance_num = -1;
-	test_collide.model_num = model_num;
-	test_collide.submodel_num = -1;
-	test_collide.orient = &pair->b->orient;
-	test_collide.pos = &pair->b->pos;
-	test_collide.p0 = &a_beam->last_start;
-	test_collide.p1 = &a_beam->last_shot;
-	test_collide.flags = MC_CHECK_MODEL | MC_CHECK_RAY;
-	model_collide(&test_collide);
+	// reset timestamp to timeout immediately
+	pair->next_check_time = timestamp(0);
 
-	// if we got a hit
-	if(test_collide.num_hits)
+	// do the collision
+	beam_collision_check_data cd;
+	if (beam_collide_model_ray(a_beam, pair->b, model_num, &cd.hits[0]))
 	{
-		bool weapon_override = false, debris_override = false;
-
-		if (scripting::hooks::OnDebrisCollision->isActive()) {
-			weapon_override = scripting::hooks::OnWeaponCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
-					scripting::hook_param("Object", 'o', pair->b),
-					scripting::hook_param("Debris", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
-		if (scripting::hooks::OnBeamCollision->isActive()) {
-			debris_override = scripting::hooks::OnBeamCollision->isOverride(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
-					scripting::hook_param("Object", 'o', pair->a),
-					scripting::hook_param("Debris", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
+		cd.num_hits = 1;
+		return {false, cd, &beam_debris_process_collision};
+	}
 
-		if(!weapon_override && !debris_override)
-		{
-			// add to the collision list
-			beam_add_collision(a_beam, pair->b, &test_collide);
-		}
+	return {false, std::any(), &beam_debris_process_collision};
+}
 
-		if (scripting::hooks::OnDebrisCollision->isActive() && !(debris_override && !weapon_override)) {
-			scripting::hooks::OnWeaponCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->a),
-					scripting::hook_param("Object", 'o', pair->b),
-					scripting::hook_param("Debris", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
-		if (scripting::hooks::OnBeamCollision->isActive() && ((debris_override && !weapon_override) || (!debris_override && !weapon_override))) {
-			scripting::hooks::OnBeamCollision->run(scripting::hooks::CollisionConditions{ {pair->a, pair->b} },
-				scripting::hook_param_list(scripting::hook_param("Self", 'o', pair->b),
-					scripting::hook_param("Object", 'o', pair->a),
-					scripting::hook_param("Debris", 'o', pair->b),
-					scripting::hook_param("Beam", 'o', pair->a),
-					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
-		}
-	}
+// collide a beam with debris, returns 1 if we can ignore all future collisions between the 2 objects
+int beam_collide_debris(obj_pair *pair)
+{
+	const auto& [never_check_again, collision_data, process_fnc] = beam_collide_debris_check(pair);
 
-	// reset timestamp to timeout immediately
-	pair->next_check_time = timestamp(0);
+	if (collision_data.has_value()) {
+		process_fnc(pair, collision_data);
+	}
 
-	return 0;
+	return never_check_again ? 1 : 0;
 }
 
 // early-out function for when adding object collision pairs, return 1 if the pair should be ignored
@@ -17,12 +17,12 @@
 //
 #include "globalincs/globals.h"
 #include "model/model.h"
+#include "object/objcollide.h"
 #include "utils/modular_curves.h"
 
 // prototypes
 class object;
 class ship_subsys;
-struct obj_pair;
 struct beam_weapon_info;
 struct vec3d;
 
@@ -267,20 +267,28 @@ void beam_level_init();
 // shutdown beam weapons for this level
 void beam_level_close();
 
+// The beam_collide_*_check() variants only look at the two objects and hand back how to apply the hit later,
+// for deferred collision processing / usage in multithreading
+
 // collide a beam with a ship, returns 1 if we can ignore all future collisions between the 2 objects
 int beam_collide_ship(obj_pair *pair);
+collision_result beam_collide_ship_check(obj_pair *pair);
 
 // collide a beam with an asteroid, returns 1 if we can ignore all future collisions between the 2 objects
 int beam_collide_asteroid(obj_pair *pair);
+collision_result beam_collide_asteroid_check(obj_pair *pair);
 
 // collide a beam with a missile, returns 1 if we can ignore all future collisions between the 2 objects
 int beam_collide_missile(obj_pair *pair);
+collision_result beam_collide_missile_check(obj_pair *pair);
 
 // collide a beam with debris, returns 1 if we can ignore all future collisions between the 2 objects
 int beam_collide_debris(obj_pair *pair);
+collision_result beam_collide_debris_check(obj_pair *pair);
 
 // collide a beam with a prop, returns 1 if we can ignore all future collisions between the 2 objects
 int beam_collide_prop(obj_pair* pair);
+collision_result beam_collide_prop_check(obj_pair* pair);
 
 // pre-move (before collision checking - but AFTER ALL OTHER OBJECTS HAVE BEEN MOVED)
 void beam_move_all_pre();
@@ -39,6 +39,7 @@
 #include "network/multiutil.h"
 #include "object/objcollide.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "parse/parsehi.h"
@@ -360,6 +361,7 @@ int missile_obj_list_add(int objnum)
 	Missile_objs[i].objnum = objnum;
 	list_append(&Missile_obj_list, &Missile_objs[i]);
 	Missile_objs[i].flags |= MISSILE_OBJ_USED;
+	obj_grid_add_late(objnum);
 
 	return i;
 }
@@ -2186,6 +2186,9 @@ void game_init()
 
 	Viewer_mode = 0;
 
+	// All tables that define curves have been parsed by now
+	curves_bake(Curve_bake_max_error);
+
 	// Now that all data has been loaded, post-process anything from game_settings before we initialize scripting
 	mod_table_post_process();
 
@@ -0,0 +1,389 @@
+#include <gtest/gtest.h>
+
+#include "ai/ai.h"
+#include "ai/ai_profiles.h"
+#include "asteroid/asteroid.h"
+#include "cmdline/cmdline.h"
+#include "iff_defs/iff_defs.h"
+#include "mission/missionparse.h"
+#include "model/model.h"
+#include "object/object.h"
+#include "object/objectgrid.h"
+#include "particle/ParticleManager.h"
+#include "ship/awacs.h"
+#include "ship/ship.h"
+#include "utils/threading.h"
+#include "weapon/weapon.h"
+
+#include "util/FSTestFixture.h"
+
+#include <deque>
+#include <random>
+
+// not in a header, the rest of the engine only gets at these through modelread.cpp and aiturret.cpp
+extern polymodel *Polygon_models[MAX_POLYGON_MODELS];
+extern int find_turret_enemy(const ship_subsys *turret_subsys, int objnum, const vec3d *tpos, const vec3d *tvec, int current_enemy);
+
+namespace {
+constexpr int TEAM_DEFENDERS = 0;
+constexpr int TEAM_ATTACKERS = 1;
+
+constexpr int WEAPON_LASER = 0;
+constexpr int WEAPON_BEAM = 1;
+}
+
+// A few capital ships covered in turrets, surrounded by fighters.  Everything is set up by hand, without tables or
+// models, so the ships only have what the turret target picks look at.
+class TurretThinkTest : public test::FSTestFixture {
+  public:
+	TurretThinkTest() : test::FSTestFixture(INIT_CFILE) {}
+
+  protected:
+	void SetUp() override
+	{
+		test::FSTestFixture::SetUp();
+
+		// ship_info makes its default particle effects when it is constructed, which a standalone server skips
+		_oldStandalone = Is_standalone;
+		Is_standalone = 1;
+		particle::ParticleManager::init();
+
+		_oldMultithreading = Cmdline_multithreading;
+		_oldAiProfile = The_mission.ai_profile;
+
+		std::swap(_oldIffInfo, Iff_info);
+		std::swap(_oldShipInfo, Ship_info);
+		std::swap(_oldWeaponInfo, Weapon_info);
+
+		for (int team : {TEAM_DEFENDERS, TEAM_ATTACKERS}) {
+			iff_info iff{};
+			sprintf(iff.iff_name, "Team %d", team);
+			iff.attackee_bitmask = iff_get_mask(team == TEAM_DEFENDERS ? TEAM_ATTACKERS : TEAM_DEFENDERS);
+			iff.attackee_bitmask_all_teams_at_war = iff.attackee_bitmask;
+			Iff_info.push_back(iff);
+		}
+
+		_profile.reset();
+		for (int i = 0; i < NUM_SKILL_LEVELS; ++i) {
+			_profile.max_turret_ownage_target[i] = 4;
+			_profile.max_turret_ownage_player[i] = 4;
+		}
+		The_mission.ai_profile = &_profile;
+
+		Ship_info.emplace_back();
+
+		Weapon_info.resize(2);
+		Weapon_info[WEAPON_LASER].subtype = WP_LASER;
+		Weapon_info[WEAPON_BEAM].subtype = WP_BEAM;
+		Weapon_info[WEAPON_BEAM].wi_flags.set(Weapon::Info_Flags::Beam);
+		for (auto& wi : Weapon_info) {
+			wi.lifetime = 10.0f;
+			wi.max_speed = 500.0f;
+			wi.weapon_range = 2500.0f;
+		}
+
+		// a single submodel without a parent, so turrets sit at the center of their ship and face along turret_norm
+		for (_modelNum = 0; Polygon_models[_modelNum] != nullptr; ++_modelNum)
+			;
+		_model = new polymodel();
+		_model->id = _modelNum;
+		_model->n_models = 1;
+		_model->submodel = make_shared<bsp_info[]>(1);
+		_model->submodel[0].parent = -1;
+		Polygon_models[_modelNum] = _model;
+		_modelInstance = model_create_instance(-1, _modelNum);
+
+		list_init(&Ship_obj_list);
+		list_init(&Missile_obj_list);
+		list_init(&Asteroid_obj_list);
+	}
+
+	void TearDown() override
+	{
+		threading::shut_down_task_pool();
+		Cmdline_multithreading = _oldMultithreading;
+
+		for (int objnum = 0; objnum < _numObjects; ++objnum) {
+			Objects[objnum].clear();
+			Ships[objnum].clear();
+		}
+		list_init(&Ship_obj_list);
+		obj_grid_rebuild(0.0f);
+
+		model_delete_instance(_modelInstance);
+		Polygon_models[_modelNum] = nullptr;
+		delete _model;
+
+		The_mission.ai_profile = _oldAiProfile;
+		std::swap(_oldIffInfo, Iff_info);
+		std::swap(_oldShipInfo, Ship_info);
+		std::swap(_oldWeaponInfo, Weapon_info);
+
+		particle::ParticleManager::shutdown();
+		Is_standalone = _oldStandalone;
+
+		test::FSTestFixture::TearDown();
+	}
+
+	int add_ship(int team, const vec3d& pos, float radius, float lethality)
+	{
+		int objnum = _numObjects++;
+
+		auto objp = &Objects[objnum];
+		objp->clear();
+		objp->type = OBJ_SHIP;
+		objp->instance = objnum;
+		objp->signature = objnum + 1;
+		objp->pos = pos;
+		objp->orient = vmd_identity_matrix;
+		objp->radius = radius;
+		objp->flags.set(Object::Object_Flags::Collides);
+
+		auto shipp = &Ships[objnum];
+		shipp->clear();
+		shipp->objnum = objnum;
+		shipp->ai_index = objnum;
+		shipp->ship_info_index = 0;
+		shipp->team = team;
+		shipp->model_instance_num = _modelInstance;
+		sprintf(shipp->ship_name, "Ship %d", objnum);
+		list_init(&shipp->subsys_list);
+
+		auto aip = &Ai_info[objnum];
+		aip->shipnum = objnum;
+		aip->ai_profile_flags.reset();
+		aip->target_objnum = -1;
+		aip->target_signature = -1;
+		aip->targeted_subsys = nullptr;
+		aip->last_objsig_hit = -1;
+		aip->lethality = lethality;
+
+		_shipObjs.emplace_back();
+		auto so = &_shipObjs.back();
+		so->objnum = objnum;
+		so->flags = 0;
+		list_append(&Ship_obj_list, so);
+
+		return objnum;
+	}
+
+	ship_subsys* add_turret(int objnum, const vec3d& norm, float fov_dot, int weapon, bool fov_required)
+	{
+		_turretInfos.emplace_back();
+		auto tp = &_turretInfos.back();
+		tp->type = SUBSYSTEM_TURRET;
+		tp->subobj_num = 0;
+		tp->turret_norm = norm;
+		tp->turret_fov = fov_dot;
+		tp->turret_max_fov = 1.0f;
+		tp->turret_base_fov = -1.0f;
+		tp->turret_max_target_ownage = -1;
+		tp->turret_max_bomb_ownage = -1;
+
+		_turrets.emplace_back();
+		auto ss = &_turrets.back();
+		ss->clear();
+		ss->system_info = tp;
+		ss->parent_objnum = objnum;
+		ss->current_hits = ss->max_hits = 100.0f;
+		ss->weapons.num_primary_banks = 1;
+		ss->weapons.primary_bank_weapons[0] = weapon;
+		for (int i = 0; i < NUM_TURRET_ORDER_TYPES; ++i)
+			ss->turret_targeting_order[i] = i;
+		if (fov_required)
+			ss->flags.set(Ship::Subsystem_Flags::FOV_Required);
+
+		list_append(&Ships[objnum].subsys_list, ss);
+		return ss;
+	}
+
+	void make_battle(unsigned int seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> coord(-3000.0f, 3000.0f);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> lethality(0.0f, 50.0f);
+		std::uniform_real_distribution<float> fov(-0.5f, 0.7f);
+		std::uniform_int_distribution<int> percent(0, 99);
+		std::uniform_int_distribution<int> attacker(0, 199);
+
+		for (int i = 0; i < 4; ++i) {
+			int objnum = add_ship(TEAM_DEFENDERS, vm_vec_new(coord(gen), coord(gen), coord(gen)), 400.0f, 0.0f);
+			for (int t = 0; t < 16; ++t) {
+				auto norm = vm_vec_new(unit(gen), unit(gen), unit(gen));
+				vm_vec_normalize_safe(&norm);
+				add_turret(objnum, norm, fov(gen), percent(gen) < 20 ? WEAPON_BEAM : WEAPON_LASER, percent(gen) < 50);
+			}
+		}
+
+		for (int i = 0; i < 200; ++i) {
+			int objnum = add_ship(TEAM_ATTACKERS, vm_vec_new(coord(gen), coord(gen), coord(gen)), 10.0f, lethality(gen));
+			int roll = percent(gen);
+			if (roll < 5)
+				Objects[objnum].flags.set(Object::Object_Flags::Protected);
+			else if (roll < 15)
+				Objects[objnum].flags.set(Object::Object_Flags::Beam_protected);
+		}
+
+		// some turrets are already busy, so that the picks depend on the targets of the other turrets on the ship
+		for (auto& ss : _turrets) {
+			if (percent(gen) < 30) {
+				int target = 4 + attacker(gen);
+				ss.turret_enemy_objnum = target;
+				ss.turret_enemy_sig = Objects[target].signature;
+			}
+		}
+
+		// done once per frame by the game before anything asks about visibility
+		awacs_level_init();
+		awacs_process();
+		obj_grid_rebuild(0.0f);
+	}
+
+	void start_pool(int num_threads)
+	{
+		Cmdline_multithreading = num_threads;
+		threading::init_task_pool();
+	}
+
+	SCP_vector<int> think()
+	{
+		ai_turret_think_all();
+
+		SCP_vector<int> picks;
+		for (const auto& ss : _turrets) {
+			// -2 for a turret that was left to the serial pass
+			picks.push_back(ss.turret_thought_generation == _turrets.front().turret_thought_generation ? ss.turret_thought_enemy_objnum : -2);
+		}
+		return picks;
+	}
+
+	// what the serial AI pass does for each turret, taking the pick from the start of the frame if it is still good
+	static int pick_now(ship_subsys* ss, int current_enemy)
+	{
+		auto objp = &Objects[ss->parent_objnum];
+		vec3d gpos, gvec;
+		ship_get_global_turret_info(objp, ss->system_info, &gpos, &gvec);
+		return find_turret_enemy(ss, ss->parent_objnum, &gpos, &gvec, current_enemy);
+	}
+
+	// every turret picks a target in turn, and the turrets after it see that target
+	SCP_vector<int> serial_pass()
+	{
+		SCP_vector<int> picks;
+		for (auto& ss : _turrets) {
+			int pick = pick_now(&ss, ss.turret_enemy_objnum);
+			ss.turret_enemy_objnum = pick;
+			ss.turret_enemy_sig = pick >= 0 ? Objects[pick].signature : 0;
+			picks.push_back(pick);
+		}
+		return picks;
+	}
+
+	int _numObjects = 0;
+	std::deque<ship_obj> _shipObjs;
+	std::deque<model_subsystem> _turretInfos;
+	std::deque<ship_subsys> _turrets;
+
+	polymodel* _model = nullptr;
+	int _modelNum = -1;
+	int _modelInstance = -1;
+
+	ai_profile_t _profile;
+
+	int _oldMultithreading = 0;
+	int _oldStandalone = 0;
+	ai_profile_t* _oldAiProfile = nullptr;
+	SCP_vector<iff_info> _oldIffInfo;
+	SCP_vector<ship_info> _oldShipInfo;
+	SCP_vector<weapon_info> _oldWeaponInfo;
+};
+
+TEST_F(TurretThinkTest, parallelPicksMatchSerialPicks)
+{
+	make_battle(42);
+
+	start_pool(4);
+	ASSERT_GT(threading::get_num_workers(), 0u);
+	auto parallel_picks = think();
+
+	threading::shut_down_task_pool();
+	ASSERT_EQ(0u, threading::get_num_workers());
+	auto serial_picks = think();
+
+	ASSERT_EQ(serial_picks, parallel_picks);
+
+	// make sure the scene actually gives the turrets something to pick from
+	int num_picked = 0;
+	for (size_t i = 0; i < serial_picks.size(); ++i) {
+		ASSERT_NE(-2, serial_picks[i]);
+		if (serial_picks[i] >= 0) {
+			ASSERT_FALSE(Objects[serial_picks[i]].flags[Object::Object_Flags::Protected]);
+			num_picked++;
+		}
+	}
+	ASSERT_GT(num_picked, static_cast<int>(serial_picks.size()) / 4);
+}
+
+TEST_F(TurretThinkTest, changedPickIsNotTaken)
+{
+	make_battle(7);
+
+	start_pool(4);
+	auto picks = think();
+
+	// one turret per kind of change, each with its own target so that the changes don't affect each other
+	ship_subsys* turrets[3] = {};
+	int targets[3] = {-1, -1, -1};
+	int found = 0;
+	for (size_t i = 0; i < _turrets.size() && found < 3; ++i) {
+		auto& ss = _turrets[i];
+		if (picks[i] < 0 || ss.turret_enemy_objnum >= 0)
+			continue;
+		if (found == 1 && ss.weapons.primary_bank_weapons[0] != WEAPON_BEAM)
+			continue;
+		if (std::find(std::begin(targets), std::end(targets), picks[i]) != std::end(targets))
+			continue;
+
+		turrets[found] = &ss;
+		targets[found] = picks[i];
+		found++;
+	}
+	ASSERT_EQ(3, found);
+
+	// unchanged, the pick from the start of the frame is used
+	for (int i = 0; i < 3; ++i)
+		ASSERT_EQ(targets[i], pick_now(turrets[i], -1));
+
+	// a SEXP or script protects the target or moves it to the turret's team after the parallel pass
+	Objects[targets[0]].flags.set(Object::Object_Flags::Protected);
+	Objects[targets[1]].flags.set(Object::Object_Flags::Beam_protected);
+	Ships[Objects[targets[2]].instance].team = TEAM_DEFENDERS;
+
+	for (int i = 0; i < 3; ++i)
+		ASSERT_NE(targets[i], pick_now(turrets[i], -1));
+}
+
+TEST_F(TurretThinkTest, serialPassMatchesWithoutPicks)
+{
+	make_battle(42);
+
+	SCP_vector<std::pair<int, int>> enemies;
+	for (const auto& ss : _turrets)
+		enemies.emplace_back(ss.turret_enemy_objnum, ss.turret_enemy_sig);
+
+	// the turrets that pick first change how many turrets attack each target, which only some of the later picks
+	// looked at
+	start_pool(4);
+	think();
+	auto taken_picks = serial_pass();
+
+	for (size_t i = 0; i < _turrets.size(); ++i) {
+		_turrets[i].turret_enemy_objnum = enemies[i].first;
+		_turrets[i].turret_enemy_sig = enemies[i].second;
+		_turrets[i].turret_thought_generation = -1;
+	}
+	auto own_picks = serial_pass();
+
+	ASSERT_EQ(own_picks, taken_picks);
+}
@@ -0,0 +1,278 @@
+#include <bmpman/bmpman.h>
+#include <cfile/cfile.h>
+#include <cmdline/cmdline.h>
+#include <globalincs/systemvars.h>
+#include <graphics/2d.h>
+#include <io/cursor.h>
+#include <localization/localize.h>
+#include <utils/threading.h>
+#include <gtest/gtest.h>
+
+#include "util/FSTestFixture.h"
+#include "util/test_util.h"
+#include "util/vp_writer.h"
+
+#include <chrono>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr int NUM_BENCHMARK_BITMAPS = 20000;
+constexpr int NUM_PAGE_IN_BITMAPS = 256;
+constexpr int PAGE_IN_BITMAP_SIZE = 256;
+
+SCP_string bitmap_name(int index)
+{
+	char name[32];
+	sprintf_safe(name, "bm%06d", index);
+	return name;
+}
+
+// A run length encoded, square 32 bit targa with a pattern that depends on index
+SCP_string make_targa(int index, int size)
+{
+	SCP_string data(18, '\0');
+	data[2] = 10;	// run length encoded true color
+	data[12] = static_cast<char>(size & 0xff);
+	data[13] = static_cast<char>(size >> 8);
+	data[14] = static_cast<char>(size & 0xff);
+	data[15] = static_cast<char>(size >> 8);
+	data[16] = 32;	// bpp
+	data[17] = 8;	// alpha bits
+
+	auto add_pixel = [&data](int value) {
+		data += static_cast<char>(value & 0xff);
+		data += static_cast<char>((value >> 8) & 0xff);
+		data += static_cast<char>((value >> 16) & 0xff);
+		data += static_cast<char>(0xff);
+	};
+
+	// alternating runs and raw packets of up to 8 pixels each
+	for (int y = 0; y < size; ++y) {
+		for (int x = 0; x < size; x += 8) {
+			const int count = std::min(8, size - x);
+
+			if ((x / 8) % 2 == 0) {
+				data += static_cast<char>(0x80 | (count - 1));
+				add_pixel(index * 7919 + y * 31 + x);
+			} else {
+				data += static_cast<char>(count - 1);
+				for (int i = 0; i < count; ++i) {
+					add_pixel(index * 7919 + y * 31 + x + i * 13);
+				}
+			}
+		}
+	}
+
+	// no extension or developer area
+	data += SCP_string(8, '\0');
+	data += "TRUEVISION-XFILE.";
+	data += '\0';
+
+	return data;
+}
+}
+
+// Writes a pack full of bitmaps into the mod directory of the test and then sets up cfile and bmpman
+class BmpmanTest : public test::FSTestFixture {
+ public:
+	BmpmanTest() : test::FSTestFixture(INIT_NONE) {
+		pushModDir("bmpman");
+	}
+
+ protected:
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		_mod_dir = TEST_DATA_PATH;
+		_mod_dir += DIR_SEPARATOR_STR "bmpman" DIR_SEPARATOR_STR;
+		_mod_dir += ::testing::UnitTest::GetInstance()->current_test_info()->name();
+		_vp_path = _mod_dir + DIR_SEPARATOR_STR "generated.vp";
+
+		_mkdir(_mod_dir.c_str());
+
+		// the fixture runs as a standalone server, which only ever loads a single placeholder bitmap
+		_old_standalone = Is_standalone;
+		Is_standalone = 0;
+
+		_old_multithreading = Cmdline_multithreading;
+	}
+	void TearDown() override {
+		threading::shut_down_task_pool();
+		Cmdline_multithreading = _old_multithreading;
+
+		if (_graphics_initialized) {
+			io::mouse::CursorManager::shutdown();
+			bm_unload_all();
+			gr_close();
+		}
+
+		Is_standalone = _old_standalone;
+
+		cfile_close();
+
+		test::FSTestFixture::TearDown();
+
+		remove(_vp_path.c_str());
+#ifdef _WIN32
+		_rmdir(_mod_dir.c_str());
+#else
+		rmdir(_mod_dir.c_str());
+#endif
+	}
+
+	// Puts num_bitmaps targas of size x size pixels into data/maps and initializes cfile and graphics
+	void init_with_bitmaps(int num_bitmaps, int size = 1) {
+		test::vp_writer pack;
+		pack.add_dir("data");
+		pack.add_dir("maps");
+		for (int i = 0; i < num_bitmaps; ++i) {
+			pack.add_file(bitmap_name(i) + ".tga", make_targa(i, size));
+		}
+		pack.add_dir("..");
+		pack.add_dir("..");
+		ASSERT_TRUE(pack.write(_vp_path));
+
+		SCP_string cfile_dir(TEST_DATA_PATH);
+		cfile_dir += DIR_SEPARATOR_CHAR;
+		cfile_dir += "test"; // Cfile expects something after the path
+
+		ASSERT_FALSE(cfile_init(cfile_dir.c_str()));
+
+		lcl_init(-1);
+		lcl_xstr_init();
+
+		ASSERT_TRUE(gr_init(nullptr, GraphicsAPI::Stub, 1024, 768));
+		_graphics_initialized = true;
+	}
+
+	SCP_string _mod_dir;
+	SCP_string _vp_path;
+	int _old_standalone = 0;
+	int _old_multithreading = 0;
+	bool _graphics_initialized = false;
+};
+
+TEST_F(BmpmanTest, reuses_loaded_bitmaps)
+{
+	init_with_bitmaps(4);
+
+	auto first = bm_load("bm000001");
+	ASSERT_GE(first, 0);
+
+	// the lookup of loaded bitmaps ignores case and extensions
+	ASSERT_EQ(first, bm_load("BM000001"));
+	ASSERT_EQ(first, bm_load("bm000001.dds"));
+
+	auto duplicate = bm_load_duplicate("bm000001");
+	ASSERT_GE(duplicate, 0);
+	ASSERT_NE(first, duplicate);
+
+	// once the first one is gone, the duplicate is found instead
+	ASSERT_EQ(0, bm_release(first));
+	ASSERT_EQ(0, bm_release(first));
+	ASSERT_EQ(1, bm_release(first));
+	ASSERT_EQ(duplicate, bm_load("bm000001"));
+
+	// a renamed bitmap is found by its new name only
+	auto other = bm_load("bm000002");
+	ASSERT_GE(other, 0);
+	ASSERT_EQ(other, bm_reload(other, "bm000003"));
+	ASSERT_EQ(other, bm_load("bm000003"));
+	ASSERT_NE(other, bm_load("bm000002"));
+}
+
+TEST_F(BmpmanTest, DISABLED_load_benchmark)
+{
+	init_with_bitmaps(NUM_BENCHMARK_BITMAPS);
+
+	SCP_vector<int> handles(NUM_BENCHMARK_BITMAPS);
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_BENCHMARK_BITMAPS; ++i) {
+		handles[i] = bm_load(bitmap_name(i));
+	}
+	auto load_ms = test::elapsed_ms(start);
+
+	// every texture of a level asks for its bitmap again when it's paged in
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_BENCHMARK_BITMAPS; ++i) {
+		ASSERT_EQ(handles[i], bm_load(bitmap_name(i)));
+	}
+	auto reload_ms = test::elapsed_ms(start);
+
+	for (int i = 0; i < NUM_BENCHMARK_BITMAPS; ++i) {
+		ASSERT_GE(handles[i], 0);
+	}
+
+	std::cout << "Loading " << NUM_BENCHMARK_BITMAPS << " bitmaps: " << load_ms << " ms" << std::endl;
+	std::cout << "Loading them again: " << reload_ms << " ms" << std::endl;
+}
+
+TEST_F(BmpmanTest, DISABLED_page_in_benchmark)
+{
+	init_with_bitmaps(NUM_PAGE_IN_BITMAPS, PAGE_IN_BITMAP_SIZE);
+
+	SCP_vector<int> handles;
+	for (int i = 0; i < NUM_PAGE_IN_BITMAPS; ++i) {
+		handles.push_back(bm_load(bitmap_name(i)));
+		ASSERT_GE(handles.back(), 0);
+	}
+
+	// pages in all bitmaps like a level load does, then checks what ended up in memory
+	int failures = 0;
+	auto page_in = [&handles, &failures](uint& checksum) {
+		bm_page_in_start();
+		for (auto handle : handles) {
+			bm_page_in_texture(handle);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		bm_page_in_stop();
+		auto page_in_ms = test::elapsed_ms(start);
+
+		checksum = 0;
+		for (auto handle : handles) {
+			auto bmp = bm_lock(handle, 16, BMP_TEX_OTHER);
+			if (bmp == nullptr) {
+				++failures;
+				continue;
+			}
+
+			auto data = reinterpret_cast<const ubyte*>(bmp->data);
+			for (int i = 0; i < bmp->w * bmp->h * (bmp->bpp >> 3); ++i) {
+				checksum = checksum * 31 + data[i];
+			}
+
+			bm_unlock(handle);
+		}
+
+		// the next run has to decode everything again
+		bm_unload_all();
+
+		return page_in_ms;
+	};
+
+	uint serial_checksum;
+	auto serial_ms = page_in(serial_checksum);
+
+	Cmdline_multithreading = 0;
+	threading::init_task_pool();
+
+	uint threaded_checksum;
+	auto threaded_ms = page_in(threaded_checksum);
+
+	ASSERT_EQ(0, failures);
+	ASSERT_EQ(serial_checksum, threaded_checksum);
+
+	std::cout << "Paging in " << NUM_PAGE_IN_BITMAPS << " " << PAGE_IN_BITMAP_SIZE << "x" << PAGE_IN_BITMAP_SIZE
+	          << " targas (stub renderer):" << std::endl;
+	std::cout << "  serial: " << serial_ms << " ms (" << NUM_PAGE_IN_BITMAPS / (serial_ms / 1000.0) << " bitmaps/s)" << std::endl;
+	std::cout << "  " << threading::get_num_workers() << " workers: " << threaded_ms << " ms ("
+	          << NUM_PAGE_IN_BITMAPS / (threaded_ms / 1000.0) << " bitmaps/s)" << std::endl;
+}
@@ -1,9 +1,21 @@
 
 #include <cfile/cfilesystem.h>
+#include <cmdline/cmdline.h>
 #include <graphics/font.h>
 #include <gtest/gtest.h>
 
 #include "util/FSTestFixture.h"
+#include "util/test_util.h"
+#include "util/vp_writer.h"
+
+#include <chrono>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
 
 class CFileInitTest : public test::FSTestFixture {
  public:
@@ -212,3 +224,210 @@ TEST_F(CFileTest, subfolder_list)
 	ASSERT_EQ(2, cf_get_file_list(table_files, CF_TYPE_TABLES, "*\\*.tbl", CF_SORT_NAME));
 	ASSERT_TRUE(table_files.back().substr(0, 6) == "folder");
 }
+
+namespace {
+constexpr int NUM_BENCHMARK_MAPS = 100000;
+constexpr int NUM_BENCHMARK_MODELS = 50000;
+constexpr int NUM_BENCHMARK_EFFECT_FOLDERS = 50;
+constexpr int NUM_BENCHMARK_EFFECTS_PER_FOLDER = 1000;
+
+constexpr int NUM_LOAD_BENCHMARK_FILES = 512;
+constexpr int LOAD_BENCHMARK_FILE_SIZE = 64 * 1024;
+
+SCP_string benchmark_name(const char* prefix, int index, const char* ext)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "%s%06d%s", prefix, index, ext);
+	return name;
+}
+}
+
+// Lets a test write a pack file into its mod directory before cfile is initialized
+class CFileGeneratedPackTest : public test::FSTestFixture {
+ public:
+	CFileGeneratedPackTest() : test::FSTestFixture(INIT_NONE) {
+		pushModDir("cfile");
+	}
+
+ protected:
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		_mod_dir = TEST_DATA_PATH;
+		_mod_dir += DIR_SEPARATOR_STR "cfile" DIR_SEPARATOR_STR;
+		_mod_dir += ::testing::UnitTest::GetInstance()->current_test_info()->name();
+		_vp_path = _mod_dir + DIR_SEPARATOR_STR "generated.vp";
+
+		_mkdir(_mod_dir.c_str());
+
+		_old_mmap_vps = Cmdline_mmap_vps;
+	}
+	void TearDown() override {
+		Cmdline_mmap_vps = _old_mmap_vps;
+
+		test::FSTestFixture::TearDown();
+
+		cfile_close();
+
+		remove(_vp_path.c_str());
+#ifdef _WIN32
+		_rmdir(_mod_dir.c_str());
+#else
+		rmdir(_mod_dir.c_str());
+#endif
+	}
+
+	void add_dir(const SCP_string& name) {
+		_pack.add_dir(name);
+	}
+	void add_file(SCP_string name, SCP_string data) {
+		_pack.add_file(std::move(name), std::move(data));
+	}
+
+	// Writes all entries added so far into the pack file and initializes cfile
+	void write_pack_and_init() {
+		ASSERT_TRUE(_pack.write(_vp_path));
+
+		SCP_string cfile_dir(TEST_DATA_PATH);
+		cfile_dir += DIR_SEPARATOR_CHAR;
+		cfile_dir += "test"; // Cfile expects something after the path
+
+		ASSERT_FALSE(cfile_init(cfile_dir.c_str()));
+	}
+
+	test::vp_writer _pack;
+	SCP_string _mod_dir;
+	SCP_string _vp_path;
+	bool _old_mmap_vps = false;
+};
+
+TEST_F(CFileGeneratedPackTest, DISABLED_lookup_benchmark)
+{
+	add_dir("data");
+	add_dir("maps");
+	for (int i = 0; i < NUM_BENCHMARK_MAPS; ++i) {
+		add_file(benchmark_name("bench", i, ".dds"), "x");
+	}
+	add_dir("..");
+	add_dir("models");
+	for (int i = 0; i < NUM_BENCHMARK_MODELS; ++i) {
+		add_file(benchmark_name("bench", i, ".pof"), "x");
+	}
+	add_dir("..");
+	add_dir("effects");
+	for (int folder = 0; folder < NUM_BENCHMARK_EFFECT_FOLDERS; ++folder) {
+		add_dir(benchmark_name("sub", folder, ""));
+		for (int i = 0; i < NUM_BENCHMARK_EFFECTS_PER_FOLDER; ++i) {
+			add_file(benchmark_name("fx", folder * NUM_BENCHMARK_EFFECTS_PER_FOLDER + i, ".png"), "x");
+		}
+		add_dir("..");
+	}
+	add_dir("..");
+	add_dir("..");
+
+	write_pack_and_init();
+
+	int found = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_BENCHMARK_MAPS; ++i) {
+		auto loc = cf_find_file_location(benchmark_name("BENCH", i, ".DDS").c_str(), CF_TYPE_MAPS);
+		found += (loc.found && loc.offset > 0 && loc.size == 1) ? 1 : 0;
+	}
+	for (int i = 0; i < NUM_BENCHMARK_MODELS; ++i) {
+		auto loc = cf_find_file_location(benchmark_name("bench", i, ".pof").c_str(), CF_TYPE_MODELS);
+		found += (loc.found && loc.offset > 0 && loc.size == 1) ? 1 : 0;
+	}
+	for (int i = 0; i < NUM_BENCHMARK_EFFECT_FOLDERS * NUM_BENCHMARK_EFFECTS_PER_FOLDER; ++i) {
+		auto name = benchmark_name("sub", i / NUM_BENCHMARK_EFFECTS_PER_FOLDER, "/") + benchmark_name("fx", i, ".png");
+		auto loc = cf_find_file_location(name.c_str(), CF_TYPE_EFFECTS);
+		found += (loc.found && loc.offset > 0 && loc.size == 1) ? 1 : 0;
+	}
+	auto location_ms = test::elapsed_ms(start);
+
+	ASSERT_EQ(NUM_BENCHMARK_MAPS + NUM_BENCHMARK_MODELS + NUM_BENCHMARK_EFFECT_FOLDERS * NUM_BENCHMARK_EFFECTS_PER_FOLDER, found);
+
+	// the wrong sub folder must not match, no sub folder matches any
+	ASSERT_FALSE(cf_find_file_location("sub01/fx000000.png", CF_TYPE_EFFECTS).found);
+	ASSERT_TRUE(cf_find_file_location("fx000000.png", CF_TYPE_EFFECTS).found);
+
+	const char* exts[] = { ".png", ".dds" };
+	found = 0;
+
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_BENCHMARK_MAPS; ++i) {
+		auto loc = cf_find_file_location_ext(benchmark_name("bench", i, "").c_str(), 2, exts, CF_TYPE_MAPS);
+		found += (loc.found && loc.extension_index == 1) ? 1 : 0;
+	}
+	auto location_ext_ms = test::elapsed_ms(start);
+
+	ASSERT_EQ(NUM_BENCHMARK_MAPS, found);
+
+	std::cout << "Resolving all " << NUM_BENCHMARK_MAPS + NUM_BENCHMARK_MODELS + NUM_BENCHMARK_EFFECT_FOLDERS * NUM_BENCHMARK_EFFECTS_PER_FOLDER
+	          << " pack file entries: " << location_ms << " ms" << std::endl;
+	std::cout << "Resolving " << NUM_BENCHMARK_MAPS << " maps by extension list: " << location_ext_ms << " ms" << std::endl;
+}
+
+TEST_F(CFileGeneratedPackTest, DISABLED_mmap_load_benchmark)
+{
+	add_dir("data");
+	add_dir("models");
+	for (int i = 0; i < NUM_LOAD_BENCHMARK_FILES; ++i) {
+		SCP_string data(LOAD_BENCHMARK_FILE_SIZE, '\0');
+		for (int j = 0; j < LOAD_BENCHMARK_FILE_SIZE; ++j) {
+			data[j] = static_cast<char>((i * 31 + j * 7) & 0xff);
+		}
+		add_file(benchmark_name("load", i, ".pof"), std::move(data));
+	}
+	add_dir("..");
+	add_dir("..");
+
+	write_pack_and_init();
+
+	// reads every file like the model code does (lots of small reads) followed by one big read for the rest
+	int failures = 0;
+	auto load_all = [&failures](bool mmap_vps, uint& checksum) {
+		Cmdline_mmap_vps = mmap_vps;
+		checksum = 0;
+
+		SCP_vector<ubyte> buffer(LOAD_BENCHMARK_FILE_SIZE);
+		auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < NUM_LOAD_BENCHMARK_FILES; ++i) {
+			auto cfp = cfopen(benchmark_name("load", i, ".pof").c_str(), "rb", CF_TYPE_MODELS);
+			if (cfp == nullptr) {
+				++failures;
+				continue;
+			}
+			if ((cf_get_view(cfp).data != nullptr) != mmap_vps) {
+				++failures;
+			}
+
+			for (int j = 0; j < 1024; ++j) {
+				checksum += static_cast<uint>(cfread_int(cfp));
+			}
+			cfread(buffer.data(), 1, LOAD_BENCHMARK_FILE_SIZE - 4096, cfp);
+			for (int j = 0; j < LOAD_BENCHMARK_FILE_SIZE - 4096; j += 64) {
+				checksum += buffer[j];
+			}
+
+			cfclose(cfp);
+		}
+
+		return test::elapsed_ms(start);
+	};
+
+	uint stdio_checksum, mmap_checksum;
+
+	// warm up the file cache so that both paths read from memory
+	load_all(false, stdio_checksum);
+
+	auto stdio_ms = load_all(false, stdio_checksum);
+	auto mmap_ms = load_all(true, mmap_checksum);
+
+	ASSERT_EQ(0, failures);
+	ASSERT_EQ(stdio_checksum, mmap_checksum);
+
+	std::cout << "Loading " << NUM_LOAD_BENCHMARK_FILES << " packed files of " << LOAD_BENCHMARK_FILE_SIZE / 1024
+	          << " KiB: stdio " << stdio_ms << " ms, memory-mapped " << mmap_ms << " ms" << std::endl;
+}
@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+
+#include "lighting/lightgrid.h"
+#include "lighting/lighting.h"
+
+#include "util/test_util.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+constexpr int NUM_BENCHMARK_LIGHTS = 4000;
+constexpr int NUM_BENCHMARK_DRAWS = 3000;
+
+light make_light(Light_Type type, const vec3d& pos, float radb)
+{
+	light l = {};
+	l.type = type;
+	l.vec = pos;
+	l.radb = radb;
+	l.radb_squared = radb * radb;
+	l.intensity = 1.0f;
+	return l;
+}
+
+// A battle: lots of small weapon and particle lights, some explosions and beams, plus the sun
+SCP_vector<light> make_scene(size_t count, float extent, unsigned int seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<float> coord(-extent, extent);
+	std::uniform_real_distribution<float> small_radius(10.0f, 300.0f);
+	std::uniform_real_distribution<float> big_radius(500.0f, 4000.0f);
+	std::uniform_real_distribution<float> beam_length(500.0f, 3000.0f);
+	std::uniform_int_distribution<int> kind(0, 99);
+
+	SCP_vector<light> lights;
+	lights.push_back(make_light(Light_Type::Directional, vm_vec_new(0.0f, 0.0f, 1.0f), 0.0f));
+
+	for (size_t i = 1; i < count; ++i) {
+		auto pos = vm_vec_new(coord(gen), coord(gen), coord(gen));
+		int k = kind(gen);
+
+		if (k < 90) {
+			lights.push_back(make_light(Light_Type::Point, pos, small_radius(gen)));
+		} else if (k < 95) {
+			lights.push_back(make_light(Light_Type::Point, pos, big_radius(gen)));
+		} else if (k < 98) {
+			auto l = make_light(Light_Type::Tube, pos, small_radius(gen));
+			vec3d dir = vm_vec_new(coord(gen), coord(gen), coord(gen));
+			vm_vec_normalize_safe(&dir);
+			vm_vec_scale_add(&l.vec2, &pos, &dir, beam_length(gen));
+			lights.push_back(l);
+		} else {
+			auto l = make_light(Light_Type::Cone, pos, small_radius(gen));
+			l.vec2 = vm_vec_new(0.0f, 1.0f, 0.0f);
+			lights.push_back(l);
+		}
+	}
+
+	return lights;
+}
+
+// What scene_lights::setLightFilter() did before it had the grid
+SCP_vector<size_t> linear_scan(const SCP_vector<light>& lights, const vec3d& pos, float rad)
+{
+	SCP_vector<size_t> indices;
+	for (size_t i = 0; i < lights.size(); ++i) {
+		const auto& l = lights[i];
+		float dist_squared;
+
+		if (l.type == Light_Type::Point) {
+			vec3d to_light;
+			vm_vec_sub(&to_light, &l.vec, &pos);
+			dist_squared = vm_vec_mag_squared(&to_light);
+		} else if (l.type == Light_Type::Tube) {
+			vec3d nearest;
+			vm_vec_dist_squared_to_line(&pos, &l.vec, &l.vec2, &nearest, &dist_squared);
+		} else {
+			continue;
+		}
+
+		float max_dist_squared = l.radb + rad;
+		max_dist_squared *= max_dist_squared;
+
+		if (dist_squared < max_dist_squared)
+			indices.push_back(i);
+	}
+
+	return indices;
+}
+}
+
+TEST(LightGridTest, empty)
+{
+	light_grid grid;
+	SCP_vector<light> lights;
+	grid.build(lights);
+
+	SCP_vector<size_t> indices;
+	grid.find(lights, vmd_zero_vector, 1000.0f, indices);
+	ASSERT_TRUE(indices.empty());
+}
+
+TEST(LightGridTest, onlyPointAndTubeLights)
+{
+	SCP_vector<light> lights;
+	lights.push_back(make_light(Light_Type::Directional, vm_vec_new(0.0f, 0.0f, 1.0f), 0.0f));
+	lights.push_back(make_light(Light_Type::Cone, vmd_zero_vector, 100.0f));
+	lights.push_back(make_light(Light_Type::Ambient, vmd_zero_vector, 100.0f));
+	lights.push_back(make_light(Light_Type::Point, vm_vec_new(50.0f, 0.0f, 0.0f), 100.0f));
+
+	auto tube = make_light(Light_Type::Tube, vm_vec_new(0.0f, 50.0f, 0.0f), 10.0f);
+	tube.vec2 = vm_vec_new(0.0f, 50.0f, 100.0f);
+	lights.push_back(tube);
+
+	light_grid grid;
+	grid.build(lights);
+
+	SCP_vector<size_t> indices;
+	grid.find(lights, vmd_zero_vector, 50.0f, indices);
+	ASSERT_EQ(SCP_vector<size_t>({3, 4}), indices);
+}
+
+TEST(LightGridTest, tubesLightTheWholeLine)
+{
+	SCP_vector<light> lights = make_scene(200, 5000.0f, 7);
+
+	auto tube = make_light(Light_Type::Tube, vmd_zero_vector, 10.0f);
+	tube.vec2 = vm_vec_new(0.0f, 0.0f, 10.0f);
+	lights.push_back(tube);
+
+	light_grid grid;
+	grid.build(lights);
+
+	// far beyond the second point, but still next to the line through both
+	SCP_vector<size_t> indices;
+	grid.find(lights, vm_vec_new(5.0f, 0.0f, 100000.0f), 1.0f, indices);
+	ASSERT_FALSE(indices.empty());
+	ASSERT_EQ(lights.size() - 1, indices.back());
+}
+
+TEST(LightGridTest, fewLightsMatchLinearScan)
+{
+	auto lights = make_scene(20, 1000.0f, 3);
+
+	light_grid grid;
+	grid.build(lights);
+	ASSERT_EQ(0u, grid.num_binned());
+
+	std::mt19937 gen(11);
+	std::uniform_real_distribution<float> coord(-1200.0f, 1200.0f);
+	std::uniform_real_distribution<float> radius(1.0f, 500.0f);
+
+	SCP_vector<size_t> indices;
+	for (int i = 0; i < 200; ++i) {
+		auto pos = vm_vec_new(coord(gen), coord(gen), coord(gen));
+		float rad = radius(gen);
+
+		indices.clear();
+		grid.find(lights, pos, rad, indices);
+		ASSERT_EQ(linear_scan(lights, pos, rad), indices);
+	}
+}
+
+TEST(LightGridTest, matchesLinearScan)
+{
+	auto lights = make_scene(3000, 8000.0f, 42);
+
+	light_grid grid;
+	grid.build(lights);
+	ASSERT_GT(grid.num_binned(), 0u);
+
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<float> coord(-9000.0f, 9000.0f);
+	std::uniform_real_distribution<float> radius(1.0f, 2500.0f);
+	std::uniform_int_distribution<size_t> light_index(0, lights.size() - 1);
+
+	size_t num_found = 0;
+	SCP_vector<size_t> indices;
+	for (int i = 0; i < 2000; ++i) {
+		// half of the draws are right at a light, which puts them on the edge of its range now and then
+		vec3d pos;
+		float rad;
+		if (i % 2) {
+			pos = vm_vec_new(coord(gen), coord(gen), coord(gen));
+			rad = radius(gen);
+		} else {
+			const auto& l = lights[light_index(gen)];
+			pos = l.vec;
+			rad = radius(gen) * 0.1f;
+		}
+
+		// existing contents are kept
+		indices.assign(1, 12345);
+		grid.find(lights, pos, rad, indices);
+
+		ASSERT_EQ(12345u, indices.front());
+		indices.erase(indices.begin());
+		ASSERT_EQ(linear_scan(lights, pos, rad), indices);
+
+		num_found += indices.size();
+	}
+
+	ASSERT_GT(num_found, 2000u);
+}
+
+TEST(LightGridTest, rebuild)
+{
+	auto lights = make_scene(500, 3000.0f, 1);
+
+	light_grid grid;
+	grid.build(lights);
+
+	lights = make_scene(800, 200.0f, 2);
+	grid.build(lights);
+
+	SCP_vector<size_t> indices;
+	grid.find(lights, vmd_zero_vector, 100.0f, indices);
+	ASSERT_EQ(linear_scan(lights, vmd_zero_vector, 100.0f), indices);
+}
+
+TEST(LightGridTest, DISABLED_benchmark)
+{
+	// every ship, weapon and debris piece of a big battle sets the lights for its draws
+	auto lights = make_scene(NUM_BENCHMARK_LIGHTS, 20000.0f, 1234);
+
+	std::mt19937 gen(99);
+	std::uniform_real_distribution<float> coord(-20000.0f, 20000.0f);
+	std::uniform_real_distribution<float> radius(2.0f, 1500.0f);
+
+	SCP_vector<std::pair<vec3d, float>> draws(NUM_BENCHMARK_DRAWS);
+	for (auto& draw : draws)
+		draw = std::make_pair(vm_vec_new(coord(gen), coord(gen), coord(gen)), radius(gen));
+
+	size_t linear_lights = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (const auto& draw : draws)
+		linear_lights += linear_scan(lights, draw.first, draw.second).size();
+	auto linear_ms = test::elapsed_ms(start);
+
+	size_t grid_lights = 0;
+	start = std::chrono::steady_clock::now();
+	light_grid grid;
+	grid.build(lights);
+	SCP_vector<size_t> indices;
+	for (const auto& draw : draws) {
+		indices.clear();
+		grid.find(lights, draw.first, draw.second, indices);
+		grid_lights += indices.size();
+	}
+	auto grid_ms = test::elapsed_ms(start);
+
+	ASSERT_EQ(linear_lights, grid_lights);
+
+	std::cout << NUM_BENCHMARK_DRAWS << " light filters among " << NUM_BENCHMARK_LIGHTS << " lights, " << grid_lights
+	          << " lights found: " << linear_ms << " ms walking all lights, " << grid_ms
+	          << " ms with the grid (including the build)" << std::endl;
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "math/curve.h"
+
+#include "util/test_util.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+constexpr float BAKE_ERROR = 0.001f;
+constexpr size_t NUM_BENCHMARK_LOOKUPS = 2000000;
+
+class CurveTest : public ::testing::Test {
+  protected:
+	void SetUp() override
+	{
+		_oldCurves = std::move(Curves);
+		Curves.clear();
+	}
+
+	void TearDown() override
+	{
+		Curves = std::move(_oldCurves);
+	}
+
+	static Curve& add_curve(const char* name, std::initializer_list<curve_keyframe> keyframes)
+	{
+		auto& curve = Curves.emplace_back(name);
+		curve.keyframes.assign(keyframes);
+		return curve;
+	}
+
+	SCP_vector<Curve> _oldCurves;
+};
+}
+
+TEST_F(CurveTest, bakedCurveStaysWithinError)
+{
+	add_curve("EaseInQuad", {curve_keyframe{vec2d{0.0f, 0.0f}, CurveInterpFunction::Polynomial, 2.0f, 1.0f},
+	                         curve_keyframe{vec2d{1.0f, 1.0f}, CurveInterpFunction::Constant, 0.0f, 0.0f}});
+	auto& curve = add_curve("Mixed", {curve_keyframe{vec2d{-2.0f, 0.5f}, CurveInterpFunction::Linear, 0.0f, 0.0f},
+	                                  curve_keyframe{vec2d{0.0f, 2.0f}, CurveInterpFunction::Circular, 0.0f, -1.0f},
+	                                  curve_keyframe{vec2d{3.0f, 1.0f}, CurveInterpFunction::Curve, 0.0f, 0.0f},
+	                                  curve_keyframe{vec2d{5.0f, 4.0f}, CurveInterpFunction::Constant, 0.0f, 0.0f}});
+
+	ASSERT_TRUE(curve.Bake(BAKE_ERROR));
+	ASSERT_TRUE(curve.IsBaked());
+
+	// a little slack for the rounding of the lookup itself
+	for (float x = -4.0f; x <= 7.0f; x += 0.0007f)
+		ASSERT_NEAR(curve.GetValueExact(x), curve.GetValue(x), BAKE_ERROR * 1.05f) << "at x = " << x;
+
+	// outside of the keyframes the curve is flat
+	ASSERT_EQ(0.5f, curve.GetValue(-100.0f));
+	ASSERT_EQ(4.0f, curve.GetValue(100.0f));
+}
+
+TEST_F(CurveTest, stepsAreEvaluatedExactly)
+{
+	auto& curve = add_curve("Step", {curve_keyframe{vec2d{0.0f, 0.0f}, CurveInterpFunction::Linear, 0.0f, 0.0f},
+	                                 curve_keyframe{vec2d{0.5f, 0.5f}, CurveInterpFunction::Constant, 0.0f, 0.0f},
+	                                 curve_keyframe{vec2d{0.75f, 1.0f}, CurveInterpFunction::Linear, 0.0f, 0.0f},
+	                                 curve_keyframe{vec2d{1.0f, 0.0f}, CurveInterpFunction::Constant, 0.0f, 0.0f}});
+
+	ASSERT_TRUE(curve.Bake(BAKE_ERROR));
+
+	for (float x = 0.74f; x <= 0.76f; x += 0.0001f)
+		ASSERT_NEAR(curve.GetValueExact(x), curve.GetValue(x), 1e-5f) << "at x = " << x;
+}
+
+TEST_F(CurveTest, constantCurvesAreNotBaked)
+{
+	auto& curve = add_curve("Flat", {curve_keyframe{vec2d{0.0f, 1.0f}, CurveInterpFunction::Constant, 0.0f, 0.0f}});
+
+	ASSERT_FALSE(curve.Bake(BAKE_ERROR));
+	ASSERT_FALSE(curve.IsBaked());
+	ASSERT_EQ(1.0f, curve.GetValue(0.5f));
+}
+
+TEST_F(CurveTest, DISABLED_benchmark)
+{
+	add_curve("EaseOutCirc", {curve_keyframe{vec2d{0.0f, 0.0f}, CurveInterpFunction::Circular, 0.0f, -1.0f},
+	                          curve_keyframe{vec2d{1.0f, 1.0f}, CurveInterpFunction::Constant, 0.0f, 0.0f}});
+	auto& curve = add_curve("Lifetime", {curve_keyframe{vec2d{0.0f, 0.0f}, CurveInterpFunction::Polynomial, 3.0f, 1.0f},
+	                                     curve_keyframe{vec2d{0.2f, 1.0f}, CurveInterpFunction::Linear, 0.0f, 0.0f},
+	                                     curve_keyframe{vec2d{0.4f, 0.8f}, CurveInterpFunction::Polynomial, 2.0f, -1.0f},
+	                                     curve_keyframe{vec2d{0.6f, 0.5f}, CurveInterpFunction::Curve, 0.0f, 0.0f},
+	                                     curve_keyframe{vec2d{0.8f, 0.9f}, CurveInterpFunction::Circular, 0.0f, 1.0f},
+	                                     curve_keyframe{vec2d{1.0f, 0.0f}, CurveInterpFunction::Constant, 0.0f, 0.0f}});
+
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<float> dist(-0.1f, 1.1f);
+	SCP_vector<float> inputs(NUM_BENCHMARK_LOOKUPS);
+	for (auto& x : inputs)
+		x = dist(gen);
+
+	auto start = std::chrono::steady_clock::now();
+	float exact_sum = 0.0f;
+	for (auto x : inputs)
+		exact_sum += curve.GetValue(x);
+	auto exact_ms = test::elapsed_ms(start);
+
+	ASSERT_TRUE(curve.Bake(BAKE_ERROR));
+
+	start = std::chrono::steady_clock::now();
+	float baked_sum = 0.0f;
+	for (auto x : inputs)
+		baked_sum += curve.GetValue(x);
+	auto baked_ms = test::elapsed_ms(start);
+
+	float max_error = 0.0f;
+	for (auto x : inputs)
+		max_error = std::max(max_error, std::fabs(curve.GetValue(x) - curve.GetValueExact(x)));
+
+	ASSERT_LE(max_error, BAKE_ERROR * 1.05f);
+
+	std::cout << "Curve lookups with " << NUM_BENCHMARK_LOOKUPS << " inputs (keyframes vs. baked):" << std::endl;
+	std::cout << "  time: " << exact_ms << " ms vs. " << baked_ms << " ms" << std::endl;
+	std::cout << "  sum: " << exact_sum << " vs. " << baked_sum << ", max error " << max_error << std::endl;
+}
@@ -0,0 +1,596 @@
+#include <gtest/gtest.h>
+
+#include "math/fvi.h"
+#include "model/model.h"
+
+#include <random>
+
+extern polymodel *Polygon_models[MAX_POLYGON_MODELS];
+
+namespace {
+// Only flat polygons, so that nothing needs textures
+constexpr ubyte FLAT_POLY = 255;
+
+// A collision tree with the six faces of a box, facing outwards
+int make_box_tree(const vec3d& lo, const vec3d& hi)
+{
+	// the corners of each face in order around it, bit 0 picks hi.x, bit 1 hi.y and bit 2 hi.z
+	static const int faces[6][4] = {{0, 2, 6, 4}, {1, 3, 7, 5}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 5, 7, 6}};
+
+	int tree_index = model_create_bsp_collision_tree();
+	auto tree = model_get_bsp_collision_tree(tree_index);
+
+	tree->n_verts = 8;
+	tree->point_list = static_cast<vec3d*>(vm_malloc(sizeof(vec3d) * 8));
+	for (int i = 0; i < 8; ++i)
+		tree->point_list[i] = vm_vec_new((i & 1) ? hi.xyz.x : lo.xyz.x, (i & 2) ? hi.xyz.y : lo.xyz.y, (i & 4) ? hi.xyz.z : lo.xyz.z);
+
+	vec3d center;
+	vm_vec_avg(&center, &lo, &hi);
+
+	tree->n_leaves = 6;
+	tree->leaf_list = static_cast<bsp_collision_leaf*>(vm_malloc(sizeof(bsp_collision_leaf) * 6));
+	tree->vert_list = static_cast<model_tmap_vert*>(vm_malloc(sizeof(model_tmap_vert) * 24));
+
+	SCP_vector<collision_bvh::bounds> bounds(6);
+	for (int f = 0; f < 6; ++f) {
+		int corners[4];
+		std::copy(std::begin(faces[f]), std::end(faces[f]), corners);
+
+		const vec3d* p = tree->point_list;
+		vec3d norm, face_center, outwards;
+		vm_vec_normal(&norm, &p[corners[0]], &p[corners[1]], &p[corners[2]]);
+		vm_vec_avg4(&face_center, &p[corners[0]], &p[corners[1]], &p[corners[2]], &p[corners[3]]);
+		vm_vec_sub(&outwards, &face_center, &center);
+		if (vm_vec_dot(&norm, &outwards) < 0.0f) {
+			std::reverse(std::begin(corners), std::end(corners));
+			vm_vec_negate(&norm);
+		}
+
+		auto& leaf = tree->leaf_list[f];
+		leaf.plane_norm = norm;
+		leaf.vert_start = f * 4;
+		leaf.num_verts = 4;
+		leaf.tmap_num = FLAT_POLY;
+		leaf.next = -1;
+
+		bounds[f].min = bounds[f].max = p[corners[0]];
+		for (int i = 0; i < 4; ++i) {
+			tree->vert_list[f * 4 + i] = model_tmap_vert();
+			tree->vert_list[f * 4 + i].vertnum = corners[i];
+			vm_vec_min(&bounds[f].min, &bounds[f].min, &p[corners[i]]);
+			vm_vec_max(&bounds[f].max, &bounds[f].max, &p[corners[i]]);
+		}
+
+		// grown a little like the boxes of a parsed model, so that the faces aren't flat boxes
+		for (int i = 0; i < 3; ++i) {
+			bounds[f].min.a1d[i] -= 0.01f;
+			bounds[f].max.a1d[i] += 0.01f;
+		}
+	}
+
+	tree->bvh.build(bounds);
+	model_collide_init_leaf_tmaps(tree->leaf_list, tree->n_leaves);
+	return tree_index;
+}
+
+void expect_same_hits(const mc_info& expected, const mc_info& batch, size_t ray)
+{
+	if (expected.flags & MC_COLLIDE_ALL) {
+		// every hit is found, but not necessarily in the same order
+		ASSERT_EQ(expected.num_hits, batch.num_hits) << "ray " << ray;
+		ASSERT_EQ(expected.hit_points_all.size(), batch.hit_points_all.size()) << "ray " << ray;
+
+		auto sorted_hits = [](const mc_info& mc) {
+			SCP_vector<std::pair<int, vec3d>> hits;
+			for (size_t i = 0; i < mc.hit_points_all.size(); ++i)
+				hits.emplace_back(mc.hit_submodels_all[i], mc.hit_points_all[i]);
+			std::sort(hits.begin(), hits.end(), [](const std::pair<int, vec3d>& a, const std::pair<int, vec3d>& b) {
+				if (a.first != b.first)
+					return a.first < b.first;
+				return std::lexicographical_compare(std::begin(a.second.a1d), std::end(a.second.a1d), std::begin(b.second.a1d), std::end(b.second.a1d));
+			});
+			return hits;
+		};
+
+		auto expected_hits = sorted_hits(expected);
+		auto batch_hits = sorted_hits(batch);
+		for (size_t i = 0; i < expected_hits.size(); ++i) {
+			EXPECT_EQ(expected_hits[i].first, batch_hits[i].first) << "ray " << ray << ", hit " << i;
+			EXPECT_TRUE(vm_vec_same(&expected_hits[i].second, &batch_hits[i].second)) << "ray " << ray << ", hit " << i;
+		}
+		return;
+	}
+
+	// how many faces are counted before the closest one depends on the order they are checked in
+	ASSERT_EQ(expected.num_hits > 0, batch.num_hits > 0) << "ray " << ray;
+	if (expected.num_hits == 0)
+		return;
+
+	EXPECT_EQ(expected.hit_submodel, batch.hit_submodel) << "ray " << ray;
+	EXPECT_EQ(expected.edge_hit, batch.edge_hit) << "ray " << ray;
+	// the same polygon is hit at the same spot, down to the last bit
+	EXPECT_EQ(expected.bsp_leaf, batch.bsp_leaf) << "ray " << ray;
+	EXPECT_EQ(expected.hit_dist, batch.hit_dist) << "ray " << ray;
+	EXPECT_TRUE(vm_vec_same(&expected.hit_point_world, &batch.hit_point_world)) << "ray " << ray;
+}
+
+class ModelCollideBatchTest : public ::testing::Test {
+  protected:
+	void SetUp() override
+	{
+		// a hull with a turret that has a barrel, and a dish below it
+		for (_modelNum = 0; Polygon_models[_modelNum] != nullptr; ++_modelNum)
+			;
+		_model = new polymodel();
+		_model->id = _modelNum;
+		_model->n_models = 4;
+		_model->n_detail_levels = 1;
+		_model->detail[0] = HULL;
+		_model->submodel = make_shared<bsp_info[]>(4);
+
+		add_submodel(HULL, -1, vmd_zero_vector, vm_vec_new(-50.0f, -50.0f, -200.0f), vm_vec_new(50.0f, 50.0f, 200.0f));
+		add_submodel(DISH, HULL, vm_vec_new(0.0f, -57.0f, 100.0f), vm_vec_new(-15.0f, -5.0f, -15.0f), vm_vec_new(15.0f, 5.0f, 15.0f));
+		add_submodel(TURRET, HULL, vm_vec_new(0.0f, 62.0f, 0.0f), vm_vec_new(-10.0f, -10.0f, -10.0f), vm_vec_new(10.0f, 10.0f, 10.0f));
+		add_submodel(BARREL, TURRET, vm_vec_new(0.0f, 0.0f, 10.0f), vm_vec_new(-2.0f, -2.0f, 0.0f), vm_vec_new(2.0f, 2.0f, 30.0f));
+
+		_model->mins = vm_vec_new(-60.0f, -70.0f, -210.0f);
+		_model->maxs = vm_vec_new(60.0f, 90.0f, 210.0f);
+		_model->rad = vm_vec_mag(&_model->maxs);
+
+		Polygon_models[_modelNum] = _model;
+		_modelInstance = model_create_instance(-1, _modelNum);
+
+		// turn the turret and raise its barrel, so that the instance transforms matter
+		auto pmi = model_get_instance(_modelInstance);
+		vm_quaternion_rotate(&pmi->submodel[TURRET].canonical_orient, 0.7f, &vmd_y_vector);
+		pmi->submodel[TURRET].transform_version++;
+		vm_quaternion_rotate(&pmi->submodel[BARREL].canonical_orient, -0.3f, &vmd_x_vector);
+		pmi->submodel[BARREL].transform_version++;
+
+		angles model_angles = {0.2f, 0.4f, -0.1f};
+		vm_angles_2_matrix(&_orient, &model_angles);
+		_pos = vm_vec_new(1000.0f, -500.0f, 250.0f);
+
+		// where the turret is in the world, which is what the submodel checks are given
+		matrix turret_orient;
+		vec3d turret_offset;
+		model_instance_get_submodel_transform(&turret_orient, &turret_offset, _model, pmi, TURRET);
+		_turretOrient = turret_orient * _orient;
+		vm_vec_unrotate(&_turretPos, &turret_offset, &_orient);
+		vm_vec_add2(&_turretPos, &_pos);
+	}
+
+	void TearDown() override
+	{
+		for (int i = 0; i < _model->n_models; ++i)
+			model_remove_bsp_collision_tree(_model->submodel[i].collision_tree_index);
+
+		model_delete_instance(_modelInstance);
+		Polygon_models[_modelNum] = nullptr;
+		delete _model;
+	}
+
+	void add_submodel(int num, int parent, const vec3d& offset, const vec3d& lo, const vec3d& hi)
+	{
+		auto& sm = _model->submodel[num];
+		sm.parent = parent;
+		sm.offset = offset;
+		sm.min = lo;
+		sm.max = hi;
+		sm.rad = std::max(vm_vec_mag(&lo), vm_vec_mag(&hi));
+		sm.collision_tree_index = make_box_tree(lo, hi);
+
+		if (parent >= 0) {
+			auto& parent_sm = _model->submodel[parent];
+			sm.next_sibling = parent_sm.first_child;
+			parent_sm.first_child = num;
+			parent_sm.num_children++;
+		}
+	}
+
+	// Shots at the model from all around, aimed at the hull or the turret, some of them stopping short
+	SCP_vector<mc_ray> make_rays(size_t count, unsigned int seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> length(200.0f, 800.0f);
+
+		SCP_vector<mc_ray> rays(count);
+		for (size_t i = 0; i < count; ++i) {
+			vec3d from = vm_vec_new(unit(gen), unit(gen), unit(gen));
+			vm_vec_normalize_safe(&from);
+			vm_vec_scale(&from, 400.0f);
+
+			vec3d target = (i % 2) ? vm_vec_new(unit(gen) * 50.0f, unit(gen) * 50.0f, unit(gen) * 200.0f)
+			                       : vm_vec_new(unit(gen) * 20.0f, 62.0f + unit(gen) * 20.0f, unit(gen) * 30.0f);
+
+			vec3d dir;
+			vm_vec_normalized_dir(&dir, &target, &from);
+
+			vec3d p0, p1;
+			vm_vec_unrotate(&p0, &from, &_orient);
+			vm_vec_add2(&p0, &_pos);
+			vm_vec_scale_add(&p1, &from, &dir, length(gen));
+			vm_vec_unrotate(&p1, &p1, &_orient);
+			vm_vec_add2(&p1, &_pos);
+
+			rays[i] = {p0, p1};
+		}
+
+		return rays;
+	}
+
+	// The submodel checks only ever look at the turret
+	mc_info make_mc(int flags, int submodel = -1)
+	{
+		mc_info mc;
+		mc.model_instance_num = _modelInstance;
+		mc.model_num = _modelNum;
+		mc.submodel_num = submodel;
+		mc.orient = (submodel >= 0) ? &_turretOrient : &_orient;
+		mc.pos = (submodel >= 0) ? &_turretPos : &_pos;
+		mc.flags = flags;
+		mc.radius = 5.0f;
+		return mc;
+	}
+
+	// Checks the rays in a batch and one at a time, and that they come out the same.  Returns how many rays hit.
+	int check_batch(mc_info& mc, const SCP_vector<mc_ray>& rays)
+	{
+		SCP_vector<mc_info> results;
+		int num_rays_hit = model_collide_batch(&mc, rays, results);
+		EXPECT_EQ(rays.size(), results.size());
+
+		int expected_rays_hit = 0;
+		for (size_t i = 0; i < rays.size(); ++i) {
+			auto single = mc;
+			single.p0 = &rays[i].p0;
+			single.p1 = &rays[i].p1;
+			if (model_collide(&single))
+				++expected_rays_hit;
+
+			expect_same_hits(single, results[i], i);
+		}
+
+		EXPECT_EQ(expected_rays_hit, num_rays_hit);
+		return num_rays_hit;
+	}
+
+	static constexpr int HULL = 0;
+	static constexpr int DISH = 1;
+	static constexpr int TURRET = 2;
+	static constexpr int BARREL = 3;
+
+	int _modelNum = -1;
+	int _modelInstance = -1;
+	polymodel* _model = nullptr;
+
+	matrix _orient = vmd_identity_matrix;
+	vec3d _pos = vmd_zero_vector;
+
+	matrix _turretOrient = vmd_identity_matrix;
+	vec3d _turretPos = vmd_zero_vector;
+};
+}
+
+namespace {
+// Stacks of quads facing rays that go along z, kept in BSP leaf lists of up to five polygons.  The model has no textures
+// loaded, so the textured quads are invisible and only the flat ones can be hit.
+class ModelCollideInvisibleTest : public ::testing::Test {
+  protected:
+	enum class check_mode {
+		LIST,		// an invisible polygon ends its leaf list, like the BSP walk did
+		SELF,		// an invisible polygon only skips itself
+		ALL			// invisible polygons are checked too
+	};
+
+	struct reference_hit {
+		const bsp_collision_leaf* leaf = nullptr;
+		float dist = 0.0f;
+		int num_hits = 0;
+	};
+
+	void SetUp() override
+	{
+		for (_modelNum = 0; Polygon_models[_modelNum] != nullptr; ++_modelNum)
+			;
+		_model = new polymodel();
+		_model->id = _modelNum;
+		_model->n_models = 1;
+		_model->n_detail_levels = 1;
+		_model->detail[0] = 0;
+		_model->submodel = make_shared<bsp_info[]>(1);
+
+		auto& sm = _model->submodel[0];
+		sm.parent = -1;
+		sm.min = vm_vec_new(-60.0f, -60.0f, -60.0f);
+		sm.max = vm_vec_new(60.0f, 60.0f, 60.0f);
+		sm.rad = vm_vec_mag(&sm.max);
+		sm.collision_tree_index = make_tree(1);
+
+		_model->mins = sm.min;
+		_model->maxs = sm.max;
+		_model->rad = sm.rad;
+
+		Polygon_models[_modelNum] = _model;
+	}
+
+	void TearDown() override
+	{
+		model_remove_bsp_collision_tree(_model->submodel[0].collision_tree_index);
+		Polygon_models[_modelNum] = nullptr;
+		delete _model;
+	}
+
+	int make_tree(unsigned int seed)
+	{
+		constexpr int NUM_LISTS = 80;
+
+		std::mt19937 gen(seed);
+		std::uniform_int_distribution<int> list_size(1, 5);
+		std::uniform_int_distribution<int> tmap(0, 5);
+		std::uniform_real_distribution<float> center(-40.0f, 40.0f);
+		std::uniform_real_distribution<float> half_size(5.0f, 20.0f);
+
+		SCP_vector<bsp_collision_leaf> leaves;
+		SCP_vector<vec3d> points;
+		for (int list = 0; list < NUM_LISTS; ++list) {
+			_listStarts.push_back(static_cast<int>(leaves.size()));
+
+			// a BSP leaf covers one spot, so the quads of a list overlap
+			float x = center(gen), y = center(gen);
+			int count = list_size(gen);
+			for (int i = 0; i < count; ++i) {
+				float w = half_size(gen), h = half_size(gen), z = center(gen);
+
+				bsp_collision_leaf leaf;
+				leaf.plane_norm = vm_vec_new(0.0f, 0.0f, -1.0f);
+				leaf.vert_start = static_cast<int>(points.size());
+				leaf.num_verts = 4;
+				// half of the quads are flat, the rest use one of three textures
+				int t = tmap(gen);
+				leaf.tmap_num = static_cast<ubyte>(t < 3 ? FLAT_POLY : t - 3);
+				leaf.next = (i < count - 1) ? static_cast<int>(leaves.size()) + 1 : -1;
+				leaves.push_back(leaf);
+
+				points.push_back(vm_vec_new(x - w, y - h, z));
+				points.push_back(vm_vec_new(x - w, y + h, z));
+				points.push_back(vm_vec_new(x + w, y + h, z));
+				points.push_back(vm_vec_new(x + w, y - h, z));
+			}
+		}
+
+		int tree_index = model_create_bsp_collision_tree();
+		auto tree = model_get_bsp_collision_tree(tree_index);
+
+		tree->n_verts = static_cast<int>(points.size());
+		tree->point_list = static_cast<vec3d*>(vm_malloc(sizeof(vec3d) * points.size()));
+		std::copy(points.begin(), points.end(), tree->point_list);
+
+		tree->n_leaves = static_cast<int>(leaves.size());
+		tree->leaf_list = static_cast<bsp_collision_leaf*>(vm_malloc(sizeof(bsp_collision_leaf) * leaves.size()));
+		std::copy(leaves.begin(), leaves.end(), tree->leaf_list);
+
+		tree->vert_list = static_cast<model_tmap_vert*>(vm_malloc(sizeof(model_tmap_vert) * points.size()));
+		SCP_vector<collision_bvh::bounds> bounds(leaves.size());
+		for (size_t i = 0; i < points.size(); ++i) {
+			tree->vert_list[i] = model_tmap_vert();
+			tree->vert_list[i].vertnum = static_cast<ushort>(i);
+		}
+		for (size_t i = 0; i < leaves.size(); ++i) {
+			bounds[i].min = points[i * 4];
+			bounds[i].max = points[i * 4 + 2];
+			for (int k = 0; k < 3; ++k) {
+				bounds[i].min.a1d[k] -= 0.01f;
+				bounds[i].max.a1d[k] += 0.01f;
+			}
+		}
+
+		tree->bvh.build(bounds);
+		model_collide_init_leaf_tmaps(tree->leaf_list, tree->n_leaves);
+		return tree_index;
+	}
+
+	// Shots through the stacks, some of them a little slanted
+	SCP_vector<mc_ray> make_rays(size_t count, unsigned int seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> spot(-55.0f, 55.0f);
+		std::uniform_real_distribution<float> slant(-10.0f, 10.0f);
+
+		SCP_vector<mc_ray> rays(count);
+		for (auto& ray : rays) {
+			float x = spot(gen), y = spot(gen);
+			ray.p0 = vm_vec_new(x, y, -80.0f);
+			ray.p1 = vm_vec_new(x + slant(gen), y + slant(gen), 80.0f);
+		}
+
+		return rays;
+	}
+
+	// Walks the leaf lists like the BSP did, and checks every polygon it gets to
+	reference_hit reference(const mc_ray& ray, check_mode mode, bool collide_all)
+	{
+		auto tree = model_get_bsp_collision_tree(_model->submodel[0].collision_tree_index);
+
+		vec3d dir;
+		vm_vec_sub(&dir, &ray.p1, &ray.p0);
+
+		reference_hit best;
+		for (int start : _listStarts) {
+			for (int l = start; l >= 0; l = tree->leaf_list[l].next) {
+				const auto& leaf = tree->leaf_list[l];
+				if (leaf.tmap_num != FLAT_POLY) {
+					if (mode == check_mode::LIST)
+						break;
+					if (mode == check_mode::SELF)
+						continue;
+				}
+
+				vec3d* points[4];
+				for (int i = 0; i < 4; ++i)
+					points[i] = &tree->point_list[tree->vert_list[leaf.vert_start + i].vertnum];
+
+				float dist = fvi_ray_plane(nullptr, points[0], &leaf.plane_norm, &ray.p0, &dir, 0.0f);
+				if (dist < 0.0f || dist > 1.0f)
+					continue;
+
+				vec3d hit_point;
+				float u, v;
+				vm_vec_scale_add(&hit_point, &ray.p0, &dir, dist);
+				if (!fvi_point_face(&hit_point, 4, points, &leaf.plane_norm, &u, &v, nullptr))
+					continue;
+
+				++best.num_hits;
+				if (collide_all || !best.leaf || dist < best.dist || (dist == best.dist && &leaf < best.leaf)) {
+					best.leaf = &leaf;
+					best.dist = dist;
+				}
+			}
+		}
+
+		return best;
+	}
+
+	// Checks model_collide() against the reference for every ray, returns how many rays hit
+	int check_rays(const SCP_vector<mc_ray>& rays, int flags, check_mode mode)
+	{
+		int num_rays_hit = 0;
+		for (size_t i = 0; i < rays.size(); ++i) {
+			mc_info mc;
+			mc.model_num = _modelNum;
+			mc.orient = &vmd_identity_matrix;
+			mc.pos = &vmd_zero_vector;
+			mc.p0 = &rays[i].p0;
+			mc.p1 = &rays[i].p1;
+			mc.flags = flags;
+
+			const bool collide_all = (flags & MC_COLLIDE_ALL) != 0;
+			auto expected = reference(rays[i], mode, collide_all);
+
+			bool hit = model_collide(&mc) != 0;
+			EXPECT_EQ(expected.num_hits > 0, hit) << "ray " << i;
+			if (expected.num_hits == 0 || !hit)
+				continue;
+
+			++num_rays_hit;
+			if (collide_all) {
+				EXPECT_EQ(expected.num_hits, mc.num_hits) << "ray " << i;
+			} else {
+				EXPECT_EQ(expected.leaf, mc.bsp_leaf) << "ray " << i;
+				EXPECT_EQ(expected.dist, mc.hit_dist) << "ray " << i;
+			}
+		}
+
+		return num_rays_hit;
+	}
+
+	int _modelNum = -1;
+	polymodel* _model = nullptr;
+	SCP_vector<int> _listStarts;
+};
+}
+
+TEST_F(ModelCollideInvisibleTest, endsLeafList)
+{
+	auto rays = make_rays(2000, 1);
+
+	ASSERT_GT(check_rays(rays, MC_CHECK_MODEL, check_mode::LIST), 100);
+	check_rays(rays, MC_CHECK_MODEL | MC_COLLIDE_ALL, check_mode::LIST);
+
+	// make sure that some rays only miss or hit something else because of the polygons after an invisible one
+	int num_differing = 0;
+	for (const auto& ray : rays) {
+		auto list = reference(ray, check_mode::LIST, false);
+		auto self = reference(ray, check_mode::SELF, false);
+		if (list.leaf != self.leaf)
+			++num_differing;
+	}
+	ASSERT_GT(num_differing, 10);
+}
+
+TEST_F(ModelCollideInvisibleTest, checkInvisibleFaces)
+{
+	auto rays = make_rays(2000, 2);
+
+	check_rays(rays, MC_CHECK_MODEL | MC_CHECK_INVISIBLE_FACES, check_mode::ALL);
+	check_rays(rays, MC_CHECK_MODEL | MC_CHECK_INVISIBLE_FACES | MC_COLLIDE_ALL, check_mode::ALL);
+
+	// $collide_invisible does the same for one submodel
+	_model->submodel[0].flags.set(Model::Submodel_flags::Collide_invisible);
+	check_rays(rays, MC_CHECK_MODEL, check_mode::ALL);
+}
+
+TEST_F(ModelCollideBatchTest, wholeModel)
+{
+	auto rays = make_rays(500, 1);
+
+	auto mc = make_mc(MC_CHECK_MODEL);
+	int num_rays_hit = check_batch(mc, rays);
+
+	// make sure the rays actually test something
+	ASSERT_GT(num_rays_hit, 100);
+	ASSERT_LT(num_rays_hit, 500);
+
+	auto sphere_mc = make_mc(MC_CHECK_MODEL | MC_CHECK_SPHERELINE);
+	check_batch(sphere_mc, rays);
+
+	auto ray_mc = make_mc(MC_CHECK_MODEL | MC_CHECK_RAY);
+	check_batch(ray_mc, rays);
+}
+
+TEST_F(ModelCollideBatchTest, collideAll)
+{
+	auto rays = make_rays(500, 2);
+
+	auto mc = make_mc(MC_CHECK_MODEL | MC_COLLIDE_ALL);
+	check_batch(mc, rays);
+
+	auto sphere_mc = make_mc(MC_CHECK_MODEL | MC_COLLIDE_ALL | MC_CHECK_SPHERELINE);
+	check_batch(sphere_mc, rays);
+}
+
+TEST_F(ModelCollideBatchTest, submodels)
+{
+	auto rays = make_rays(500, 3);
+
+	// only the turret
+	auto mc = make_mc(MC_CHECK_MODEL | MC_SUBMODEL, TURRET);
+	ASSERT_GT(check_batch(mc, rays), 0);
+
+	// the turret and its barrel
+	auto instance_mc = make_mc(MC_CHECK_MODEL | MC_SUBMODEL_INSTANCE, TURRET);
+	ASSERT_GT(check_batch(instance_mc, rays), 0);
+
+	auto all_mc = make_mc(MC_CHECK_MODEL | MC_SUBMODEL_INSTANCE | MC_COLLIDE_ALL, TURRET);
+	check_batch(all_mc, rays);
+}
+
+TEST_F(ModelCollideBatchTest, collisionChecked)
+{
+	auto rays = make_rays(500, 4);
+
+	// the turret and with it its barrel were already checked
+	auto mc = make_mc(MC_CHECK_MODEL | MC_COLLIDE_ALL);
+	mc.collision_checked.assign(_model->n_models, 0);
+	mc.collision_checked[TURRET] = 1;
+	const auto checked = mc.collision_checked;
+
+	check_batch(mc, rays);
+	ASSERT_EQ(checked, mc.collision_checked);
+
+	SCP_vector<mc_info> results;
+	model_collide_batch(&mc, rays, results);
+	for (const auto& result : results) {
+		for (int submodel : result.hit_submodels_all) {
+			ASSERT_NE(TURRET, submodel);
+			ASSERT_NE(BARREL, submodel);
+		}
+	}
+
+	// an empty list is set up for each check, but must not be filled in for the caller
+	auto empty_mc = make_mc(MC_CHECK_MODEL);
+	model_collide_batch(&empty_mc, rays, results);
+	ASSERT_TRUE(empty_mc.collision_checked.empty());
+}
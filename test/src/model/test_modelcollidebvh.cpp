@@ -0,0 +1,525 @@
+#include <gtest/gtest.h>
+
+#include "math/fvi.h"
+#include "model/modelcollidebvh.h"
+
+#include "util/test_util.h"
+
+#include <chrono>
+#include <numeric>
+#include <random>
+
+namespace {
+constexpr int NUM_BENCHMARK_RAYS = 20000;
+
+struct test_poly {
+	int nv;
+	vec3d verts[4];
+	vec3d norm;
+};
+
+void add_poly(SCP_vector<test_poly>& polys, std::initializer_list<vec3d> verts)
+{
+	test_poly poly;
+	poly.nv = 0;
+	for (const auto& v : verts)
+		poly.verts[poly.nv++] = v;
+
+	vm_vec_normal(&poly.norm, &poly.verts[0], &poly.verts[1], &poly.verts[2]);
+	polys.push_back(poly);
+}
+
+// Something shaped like a capital ship: a long hull covered in greebles of all sizes, which is what the weapons of a
+// big battle spend their time hitting
+SCP_vector<test_poly> make_capship(unsigned int seed)
+{
+	constexpr int SLICES = 96;
+	constexpr int STACKS = 64;
+	const vec3d hull_size = vm_vec_new(300.0f, 200.0f, 1000.0f);
+
+	auto hull_point = [&hull_size](int slice, int stack) {
+		float theta = PI2 * slice / SLICES;
+		float phi = PI * stack / STACKS;
+		return vm_vec_new(hull_size.xyz.x * sinf(phi) * cosf(theta), hull_size.xyz.y * sinf(phi) * sinf(theta), hull_size.xyz.z * -cosf(phi));
+	};
+
+	SCP_vector<test_poly> polys;
+	for (int stack = 0; stack < STACKS; ++stack) {
+		for (int slice = 0; slice < SLICES; ++slice) {
+			auto a = hull_point(slice, stack);
+			auto b = hull_point(slice + 1, stack);
+			auto c = hull_point(slice + 1, stack + 1);
+			auto d = hull_point(slice, stack + 1);
+
+			if (stack == 0)
+				add_poly(polys, {a, c, d});
+			else if (stack == STACKS - 1)
+				add_poly(polys, {a, b, c});
+			else
+				add_poly(polys, {a, b, c, d});
+		}
+	}
+
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<int> slice_dist(0, SLICES - 1);
+	std::uniform_int_distribution<int> stack_dist(4, STACKS - 5);
+	std::uniform_real_distribution<float> size_dist(1.0f, 30.0f);
+
+	for (int i = 0; i < 800; ++i) {
+		auto center = hull_point(slice_dist(gen), stack_dist(gen));
+		float s = size_dist(gen);
+		float lo[3], hi[3];
+		for (int j = 0; j < 3; ++j) {
+			lo[j] = center.a1d[j] - s;
+			hi[j] = center.a1d[j] + s * 0.5f;
+		}
+
+		auto corner = [&](int x, int y, int z) { return vm_vec_new(x ? hi[0] : lo[0], y ? hi[1] : lo[1], z ? hi[2] : lo[2]); };
+		add_poly(polys, {corner(0, 0, 0), corner(0, 1, 0), corner(1, 1, 0), corner(1, 0, 0)});
+		add_poly(polys, {corner(0, 0, 1), corner(1, 0, 1), corner(1, 1, 1), corner(0, 1, 1)});
+		add_poly(polys, {corner(0, 0, 0), corner(0, 0, 1), corner(0, 1, 1), corner(0, 1, 0)});
+		add_poly(polys, {corner(1, 0, 0), corner(1, 1, 0), corner(1, 1, 1), corner(1, 0, 1)});
+		add_poly(polys, {corner(0, 0, 0), corner(1, 0, 0), corner(1, 0, 1), corner(0, 0, 1)});
+		add_poly(polys, {corner(0, 1, 0), corner(0, 1, 1), corner(1, 1, 1), corner(1, 1, 0)});
+	}
+
+	return polys;
+}
+
+SCP_vector<collision_bvh::bounds> poly_bounds(const SCP_vector<test_poly>& polys)
+{
+	SCP_vector<collision_bvh::bounds> bounds(polys.size());
+	for (size_t i = 0; i < polys.size(); ++i) {
+		bounds[i].min = bounds[i].max = polys[i].verts[0];
+		for (int j = 1; j < polys[i].nv; ++j) {
+			vm_vec_min(&bounds[i].min, &bounds[i].min, &polys[i].verts[j]);
+			vm_vec_max(&bounds[i].max, &bounds[i].max, &polys[i].verts[j]);
+		}
+	}
+
+	return bounds;
+}
+
+// Where the segment p0 + t * dir hits the polygon, the same way mc_check_face() checks it.  Negative if it doesn't.
+float poly_hit(const test_poly& poly, const vec3d& p0, const vec3d& dir)
+{
+	float dist = fvi_ray_plane(nullptr, &poly.verts[0], &poly.norm, &p0, &dir, 0.0f);
+	if (dist < 0.0f || dist > 1.0f)
+		return -1.0f;
+
+	vec3d hit_point;
+	vm_vec_scale_add(&hit_point, &p0, &dir, dist);
+
+	const vec3d* verts[4] = {&poly.verts[0], &poly.verts[1], &poly.verts[2], &poly.verts[3]};
+	if (!fvi_point_face(&hit_point, poly.nv, verts, &poly.norm, nullptr, nullptr, nullptr))
+		return -1.0f;
+
+	return dist;
+}
+
+bool box_hit(const collision_bvh::bounds& box, const vec3d& p0, const vec3d& dir, float radius, float max_t)
+{
+	auto grown = box;
+	for (int i = 0; i < 3; ++i) {
+		grown.min.a1d[i] -= radius;
+		grown.max.a1d[i] += radius;
+	}
+
+	vec3d hit_point;
+	if (!fvi_ray_boundingbox(&grown.min, &grown.max, &p0, &dir, &hit_point))
+		return false;
+
+	vec3d to_hit;
+	vm_vec_sub(&to_hit, &hit_point, &p0);
+	return vm_vec_mag(&to_hit) <= max_t * vm_vec_mag(&dir);
+}
+
+// Shots at the hull from all around, some of them stopping short of it
+void make_rays(SCP_vector<std::pair<vec3d, vec3d>>& rays, size_t count, unsigned int seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> length(1000.0f, 4000.0f);
+
+	rays.resize(count);
+	for (auto& ray : rays) {
+		vec3d from = vm_vec_new(unit(gen), unit(gen), unit(gen));
+		vm_vec_normalize_safe(&from);
+		vm_vec_scale(&from, 2500.0f);
+
+		vec3d target = vm_vec_new(unit(gen) * 300.0f, unit(gen) * 200.0f, unit(gen) * 1000.0f);
+		vec3d dir;
+		vm_vec_normalized_dir(&dir, &target, &from);
+		vm_vec_scale(&dir, length(gen));
+
+		ray = std::make_pair(from, dir);
+	}
+}
+
+// A tree split at the average of the polygon centers along the longest side, like the BSPs the POF tools make, walked
+// recursively one box at a time the way model_collide used to
+struct reference_tree {
+	struct node {
+		collision_bvh::bounds box;
+		int children[2];
+		SCP_vector<int> polys;
+	};
+	SCP_vector<node> nodes;
+
+	int build(const SCP_vector<collision_bvh::bounds>& bounds, SCP_vector<int> polys)
+	{
+		collision_bvh::bounds box = bounds[polys[0]];
+		vec3d avg = vmd_zero_vector;
+		for (int p : polys) {
+			vm_vec_min(&box.min, &box.min, &bounds[p].min);
+			vm_vec_max(&box.max, &box.max, &bounds[p].max);
+
+			vec3d center;
+			vm_vec_avg(&center, &bounds[p].min, &bounds[p].max);
+			vm_vec_add2(&avg, &center);
+		}
+		vm_vec_scale(&avg, 1.0f / polys.size());
+
+		int index = static_cast<int>(nodes.size());
+		nodes.push_back({box, {-1, -1}, {}});
+
+		vec3d size;
+		vm_vec_sub(&size, &box.max, &box.min);
+		int axis = size.xyz.x > size.xyz.y ? (size.xyz.x > size.xyz.z ? 0 : 2) : (size.xyz.y > size.xyz.z ? 1 : 2);
+
+		SCP_vector<int> front, back;
+		for (int p : polys) {
+			vec3d center;
+			vm_vec_avg(&center, &bounds[p].min, &bounds[p].max);
+			(center.a1d[axis] < avg.a1d[axis] ? back : front).push_back(p);
+		}
+
+		if (polys.size() <= 4 || front.empty() || back.empty()) {
+			nodes[index].polys = std::move(polys);
+			return index;
+		}
+
+		int b = build(bounds, std::move(back));
+		int f = build(bounds, std::move(front));
+		nodes[index].children[0] = b;
+		nodes[index].children[1] = f;
+		return index;
+	}
+
+	template <typename Func>
+	void walk(int index, const vec3d& p0, const vec3d& dir, Func&& func) const
+	{
+		const auto& n = nodes[index];
+		if (!box_hit(n.box, p0, dir, 0.0f, 1.0f))
+			return;
+
+		for (int p : n.polys)
+			func(p);
+
+		for (int child : n.children) {
+			if (child >= 0)
+				walk(child, p0, dir, func);
+		}
+	}
+};
+}
+
+TEST(CollisionBVHTest, empty)
+{
+	collision_bvh bvh;
+	ASSERT_TRUE(bvh.empty());
+
+	bvh.build({});
+	ASSERT_TRUE(bvh.empty());
+
+	int visited = 0;
+	bvh.traverse(vmd_zero_vector, vmd_x_vector, 0.0f, 1.0f, [&visited](int) {
+		++visited;
+		return 1.0f;
+	});
+	ASSERT_EQ(0, visited);
+}
+
+TEST(CollisionBVHTest, singlePrimitive)
+{
+	collision_bvh bvh;
+	bvh.build({{vm_vec_new(-1.0f, -1.0f, 4.0f), vm_vec_new(1.0f, 1.0f, 5.0f)}});
+
+	SCP_vector<int> visited;
+	auto visit = [&visited](int prim) {
+		visited.push_back(prim);
+		return 1.0f;
+	};
+
+	bvh.traverse(vmd_zero_vector, vm_vec_new(0.0f, 0.0f, 10.0f), 0.0f, 1.0f, visit);
+	ASSERT_EQ((SCP_vector<int>{0}), visited);
+
+	// stops short of the box
+	visited.clear();
+	bvh.traverse(vmd_zero_vector, vm_vec_new(0.0f, 0.0f, 3.0f), 0.0f, 1.0f, visit);
+	ASSERT_TRUE(visited.empty());
+
+	// unless the ray goes on forever
+	bvh.traverse(vmd_zero_vector, vm_vec_new(0.0f, 0.0f, 3.0f), 0.0f, FLT_MAX, visit);
+	ASSERT_EQ((SCP_vector<int>{0}), visited);
+
+	// passes by, but not with a big enough sphere
+	visited.clear();
+	bvh.traverse(vm_vec_new(2.0f, 0.0f, 0.0f), vm_vec_new(0.0f, 0.0f, 10.0f), 0.5f, 1.0f, visit);
+	ASSERT_TRUE(visited.empty());
+
+	bvh.traverse(vm_vec_new(2.0f, 0.0f, 0.0f), vm_vec_new(0.0f, 0.0f, 10.0f), 1.5f, 1.0f, visit);
+	ASSERT_EQ((SCP_vector<int>{0}), visited);
+}
+
+TEST(CollisionBVHTest, visitsAllBoxesPassedThrough)
+{
+	auto polys = make_capship(42);
+	auto bounds = poly_bounds(polys);
+
+	collision_bvh bvh;
+	bvh.build(bounds);
+	ASSERT_FALSE(bvh.empty());
+
+	SCP_vector<std::pair<vec3d, vec3d>> rays;
+	make_rays(rays, 300, 7);
+
+	SCP_vector<bool> visited(polys.size());
+	for (size_t i = 0; i < rays.size(); ++i) {
+		const auto& p0 = rays[i].first;
+		const auto& dir = rays[i].second;
+
+		for (float radius : {0.0f, 25.0f}) {
+			std::fill(visited.begin(), visited.end(), false);
+			bvh.traverse(p0, dir, radius, 1.0f, [&visited](int prim) {
+				visited[prim] = true;
+				return 1.0f;
+			});
+
+			for (size_t p = 0; p < polys.size(); ++p) {
+				if (box_hit(bounds[p], p0, dir, radius, 1.0f))
+					ASSERT_TRUE(visited[p]) << "ray " << i << ", radius " << radius << ", poly " << p;
+			}
+		}
+	}
+}
+
+TEST(CollisionBVHTest, closestHitMatchesBruteForce)
+{
+	auto polys = make_capship(42);
+
+	collision_bvh bvh;
+	bvh.build(poly_bounds(polys));
+
+	SCP_vector<std::pair<vec3d, vec3d>> rays;
+	make_rays(rays, 2000, 11);
+
+	int num_hits = 0;
+	for (size_t i = 0; i < rays.size(); ++i) {
+		const auto& p0 = rays[i].first;
+		const auto& dir = rays[i].second;
+
+		float expected = FLT_MAX;
+		for (const auto& poly : polys) {
+			float dist = poly_hit(poly, p0, dir);
+			if (dist >= 0.0f)
+				expected = std::min(expected, dist);
+		}
+
+		float closest = FLT_MAX;
+		bvh.traverse(p0, dir, 0.0f, 1.0f, [&](int prim) {
+			float dist = poly_hit(polys[prim], p0, dir);
+			if (dist >= 0.0f)
+				closest = std::min(closest, dist);
+			return std::min(closest, 1.0f);
+		});
+
+		ASSERT_EQ(expected, closest) << "ray " << i;
+		if (closest <= 1.0f)
+			++num_hits;
+	}
+
+	// make sure the rays actually test something
+	ASSERT_GT(num_hits, 500);
+	ASSERT_LT(num_hits, 2000);
+}
+
+TEST(CollisionBVHTest, DISABLED_benchmark)
+{
+	auto polys = make_capship(1234);
+	auto bounds = poly_bounds(polys);
+
+	SCP_vector<std::pair<vec3d, vec3d>> rays;
+	make_rays(rays, NUM_BENCHMARK_RAYS, 99);
+
+	reference_tree tree;
+	SCP_vector<int> all_polys(polys.size());
+	std::iota(all_polys.begin(), all_polys.end(), 0);
+	tree.build(bounds, std::move(all_polys));
+
+	SCP_vector<float> tree_hits(rays.size(), FLT_MAX);
+	size_t tree_polys = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < rays.size(); ++i) {
+		const auto& p0 = rays[i].first;
+		const auto& dir = rays[i].second;
+		tree.walk(0, p0, dir, [&](int prim) {
+			++tree_polys;
+			float dist = poly_hit(polys[prim], p0, dir);
+			if (dist >= 0.0f)
+				tree_hits[i] = std::min(tree_hits[i], dist);
+		});
+	}
+	auto tree_ms = test::elapsed_ms(start);
+
+	start = std::chrono::steady_clock::now();
+	collision_bvh bvh;
+	bvh.build(bounds);
+	auto build_ms = test::elapsed_ms(start);
+
+	SCP_vector<float> bvh_hits(rays.size(), FLT_MAX);
+	size_t bvh_polys = 0;
+	start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < rays.size(); ++i) {
+		const auto& p0 = rays[i].first;
+		const auto& dir = rays[i].second;
+		bvh.traverse(p0, dir, 0.0f, 1.0f, [&](int prim) {
+			++bvh_polys;
+			float dist = poly_hit(polys[prim], p0, dir);
+			if (dist >= 0.0f)
+				bvh_hits[i] = std::min(bvh_hits[i], dist);
+			return std::min(bvh_hits[i], 1.0f);
+		});
+	}
+	auto bvh_ms = test::elapsed_ms(start);
+
+	ASSERT_EQ(tree_hits, bvh_hits);
+
+	std::cout << NUM_BENCHMARK_RAYS << " rays against " << polys.size() << " polygons: " << tree_polys
+	          << " polygons checked walking a BSP style tree in " << tree_ms << " ms, " << bvh_polys << " polygons checked with the BVH ("
+	          << bvh.num_nodes() << " nodes, built in " << build_ms << " ms) in " << bvh_ms << " ms" << std::endl;
+}
+
+TEST(CollisionBVHTest, packetMatchesSingleRays)
+{
+	auto polys = make_capship(42);
+
+	collision_bvh bvh;
+	bvh.build(poly_bounds(polys));
+
+	SCP_vector<std::pair<vec3d, vec3d>> rays;
+	make_rays(rays, 1000, 13);
+
+	// packets of all sizes, closest hits only
+	size_t first = 0;
+	for (int count = 1; first < rays.size(); count = count % collision_bvh::PACKET_SIZE + 1) {
+		count = std::min(count, static_cast<int>(rays.size() - first));
+
+		vec3d p0[collision_bvh::PACKET_SIZE], dir[collision_bvh::PACKET_SIZE];
+		float max_t[collision_bvh::PACKET_SIZE];
+		float closest[collision_bvh::PACKET_SIZE];
+		for (int r = 0; r < count; ++r) {
+			p0[r] = rays[first + r].first;
+			dir[r] = rays[first + r].second;
+			max_t[r] = 1.0f;
+			closest[r] = FLT_MAX;
+		}
+
+		bvh.traverse_packet(p0, dir, count, 0.0f, max_t, [&](int r, int prim) {
+			float dist = poly_hit(polys[prim], p0[r], dir[r]);
+			if (dist >= 0.0f)
+				closest[r] = std::min(closest[r], dist);
+			return std::min(closest[r], 1.0f);
+		});
+
+		for (int r = 0; r < count; ++r) {
+			float expected = FLT_MAX;
+			bvh.traverse(p0[r], dir[r], 0.0f, 1.0f, [&](int prim) {
+				float dist = poly_hit(polys[prim], p0[r], dir[r]);
+				if (dist >= 0.0f)
+					expected = std::min(expected, dist);
+				return std::min(expected, 1.0f);
+			});
+
+			ASSERT_EQ(expected, closest[r]) << "ray " << first + r << " in a packet of " << count;
+		}
+
+		first += count;
+	}
+
+	// every box passed through is visited, with spheres too
+	for (first = 0; first < rays.size(); first += collision_bvh::PACKET_SIZE) {
+		int count = static_cast<int>(std::min(rays.size() - first, static_cast<size_t>(collision_bvh::PACKET_SIZE)));
+
+		vec3d p0[collision_bvh::PACKET_SIZE], dir[collision_bvh::PACKET_SIZE];
+		float max_t[collision_bvh::PACKET_SIZE];
+		for (int r = 0; r < count; ++r) {
+			p0[r] = rays[first + r].first;
+			dir[r] = rays[first + r].second;
+			max_t[r] = 1.0f;
+		}
+
+		SCP_vector<std::pair<int, int>> visited;
+		bvh.traverse_packet(p0, dir, count, 25.0f, max_t, [&](int r, int prim) {
+			visited.emplace_back(r, prim);
+			return 1.0f;
+		});
+		std::sort(visited.begin(), visited.end());
+
+		for (int r = 0; r < count; ++r) {
+			bvh.traverse(p0[r], dir[r], 25.0f, 1.0f, [&](int prim) {
+				EXPECT_TRUE(std::binary_search(visited.begin(), visited.end(), std::make_pair(r, prim))) << "ray " << first + r << ", poly " << prim;
+				return 1.0f;
+			});
+		}
+	}
+}
+
+TEST(CollisionBVHTest, DISABLED_packetBenchmark)
+{
+	// a volumetric nebula bake: rows of parallel rays through the whole hull, collecting every hit
+	constexpr int GRID = 256;
+
+	auto polys = make_capship(1234);
+
+	collision_bvh bvh;
+	bvh.build(poly_bounds(polys));
+
+	SCP_vector<vec3d> p0(GRID * GRID);
+	for (int x = 0; x < GRID; ++x) {
+		for (int y = 0; y < GRID; ++y)
+			p0[x * GRID + y] = vm_vec_new(-320.0f + 640.0f * x / GRID, -220.0f + 440.0f * y / GRID, -1100.0f);
+	}
+	const vec3d dir = vm_vec_new(0.0f, 0.0f, 2200.0f);
+
+	size_t single_hits = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (const auto& from : p0) {
+		bvh.traverse(from, dir, 0.0f, 1.0f, [&](int prim) {
+			if (poly_hit(polys[prim], from, dir) >= 0.0f)
+				++single_hits;
+			return 1.0f;
+		});
+	}
+	auto single_ms = test::elapsed_ms(start);
+
+	size_t packet_hits = 0;
+	start = std::chrono::steady_clock::now();
+	vec3d dirs[collision_bvh::PACKET_SIZE];
+	float max_t[collision_bvh::PACKET_SIZE];
+	std::fill(std::begin(dirs), std::end(dirs), dir);
+	for (size_t first = 0; first < p0.size(); first += collision_bvh::PACKET_SIZE) {
+		std::fill(std::begin(max_t), std::end(max_t), 1.0f);
+		bvh.traverse_packet(&p0[first], dirs, collision_bvh::PACKET_SIZE, 0.0f, max_t, [&](int r, int prim) {
+			if (poly_hit(polys[prim], p0[first + r], dir) >= 0.0f)
+				++packet_hits;
+			return 1.0f;
+		});
+	}
+	auto packet_ms = test::elapsed_ms(start);
+
+	ASSERT_EQ(single_hits, packet_hits);
+
+	std::cout << GRID * GRID << " parallel rays through " << polys.size() << " polygons, " << packet_hits << " hits: "
+	          << single_ms << " ms one ray at a time, " << packet_ms << " ms in packets of " << collision_bvh::PACKET_SIZE << std::endl;
+}
@@ -2,6 +2,9 @@
 #include <model/model.h>
 
 #include "util/FSTestFixture.h"
+#include "util/test_util.h"
+
+#include <chrono>
 
 #define EXPECT_VECMAT_NEAR(global,vector) EXPECT_NEAR(error(&global,vector), 0.0f, 0.001f);
 
@@ -98,4 +101,138 @@ TEST_F(SubmodelLocalizeTest, submodel_instance_localize_roundtrip_world) {
 	EXPECT_VECMAT_NEAR(global, (vec3d{ {{-1.0f, 4.0f, 1.0f}} }));
 	EXPECT_VECMAT_NEAR(roundtrip, local);
 	EXPECT_VECMAT_NEAR(roundtripMat, localMat);
-}
\ No newline at end of file
+}
+
+TEST_F(SubmodelLocalizeTest, submodel_instance_cached_transforms) {
+	vec3d globalPos{ {{0.0f, 5.0f, 0.0f}} };
+	matrix globalOrient;
+	angles globalRot{ 0.0f, PI_2, 0.0f };
+	vm_angles_2_matrix(&globalOrient, &globalRot);
+
+	vec3d local{ {{0.3f, 1.0f, -2.0f}} };
+	matrix localMat = globalOrient;
+
+	auto check = [&]() {
+		for (int submodel = 0; submodel < 3; submodel++) {
+			vec3d uncached[4], cached[4];
+			matrix uncachedMat, cachedMat;
+
+			pmi->transform_cache.reset();
+			model_instance_local_to_global_point(&uncached[0], &local, pm, pmi, submodel, &globalOrient, &globalPos);
+			model_instance_local_to_global_point(&uncached[1], &local, pm, pmi, submodel, &globalOrient, &globalPos, true);
+			model_instance_global_to_local_point(&uncached[2], &local, pm, pmi, submodel, &globalOrient, &globalPos);
+			model_instance_local_to_global_point_orient(&uncached[3], &uncachedMat, &local, &localMat, pm, pmi, submodel, &globalOrient, &globalPos);
+
+			model_instance_init_transform_cache(pmi, 3);
+			model_instance_local_to_global_point(&cached[0], &local, pm, pmi, submodel, &globalOrient, &globalPos);
+			model_instance_local_to_global_point(&cached[1], &local, pm, pmi, submodel, &globalOrient, &globalPos, true);
+			model_instance_global_to_local_point(&cached[2], &local, pm, pmi, submodel, &globalOrient, &globalPos);
+			model_instance_local_to_global_point_orient(&cached[3], &cachedMat, &local, &localMat, pm, pmi, submodel, &globalOrient, &globalPos);
+
+			for (int i = 0; i < 4; i++)
+				EXPECT_VECMAT_NEAR(cached[i], uncached[i]);
+			EXPECT_VECMAT_NEAR(cachedMat, uncachedMat);
+		}
+	};
+
+	check();
+
+	// moving the middle submodel has to move its child as well
+	vec3d before, after;
+	model_instance_local_to_global_point(&before, &local, pm, pmi, 2);
+
+	pmi->submodel[1].canonical_prev_orient = pmi->submodel[1].canonical_orient;
+	vm_quaternion_rotate(&pmi->submodel[1].canonical_orient, 0.5f, &vmd_z_vector);
+	pmi->submodel[1].canonical_offset = vec3d{ {{0.0f, 0.0f, 2.0f}} };
+	pmi->submodel[1].transform_version++;
+
+	model_instance_local_to_global_point(&after, &local, pm, pmi, 2);
+	EXPECT_GT(vm_vec_dist(&before, &after), 0.1f);
+
+	vec3d lastFrame;
+	model_instance_local_to_global_point(&lastFrame, &local, pm, pmi, 2, nullptr, nullptr, true);
+	EXPECT_VECMAT_NEAR(lastFrame, before);
+
+	check();
+}
+
+// A capital ship with a turret base and barrel per turret.  Every frame, every turret is aimed and then its gun
+// points, normal and target are looked up several times, as turret AI, weapon firing and the HUD do.
+TEST(SubmodelTransformTest, DISABLED_benchmark)
+{
+	constexpr int NUM_TURRETS = 60;
+	constexpr int NUM_FRAMES = 200;
+	constexpr int NUM_LOOKUPS = 8;
+	constexpr int NUM_SUBMODELS = 1 + NUM_TURRETS * 2;
+
+	polymodel pm;
+	pm.n_models = NUM_SUBMODELS;
+	pm.submodel = make_shared<bsp_info[]>(NUM_SUBMODELS);
+	pm.submodel[0].parent = -1;
+	pm.submodel[0].depth = 1;
+
+	for (int i = 0; i < NUM_TURRETS; i++) {
+		auto& base = pm.submodel[1 + i * 2];
+		base.parent = 0;
+		base.depth = 2;
+		base.offset = vec3d{ {{static_cast<float>(i % 6) * 100.0f - 250.0f, static_cast<float>(i % 2) * 80.0f - 40.0f, static_cast<float>(i / 6) * 200.0f - 1000.0f}} };
+
+		auto& barrel = pm.submodel[2 + i * 2];
+		barrel.parent = 1 + i * 2;
+		barrel.depth = 3;
+		barrel.offset = vec3d{ {{0.0f, 6.0f, 2.0f}} };
+	}
+
+	polymodel_instance cached, uncached;
+	cached.submodel = new submodel_instance[NUM_SUBMODELS];
+	uncached.submodel = new submodel_instance[NUM_SUBMODELS];
+	model_instance_init_transform_cache(&cached, NUM_SUBMODELS);
+
+	matrix shipOrient;
+	angles shipRot{ 0.1f, 0.2f, 0.3f };
+	vm_angles_2_matrix(&shipOrient, &shipRot);
+	vec3d shipPos{ {{1000.0f, -500.0f, 20000.0f}} };
+	vec3d firingPoints[2] = { {{{-1.5f, 0.0f, 20.0f}}}, {{{1.5f, 0.0f, 20.0f}}} };
+	vec3d target{ {{3000.0f, 0.0f, 21000.0f}} };
+
+	auto run = [&](polymodel_instance* pmi, vec3d& checksum) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (int frame = 0; frame < NUM_FRAMES; frame++) {
+			for (int i = 0; i < NUM_TURRETS; i++) {
+				for (int sub = 1 + i * 2; sub <= 2 + i * 2; sub++) {
+					auto smi = &pmi->submodel[sub];
+					smi->canonical_prev_orient = smi->canonical_orient;
+					vm_quaternion_rotate(&smi->canonical_orient, static_cast<float>(frame) * 0.01f + static_cast<float>(sub), sub % 2 ? &vmd_y_vector : &vmd_x_vector);
+					smi->transform_version++;
+				}
+			}
+
+			for (int i = 0; i < NUM_TURRETS; i++) {
+				int barrel = 2 + i * 2;
+				for (int lookup = 0; lookup < NUM_LOOKUPS; lookup++) {
+					vec3d pnt, dir, localTarget;
+					model_instance_local_to_global_point_dir(&pnt, &dir, &firingPoints[lookup % 2], &vmd_z_vector, &pm, pmi, barrel, &shipOrient, &shipPos);
+					model_instance_global_to_local_point(&localTarget, &target, &pm, pmi, barrel, &shipOrient, &shipPos);
+					checksum += pnt;
+					checksum += dir;
+					checksum += localTarget;
+				}
+			}
+		}
+
+		return test::elapsed_ms(start);
+	};
+
+	vec3d uncachedSum = vmd_zero_vector, cachedSum = vmd_zero_vector;
+	auto uncachedMs = run(&uncached, uncachedSum);
+	auto cachedMs = run(&cached, cachedSum);
+
+	EXPECT_LT(vm_vec_dist(&uncachedSum, &cachedSum), vm_vec_mag(&uncachedSum) * 1e-4f);
+
+	std::cout << NUM_FRAMES << " frames of " << NUM_TURRETS << " turrets with " << NUM_LOOKUPS << " lookups each: " << uncachedMs
+	          << " ms walking the submodel tree, " << cachedMs << " ms with cached transforms" << std::endl;
+
+	delete[] cached.submodel;
+	delete[] uncached.submodel;
+}
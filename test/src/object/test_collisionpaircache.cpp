@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include "object/collisionpaircache.h"
+
+#include "util/test_util.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+constexpr int NUM_BENCHMARK_PAIRS = 100000;
+
+SCP_vector<uint> make_keys(size_t count)
+{
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<int> objnum(0, MAX_OBJECTS - 1);
+
+	SCP_unordered_set<uint> seen;
+	SCP_vector<uint> keys;
+	while (keys.size() < count) {
+		auto key = collision_pair_key(objnum(gen), objnum(gen));
+		if (seen.insert(key).second)
+			keys.push_back(key);
+	}
+
+	return keys;
+}
+}
+
+TEST(CollisionPairCacheTest, insertFindErase)
+{
+	collision_pair_cache cache;
+	bool inserted;
+
+	ASSERT_EQ(nullptr, cache.find(collision_pair_key(1, 2)));
+
+	auto pair = cache.find_or_insert(collision_pair_key(1, 2), inserted);
+	ASSERT_TRUE(inserted);
+	ASSERT_EQ(-1, pair->signature_a);
+	pair->next_check_time = 42;
+
+	pair = cache.find_or_insert(collision_pair_key(1, 2), inserted);
+	ASSERT_FALSE(inserted);
+	ASSERT_EQ(42, pair->next_check_time);
+
+	// the pair key is ordered
+	ASSERT_EQ(nullptr, cache.find(collision_pair_key(2, 1)));
+	ASSERT_EQ(1u, cache.size());
+
+	ASSERT_TRUE(cache.erase(collision_pair_key(1, 2)));
+	ASSERT_FALSE(cache.erase(collision_pair_key(1, 2)));
+	ASSERT_EQ(nullptr, cache.find(collision_pair_key(1, 2)));
+	ASSERT_TRUE(cache.empty());
+}
+
+TEST(CollisionPairCacheTest, eraseKeepsProbeSequences)
+{
+	collision_pair_cache cache;
+	SCP_unordered_map<uint, int> reference;
+	bool inserted;
+
+	auto keys = make_keys(20000);
+	for (size_t i = 0; i < keys.size(); ++i) {
+		cache.find_or_insert(keys[i], inserted)->next_check_time = static_cast<int>(i);
+		reference[keys[i]] = static_cast<int>(i);
+	}
+
+	// remove every third pair through both removal paths
+	for (size_t i = 0; i < keys.size(); i += 6) {
+		ASSERT_TRUE(cache.erase(keys[i]));
+		reference.erase(keys[i]);
+	}
+	cache.erase_if([](uint, collider_pair& pair) { return pair.next_check_time % 6 == 3; });
+	for (size_t i = 3; i < keys.size(); i += 6)
+		reference.erase(keys[i]);
+
+	ASSERT_EQ(reference.size(), cache.size());
+	for (auto key : keys) {
+		auto pair = cache.find(key);
+		auto it = reference.find(key);
+		if (it == reference.end()) {
+			ASSERT_EQ(nullptr, pair);
+		} else {
+			ASSERT_NE(nullptr, pair);
+			ASSERT_EQ(it->second, pair->next_check_time);
+		}
+	}
+
+	size_t visited = 0;
+	cache.for_each([&visited](uint, collider_pair&) { ++visited; });
+	ASSERT_EQ(reference.size(), visited);
+}
+
+TEST(CollisionPairCacheTest, clearEmptiesTable)
+{
+	collision_pair_cache cache;
+	bool inserted;
+
+	auto keys = make_keys(5000);
+	for (auto key : keys)
+		cache.find_or_insert(key, inserted);
+
+	auto capacity = cache.capacity();
+	cache.clear();
+
+	ASSERT_TRUE(cache.empty());
+	ASSERT_EQ(capacity, cache.capacity());
+	for (auto key : keys)
+		ASSERT_EQ(nullptr, cache.find(key));
+
+	cache.find_or_insert(keys[0], inserted);
+	ASSERT_TRUE(inserted);
+	ASSERT_EQ(1u, cache.size());
+}
+
+TEST(CollisionPairCacheTest, DISABLED_benchmark)
+{
+	collision_pair_cache cache;
+	SCP_unordered_map<uint, collider_pair> map;
+	bool inserted;
+
+	auto keys = make_keys(NUM_BENCHMARK_PAIRS);
+
+	auto start = std::chrono::steady_clock::now();
+	for (auto key : keys)
+		cache.find_or_insert(key, inserted)->next_check_time = 0;
+	auto cache_insert = test::elapsed_ms(start);
+
+	start = std::chrono::steady_clock::now();
+	for (auto key : keys)
+		map[key].next_check_time = 0;
+	auto map_insert = test::elapsed_ms(start);
+
+	start = std::chrono::steady_clock::now();
+	for (auto key : keys)
+		cache.find_or_insert(key, inserted)->next_check_time++;
+	auto cache_lookup = test::elapsed_ms(start);
+
+	start = std::chrono::steady_clock::now();
+	for (auto key : keys)
+		map[key].next_check_time++;
+	auto map_lookup = test::elapsed_ms(start);
+
+	// drop every other pair and retime the rest, like obj_collide_retime_stale_pairs()
+	start = std::chrono::steady_clock::now();
+	cache.erase_if([](uint key, collider_pair& pair) {
+		if (key & 1)
+			return true;
+		pair.next_check_time = 0;
+		return false;
+	});
+	auto cache_retime = test::elapsed_ms(start);
+
+	start = std::chrono::steady_clock::now();
+	for (auto it = map.begin(); it != map.end();) {
+		if (it->first & 1) {
+			it = map.erase(it);
+		} else {
+			it->second.next_check_time = 0;
+			++it;
+		}
+	}
+	auto map_retime = test::elapsed_ms(start);
+
+	ASSERT_EQ(map.size(), cache.size());
+
+	std::cout << "Collision pair cache with " << NUM_BENCHMARK_PAIRS << " pairs (flat table vs. unordered_map):" << std::endl;
+	std::cout << "  insert: " << cache_insert << " ms vs. " << map_insert << " ms" << std::endl;
+	std::cout << "  lookup: " << cache_lookup << " ms vs. " << map_lookup << " ms" << std::endl;
+	std::cout << "  retime: " << cache_retime << " ms vs. " << map_retime << " ms" << std::endl;
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "object/objcollide.h"
+#include "object/object.h"
+
+#include "util/test_util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <random>
+
+namespace {
+constexpr int NUM_BENCHMARK_SHIPS = 400;
+constexpr int NUM_BENCHMARK_WEAPONS = 2400;
+constexpr int NUM_BENCHMARK_OBJECTS = 4000;		// room for the weapons that are fired while others are still waiting to be freed
+constexpr int NUM_BENCHMARK_CHURN = 200;		// weapons fired and weapons gone each frame
+constexpr int NUM_BENCHMARK_FRAMES = 300;
+constexpr float BENCHMARK_FRAMETIME = 1.0f / 60.0f;
+
+// A fleet battle: ships drift about while weapons are fired and expire every frame.  None of the objects have the
+// Collides flag, so obj_collide_pair() returns right away and only the broadphase is measured, which is the same
+// pair work for both paths anyway.  Returns the milliseconds spent adding, removing and sorting colliders.
+double run_churn_frames(bool full_resort)
+{
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<float> coord(-10000.0f, 10000.0f);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> ship_radius(20.0f, 400.0f);
+	std::uniform_real_distribution<float> weapon_radius(1.0f, 5.0f);
+
+	SCP_vector<vec3d> velocity(NUM_BENCHMARK_OBJECTS);
+	auto spawn = [&](int objnum, bool weapon) {
+		auto objp = &Objects[objnum];
+		objp->clear();
+		objp->type = weapon ? OBJ_WEAPON : OBJ_SHIP;
+		objp->signature = objnum + 1;
+		objp->flags.set(Object::Object_Flags::Not_in_coll);
+		objp->pos = vm_vec_new(coord(gen), coord(gen), coord(gen));
+		objp->last_pos = objp->pos;
+		objp->radius = weapon ? weapon_radius(gen) : ship_radius(gen);
+
+		float speed = weapon ? 800.0f : 60.0f;
+		velocity[objnum] = vm_vec_new(unit(gen) * speed, unit(gen) * speed, unit(gen) * speed);
+	};
+
+	// the collider list as obj_add_collider() and obj_remove_collider() kept it when every frame sorted it anew
+	SCP_vector<int> resort_list;
+	auto add = [&](int objnum) {
+		if (full_resort) {
+			Objects[objnum].flags.remove(Object::Object_Flags::Not_in_coll);
+			resort_list.push_back(objnum);
+		} else {
+			obj_add_collider(objnum);
+		}
+	};
+	auto remove = [&](int objnum) {
+		if (full_resort) {
+			Objects[objnum].flags.set(Object::Object_Flags::Not_in_coll);
+			auto it = std::find(resort_list.begin(), resort_list.end(), objnum);
+			*it = resort_list.back();
+			resort_list.pop_back();
+		} else {
+			obj_remove_collider(objnum);
+		}
+	};
+
+	obj_reset_colliders();
+
+	SCP_vector<int> live;
+	for (int objnum = 0; objnum < NUM_BENCHMARK_SHIPS + NUM_BENCHMARK_WEAPONS; ++objnum) {
+		spawn(objnum, objnum >= NUM_BENCHMARK_SHIPS);
+		add(objnum);
+		live.push_back(objnum);
+	}
+
+	// freed objects go to the back of the free list and new ones come from the front, like obj_allocate()
+	std::deque<int> free_list;
+	for (int objnum = NUM_BENCHMARK_SHIPS + NUM_BENCHMARK_WEAPONS; objnum < NUM_BENCHMARK_OBJECTS; ++objnum)
+		free_list.push_back(objnum);
+
+	double elapsed = 0.0;
+	for (int frame = 0; frame < NUM_BENCHMARK_FRAMES; ++frame) {
+		for (int i = 0; i < NUM_BENCHMARK_CHURN; ++i) {
+			int objnum = free_list.front();
+			free_list.pop_front();
+			spawn(objnum, true);
+			live.push_back(objnum);
+		}
+
+		for (int objnum : live) {
+			auto objp = &Objects[objnum];
+			objp->last_pos = objp->pos;
+			vm_vec_scale_add2(&objp->pos, &velocity[objnum], BENCHMARK_FRAMETIME);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = live.size() - NUM_BENCHMARK_CHURN; i < live.size(); ++i)
+			add(live[i]);
+		obj_sort_and_collide(full_resort ? &resort_list : nullptr);
+		elapsed += test::elapsed_ms(start);
+
+		// weapons hit something or run out of time, and are deleted at the end of the frame
+		for (int i = 0; i < NUM_BENCHMARK_CHURN; ++i) {
+			std::uniform_int_distribution<size_t> weapon(NUM_BENCHMARK_SHIPS, live.size() - 1);
+			auto index = weapon(gen);
+			int objnum = live[index];
+			live[index] = live.back();
+			live.pop_back();
+
+			start = std::chrono::steady_clock::now();
+			remove(objnum);
+			elapsed += test::elapsed_ms(start);
+
+			free_list.push_back(objnum);
+		}
+	}
+
+	obj_reset_colliders();
+	for (int objnum = 0; objnum < NUM_BENCHMARK_OBJECTS; ++objnum)
+		Objects[objnum].clear();
+
+	return elapsed;
+}
+}
+
+TEST(ObjCollideTest, DISABLED_churnBenchmark)
+{
+	auto persistent_ms = run_churn_frames(false);
+	auto full_resort_ms = run_churn_frames(true);
+
+	std::cout << NUM_BENCHMARK_FRAMES << " frames with " << NUM_BENCHMARK_SHIPS + NUM_BENCHMARK_WEAPONS << " colliders, "
+	          << NUM_BENCHMARK_CHURN << " of them replaced each frame: " << persistent_ms / NUM_BENCHMARK_FRAMES
+	          << " ms per frame keeping the sort order, " << full_resort_ms / NUM_BENCHMARK_FRAMES
+	          << " ms per frame sorting from scratch" << std::endl;
+}
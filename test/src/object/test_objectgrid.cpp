@@ -0,0 +1,412 @@
+#include <gtest/gtest.h>
+
+#include "asteroid/asteroid.h"
+#include "cfile/cfile.h"
+#include "object/object.h"
+#include "object/objectgrid.h"
+#include "ship/ship.h"
+#include "weapon/weapon.h"
+
+#include "util/FSTestFixture.h"
+#include "util/test_util.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+SCP_vector<object_grid::entry> make_fleet(size_t count, float extent, unsigned int seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<float> coord(-extent, extent);
+	std::uniform_real_distribution<float> reach(5.0f, 600.0f);
+	std::uniform_int_distribution<int> team(-1, 3);
+	std::uniform_int_distribution<int> type(1, 3);
+	std::uniform_int_distribution<int> flags(0, 7);
+
+	SCP_vector<object_grid::entry> entries(count);
+	for (size_t i = 0; i < count; ++i) {
+		auto& e = entries[i];
+		e.objnum = static_cast<int>(i * 3 + 1);
+		int t = team(gen);
+		e.team_mask = t >= 0 ? 1 << t : 0;
+		e.type = type(gen);
+		e.flags = flags(gen);
+		e.pos = vm_vec_new(coord(gen), coord(gen), coord(gen));
+		e.reach = reach(gen);
+	}
+
+	return entries;
+}
+
+object_grid::filter team_filter(int team_mask)
+{
+	object_grid::filter filter;
+	filter.team_mask = team_mask;
+	return filter;
+}
+
+bool brute_force_matches(const object_grid::entry& e, const vec3d& center, float radius, const object_grid::filter& filter)
+{
+	if (!(object_grid::type_bit(e.type) & filter.type_mask))
+		return false;
+	if (filter.team_mask != -1 && !(e.team_mask & filter.team_mask))
+		return false;
+	if ((e.flags & filter.required_flags) != filter.required_flags || (e.flags & filter.excluded_flags))
+		return false;
+
+	float max_dist = radius + e.reach;
+	return vm_vec_dist_squared(&center, &e.pos) <= max_dist * max_dist;
+}
+
+SCP_vector<int> brute_force_find(const SCP_vector<object_grid::entry>& entries, const vec3d& center, float radius, const object_grid::filter& filter)
+{
+	SCP_vector<int> objnums;
+	for (const auto& e : entries) {
+		if (brute_force_matches(e, center, radius, filter))
+			objnums.push_back(e.objnum);
+	}
+
+	return objnums;
+}
+
+object_grid::filter random_filter(std::mt19937& gen)
+{
+	std::uniform_int_distribution<int> team_mask(-1, 15);
+	std::uniform_int_distribution<int> type_mask(1, 15);
+	std::uniform_int_distribution<int> flags(0, 7);
+
+	object_grid::filter filter;
+	filter.team_mask = team_mask(gen);
+	filter.type_mask = type_mask(gen);
+	// keep most queries from coming back empty
+	filter.required_flags = flags(gen) & flags(gen) & flags(gen);
+	filter.excluded_flags = flags(gen) & flags(gen) & flags(gen) & ~filter.required_flags;
+	return filter;
+}
+}
+
+TEST(ObjectGridTest, empty)
+{
+	object_grid grid;
+	SCP_vector<int> objnums;
+
+	grid.find(vmd_zero_vector, 1000.0f, object_grid::filter(), objnums);
+	ASSERT_TRUE(objnums.empty());
+
+	grid.build({});
+	grid.find(vmd_zero_vector, 1000.0f, object_grid::filter(), objnums);
+	grid.find_nearest(vmd_zero_vector, 1000.0f, 5, object_grid::filter(), objnums);
+	ASSERT_TRUE(objnums.empty());
+	ASSERT_EQ(0u, grid.size());
+}
+
+TEST(ObjectGridTest, matchesBruteForce)
+{
+	// a tight cluster, a whole battlefield and a few far away stragglers
+	for (float extent : {1500.0f, 20000.0f, 500000.0f}) {
+		auto entries = make_fleet(500, extent, 42);
+
+		object_grid grid;
+		grid.build(entries);
+		ASSERT_EQ(entries.size(), grid.size());
+
+		std::mt19937 gen(7);
+		std::uniform_real_distribution<float> coord(-extent, extent);
+		std::uniform_real_distribution<float> radius(0.0f, 8000.0f);
+
+		SCP_vector<int> objnums;
+		for (int i = 0; i < 500; ++i) {
+			auto center = vm_vec_new(coord(gen), coord(gen), coord(gen));
+			float r = radius(gen);
+			auto filter = random_filter(gen);
+
+			objnums.clear();
+			grid.find(center, r, filter, objnums);
+
+			// same objects in the same order
+			ASSERT_EQ(brute_force_find(entries, center, r, filter), objnums) << "extent " << extent << ", query " << i;
+		}
+	}
+}
+
+TEST(ObjectGridTest, nearestMatchesBruteForce)
+{
+	auto entries = make_fleet(1000, 20000.0f, 42);
+
+	object_grid grid;
+	grid.build(entries);
+
+	std::mt19937 gen(11);
+	std::uniform_real_distribution<float> coord(-20000.0f, 20000.0f);
+	std::uniform_real_distribution<float> radius(0.0f, 10000.0f);
+	std::uniform_int_distribution<size_t> count(0, 20);
+
+	SCP_vector<int> objnums;
+	for (int i = 0; i < 500; ++i) {
+		auto center = vm_vec_new(coord(gen), coord(gen), coord(gen));
+		float r = radius(gen);
+		size_t k = count(gen);
+		auto filter = random_filter(gen);
+
+		SCP_vector<std::pair<float, size_t>> expected_found;
+		for (size_t j = 0; j < entries.size(); ++j) {
+			if (brute_force_matches(entries[j], center, r, filter))
+				expected_found.emplace_back(vm_vec_dist_squared(&center, &entries[j].pos), j);
+		}
+		std::sort(expected_found.begin(), expected_found.end());
+
+		SCP_vector<int> expected;
+		for (size_t j = 0; j < std::min(k, expected_found.size()); ++j)
+			expected.push_back(entries[expected_found[j].second].objnum);
+
+		objnums.clear();
+		grid.find_nearest(center, r, k, filter, objnums);
+		ASSERT_EQ(expected, objnums) << "query " << i;
+	}
+}
+
+TEST(ObjectGridTest, filters)
+{
+	SCP_vector<object_grid::entry> entries(3);
+	entries[0].objnum = 1;
+	entries[0].type = 1;
+	entries[0].team_mask = 1;
+	entries[0].flags = 1;
+	entries[1].objnum = 2;
+	entries[1].type = 2;
+	entries[1].team_mask = 2;
+	entries[1].flags = 3;
+	// no team
+	entries[2].objnum = 3;
+	entries[2].type = 3;
+
+	object_grid grid;
+	grid.build(entries);
+
+	object_grid::filter filter;
+	SCP_vector<int> objnums;
+	grid.find(vmd_zero_vector, 10.0f, filter, objnums);
+	ASSERT_EQ((SCP_vector<int>{1, 2, 3}), objnums);
+
+	// objects without a team only match any team
+	objnums.clear();
+	filter.team_mask = 3;
+	grid.find(vmd_zero_vector, 10.0f, filter, objnums);
+	ASSERT_EQ((SCP_vector<int>{1, 2}), objnums);
+
+	objnums.clear();
+	filter.team_mask = -1;
+	filter.type_mask = object_grid::type_bit(2) | object_grid::type_bit(3);
+	grid.find(vmd_zero_vector, 10.0f, filter, objnums);
+	ASSERT_EQ((SCP_vector<int>{2, 3}), objnums);
+
+	objnums.clear();
+	filter.type_mask = -1;
+	filter.required_flags = 1;
+	filter.excluded_flags = 2;
+	grid.find(vmd_zero_vector, 10.0f, filter, objnums);
+	ASSERT_EQ((SCP_vector<int>{1}), objnums);
+}
+
+TEST(ObjectGridTest, appendsAndRebuilds)
+{
+	SCP_vector<object_grid::entry> entries(2);
+	entries[0].objnum = 10;
+	entries[0].team_mask = 1;
+	entries[0].pos = vm_vec_new(100.0f, 0.0f, 0.0f);
+	entries[0].reach = 50.0f;
+	entries[1].objnum = 20;
+	entries[1].team_mask = 2;
+	entries[1].pos = vm_vec_new(-5000.0f, 0.0f, 0.0f);
+	entries[1].reach = 50.0f;
+
+	object_grid grid;
+	grid.build(entries);
+
+	// results are appended to what is already there
+	SCP_vector<int> objnums{-1};
+	grid.find(vmd_zero_vector, 60.0f, team_filter(1), objnums);
+	ASSERT_EQ((SCP_vector<int>{-1, 10}), objnums);
+
+	// the reach of an entry counts towards the distance
+	objnums.clear();
+	grid.find(vmd_zero_vector, 49.0f, team_filter(1), objnums);
+	ASSERT_TRUE(objnums.empty());
+
+	objnums.clear();
+	grid.find(vmd_zero_vector, 6000.0f, team_filter(2), objnums);
+	ASSERT_EQ((SCP_vector<int>{20}), objnums);
+
+	entries[0].pos = vm_vec_new(-5000.0f, 10.0f, 0.0f);
+	grid.build(entries);
+
+	objnums.clear();
+	grid.find(vm_vec_new(-5000.0f, 0.0f, 0.0f), 10.0f, team_filter(3), objnums);
+	ASSERT_EQ((SCP_vector<int>{10, 20}), objnums);
+}
+
+TEST(ObjectGridTest, objectsCreatedAfterTheBuild)
+{
+	list_init(&Ship_obj_list);
+	list_init(&Missile_obj_list);
+	list_init(&Asteroid_obj_list);
+	obj_grid_rebuild(0.0f);
+
+	// an asteroid that came into the mission after the grid was built
+	constexpr int objnum = 7;
+	auto objp = &Objects[objnum];
+	objp->clear();
+	objp->type = OBJ_ASTEROID;
+	objp->signature = 1234;
+	objp->pos = vm_vec_new(100.0f, 0.0f, 0.0f);
+	objp->radius = 10.0f;
+	obj_grid_add_late(objnum);
+
+	object_grid::filter filter;
+	SCP_vector<int> objnums;
+	obj_grid_find(vmd_zero_vector, 95.0f, filter, objnums);
+	ASSERT_EQ((SCP_vector<int>{objnum}), objnums);
+
+	objnums.clear();
+	obj_grid_find_nearest(vmd_zero_vector, 95.0f, 1, filter, objnums);
+	ASSERT_EQ((SCP_vector<int>{objnum}), objnums);
+
+	objnums.clear();
+	obj_grid_find(vmd_zero_vector, 85.0f, filter, objnums);
+	ASSERT_TRUE(objnums.empty());
+
+	filter.type_mask = object_grid::type_bit(OBJ_SHIP);
+	obj_grid_find(vmd_zero_vector, 95.0f, filter, objnums);
+	ASSERT_TRUE(objnums.empty());
+
+	// deleted, and its slot taken by something else
+	filter.type_mask = -1;
+	objp->signature = 1235;
+	obj_grid_find(vmd_zero_vector, 95.0f, filter, objnums);
+	ASSERT_TRUE(objnums.empty());
+
+	// from the next build on, only the object lists count, which the asteroid isn't in here
+	objp->signature = 1234;
+	obj_grid_rebuild(0.0f);
+	obj_grid_find(vmd_zero_vector, 95.0f, filter, objnums);
+	ASSERT_TRUE(objnums.empty());
+
+	objp->clear();
+}
+
+namespace {
+struct grid_query {
+	vec3d center;
+	float radius;
+	int count;	// -1 for obj_grid_find()
+	object_grid::filter filter;
+};
+
+struct grid_snapshot {
+	SCP_vector<object_grid::entry> entries;
+	SCP_vector<grid_query> queries;
+};
+
+// Reads a file written by the grid_snapshot debug command
+bool load_snapshot(const SCP_string& filename, grid_snapshot& snapshot)
+{
+	auto cfp = cfopen(filename.c_str(), "rt", CF_TYPE_DATA);
+	if (cfp == nullptr)
+		return false;
+
+	char line[256];
+	while (cfgets(line, static_cast<int>(sizeof(line)), cfp) != nullptr) {
+		object_grid::entry e;
+		grid_query q;
+		auto& f = q.filter;
+
+		if (sscanf(line, "entry %d %d %d %d %f %f %f %f", &e.objnum, &e.type, &e.team_mask, &e.flags, &e.pos.xyz.x, &e.pos.xyz.y, &e.pos.xyz.z, &e.reach) == 8) {
+			snapshot.entries.push_back(e);
+		} else if (sscanf(line, "find %f %f %f %f %d %d %d %d", &q.center.xyz.x, &q.center.xyz.y, &q.center.xyz.z, &q.radius, &f.type_mask, &f.team_mask, &f.required_flags, &f.excluded_flags) == 8) {
+			q.count = -1;
+			snapshot.queries.push_back(q);
+		} else if (sscanf(line, "nearest %f %f %f %f %d %d %d %d %d", &q.center.xyz.x, &q.center.xyz.y, &q.center.xyz.z, &q.radius, &q.count, &f.type_mask, &f.team_mask, &f.required_flags, &f.excluded_flags) == 9) {
+			snapshot.queries.push_back(q);
+		}
+	}
+
+	cfclose(cfp);
+	return true;
+}
+
+// What the callers did before the grid: walk all objects and check each one
+void linear_scan(const SCP_vector<object_grid::entry>& entries, const grid_query& q, SCP_vector<int>& objnums)
+{
+	if (q.count < 0) {
+		for (const auto& e : entries) {
+			if (object_grid::entry_matches(e, q.center, q.radius, q.filter))
+				objnums.push_back(e.objnum);
+		}
+		return;
+	}
+
+	static SCP_vector<std::pair<float, size_t>> found;
+	found.clear();
+	for (size_t i = 0; i < entries.size(); ++i) {
+		if (object_grid::entry_matches(entries[i], q.center, q.radius, q.filter))
+			found.emplace_back(vm_vec_dist_squared(&q.center, &entries[i].pos), i);
+	}
+
+	auto count = std::min(static_cast<size_t>(q.count), found.size());
+	std::partial_sort(found.begin(), found.begin() + count, found.end());
+	for (size_t i = 0; i < count; ++i)
+		objnums.push_back(entries[found[i].second].objnum);
+}
+}
+
+// Replays the object grid and the queries of a frame saved with the grid_snapshot debug command during a mission.
+// Snapshots go into test/test_data/objectgrid/DISABLED_snapshotBenchmark/data and end in .grid.
+class ObjectGridSnapshotTest : public test::FSTestFixture {
+  public:
+	ObjectGridSnapshotTest() : test::FSTestFixture(INIT_CFILE) { pushModDir("objectgrid"); }
+};
+
+TEST_F(ObjectGridSnapshotTest, DISABLED_snapshotBenchmark)
+{
+	SCP_vector<SCP_string> files;
+	cf_get_file_list(files, CF_TYPE_DATA, "*.grid", CF_SORT_NAME);
+	if (files.empty()) {
+		std::cout << "No object grid snapshots in objectgrid/DISABLED_snapshotBenchmark/data, save one in a mission with the grid_snapshot debug command" << std::endl;
+		return;
+	}
+
+	for (const auto& file : files) {
+		grid_snapshot snapshot;
+		ASSERT_TRUE(load_snapshot(file + ".grid", snapshot)) << file;
+
+		SCP_vector<int> objnums;
+		size_t scan_candidates = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (const auto& q : snapshot.queries) {
+			objnums.clear();
+			linear_scan(snapshot.entries, q, objnums);
+			scan_candidates += objnums.size();
+		}
+		auto scan_ms = test::elapsed_ms(start);
+
+		size_t grid_candidates = 0;
+		start = std::chrono::steady_clock::now();
+		object_grid grid;
+		grid.build(snapshot.entries);
+		for (const auto& q : snapshot.queries) {
+			objnums.clear();
+			if (q.count < 0)
+				grid.find(q.center, q.radius, q.filter, objnums);
+			else
+				grid.find_nearest(q.center, q.radius, static_cast<size_t>(q.count), q.filter, objnums);
+			grid_candidates += objnums.size();
+		}
+		auto grid_ms = test::elapsed_ms(start);
+
+		ASSERT_EQ(scan_candidates, grid_candidates) << file;
+
+		std::cout << file << ": " << snapshot.queries.size() << " queries among " << snapshot.entries.size()
+		          << " objects, " << grid_candidates << " candidates; " << scan_ms << " ms walking the objects, "
+		          << grid_ms << " ms with the grid (including the build)" << std::endl;
+	}
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include "bmpman/bmpman.h"
+#include "cmdline/cmdline.h"
+#include "physics/physics.h"
+#include "render/3d.h"
+#include "render/batching.h"
+#include "utils/threading.h"
+
+#include "util/FSTestFixture.h"
+#include "util/test_util.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+constexpr int NUM_PARTICLES = 20000;
+constexpr int NUM_BENCHMARK_PARTICLES = 200000;
+
+SCP_vector<batch_particle_instance> make_instances(size_t count, int bitmap_texture, int laser_texture)
+{
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<float> coord(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	SCP_vector<batch_particle_instance> instances(count);
+	for (auto& instance : instances) {
+		instance.position = vm_vec_new(coord(gen), coord(gen), coord(gen));
+		instance.end = vm_vec_new(coord(gen), coord(gen), coord(gen));
+		instance.radius = 0.1f + unit(gen) * 10.0f;
+		instance.angle = unit(gen) * PI2;
+		instance.alpha = unit(gen);
+		instance.is_laser = unit(gen) < 0.3f;
+		instance.texture = instance.is_laser ? laser_texture : bitmap_texture;
+
+		// culled particles
+		if (unit(gen) < 0.1f)
+			instance.texture = -1;
+	}
+
+	return instances;
+}
+
+SCP_vector<batch_vertex> take_vertices(int texture, bool is_laser)
+{
+	auto material = batch_info::FLAT_EMISSIVE;
+	if (!is_laser && gr_is_capable(gr_capability::CAPABILITY_SOFT_PARTICLES))
+		material = batch_info::VOLUME_EMISSIVE;
+
+	auto batch = batching_find_batch(texture, material);
+
+	SCP_vector<batch_vertex> verts(batch->num_verts());
+	batch->load_buffer(verts.data(), 0);
+	batch->clear();
+
+	return verts;
+}
+
+void expect_same_vertices(const SCP_vector<batch_vertex>& expected, const SCP_vector<batch_vertex>& actual, bool compare_radius)
+{
+	ASSERT_EQ(expected.size(), actual.size());
+
+	for (size_t i = 0; i < expected.size(); ++i) {
+		const auto& a = expected[i];
+		const auto& b = actual[i];
+
+		ASSERT_FLOAT_EQ(a.position.xyz.x, b.position.xyz.x) << "vertex " << i;
+		ASSERT_FLOAT_EQ(a.position.xyz.y, b.position.xyz.y) << "vertex " << i;
+		ASSERT_FLOAT_EQ(a.position.xyz.z, b.position.xyz.z) << "vertex " << i;
+		for (int j = 0; j < 4; ++j)
+			ASSERT_FLOAT_EQ(a.tex_coord.a1d[j], b.tex_coord.a1d[j]) << "vertex " << i;
+
+		ASSERT_EQ(a.r, b.r);
+		ASSERT_EQ(a.g, b.g);
+		ASSERT_EQ(a.b, b.b);
+		ASSERT_EQ(a.a, b.a);
+
+		// lasers don't use the radius
+		if (compare_radius)
+			ASSERT_FLOAT_EQ(a.radius, b.radius);
+	}
+}
+}
+
+class BatchingTest : public test::FSTestFixture {
+  public:
+	BatchingTest() : test::FSTestFixture(INIT_CFILE | INIT_GRAPHICS) {}
+
+  protected:
+	void SetUp() override
+	{
+		test::FSTestFixture::SetUp();
+
+		_old_multithreading = Cmdline_multithreading;
+		Cmdline_multithreading = 4;
+		threading::init_task_pool();
+
+		_bitmap_texture = bm_create(32, 4, 4, _pixels, 0);
+		_laser_texture = bm_create(32, 4, 4, _pixels, 0);
+		ASSERT_GE(_bitmap_texture, 0);
+		ASSERT_GE(_laser_texture, 0);
+
+		View_position = vm_vec_new(10.0f, -20.0f, -1000.0f);
+		View_matrix = vmd_identity_matrix;
+		Eye_position = View_position;
+		Eye_matrix = View_matrix;
+		Physics_viewer_bank = 0.3f;
+	}
+
+	void TearDown() override
+	{
+		threading::shut_down_task_pool();
+		Cmdline_multithreading = _old_multithreading;
+
+		test::FSTestFixture::TearDown();
+	}
+
+	void add_one_by_one(const SCP_vector<batch_particle_instance>& instances)
+	{
+		for (const auto& instance : instances) {
+			if (instance.texture < 0)
+				continue;
+
+			if (instance.is_laser) {
+				batching_add_laser(instance.texture, &instance.position, instance.radius, &instance.end, instance.radius);
+			} else {
+				vertex pos;
+				g3_transfer_vertex(&pos, &instance.position);
+				batching_add_volume_bitmap_rotated(instance.texture, &pos, instance.angle, instance.radius, instance.alpha);
+			}
+		}
+	}
+
+	uint _pixels[16] = {};
+	int _bitmap_texture = -1;
+	int _laser_texture = -1;
+	int _old_multithreading = 0;
+};
+
+TEST_F(BatchingTest, instancesMatchSingleQuads)
+{
+	auto instances = make_instances(NUM_PARTICLES, _bitmap_texture, _laser_texture);
+
+	add_one_by_one(instances);
+	auto expected_bitmaps = take_vertices(_bitmap_texture, false);
+	auto expected_lasers = take_vertices(_laser_texture, true);
+
+	batching_add_particle_instances(instances);
+	auto bitmaps = take_vertices(_bitmap_texture, false);
+	auto lasers = take_vertices(_laser_texture, true);
+
+	ASSERT_FALSE(expected_bitmaps.empty());
+	ASSERT_FALSE(expected_lasers.empty());
+	expect_same_vertices(expected_bitmaps, bitmaps, true);
+	expect_same_vertices(expected_lasers, lasers, false);
+}
+
+TEST_F(BatchingTest, instancesAppendToExistingVertices)
+{
+	auto instances = make_instances(100, _bitmap_texture, _laser_texture);
+
+	// something else already drew with the same texture this frame
+	add_one_by_one(instances);
+	add_one_by_one(instances);
+	auto expected = take_vertices(_bitmap_texture, false);
+	take_vertices(_laser_texture, true);
+
+	add_one_by_one(instances);
+	batching_add_particle_instances(instances);
+	auto actual = take_vertices(_bitmap_texture, false);
+	take_vertices(_laser_texture, true);
+
+	expect_same_vertices(expected, actual, true);
+}
+
+TEST_F(BatchingTest, DISABLED_benchmark)
+{
+	auto instances = make_instances(NUM_BENCHMARK_PARTICLES, _bitmap_texture, _laser_texture);
+
+	auto start = std::chrono::steady_clock::now();
+	add_one_by_one(instances);
+	auto single_ms = test::elapsed_ms(start);
+	take_vertices(_bitmap_texture, false);
+	take_vertices(_laser_texture, true);
+
+	start = std::chrono::steady_clock::now();
+	batching_add_particle_instances(instances);
+	auto instanced_ms = test::elapsed_ms(start);
+	take_vertices(_bitmap_texture, false);
+	take_vertices(_laser_texture, true);
+
+	std::cout << "Batching " << NUM_BENCHMARK_PARTICLES << " particles with " << threading::get_num_workers()
+	          << " workers: " << single_ms << " ms one by one, " << instanced_ms << " ms as instances" << std::endl;
+}
@@ -1,6 +1,13 @@
 
+// FSTestFixture.h pulls test::scripting into the global namespace, so the engine headers go first
+#include "scripting/hook_api.h"
+
 #include "scripting/ScriptingTestFixture.h"
 
+#include "util/test_util.h"
+
+#include <chrono>
+
 namespace {
 
 class HookVarsTest : public test::scripting::ScriptingTestFixture {
@@ -11,6 +18,78 @@ class HookVarsTest : public test::scripting::ScriptingTestFixture {
 	}
 };
 
+// Hooks are never unregistered, so the test hooks live as long as the real ones
+const std::shared_ptr<::scripting::Hook<>> TestHook = ::scripting::Hook<>::Factory("On Hook Vars Test",
+	"Only run by the hook variable tests.",
+	{
+		{"Self", "number", "A parameter."},
+		{"Object", "number", "A parameter."},
+		{"Ship", "number", "A parameter."},
+		{"Weapon", "number", "A parameter."},
+		{"Hitpos", "number", "A parameter."},
+		{"Counted", "string", "Counts how often it was marshalled."},
+	});
+
+const std::shared_ptr<::scripting::OverridableHook<>> TestOverridableHook = ::scripting::OverridableHook<>::Factory("On Overridable Hook Vars Test",
+	"Only run by the hook variable tests.",
+	{
+		{"Self", "number", "A parameter."},
+		{"Object", "number", "A parameter."},
+		{"Ship", "number", "A parameter."},
+		{"Weapon", "number", "A parameter."},
+		{"Hitpos", "number", "A parameter."},
+		{"Counted", "string", "Counts how often it was marshalled."},
+	});
+
+// A hook parameter that counts how often it is turned into a Lua value
+struct counted_string {
+	int* conversions;
+
+	operator SCP_string() const
+	{
+		++*conversions;
+		return "counted";
+	}
+};
+
+// Runs hooks of the global script state, which is what hooks always go through
+class HookRunTest : public HookVarsTest {
+  protected:
+	void SetUp() override
+	{
+		HookVarsTest::SetUp();
+
+		_oldGameInitRun = Scripting_game_init_run;
+		Scripting_game_init_run = true;
+		Script_system.CreateLuaState();
+	}
+
+	void TearDown() override
+	{
+		Script_system.Clear();
+		Scripting_game_init_run = _oldGameInitRun;
+
+		HookVarsTest::TearDown();
+	}
+
+	void add_script(const ::scripting::HookBase& hook, const char* code, bool override)
+	{
+		auto L = Script_system.GetLuaSession();
+
+		script_action action;
+		action.hook.hook_function.language = SC_LUA;
+		action.hook.hook_function.function = luacpp::LuaFunction::createFromCode(L, code, hook.getHookName());
+		action.hook.override_function.language = SC_LUA;
+		action.hook.override_function.function =
+			luacpp::LuaFunction::createFromCode(L, override ? "return true" : "return false", hook.getHookName());
+
+		Script_system.AddConditionedHook(hook.getHookId(), std::move(action));
+		Script_system.ProcessAddedHooks();
+	}
+
+	bool _oldGameInitRun = false;
+};
+
 } // namespace
 
 TEST_F(HookVarsTest, empty)
@@ -44,3 +123,107 @@ TEST_F(HookVarsTest, removeNonExistent)
 	// Should not cause any errors
 	_state->RemHookVar("Test");
 }
+
+TEST_F(HookVarsTest, slots)
+{
+	const auto slot = script_hook_var_slot("Test");
+	ASSERT_EQ(slot, script_hook_var_slot("Test"));
+	ASSERT_EQ(slot, script_find_hook_var_slot("Test"));
+	ASSERT_EQ("Test", script_hook_var_name(slot));
+	ASSERT_EQ(-1, script_find_hook_var_slot("Never used by any hook"));
+
+	// Names and slots address the same variables
+	_state->SetHookVar(slot, 'i', 1);
+	_state->SetHookVar("Test", 'i', 2);
+	ASSERT_NE(nullptr, _state->GetHookVariableReference("Test"));
+
+	_state->RemHookVar(slot);
+	ASSERT_NE(nullptr, _state->GetHookVariableReference("Test"));
+
+	_state->RemHookVar("Test");
+	ASSERT_EQ(nullptr, _state->GetHookVariableReference("Test"));
+	ASSERT_EQ(nullptr, _state->GetHookVariableReference("Never used by any hook"));
+}
+
+TEST_F(HookRunTest, runSkipsMarshallingWhenInactive)
+{
+	int conversions = 0;
+	auto params = [&conversions]() {
+		return ::scripting::hook_param_list(::scripting::hook_param("Self", 'i', 1),
+			::scripting::hook_param("Counted", 's', counted_string{&conversions}));
+	};
+
+	ASSERT_FALSE(Script_system.IsActiveAction(TestHook->getHookId()));
+	ASSERT_EQ(0, TestHook->run(params()));
+	ASSERT_EQ(0, conversions);
+
+	ASSERT_FALSE(Script_system.IsActiveAction(TestOverridableHook->getHookId()));
+	ASSERT_FALSE(TestOverridableHook->isOverride(params()));
+	ASSERT_EQ(0, conversions);
+
+	add_script(*TestHook, "HookRuns = (HookRuns or 0) + 1", false);
+	add_script(*TestOverridableHook, "", true);
+
+	ASSERT_EQ(1, TestHook->run(params()));
+	ASSERT_EQ(1, conversions);
+
+	ASSERT_TRUE(TestOverridableHook->isOverride(params()));
+	ASSERT_EQ(2, conversions);
+
+	int hookRuns = 0;
+	ASSERT_TRUE(Script_system.EvalStringWithReturn("HookRuns", "i", &hookRuns));
+	ASSERT_EQ(1, hookRuns);
+
+	// the variables only exist while the hook runs
+	ASSERT_EQ(nullptr, Script_system.GetHookVariableReference("Self"));
+	ASSERT_EQ(nullptr, Script_system.GetHookVariableReference("Counted"));
+}
+
+TEST_F(HookRunTest, DISABLED_benchmark)
+{
+	// Fires a hook with the parameters of a collision hook. The script reads one of them, like most scripts would.
+	constexpr int NUM_FIRES = 100000;
+	auto params = [](int i) {
+		return ::scripting::hook_param_list(::scripting::hook_param("Self", 'i', i),
+			::scripting::hook_param("Object", 'i', i + 1),
+			::scripting::hook_param("Ship", 'i', i + 2),
+			::scripting::hook_param("Weapon", 'i', i + 3),
+			::scripting::hook_param("Hitpos", 'i', i + 4));
+	};
+
+	int num_run = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_FIRES; ++i) {
+		num_run += TestHook->run(params(i));
+	}
+	auto inactive_ms = test::elapsed_ms(start);
+	ASSERT_EQ(0, num_run);
+
+	add_script(*TestHook, "local self = hv.Self", false);
+	add_script(*TestOverridableHook, "", false);
+
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_FIRES; ++i) {
+		num_run += TestHook->run(params(i));
+	}
+	auto run_ms = test::elapsed_ms(start);
+	ASSERT_EQ(NUM_FIRES, num_run);
+
+	int num_override = 0;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_FIRES; ++i) {
+		num_override += TestOverridableHook->isOverride(params(i)) ? 1 : 0;
+	}
+	auto override_ms = test::elapsed_ms(start);
+	ASSERT_EQ(0, num_override);
+
+	for (auto name : {"Self", "Object", "Ship", "Weapon", "Hitpos"}) {
+		ASSERT_EQ(nullptr, Script_system.GetHookVariableReference(name));
+	}
+
+	auto rate = [](double ms) { return NUM_FIRES / ms * 1000.0; };
+	std::cout << NUM_FIRES << " fires of a hook with five parameters:" << std::endl;
+	std::cout << "  without scripts: " << inactive_ms << " ms (" << rate(inactive_ms) << " per second)" << std::endl;
+	std::cout << "  run(): " << run_ms << " ms (" << rate(run_ms) << " per second)" << std::endl;
+	std::cout << "  isOverride(): " << override_ms << " ms (" << rate(override_ms) << " per second)" << std::endl;
+}
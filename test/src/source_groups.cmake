@@ -9,10 +9,18 @@ add_file_folder(""
 add_file_folder("Actions"
 )
 
+add_file_folder("AI"
+    ai/test_turretthink.cpp
+)
+
 add_file_folder("Actions\\\\Expression"
 	actions/expression/test_ExpressionParser.cpp
 )
 
+add_file_folder("Bmpman"
+    bmpman/test_bmpman.cpp
+)
+
 add_file_folder("CFile"
     cfile/cfile.cpp
 )
@@ -33,7 +41,12 @@ if (FSO_BUILD_WITH_VULKAN)
 	)
 endif()
 
+add_file_folder("Lighting"
+    lighting/test_lightgrid.cpp
+)
+
 add_file_folder("Math"
+    math/test_curve.cpp
     math/test_vecmat.cpp
 )
 
@@ -46,9 +59,17 @@ add_file_folder("mod"
 )
 
 add_file_folder("model"
+    model/test_modelcollide.cpp
+    model/test_modelcollidebvh.cpp
     model/test_modelread.cpp
 )
 
+add_file_folder("Object"
+    object/test_collisionpaircache.cpp
+    object/test_objcollide.cpp
+    object/test_objectgrid.cpp
+)
+
 add_file_folder("Parse"
     parse/test_parselo.cpp
     parse/test_replace.cpp
@@ -58,6 +79,10 @@ add_file_folder("Pilotfile"
     pilotfile/plr.cpp
 )
 
+add_file_folder("Render"
+    render/test_batching.cpp
+)
+
 add_file_folder("Scripting"
     scripting/ade_args.cpp
     scripting/doc_parser.cpp
@@ -91,10 +116,14 @@ add_file_folder("Test Util"
     util/FSTestFixture.cpp
     util/FSTestFixture.h
     util/test_util.h
+    util/vp_writer.cpp
+    util/vp_writer.h
 )
 
 add_file_folder("Utils"
     utils/HeapAllocatorTest.cpp
+    utils/SpscQueueTest.cpp
+    utils/ThreadingTest.cpp
 )
 
 add_file_folder("Weapon"
@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 // This macro skips the following test if we are not in debug mode
 // useful for things like parsing tests where there are no warnings in release mode
 #ifdef NDEBUG
@@ -15,4 +17,15 @@
 #define DEBUG_TEST() do {  } while (false)
 #endif
 
+namespace test {
+
+// Benchmarks are disabled tests (DISABLED_ prefix), run them with --gtest_also_run_disabled_tests.
+// This returns the milliseconds that have passed since start for their output.
+inline double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
 #endif //FS2_OPEN_TEST_UTIL_H
@@ -0,0 +1,55 @@
+#include "vp_writer.h"
+
+#include <cstdio>
+
+namespace test {
+
+void vp_writer::add_dir(const SCP_string& name) {
+	_entries.push_back({ name, SCP_string(), true });
+}
+
+void vp_writer::add_file(SCP_string name, SCP_string data) {
+	_entries.push_back({ std::move(name), std::move(data), false });
+}
+
+bool vp_writer::write(const SCP_string& path) {
+	FILE* fp = fopen(path.c_str(), "wb");
+	if (fp == nullptr) {
+		return false;
+	}
+
+	// the file data goes between the header and the index
+	int index_offset = 16;
+	for (const auto& entry : _entries) {
+		index_offset += static_cast<int>(entry.data.size());
+	}
+
+	const int header[4] = { 0x50565056 /* "VPVP" */, 2, index_offset, static_cast<int>(_entries.size()) };
+	fwrite(header, sizeof(header), 1, fp);
+
+	for (const auto& entry : _entries) {
+		fwrite(entry.data.data(), 1, entry.data.size(), fp);
+	}
+
+	int offset = 16;
+	for (const auto& entry : _entries) {
+		const int entry_offset = entry.is_dir ? 0 : offset;
+		const int size = static_cast<int>(entry.data.size());
+		char filename[32] = {};
+		strcpy_s(filename, entry.name.c_str());
+		const int write_time = 0;
+
+		fwrite(&entry_offset, sizeof(entry_offset), 1, fp);
+		fwrite(&size, sizeof(size), 1, fp);
+		fwrite(filename, sizeof(filename), 1, fp);
+		fwrite(&write_time, sizeof(write_time), 1, fp);
+
+		offset += size;
+	}
+
+	_entries.clear();
+
+	return fclose(fp) == 0;
+}
+
+}
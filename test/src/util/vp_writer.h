@@ -0,0 +1,31 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace test {
+
+/**
+ * @brief Writes VP pack files for tests that need more files than it makes sense to keep in the test data
+ *
+ * Entries are written in the order they were added, so directories are entered with add_dir("name") and left with
+ * add_dir("..") just like in a real pack.
+ */
+class vp_writer {
+  public:
+	void add_dir(const SCP_string& name);
+	void add_file(SCP_string name, SCP_string data);
+
+	// Writes all entries added so far to path and forgets about them. Returns false if the file could not be written.
+	bool write(const SCP_string& path);
+
+  private:
+	struct entry {
+		SCP_string name;
+		SCP_string data;
+		bool is_dir;
+	};
+
+	SCP_vector<entry> _entries;
+};
+
+}
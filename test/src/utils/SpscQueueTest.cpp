@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "utils/spsc_queue.h"
+#include "utils/threading.h"
+
+#include <thread>
+
+using namespace util;
+
+TEST(SpscQueueTests, fifoAcrossBlocks) {
+	spsc_queue<int, 4> queue;
+	int value;
+
+	ASSERT_TRUE(queue.empty());
+	ASSERT_FALSE(queue.try_pop(value));
+
+	for (int round = 0; round < 3; ++round) {
+		for (int i = 0; i < 10; ++i)
+			queue.push(int(i));
+
+		ASSERT_FALSE(queue.empty());
+		for (int i = 0; i < 10; ++i) {
+			ASSERT_TRUE(queue.try_pop(value));
+			ASSERT_EQ(i, value);
+		}
+
+		ASSERT_TRUE(queue.empty());
+		ASSERT_FALSE(queue.try_pop(value));
+	}
+}
+
+TEST(SpscQueueTests, producerConsumerThreads) {
+	constexpr int NUM_ITEMS = 200000;
+
+	spsc_queue<int, 64> queue;
+	threading::wakeup_signal signal;
+	std::atomic_bool producer_done = false;
+
+	std::thread producer([&]() {
+		for (int i = 0; i < NUM_ITEMS; ++i) {
+			queue.push(int(i));
+			signal.notify();
+		}
+		producer_done.store(true);
+		signal.notify();
+	});
+
+	int expected = 0;
+	int value;
+	while (expected < NUM_ITEMS) {
+		if (queue.try_pop(value)) {
+			ASSERT_EQ(expected, value);
+			++expected;
+			continue;
+		}
+
+		signal.wait_until([&]() { return !queue.empty() || producer_done.load(); });
+	}
+
+	producer.join();
+	ASSERT_TRUE(queue.empty());
+}
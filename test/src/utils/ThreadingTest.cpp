@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "cmdline/cmdline.h"
+#include "utils/threading.h"
+
+#include "util/test_util.h"
+
+#include <chrono>
+#include <thread>
+
+namespace {
+class ThreadingTest : public ::testing::Test {
+  protected:
+	void SetUp() override
+	{
+		_oldMultithreading = Cmdline_multithreading;
+	}
+
+	void start_pool(int num_threads)
+	{
+		Cmdline_multithreading = num_threads;
+		threading::init_task_pool();
+	}
+
+	void TearDown() override
+	{
+		threading::shut_down_task_pool();
+		Cmdline_multithreading = _oldMultithreading;
+	}
+
+	int _oldMultithreading = 0;
+};
+
+// deliberately not vectorizable, so that the work per index is roughly constant
+float burn(size_t i)
+{
+	float x = static_cast<float>(i);
+	for (int k = 0; k < 200; ++k)
+		x = std::sqrt(x + static_cast<float>(k));
+	return x;
+}
+}
+
+TEST_F(ThreadingTest, parallelForVisitsEveryIndexOnce)
+{
+	start_pool(4);
+
+	SCP_vector<std::atomic_int> visits(10000);
+	threading::parallel_for(0, visits.size(), 16, [&visits](size_t i) { visits[i].fetch_add(1); });
+
+	for (auto& count : visits)
+		ASSERT_EQ(1, count.load());
+}
+
+TEST_F(ThreadingTest, nestedTaskGroups)
+{
+	start_pool(4);
+
+	std::atomic_int total = 0;
+	threading::task_group outer;
+	for (int i = 0; i < 16; ++i) {
+		outer.run([&total]() {
+			threading::task_group inner;
+			for (int j = 0; j < 16; ++j)
+				inner.run([&total]() { total.fetch_add(1); });
+			inner.wait();
+		});
+	}
+	outer.wait();
+
+	ASSERT_EQ(16 * 16, total.load());
+}
+
+TEST_F(ThreadingTest, waitOnlyRunsTasksOfItsGroup)
+{
+	// two workers, so that the blocking task below stays queued while both are busy
+	start_pool(3);
+	ASSERT_EQ(2u, threading::get_num_workers());
+
+	std::atomic_int workers_busy = 0;
+	std::atomic_bool release_worker = false;
+	std::atomic_bool release_blocker = false;
+
+	threading::task_group occupy;
+	occupy.run([&]() {
+		workers_busy.fetch_add(1);
+		while (!release_worker.load())
+			std::this_thread::yield();
+	});
+
+	threading::task_group other;
+	other.run([&]() {
+		workers_busy.fetch_add(1);
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	});
+
+	while (workers_busy.load() < 2)
+		std::this_thread::yield();
+
+	// like a collision worker, this task only returns once the main thread has moved on
+	threading::task_group blocking;
+	blocking.run([&release_blocker]() {
+		while (!release_blocker.load())
+			std::this_thread::yield();
+	});
+
+	// waiting for the other group must not pick up the blocking task, or it would never return
+	other.wait();
+
+	release_blocker.store(true);
+	release_worker.store(true);
+	blocking.wait();
+	occupy.wait();
+}
+
+TEST_F(ThreadingTest, threadIndexIsInRange)
+{
+	start_pool(4);
+
+	const size_t num_slots = threading::get_num_workers() + 1;
+	ASSERT_EQ(0u, threading::get_thread_index());
+
+	SCP_vector<std::atomic_int> used(num_slots);
+	threading::parallel_for(0, 1000, 1, [&used, num_slots](size_t) {
+		auto index = threading::get_thread_index();
+		ASSERT_LT(index, num_slots);
+		used[index].fetch_add(1);
+	});
+
+	int sum = 0;
+	for (auto& count : used)
+		sum += count.load();
+	ASSERT_EQ(1000, sum);
+}
+
+TEST_F(ThreadingTest, DISABLED_scalingBenchmark)
+{
+	const int max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	constexpr size_t NUM_ITEMS = 200000;
+
+	SCP_vector<float> results(NUM_ITEMS);
+	double single_thread_ms = 0.0;
+
+	for (int num_threads = 1; num_threads <= max_threads; ++num_threads) {
+		start_pool(num_threads);
+
+		auto start = std::chrono::steady_clock::now();
+		threading::parallel_for(0, NUM_ITEMS, 256, [&results](size_t i) { results[i] = burn(i); });
+		auto elapsed = test::elapsed_ms(start);
+
+		if (num_threads == 1)
+			single_thread_ms = elapsed;
+
+		std::cout << "parallel_for with " << num_threads << " thread(s): " << elapsed << " ms (speedup "
+		          << single_thread_ms / elapsed << "x)" << std::endl;
+
+		threading::shut_down_task_pool();
+	}
+
+	for (size_t i = 0; i < NUM_ITEMS; i += 997)
+		ASSERT_EQ(burn(i), results[i]);
+
+	// TearDown shuts down the pool again
+	start_pool(1);
+}